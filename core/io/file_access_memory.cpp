@@ -141,6 +141,13 @@ uint64_t FileAccessMemory::get_buffer(uint8_t *p_dst, uint64_t p_length) const {
 	return read;
 }
 
+Span<uint8_t> FileAccessMemory::get_mapped_span() const {
+	if (!data || pos >= length) {
+		return Span<uint8_t>();
+	}
+	return Span<uint8_t>(&data[pos], length - pos);
+}
+
 Error FileAccessMemory::get_error() const {
 	return pos >= length ? ERR_FILE_EOF : OK;
 }
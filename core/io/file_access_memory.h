@@ -55,6 +55,7 @@ public:
 	virtual bool eof_reached() const override; ///< reading passed EOF
 
 	virtual uint64_t get_buffer(uint8_t *p_dst, uint64_t p_length) const override; ///< get an array of bytes
+	virtual Span<uint8_t> get_mapped_span() const override;
 
 	virtual Error get_error() const override; ///< get last error
 
@@ -143,9 +143,19 @@ public:
 };
 
 class PackedSourcePCK : public PackSource {
+	struct MappedPack {
+		const uint8_t *data = nullptr;
+		uint64_t size = 0;
+	};
+
+	// Packs are memory-mapped once when supported by the OS, unencrypted files are then read straight from the mapping.
+	HashMap<String, MappedPack> mapped_packs;
+
 public:
 	virtual bool try_open_pack(const String &p_path, bool p_replace_files, uint64_t p_offset) override;
 	virtual Ref<FileAccess> get_file(const String &p_path, PackedData::PackedFile *p_file) override;
+
+	virtual ~PackedSourcePCK() override;
 };
 
 class PackedSourceDirectory : public PackSource {
@@ -163,6 +173,7 @@ class FileAccessPack : public FileAccess {
 	mutable bool eof;
 	uint64_t off;
 
+	const uint8_t *mapped_data = nullptr; // Start of this file in the memory-mapped pack, if any. Used instead of `f`.
 	Ref<FileAccess> f;
 	virtual Error open_internal(const String &p_path, int p_mode_flags) override;
 	virtual uint64_t _get_modified_time(const String &p_file) override { return 0; }
@@ -187,6 +198,7 @@ public:
 	virtual bool eof_reached() const override;
 
 	virtual uint64_t get_buffer(uint8_t *p_dst, uint64_t p_length) const override;
+	virtual Span<uint8_t> get_mapped_span() const override;
 
 	virtual void set_big_endian(bool p_big_endian) override;
 
@@ -200,7 +212,7 @@ public:
 
 	virtual void close() override;
 
-	FileAccessPack(const String &p_path, const PackedData::PackedFile &p_file);
+	FileAccessPack(const String &p_path, const PackedData::PackedFile &p_file, const uint8_t *p_mapped_data = nullptr);
 };
 
 int64_t PackedData::get_size(const String &p_path) {
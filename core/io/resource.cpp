@@ -31,6 +31,7 @@
 #include "resource.h"
 
 #include "core/io/resource_loader.h"
+#include "core/io/resource_residency.h"
 #include "core/math/math_funcs.h"
 #include "core/math/random_pcg.h"
 #include "core/os/os.h"
@@ -262,6 +263,29 @@ void Resource::reload_from_file() {
 	copy_from(s);
 }
 
+Error Resource::load_payload(Variant &r_payload) const {
+	Dictionary properties;
+	Error err = ResourceLoader::read_properties(get_path(), properties);
+	if (err != OK) {
+		return err;
+	}
+	r_payload = properties;
+	return OK;
+}
+
+void Resource::apply_payload(const Variant &p_payload) {
+	ERR_FAIL_COND(p_payload.get_type() != Variant::DICTIONARY);
+	const Dictionary properties = p_payload;
+
+	_block_emit_changed();
+
+	for (const KeyValue<Variant, Variant> &E : properties) {
+		set(E.key, E.value);
+	}
+
+	_unblock_emit_changed();
+}
+
 void Resource::_dupe_sub_resources(Variant &r_variant, Node *p_for_scene, HashMap<Ref<Resource>, Ref<Resource>> &p_remap_cache) {
 	switch (r_variant.get_type()) {
 		case Variant::ARRAY: {
@@ -600,6 +624,10 @@ Resource::Resource() :
 		remapped_list(this) {}
 
 Resource::~Resource() {
+	if (unlikely(residency_tracked) && ResourceResidency::get_singleton()) {
+		ResourceResidency::get_singleton()->_resource_freed(get_instance_id());
+	}
+
 	if (unlikely(path_cache.is_empty())) {
 		return;
 	}
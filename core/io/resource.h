@@ -60,6 +60,7 @@ public:
 private:
 	friend class ResBase;
 	friend class ResourceCache;
+	friend class ResourceResidency;
 
 	String name;
 	String path_cache;
@@ -78,6 +79,7 @@ private:
 	};
 	EmitChangedState emit_changed_state = EMIT_CHANGED_UNBLOCKED;
 	bool local_to_scene = false;
+	bool residency_tracked = false;
 	friend class SceneState;
 	Node *local_scene = nullptr;
 
@@ -114,6 +116,14 @@ public:
 	virtual Error copy_from(const Ref<Resource> &p_resource);
 	virtual void reload_from_file();
 
+	// Residency (see ResourceResidency). The payload is the heavy part of a resource that can be
+	// dropped while the rest stays usable as a stub, then read back from the resource's file.
+	virtual bool can_evict_payload() const { return false; }
+	virtual uint64_t get_payload_size() const { return 0; }
+	virtual void evict_payload() {}
+	virtual Error load_payload(Variant &r_payload) const; // Thread-safe, doesn't modify the resource.
+	virtual void apply_payload(const Variant &p_payload);
+
 	void emit_changed();
 	void connect_changed(const Callable &p_callable, uint32_t p_flags = 0);
 	void disconnect_changed(const Callable &p_callable);
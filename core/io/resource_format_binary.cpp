@@ -35,6 +35,7 @@
 #include "core/io/file_access_compressed.h"
 #include "core/io/missing_resource.h"
 #include "core/object/script_language.h"
+#include "core/object/worker_thread_pool.h"
 #include "core/version.h"
 
 //#define print_bl(m_what) print_line(m_what)
@@ -445,7 +446,9 @@ Error ResourceLoaderBinary::parse_variant(Variant &r_v) {
 						r_v = Variant();
 					} else {
 						Ref<ResourceLoader::LoadToken> &load_token = external_resources.write[erindex].load_token;
-						if (load_token.is_valid()) { // If not valid, it's OK since then we know this load accepts broken dependencies.
+						if (external_resources[erindex].resource.is_valid()) {
+							r_v = external_resources[erindex].resource;
+						} else if (load_token.is_valid()) { // If not valid, it's OK since then we know this load accepts broken dependencies.
 							Error err;
 							Ref<Resource> res = ResourceLoader::_load_complete(*load_token.ptr(), &err);
 							if (res.is_null()) {
@@ -676,224 +679,480 @@ Ref<Resource> ResourceLoaderBinary::get_resource() {
 	return resource;
 }
 
-Error ResourceLoaderBinary::load() {
-	if (error != OK) {
-		return error;
-	}
-
-	for (int i = 0; i < external_resources.size(); i++) {
-		String path = external_resources[i].path;
+Error ResourceLoaderBinary::_instance_internal_resource(int p_index, InternalResourceLoad &r_load) {
+	//maybe it is loaded already
+	if (!r_load.main) {
+		r_load.path = internal_resources[p_index].path;
 
-		if (remaps.has(path)) {
-			path = remaps[path];
-		}
+		if (r_load.path.begins_with("local://")) {
+			r_load.path = r_load.path.replace_first("local://", "");
+			r_load.id = r_load.path;
+			r_load.path = res_path + "::" + r_load.path;
 
-		if (!path.contains("://") && path.is_relative_path()) {
-			// path is relative to file being loaded, so convert to a resource path
-			path = ProjectSettings::get_singleton()->localize_path(path.get_base_dir().path_join(external_resources[i].path));
+			internal_resources.write[p_index].path = r_load.path; // Update path.
 		}
 
-		external_resources.write[i].path = path; //remap happens here, not on load because on load it can actually be used for filesystem dock resource remap
-		external_resources.write[i].load_token = ResourceLoader::_load_start(path, external_resources[i].type, use_sub_threads ? ResourceLoader::LOAD_THREAD_DISTRIBUTE : ResourceLoader::LOAD_THREAD_FROM_CURRENT, cache_mode_for_external);
-		if (external_resources[i].load_token.is_null()) {
-			if (!ResourceLoader::get_abort_on_missing_resources()) {
-				ResourceLoader::notify_dependency_error(local_path, path, external_resources[i].type);
-			} else {
-				error = ERR_FILE_MISSING_DEPENDENCIES;
-				ERR_FAIL_V_MSG(error, vformat("Can't load dependency: '%s'.", path));
+		if (cache_mode == ResourceFormatLoader::CACHE_MODE_REUSE && ResourceCache::has(r_load.path)) {
+			Ref<Resource> cached = ResourceCache::get_ref(r_load.path);
+			if (cached.is_valid()) {
+				//already loaded, don't do anything
+				error = OK;
+				internal_index_cache[r_load.path] = cached;
+				r_load.cached = true;
+				return OK;
 			}
 		}
+	} else {
+		if (cache_mode != ResourceFormatLoader::CACHE_MODE_IGNORE && !ResourceCache::has(res_path)) {
+			r_load.path = res_path;
+		}
 	}
 
-	for (int i = 0; i < internal_resources.size(); i++) {
-		bool main = i == (internal_resources.size() - 1);
+	f->seek(internal_resources[p_index].offset);
 
-		//maybe it is loaded already
-		String path;
-		String id;
+	String t = get_unicode_string();
 
-		if (!main) {
-			path = internal_resources[i].path;
+	Ref<Resource> res;
+	Resource *r = nullptr;
 
-			if (path.begins_with("local://")) {
-				path = path.replace_first("local://", "");
-				id = path;
-				path = res_path + "::" + path;
-
-				internal_resources.write[i].path = path; // Update path.
+	if (r_load.main) {
+		res = ResourceLoader::get_resource_ref_override(local_path);
+		r = res.ptr();
+	}
+	if (!r) {
+		if (cache_mode == ResourceFormatLoader::CACHE_MODE_REPLACE && ResourceCache::has(r_load.path)) {
+			//use the existing one
+			Ref<Resource> cached = ResourceCache::get_ref(r_load.path);
+			if (cached->get_class() == t) {
+				cached->reset_state();
+				res = cached;
 			}
+		}
 
-			if (cache_mode == ResourceFormatLoader::CACHE_MODE_REUSE && ResourceCache::has(path)) {
-				Ref<Resource> cached = ResourceCache::get_ref(path);
-				if (cached.is_valid()) {
-					//already loaded, don't do anything
-					error = OK;
-					internal_index_cache[path] = cached;
-					continue;
+		if (res.is_null()) {
+			//did not replace
+
+			Object *obj = ClassDB::instantiate(t);
+			if (!obj) {
+				if (ResourceLoader::is_creating_missing_resources_if_class_unavailable_enabled()) {
+					//create a missing resource
+					r_load.missing_resource = memnew(MissingResource);
+					r_load.missing_resource->set_original_class(t);
+					r_load.missing_resource->set_recording_properties(true);
+					obj = r_load.missing_resource;
+				} else {
+					error = ERR_FILE_CORRUPT;
+					ERR_FAIL_V_MSG(ERR_FILE_CORRUPT, vformat("'%s': Resource of unrecognized type in file: '%s'.", local_path, t));
 				}
 			}
-		} else {
-			if (cache_mode != ResourceFormatLoader::CACHE_MODE_IGNORE && !ResourceCache::has(res_path)) {
-				path = res_path;
+
+			r = Object::cast_to<Resource>(obj);
+			if (!r) {
+				String obj_class = obj->get_class();
+				error = ERR_FILE_CORRUPT;
+				memdelete(obj); //bye
+				ERR_FAIL_V_MSG(ERR_FILE_CORRUPT, vformat("'%s': Resource type in resource field not a resource, type is: %s.", local_path, obj_class));
 			}
+
+			res = Ref<Resource>(r);
 		}
+	}
 
-		uint64_t offset = internal_resources[i].offset;
+	r_load.resource = res;
 
-		f->seek(offset);
+	if (!r_load.main) {
+		internal_index_cache[r_load.path] = res;
+	}
 
-		String t = get_unicode_string();
+	return OK;
+}
+
+void ResourceLoaderBinary::_assign_internal_resource_path(InternalResourceLoad &p_load) {
+	Resource *r = p_load.resource.ptr();
+	if (!p_load.path.is_empty()) {
+		if (cache_mode != ResourceFormatLoader::CACHE_MODE_IGNORE) {
+			r->set_path(p_load.path, cache_mode == ResourceFormatLoader::CACHE_MODE_REPLACE); // If got here because the resource with same path has different type, replace it.
+		} else {
+			r->set_path_cache(p_load.path);
+		}
+	}
+	r->set_scene_unique_id(p_load.id);
+}
 
-		Ref<Resource> res;
-		Resource *r = nullptr;
+Error ResourceLoaderBinary::_parse_internal_resource_properties(int p_index, List<Pair<StringName, Variant>> &r_properties) {
+	f->seek(internal_resources[p_index].offset);
+	get_unicode_string(); // Type, already known from instancing.
 
-		MissingResource *missing_resource = nullptr;
+	int pc = f->get_32();
 
-		if (main) {
-			res = ResourceLoader::get_resource_ref_override(local_path);
-			r = res.ptr();
+	for (int j = 0; j < pc; j++) {
+		StringName name = _get_string();
+
+		if (name == StringName()) {
+			error = ERR_FILE_CORRUPT;
+			ERR_FAIL_V(ERR_FILE_CORRUPT);
 		}
-		if (!r) {
-			if (cache_mode == ResourceFormatLoader::CACHE_MODE_REPLACE && ResourceCache::has(path)) {
-				//use the existing one
-				Ref<Resource> cached = ResourceCache::get_ref(path);
-				if (cached->get_class() == t) {
-					cached->reset_state();
-					res = cached;
-				}
+
+		Variant value;
+
+		error = parse_variant(value);
+		if (error) {
+			return error;
+		}
+
+		r_properties.push_back(Pair<StringName, Variant>(name, value));
+	}
+
+	return OK;
+}
+
+void ResourceLoaderBinary::_apply_internal_resource_properties(InternalResourceLoad &p_load) {
+	const Ref<Resource> &res = p_load.resource;
+
+	//set properties
+
+	Dictionary missing_resource_properties;
+
+	for (Pair<StringName, Variant> &E : p_load.properties) {
+		const StringName &name = E.first;
+		Variant &value = E.second;
+
+		bool set_valid = true;
+		if (value.get_type() == Variant::OBJECT && p_load.missing_resource == nullptr && ResourceLoader::is_creating_missing_resources_if_class_unavailable_enabled()) {
+			// If the property being set is a missing resource (and the parent is not),
+			// then setting it will most likely not work.
+			// Instead, save it as metadata.
+
+			Ref<MissingResource> mr = value;
+			if (mr.is_valid()) {
+				missing_resource_properties[name] = mr;
+				set_valid = false;
 			}
+		}
 
-			if (res.is_null()) {
-				//did not replace
-
-				Object *obj = ClassDB::instantiate(t);
-				if (!obj) {
-					if (ResourceLoader::is_creating_missing_resources_if_class_unavailable_enabled()) {
-						//create a missing resource
-						missing_resource = memnew(MissingResource);
-						missing_resource->set_original_class(t);
-						missing_resource->set_recording_properties(true);
-						obj = missing_resource;
-					} else {
-						error = ERR_FILE_CORRUPT;
-						ERR_FAIL_V_MSG(ERR_FILE_CORRUPT, vformat("'%s': Resource of unrecognized type in file: '%s'.", local_path, t));
-					}
+		if (value.get_type() == Variant::ARRAY) {
+			Array set_array = value;
+			bool is_get_valid = false;
+			Variant get_value = res->get(name, &is_get_valid);
+			if (is_get_valid && get_value.get_type() == Variant::ARRAY) {
+				Array get_array = get_value;
+				if (!set_array.is_same_typed(get_array)) {
+					value = Array(set_array, get_array.get_typed_builtin(), get_array.get_typed_class_name(), get_array.get_typed_script());
 				}
+			}
+		}
 
-				r = Object::cast_to<Resource>(obj);
-				if (!r) {
-					String obj_class = obj->get_class();
-					error = ERR_FILE_CORRUPT;
-					memdelete(obj); //bye
-					ERR_FAIL_V_MSG(ERR_FILE_CORRUPT, vformat("'%s': Resource type in resource field not a resource, type is: %s.", local_path, obj_class));
+		if (value.get_type() == Variant::DICTIONARY) {
+			Dictionary set_dict = value;
+			bool is_get_valid = false;
+			Variant get_value = res->get(name, &is_get_valid);
+			if (is_get_valid && get_value.get_type() == Variant::DICTIONARY) {
+				Dictionary get_dict = get_value;
+				if (!set_dict.is_same_typed(get_dict)) {
+					value = Dictionary(set_dict, get_dict.get_typed_key_builtin(), get_dict.get_typed_key_class_name(), get_dict.get_typed_key_script(),
+							get_dict.get_typed_value_builtin(), get_dict.get_typed_value_class_name(), get_dict.get_typed_value_script());
 				}
-
-				res = Ref<Resource>(r);
 			}
 		}
 
-		if (r) {
-			if (!path.is_empty()) {
-				if (cache_mode != ResourceFormatLoader::CACHE_MODE_IGNORE) {
-					r->set_path(path, cache_mode == ResourceFormatLoader::CACHE_MODE_REPLACE); // If got here because the resource with same path has different type, replace it.
+		if (set_valid) {
+			res->set(name, value);
+		}
+	}
+
+	p_load.properties.clear();
+
+	if (p_load.missing_resource) {
+		p_load.missing_resource->set_recording_properties(false);
+	}
+
+	if (!missing_resource_properties.is_empty()) {
+		res->set_meta(META_MISSING_RESOURCES, missing_resource_properties);
+	}
+}
+
+void ResourceLoaderBinary::_finish_internal_resource(int p_index, InternalResourceLoad &p_load) {
+#ifdef TOOLS_ENABLED
+	p_load.resource->set_edited(false);
+#endif
+
+	if (progress) {
+		*progress = (p_index + 1) / float(internal_resources.size());
+	}
+
+	resource_cache.push_back(p_load.resource);
+
+	if (p_load.main) {
+		f.unref();
+		resource = p_load.resource;
+		resource->set_as_translation_remapped(translation_remapped);
+		error = OK;
+	}
+}
+
+bool ResourceLoaderBinary::_can_decode_in_parallel() const {
+	if (!use_sub_threads || compressed || !using_named_scene_ids || file_path.is_empty()) {
+		return false;
+	}
+	if (internal_resources.size() < 2 || WorkerThreadPool::get_singleton()->get_thread_count() < 2) {
+		return false;
+	}
+	// Below this size, reopening the file costs more than decoding it on a single thread.
+	return f->get_length() >= PARALLEL_DECODE_MIN_FILE_SIZE;
+}
+
+Error ResourceLoaderBinary::_complete_external_resources() {
+	// Completing a load token relies on per-thread state of the resource loader,
+	// so it must happen on this thread before decoding is handed to the pool.
+	for (int i = 0; i < external_resources.size(); i++) {
+		ExtResource &er = external_resources.write[i];
+		if (er.load_token.is_null()) {
+			continue;
+		}
+
+		Error err;
+		Ref<Resource> res = ResourceLoader::_load_complete(*er.load_token.ptr(), &err);
+		if (res.is_null()) {
+			if (!ResourceLoader::is_cleaning_tasks()) {
+				if (!ResourceLoader::get_abort_on_missing_resources()) {
+					ResourceLoader::notify_dependency_error(local_path, er.path, er.type);
 				} else {
-					r->set_path_cache(path);
+					error = ERR_FILE_MISSING_DEPENDENCIES;
+					ERR_FAIL_V_MSG(error, vformat("Can't load dependency: '%s'.", er.path));
 				}
 			}
-			r->set_scene_unique_id(id);
+		} else {
+			er.resource = res;
 		}
+	}
+
+	return OK;
+}
 
-		if (!main) {
-			internal_index_cache[path] = res;
+void ResourceLoaderBinary::_decode_internal_resources_task(ParallelDecode *p_decode) {
+	// Each task decodes with its own loader and file handle, sharing only read-only state.
+	ResourceLoaderBinary decoder;
+	decoder.local_path = local_path;
+	decoder.res_path = res_path;
+	decoder.ver_format = ver_format;
+	decoder.using_named_scene_ids = using_named_scene_ids;
+	decoder.string_map = string_map;
+	decoder.internal_resources = internal_resources;
+	decoder.internal_index_cache = internal_index_cache;
+	decoder.remaps = remaps;
+	decoder.cache_mode_for_external = cache_mode_for_external;
+	decoder.external_resources = external_resources;
+	for (int i = 0; i < decoder.external_resources.size(); i++) {
+		// Failed dependencies were already reported, so treat them as accepted broken ones.
+		decoder.external_resources.write[i].load_token.unref();
+	}
+
+	Error err = OK;
+	decoder.f = FileAccess::open(file_path, FileAccess::READ, &err);
+	if (decoder.f.is_valid()) {
+		decoder.f->set_big_endian(f->is_big_endian());
+		decoder.f->real_is_double = f->real_is_double;
+	} else if (err == OK) {
+		err = ERR_FILE_CANT_OPEN;
+	}
+
+	while (true) {
+		uint32_t work = p_decode->next.postincrement();
+		if (work >= p_decode->count) {
+			break;
 		}
 
-		int pc = f->get_32();
+		uint32_t index = p_decode->indices[work];
+		InternalResourceLoad &load = p_decode->loads[index];
+		if (err != OK) {
+			load.error = err;
+			continue;
+		}
 
-		//set properties
+		decoder.error = OK;
+		load.error = decoder._parse_internal_resource_properties(index, load.properties);
+	}
+}
 
-		Dictionary missing_resource_properties;
+Error ResourceLoaderBinary::_load_internal_resources_parallel() {
+	LocalVector<InternalResourceLoad> loads;
+	loads.resize(internal_resources.size());
+	LocalVector<uint32_t> to_decode;
 
-		for (int j = 0; j < pc; j++) {
-			StringName name = _get_string();
+	// Objects are created up front so that every internal reference can be resolved while decoding.
+	for (int i = 0; i < internal_resources.size(); i++) {
+		InternalResourceLoad &load = loads[i];
+		load.main = i == (internal_resources.size() - 1);
 
-			if (name == StringName()) {
-				error = ERR_FILE_CORRUPT;
-				ERR_FAIL_V(ERR_FILE_CORRUPT);
-			}
+		Error err = _instance_internal_resource(i, load);
+		if (err != OK) {
+			return err;
+		}
+		if (!load.cached) {
+			to_decode.push_back(i);
+		}
+	}
 
-			Variant value;
+	Error err = _complete_external_resources();
+	if (err != OK) {
+		return err;
+	}
 
-			error = parse_variant(value);
-			if (error) {
-				return error;
-			}
+	ParallelDecode decode;
+	decode.loads = loads.ptr();
+	decode.indices = to_decode.ptr();
+	decode.count = to_decode.size();
 
-			bool set_valid = true;
-			if (value.get_type() == Variant::OBJECT && missing_resource == nullptr && ResourceLoader::is_creating_missing_resources_if_class_unavailable_enabled()) {
-				// If the property being set is a missing resource (and the parent is not),
-				// then setting it will most likely not work.
-				// Instead, save it as metadata.
+	// The calling thread decodes too. Helpers are regular tasks so a loader running
+	// on a pool thread waits collaboratively instead of blocking the pool.
+	int helper_count = MIN((int)to_decode.size(), WorkerThreadPool::get_singleton()->get_thread_count()) - 1;
+	LocalVector<WorkerThreadPool::TaskID> helpers;
+	for (int i = 0; i < helper_count; i++) {
+		helpers.push_back(WorkerThreadPool::get_singleton()->add_template_task(this, &ResourceLoaderBinary::_decode_internal_resources_task, &decode, false, vformat("Decode resource: %s", local_path)));
+	}
+	_decode_internal_resources_task(&decode);
+	for (WorkerThreadPool::TaskID helper : helpers) {
+		WorkerThreadPool::get_singleton()->wait_for_task_completion(helper);
+	}
 
-				Ref<MissingResource> mr = value;
-				if (mr.is_valid()) {
-					missing_resource_properties[name] = mr;
-					set_valid = false;
-				}
-			}
+	// Properties are applied serially in file order, as setters may have side effects on other resources.
+	for (uint32_t i = 0; i < loads.size(); i++) {
+		InternalResourceLoad &load = loads[i];
+		if (load.cached) {
+			continue;
+		}
 
-			if (value.get_type() == Variant::ARRAY) {
-				Array set_array = value;
-				bool is_get_valid = false;
-				Variant get_value = res->get(name, &is_get_valid);
-				if (is_get_valid && get_value.get_type() == Variant::ARRAY) {
-					Array get_array = get_value;
-					if (!set_array.is_same_typed(get_array)) {
-						value = Array(set_array, get_array.get_typed_builtin(), get_array.get_typed_class_name(), get_array.get_typed_script());
-					}
-				}
-			}
+		if (load.error != OK) {
+			error = load.error;
+			return error;
+		}
 
-			if (value.get_type() == Variant::DICTIONARY) {
-				Dictionary set_dict = value;
-				bool is_get_valid = false;
-				Variant get_value = res->get(name, &is_get_valid);
-				if (is_get_valid && get_value.get_type() == Variant::DICTIONARY) {
-					Dictionary get_dict = get_value;
-					if (!set_dict.is_same_typed(get_dict)) {
-						value = Dictionary(set_dict, get_dict.get_typed_key_builtin(), get_dict.get_typed_key_class_name(), get_dict.get_typed_key_script(),
-								get_dict.get_typed_value_builtin(), get_dict.get_typed_value_class_name(), get_dict.get_typed_value_script());
-					}
-				}
+		_assign_internal_resource_path(load);
+		_apply_internal_resource_properties(load);
+		_finish_internal_resource(i, load);
+
+		if (load.main) {
+			return OK;
+		}
+	}
+
+	return ERR_FILE_EOF;
+}
+
+Error ResourceLoaderBinary::_start_external_loads() {
+	for (int i = 0; i < external_resources.size(); i++) {
+		String path = external_resources[i].path;
+
+		if (remaps.has(path)) {
+			path = remaps[path];
+		}
+
+		if (!path.contains("://") && path.is_relative_path()) {
+			// path is relative to file being loaded, so convert to a resource path
+			path = ProjectSettings::get_singleton()->localize_path(path.get_base_dir().path_join(external_resources[i].path));
+		}
+
+		external_resources.write[i].path = path; //remap happens here, not on load because on load it can actually be used for filesystem dock resource remap
+		external_resources.write[i].load_token = ResourceLoader::_load_start(path, external_resources[i].type, use_sub_threads ? ResourceLoader::LOAD_THREAD_DISTRIBUTE : ResourceLoader::LOAD_THREAD_FROM_CURRENT, cache_mode_for_external);
+		if (external_resources[i].load_token.is_null()) {
+			if (!ResourceLoader::get_abort_on_missing_resources()) {
+				ResourceLoader::notify_dependency_error(local_path, path, external_resources[i].type);
+			} else {
+				error = ERR_FILE_MISSING_DEPENDENCIES;
+				ERR_FAIL_V_MSG(error, vformat("Can't load dependency: '%s'.", path));
 			}
+		}
+	}
+
+	return OK;
+}
 
-			if (set_valid) {
-				res->set(name, value);
+Error ResourceLoaderBinary::read_internal_resource_properties(const String &p_resource_path, Dictionary &r_properties) {
+	if (error != OK) {
+		return error;
+	}
+
+	// Only the requested sub-resource is decoded. The others are looked up in the
+	// resource cache, so references to ones that are no longer loaded come back empty.
+	int index = -1;
+	for (int i = 0; i < internal_resources.size(); i++) {
+		String path;
+		if (i == internal_resources.size() - 1) {
+			path = res_path;
+		} else {
+			path = internal_resources[i].path;
+			if (path.begins_with("local://")) {
+				path = res_path + "::" + path.replace_first("local://", "");
+				internal_resources.write[i].path = path;
 			}
 		}
 
-		if (missing_resource) {
-			missing_resource->set_recording_properties(false);
+		if (path == p_resource_path) {
+			index = i;
+		} else {
+			Ref<Resource> cached = ResourceCache::get_ref(path);
+			if (cached.is_valid()) {
+				internal_index_cache[path] = cached;
+			}
 		}
+	}
+	ERR_FAIL_COND_V_MSG(index == -1, ERR_CANT_RESOLVE, vformat("Resource '%s' not found in file: '%s'.", p_resource_path, local_path));
+
+	Error err = _start_external_loads();
+	if (err != OK) {
+		return err;
+	}
+
+	List<Pair<StringName, Variant>> properties;
+	err = _parse_internal_resource_properties(index, properties);
+	if (err != OK) {
+		return err;
+	}
+
+	for (const Pair<StringName, Variant> &E : properties) {
+		r_properties[E.first] = E.second;
+	}
+
+	return OK;
+}
+
+Error ResourceLoaderBinary::load() {
+	if (error != OK) {
+		return error;
+	}
+
+	Error err = _start_external_loads();
+	if (err != OK) {
+		return err;
+	}
 
-		if (!missing_resource_properties.is_empty()) {
-			res->set_meta(META_MISSING_RESOURCES, missing_resource_properties);
+	if (_can_decode_in_parallel()) {
+		return _load_internal_resources_parallel();
+	}
+
+	for (int i = 0; i < internal_resources.size(); i++) {
+		InternalResourceLoad load;
+		load.main = i == (internal_resources.size() - 1);
+
+		err = _instance_internal_resource(i, load);
+		if (err != OK) {
+			return err;
+		}
+		if (load.cached) {
+			continue;
 		}
 
-#ifdef TOOLS_ENABLED
-		res->set_edited(false);
-#endif
+		_assign_internal_resource_path(load);
 
-		if (progress) {
-			*progress = (i + 1) / float(internal_resources.size());
+		err = _parse_internal_resource_properties(i, load.properties);
+		if (err != OK) {
+			return err;
 		}
 
-		resource_cache.push_back(res);
+		_apply_internal_resource_properties(load);
+		_finish_internal_resource(i, load);
 
-		if (main) {
-			f.unref();
-			resource = res;
-			resource->set_as_translation_remapped(translation_remapped);
-			error = OK;
+		if (load.main) {
 			return OK;
 		}
 	}
@@ -994,6 +1253,7 @@ void ResourceLoaderBinary::open(Ref<FileAccess> p_f, bool p_no_resources, bool p
 			ERR_FAIL_MSG(vformat("Failed to open binary resource file: '%s'.", local_path));
 		}
 		f = fac;
+		compressed = true;
 
 	} else if (header[0] != 'R' || header[1] != 'S' || header[2] != 'R' || header[3] != 'C') {
 		// Not normal.
@@ -1240,6 +1500,7 @@ Ref<Resource> ResourceFormatLoaderBinary::load(const String &p_path, const Strin
 	String path = !p_original_path.is_empty() ? p_original_path : p_path;
 	loader.local_path = ProjectSettings::get_singleton()->localize_path(path);
 	loader.res_path = loader.local_path;
+	loader.file_path = p_path;
 	loader.open(f);
 
 	err = loader.load();
@@ -1254,6 +1515,27 @@ Ref<Resource> ResourceFormatLoaderBinary::load(const String &p_path, const Strin
 	return loader.resource;
 }
 
+Error ResourceFormatLoaderBinary::read_properties(const String &p_path, const String &p_original_path, const String &p_resource_path, Dictionary &r_properties) {
+	Error err;
+	Ref<FileAccess> f = FileAccess::open(p_path, FileAccess::READ, &err);
+
+	ERR_FAIL_COND_V_MSG(err != OK, err, vformat("Cannot open file '%s'.", p_path));
+
+	ResourceLoaderBinary loader;
+	String path = !p_original_path.is_empty() ? p_original_path : p_path;
+	loader.local_path = ProjectSettings::get_singleton()->localize_path(path);
+	loader.res_path = loader.local_path;
+	loader.file_path = p_path;
+	loader.open(f);
+
+	return loader.read_internal_resource_properties(p_resource_path, r_properties);
+}
+
+bool ResourceFormatLoaderBinary::can_read_properties(const String &p_path, const String &p_resource_path) const {
+	// Built-in resources are decoded on their own, see `ResourceLoaderBinary::read_internal_resource_properties`.
+	return FileAccess::exists(p_path);
+}
+
 void ResourceFormatLoaderBinary::get_recognized_extensions_for_type(const String &p_type, List<String> *p_extensions) const {
 	if (p_type.is_empty()) {
 		get_recognized_extensions(p_extensions);
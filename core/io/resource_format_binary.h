@@ -33,6 +33,9 @@
 #include "core/io/file_access.h"
 #include "core/io/resource_loader.h"
 #include "core/io/resource_saver.h"
+#include "core/templates/safe_refcount.h"
+
+class MissingResource;
 
 class ResourceLoaderBinary {
 	bool translation_remapped = false;
@@ -43,6 +46,8 @@ class ResourceLoaderBinary {
 	uint32_t ver_format = 0;
 
 	Ref<FileAccess> f;
+	String file_path; // Used to reopen the file when decoding sub-resources in parallel.
+	bool compressed = false;
 
 	uint64_t importmd_ofs = 0;
 
@@ -60,6 +65,7 @@ class ResourceLoaderBinary {
 		String type;
 		ResourceUID::ID uid = ResourceUID::INVALID_ID;
 		Ref<ResourceLoader::LoadToken> load_token;
+		Ref<Resource> resource; // Completed ahead of time when sub-resources are decoded in parallel.
 	};
 
 	bool using_named_scene_ids = false;
@@ -90,11 +96,44 @@ class ResourceLoaderBinary {
 
 	Error parse_variant(Variant &r_v);
 
+	struct InternalResourceLoad {
+		Ref<Resource> resource;
+		MissingResource *missing_resource = nullptr;
+		String path;
+		String id;
+		bool main = false;
+		bool cached = false;
+		List<Pair<StringName, Variant>> properties;
+		Error error = OK;
+	};
+
+	static constexpr uint64_t PARALLEL_DECODE_MIN_FILE_SIZE = 256 * 1024;
+
+	struct ParallelDecode {
+		InternalResourceLoad *loads = nullptr;
+		const uint32_t *indices = nullptr;
+		uint32_t count = 0;
+		SafeNumeric<uint32_t> next;
+	};
+
+	Error _start_external_loads();
+	Error _instance_internal_resource(int p_index, InternalResourceLoad &r_load);
+	void _assign_internal_resource_path(InternalResourceLoad &p_load);
+	Error _parse_internal_resource_properties(int p_index, List<Pair<StringName, Variant>> &r_properties);
+	void _apply_internal_resource_properties(InternalResourceLoad &p_load);
+	void _finish_internal_resource(int p_index, InternalResourceLoad &p_load);
+
+	bool _can_decode_in_parallel() const;
+	Error _complete_external_resources();
+	void _decode_internal_resources_task(ParallelDecode *p_decode);
+	Error _load_internal_resources_parallel();
+
 	HashMap<String, Ref<Resource>> dependency_cache;
 
 public:
 	Ref<Resource> get_resource();
 	Error load();
+	Error read_internal_resource_properties(const String &p_resource_path, Dictionary &r_properties);
 	void set_translation_remapped(bool p_remapped);
 
 	void set_remaps(const HashMap<String, String> &p_remaps) { remaps = p_remaps; }
@@ -120,6 +159,8 @@ public:
 	virtual bool has_custom_uid_support() const override;
 	virtual void get_dependencies(const String &p_path, List<String> *p_dependencies, bool p_add_types = false) override;
 	virtual Error rename_dependencies(const String &p_path, const HashMap<String, String> &p_map) override;
+	virtual Error read_properties(const String &p_path, const String &p_original_path, const String &p_resource_path, Dictionary &r_properties) override;
+	virtual bool can_read_properties(const String &p_path, const String &p_resource_path) const override;
 };
 
 class ResourceFormatSaverBinaryInstance {
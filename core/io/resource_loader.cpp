@@ -35,6 +35,7 @@
 #include "core/io/dir_access.h"
 #include "core/io/file_access.h"
 #include "core/io/resource_importer.h"
+#include "core/io/resource_persistent_cache.h"
 #include "core/object/script_language.h"
 #include "core/os/condition_variable.h"
 #include "core/os/os.h"
@@ -199,6 +200,34 @@ Error ResourceFormatLoader::rename_dependencies(const String &p_path, const Hash
 	return err;
 }
 
+Error ResourceFormatLoader::read_properties(const String &p_path, const String &p_original_path, const String &p_resource_path, Dictionary &r_properties) {
+	if (p_resource_path.contains("::")) {
+		return ERR_UNAVAILABLE; // Built-in resources can't be loaded on their own by default.
+	}
+
+	Error err = OK;
+	Ref<Resource> res = load(p_path, p_original_path, &err, false, nullptr, CACHE_MODE_IGNORE);
+	if (res.is_null()) {
+		return err != OK ? err : ERR_CANT_OPEN;
+	}
+
+	List<PropertyInfo> pi;
+	res->get_property_list(&pi);
+	for (const PropertyInfo &E : pi) {
+		if (!(E.usage & PROPERTY_USAGE_STORAGE) || E.name == "resource_path") {
+			continue;
+		}
+		r_properties[E.name] = res->get(E.name);
+	}
+
+	return OK;
+}
+
+bool ResourceFormatLoader::can_read_properties(const String &p_path, const String &p_resource_path) const {
+	// The default `read_properties` reloads the whole file, so it can't give back built-in resources.
+	return !p_resource_path.contains("::") && exists(p_path);
+}
+
 void ResourceFormatLoader::_bind_methods() {
 	BIND_ENUM_CONSTANT(CACHE_MODE_IGNORE);
 	BIND_ENUM_CONSTANT(CACHE_MODE_REUSE);
@@ -304,16 +333,26 @@ Ref<Resource> ResourceLoader::_load(const String &p_path, const String &p_origin
 
 	print_verbose(vformat("Loading resource: %s", p_path));
 
-	// Try all loaders and pick the first match for the type hint
 	bool found = false;
 	Ref<Resource> res;
-	for (int i = 0; i < loader_count; i++) {
+
+	const String cache_entry_path = ResourcePersistentCache::get_entry_path(p_path, original_path);
+	if (!cache_entry_path.is_empty()) {
+		res = ResourcePersistentCache::load(cache_entry_path, original_path, r_error, p_use_sub_threads, r_progress, p_cache_mode);
+		found = res.is_valid();
+	}
+
+	// Try all loaders and pick the first match for the type hint
+	for (int i = 0; i < loader_count && res.is_null(); i++) {
 		if (!loader[i]->recognize_path(p_path, p_type_hint)) {
 			continue;
 		}
 		found = true;
 		res = loader[i]->load(p_path, original_path, r_error, p_use_sub_threads, r_progress, p_cache_mode);
 		if (res.is_valid()) {
+			if (!cache_entry_path.is_empty()) {
+				ResourcePersistentCache::store(cache_entry_path, p_path, original_path);
+			}
 			break;
 		}
 	}
@@ -1150,6 +1189,40 @@ Error ResourceLoader::rename_dependencies(const String &p_path, const HashMap<St
 	return OK; // ??
 }
 
+Error ResourceLoader::read_properties(const String &p_resource_path, Dictionary &r_properties) {
+	ERR_FAIL_COND_V_MSG(p_resource_path.is_empty(), ERR_FILE_BAD_PATH, "Resource has no file to read properties from.");
+	const String original_path = p_resource_path.get_slice("::", 0);
+	const String local_path = import_remap(_path_remap(original_path));
+
+	for (int i = 0; i < loader_count; i++) {
+		if (!loader[i]->recognize_path(local_path)) {
+			continue;
+		}
+
+		return loader[i]->read_properties(local_path, original_path, p_resource_path, r_properties);
+	}
+
+	return ERR_FILE_UNRECOGNIZED;
+}
+
+bool ResourceLoader::can_read_properties(const String &p_resource_path) {
+	if (p_resource_path.is_empty() || p_resource_path.begins_with("local://")) {
+		return false; // Not saved to a file.
+	}
+	const String original_path = p_resource_path.get_slice("::", 0);
+	const String local_path = import_remap(_path_remap(original_path));
+
+	for (int i = 0; i < loader_count; i++) {
+		if (!loader[i]->recognize_path(local_path)) {
+			continue;
+		}
+
+		return loader[i]->can_read_properties(local_path, p_resource_path);
+	}
+
+	return false;
+}
+
 void ResourceLoader::get_classes_used(const String &p_path, HashSet<StringName> *r_classes) {
 	String local_path = _validate_local_path(p_path);
 
@@ -86,6 +86,8 @@ public:
 	virtual bool has_custom_uid_support() const;
 	virtual void get_dependencies(const String &p_path, List<String> *p_dependencies, bool p_add_types = false);
 	virtual Error rename_dependencies(const String &p_path, const HashMap<String, String> &p_map);
+	virtual Error read_properties(const String &p_path, const String &p_original_path, const String &p_resource_path, Dictionary &r_properties);
+	virtual bool can_read_properties(const String &p_path, const String &p_resource_path) const;
 	virtual bool is_import_valid(const String &p_path) const { return true; }
 	virtual bool is_imported(const String &p_path) const { return false; }
 	virtual int get_import_order(const String &p_path) const { return 0; }
@@ -249,6 +251,8 @@ public:
 	static bool should_create_uid_file(const String &p_path);
 	static void get_dependencies(const String &p_path, List<String> *p_dependencies, bool p_add_types = false);
 	static Error rename_dependencies(const String &p_path, const HashMap<String, String> &p_map);
+	static Error read_properties(const String &p_resource_path, Dictionary &r_properties);
+	static bool can_read_properties(const String &p_resource_path);
 	static bool is_import_valid(const String &p_path);
 	static String get_import_group_file(const String &p_path);
 	static bool is_imported(const String &p_path);
@@ -0,0 +1,245 @@
+/**************************************************************************/
+/*  resource_persistent_cache.cpp                                         */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#include "resource_persistent_cache.h"
+
+#include "core/config/project_settings.h"
+#include "core/io/dir_access.h"
+#include "core/io/resource_format_binary.h"
+#include "core/os/os.h"
+#include "core/version.h"
+
+bool ResourcePersistentCache::enabled = false;
+String ResourcePersistentCache::cache_dir;
+Mutex ResourcePersistentCache::mutex;
+HashSet<String> ResourcePersistentCache::pending_entries;
+LocalVector<WorkerThreadPool::TaskID> ResourcePersistentCache::pending_tasks;
+thread_local bool ResourcePersistentCache::storing = false;
+
+void ResourcePersistentCache::initialize() {
+	flush();
+
+	enabled = GLOBAL_GET("resource_loader/persistent_cache/enabled");
+#ifdef TOOLS_ENABLED
+	if (Engine::get_singleton()->is_editor_hint()) {
+		enabled = false; // Sources change all the time while editing.
+	}
+#endif
+	if (!enabled) {
+		return;
+	}
+
+	cache_dir = ProjectSettings::get_singleton()->globalize_path(GLOBAL_GET("resource_loader/persistent_cache/path"));
+	Error err = DirAccess::make_dir_recursive_absolute(cache_dir);
+	if (err != OK) {
+		enabled = false;
+		ERR_FAIL_MSG(vformat("Can't create the persistent resource cache directory: '%s'.", cache_dir));
+	}
+}
+
+String ResourcePersistentCache::_get_entry_prefix(const String &p_original_path) {
+	const ResourceUID::ID uid = ResourceLoader::get_resource_uid(p_original_path);
+	if (uid != ResourceUID::INVALID_ID) {
+		return ResourceUID::get_singleton()->id_to_text(uid).trim_prefix("uid://");
+	}
+	return p_original_path.md5_text();
+}
+
+String ResourcePersistentCache::_get_temp_path(const String &p_path) {
+	// Other processes may share the cache directory, so the thread ID alone doesn't make the name unique.
+	return p_path + vformat(".%d.%d.tmp", OS::get_singleton()->get_process_id(), (uint64_t)Thread::get_caller_id());
+}
+
+bool ResourcePersistentCache::_rename_into_place(const String &p_temp_path, const String &p_path) {
+	Ref<DirAccess> da = DirAccess::open(cache_dir);
+	if (da.is_null() || da->rename(p_temp_path, p_path) != OK) {
+		DirAccess::remove_absolute(p_temp_path);
+		return false;
+	}
+	return true;
+}
+
+String ResourcePersistentCache::get_entry_path(const String &p_path, const String &p_original_path) {
+	if (!enabled || storing) {
+		return String();
+	}
+
+	// Binary resources are already decoded from their own format, text ones are worth converting.
+	// Exported projects convert their text resources to binary, so this only helps projects that ship them as text.
+	const String extension = p_path.get_extension().to_lower();
+	if (extension != "tscn" && extension != "tres") {
+		return String();
+	}
+
+	const String prefix = _get_entry_prefix(p_original_path);
+	const uint64_t modified_time = FileAccess::get_modified_time(p_path);
+	const int64_t size = FileAccess::get_size(p_path);
+	if (size < 0) {
+		return String();
+	}
+
+	// The index remembers the key of the last hashed contents along with the file's time and size,
+	// so the sources only need to be hashed again when those change.
+	const String index_path = cache_dir.path_join(prefix + ".key");
+	const Vector<String> index = FileAccess::get_file_as_string(index_path).split(" ");
+	String key;
+	if (index.size() == 3 && index[0].to_int() == (int64_t)modified_time && index[1].to_int() == size && index[2].length() == 32) {
+		key = index[2];
+	} else {
+		const String content_hash = FileAccess::get_sha256(p_path);
+		if (content_hash.is_empty()) {
+			return String();
+		}
+
+		// Entries written by another engine build may not decode the same way.
+		key = (content_hash + GODOT_VERSION_FULL_BUILD + GODOT_VERSION_HASH).sha256_text().left(32);
+
+		// Modification times only have a precision of seconds, a file changed again within the same second
+		// would keep its time and maybe its size. Only remember files that weren't modified just now.
+		if (modified_time < (uint64_t)OS::get_singleton()->get_unix_time()) {
+			const String temp_path = _get_temp_path(index_path);
+			Ref<FileAccess> f = FileAccess::open(temp_path, FileAccess::WRITE);
+			if (f.is_valid()) {
+				f->store_string(vformat("%d %d %s", modified_time, size, key));
+				f.unref();
+				_rename_into_place(temp_path, index_path);
+			}
+		}
+	}
+
+	return cache_dir.path_join(prefix + "-" + key + ".res");
+}
+
+Ref<Resource> ResourcePersistentCache::load(const String &p_entry_path, const String &p_original_path, Error *r_error, bool p_use_sub_threads, float *r_progress, ResourceFormatLoader::CacheMode p_cache_mode) {
+	if (!FileAccess::exists(p_entry_path)) {
+		return Ref<Resource>();
+	}
+
+	ResourceFormatLoaderBinary loader;
+	Ref<Resource> res = loader.load(p_entry_path, p_original_path, r_error, p_use_sub_threads, r_progress, p_cache_mode);
+	if (res.is_null()) {
+		// Corrupt or unreadable, it will be written again after the regular load.
+		WARN_PRINT(vformat("Discarding persistent resource cache entry for '%s'.", p_original_path));
+		DirAccess::remove_absolute(p_entry_path);
+	}
+	return res;
+}
+
+void ResourcePersistentCache::store(const String &p_entry_path, const String &p_path, const String &p_original_path) {
+	MutexLock lock(mutex);
+	if (pending_entries.has(p_entry_path)) {
+		return;
+	}
+	pending_entries.insert(p_entry_path);
+
+	StoreTask *task = memnew(StoreTask);
+	task->entry_path = p_entry_path;
+	task->path = p_path;
+	task->original_path = p_original_path;
+	pending_tasks.push_back(WorkerThreadPool::get_singleton()->add_native_task(&ResourcePersistentCache::_store_task, task, false, "ResourcePersistentCache::store"));
+}
+
+void ResourcePersistentCache::_store_task(void *p_userdata) {
+	StoreTask *task = static_cast<StoreTask *>(p_userdata);
+
+	// The caller may already be modifying the resource it got, so this loads a copy of its own. Its dependencies
+	// are only referenced by path in the entry, and aren't cached from here, so they don't queue more work.
+	storing = true;
+	Ref<Resource> res = ResourceLoader::load(task->original_path, "", ResourceFormatLoader::CACHE_MODE_IGNORE);
+	storing = false;
+
+	// Don't file newer contents under the key of the ones that were loaded, in case the sources changed since.
+	if (res.is_valid() && get_entry_path(task->path, task->original_path) == task->entry_path) {
+		_write_entry(task->entry_path, res);
+	}
+
+	{
+		MutexLock lock(mutex);
+		pending_entries.erase(task->entry_path);
+	}
+	memdelete(task);
+}
+
+void ResourcePersistentCache::_write_entry(const String &p_entry_path, const Ref<Resource> &p_resource) {
+	// Write to a temporary file first, so concurrent loads never see a partial entry.
+	const String temp_path = _get_temp_path(p_entry_path);
+	ResourceFormatSaverBinaryInstance saver;
+	Error err = saver.save(temp_path, p_resource);
+	if (err != OK) {
+		DirAccess::remove_absolute(temp_path);
+		ERR_FAIL_MSG(vformat("Can't write persistent resource cache entry: '%s'.", p_entry_path));
+	}
+
+	// Drop entries for older contents of the same resource.
+	const String file_name = p_entry_path.get_file();
+	const String prefix = file_name.get_slice("-", 0) + "-";
+	Ref<DirAccess> da = DirAccess::open(cache_dir);
+	if (da.is_null()) {
+		DirAccess::remove_absolute(temp_path);
+		ERR_FAIL_MSG(vformat("Can't open the persistent resource cache directory: '%s'.", cache_dir));
+	}
+	for (const String &file : da->get_files()) {
+		if (file.begins_with(prefix) && file.ends_with(".res") && file != file_name) {
+			da->remove(file);
+		}
+	}
+
+	if (!_rename_into_place(temp_path, p_entry_path)) {
+		ERR_FAIL_MSG(vformat("Can't write persistent resource cache entry: '%s'.", p_entry_path));
+	}
+}
+
+void ResourcePersistentCache::flush() {
+	LocalVector<WorkerThreadPool::TaskID> tasks;
+	{
+		MutexLock lock(mutex);
+		tasks = pending_tasks;
+		pending_tasks.clear();
+	}
+	for (WorkerThreadPool::TaskID task : tasks) {
+		WorkerThreadPool::get_singleton()->wait_for_task_completion(task);
+	}
+}
+
+void ResourcePersistentCache::clear() {
+	flush();
+
+	if (cache_dir.is_empty()) {
+		return;
+	}
+
+	Ref<DirAccess> da = DirAccess::open(cache_dir);
+	ERR_FAIL_COND(da.is_null());
+	for (const String &file : da->get_files()) {
+		if (file.ends_with(".res") || file.ends_with(".key") || file.ends_with(".tmp")) {
+			da->remove(file);
+		}
+	}
+}
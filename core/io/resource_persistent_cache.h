@@ -0,0 +1,74 @@
+/**************************************************************************/
+/*  resource_persistent_cache.h                                           */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#pragma once
+
+#include "core/io/resource_loader.h"
+#include "core/object/worker_thread_pool.h"
+#include "core/os/mutex.h"
+#include "core/templates/hash_set.h"
+
+// Keeps binary copies of text resources on disk, so later runs can skip parsing them.
+// Entries are named after the resource UID (or path) and a hash of the source contents,
+// so edited files simply miss and their stale entries are replaced. The hash is kept in
+// an index next to the entries and only computed again when the file's time or size change.
+// Entries are written by low priority tasks, which load their own copy of the resource, so
+// the loading thread doesn't wait for the disk and nothing reads the returned resource concurrently.
+class ResourcePersistentCache {
+	struct StoreTask {
+		String entry_path;
+		String path;
+		String original_path;
+	};
+
+	static bool enabled;
+	static String cache_dir;
+
+	static Mutex mutex;
+	static HashSet<String> pending_entries;
+	static LocalVector<WorkerThreadPool::TaskID> pending_tasks;
+	static thread_local bool storing;
+
+	static String _get_entry_prefix(const String &p_original_path);
+	static String _get_temp_path(const String &p_path);
+	static bool _rename_into_place(const String &p_temp_path, const String &p_path);
+	static void _store_task(void *p_userdata);
+	static void _write_entry(const String &p_entry_path, const Ref<Resource> &p_resource);
+
+public:
+	static void initialize();
+	static bool is_enabled() { return enabled; }
+
+	static String get_entry_path(const String &p_path, const String &p_original_path);
+	static Ref<Resource> load(const String &p_entry_path, const String &p_original_path, Error *r_error, bool p_use_sub_threads, float *r_progress, ResourceFormatLoader::CacheMode p_cache_mode);
+	static void store(const String &p_entry_path, const String &p_path, const String &p_original_path);
+	static void flush();
+	static void clear();
+};
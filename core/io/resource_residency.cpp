@@ -0,0 +1,422 @@
+/**************************************************************************/
+/*  resource_residency.cpp                                                */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#include "resource_residency.h"
+
+#include "core/io/resource_loader.h"
+
+ResourceResidency *ResourceResidency::singleton = nullptr;
+
+void ResourceResidency::_erase_entry(const ObjectID &p_id) {
+	HashMap<ObjectID, Entry>::Iterator E = entries.find(p_id);
+	if (!E) {
+		return;
+	}
+	if (E->value.state == STATE_RESIDENT) {
+		resident_size -= E->value.payload_size;
+	}
+	entries.remove(E);
+}
+
+void ResourceResidency::_resource_freed(ObjectID p_id) {
+	// Called from the resource's destructor, so the entry doesn't keep counting towards the budget.
+	MutexLock lock(mutex);
+	_erase_entry(p_id);
+}
+
+void ResourceResidency::_reap_restore_tasks() {
+	LocalVector<WorkerThreadPool::TaskID> finished;
+	{
+		MutexLock lock(mutex);
+		for (int64_t i = int64_t(restore_tasks.size()) - 1; i >= 0; i--) {
+			if (WorkerThreadPool::get_singleton()->is_task_completed(restore_tasks[i])) {
+				finished.push_back(restore_tasks[i]);
+				restore_tasks.remove_at_unordered(i);
+			}
+		}
+	}
+
+	for (WorkerThreadPool::TaskID task : finished) {
+		WorkerThreadPool::get_singleton()->wait_for_task_completion(task);
+	}
+}
+
+void ResourceResidency::_evict_payload(const Ref<Resource> &p_resource) {
+	// The entry is already marked busy and no longer counted as resident.
+	p_resource->evict_payload();
+
+	MutexLock lock(mutex);
+	Entry *e = entries.getptr(p_resource->get_instance_id());
+	if (e) {
+		e->state = STATE_EVICTED;
+	}
+}
+
+void ResourceResidency::_finish_restore(const Ref<Resource> &p_resource, const Variant &p_payload, Error p_error) {
+	if (p_error == OK) {
+		p_resource->apply_payload(p_payload);
+	}
+
+	const ObjectID id = p_resource->get_instance_id();
+	{
+		MutexLock lock(mutex);
+		Entry *e = entries.getptr(id);
+		if (!e) {
+			return;
+		}
+
+		if (p_error != OK) {
+			e->state = STATE_EVICTED;
+			ERR_FAIL_MSG(vformat("Failed to restore the payload of resource: '%s'.", p_resource->get_path()));
+		}
+
+		e->state = STATE_RESIDENT;
+		e->payload_size = p_resource->get_payload_size();
+		e->last_used = ++use_counter;
+		resident_size += e->payload_size;
+	}
+
+	_enforce_budget(id);
+}
+
+void ResourceResidency::_load_payload_task(ObjectID p_id) {
+	Ref<Resource> res = ObjectDB::get_ref<Resource>(p_id);
+	if (res.is_null()) {
+		return;
+	}
+
+	Variant payload;
+	Error err = res->load_payload(payload);
+
+	{
+		MutexLock lock(mutex);
+		Entry *e = entries.getptr(p_id);
+		if (!e) {
+			return;
+		}
+		e->pending_payload = payload;
+		e->pending_error = err;
+	}
+
+	// Applying changes resources that may be in use, so it happens on the main thread.
+	callable_mp(this, &ResourceResidency::_apply_pending_payload).call_deferred(p_id);
+}
+
+void ResourceResidency::_apply_pending_payload(ObjectID p_id) {
+	_reap_restore_tasks();
+
+	Ref<Resource> res = ObjectDB::get_ref<Resource>(p_id);
+
+	Variant payload;
+	Error err;
+	{
+		MutexLock lock(mutex);
+		Entry *e = entries.getptr(p_id);
+		if (!e || e->state != STATE_BUSY) {
+			return;
+		}
+		if (res.is_null()) {
+			_erase_entry(p_id);
+			return;
+		}
+		payload = e->pending_payload;
+		err = e->pending_error;
+		e->pending_payload = Variant();
+	}
+
+	_finish_restore(res, payload, err);
+}
+
+void ResourceResidency::_enforce_budget(ObjectID p_keep) {
+	struct Candidate {
+		uint64_t last_used;
+		ObjectID id;
+
+		bool operator<(const Candidate &p_other) const { return last_used < p_other.last_used; }
+	};
+
+	LocalVector<Ref<Resource>> to_evict;
+	{
+		MutexLock lock(mutex);
+		if (budget == 0 || resident_size <= budget) {
+			return;
+		}
+
+		LocalVector<Candidate> candidates;
+		for (const KeyValue<ObjectID, Entry> &E : entries) {
+			if (E.value.state == STATE_RESIDENT && E.key != p_keep) {
+				candidates.push_back({ E.value.last_used, E.key });
+			}
+		}
+		candidates.sort();
+
+		// Least recently used first.
+		for (const Candidate &candidate : candidates) {
+			if (resident_size <= budget) {
+				break;
+			}
+
+			Ref<Resource> res = ObjectDB::get_ref<Resource>(candidate.id);
+			if (res.is_null()) {
+				_erase_entry(candidate.id);
+				continue;
+			}
+
+			Entry &e = entries[candidate.id];
+			e.state = STATE_BUSY;
+			resident_size -= e.payload_size;
+			to_evict.push_back(res);
+		}
+	}
+
+	for (const Ref<Resource> &res : to_evict) {
+		_evict_payload(res);
+	}
+}
+
+void ResourceResidency::set_budget(uint64_t p_bytes) {
+	{
+		MutexLock lock(mutex);
+		budget = p_bytes;
+	}
+	_enforce_budget();
+}
+
+uint64_t ResourceResidency::get_budget() const {
+	MutexLock lock(mutex);
+	return budget;
+}
+
+uint64_t ResourceResidency::get_resident_size() const {
+	MutexLock lock(mutex);
+	return resident_size;
+}
+
+bool ResourceResidency::track(const Ref<Resource> &p_resource) {
+	ERR_FAIL_COND_V(p_resource.is_null(), false);
+	if (!p_resource->can_evict_payload() || !ResourceLoader::can_read_properties(p_resource->get_path())) {
+		return false; // Can't be restored, so it has to stay resident.
+	}
+
+	const ObjectID id = p_resource->get_instance_id();
+	{
+		MutexLock lock(mutex);
+		if (entries.has(id)) {
+			return true;
+		}
+
+		p_resource->residency_tracked = true;
+
+		Entry e;
+		e.type = p_resource->get_class_name();
+		e.payload_size = p_resource->get_payload_size();
+		e.last_used = ++use_counter;
+		resident_size += e.payload_size;
+		entries.insert(id, e);
+	}
+
+	_enforce_budget(id);
+	return true;
+}
+
+void ResourceResidency::untrack(const Ref<Resource> &p_resource) {
+	ERR_FAIL_COND(p_resource.is_null());
+	MutexLock lock(mutex);
+	p_resource->residency_tracked = false;
+	_erase_entry(p_resource->get_instance_id());
+}
+
+bool ResourceResidency::is_tracked(const Ref<Resource> &p_resource) const {
+	ERR_FAIL_COND_V(p_resource.is_null(), false);
+	MutexLock lock(mutex);
+	return entries.has(p_resource->get_instance_id());
+}
+
+bool ResourceResidency::is_resident(const Ref<Resource> &p_resource) const {
+	ERR_FAIL_COND_V(p_resource.is_null(), false);
+	MutexLock lock(mutex);
+	const Entry *e = entries.getptr(p_resource->get_instance_id());
+	return !e || e->state == STATE_RESIDENT;
+}
+
+Ref<Resource> ResourceResidency::load_stub(const String &p_path, const String &p_type_hint) {
+	Ref<Resource> res = ResourceLoader::load(p_path, p_type_hint);
+	ERR_FAIL_COND_V_MSG(res.is_null(), Ref<Resource>(), vformat("Failed to load resource: '%s'.", p_path));
+
+	if (track(res)) {
+		evict(res);
+	}
+	return res;
+}
+
+bool ResourceResidency::evict(const Ref<Resource> &p_resource) {
+	ERR_FAIL_COND_V(p_resource.is_null(), false);
+	{
+		MutexLock lock(mutex);
+		Entry *e = entries.getptr(p_resource->get_instance_id());
+		if (!e || e->state != STATE_RESIDENT) {
+			return false;
+		}
+		e->state = STATE_BUSY;
+		resident_size -= e->payload_size;
+	}
+
+	_evict_payload(p_resource);
+	return true;
+}
+
+Error ResourceResidency::make_resident(const Ref<Resource> &p_resource) {
+	ERR_FAIL_COND_V(p_resource.is_null(), ERR_INVALID_PARAMETER);
+	{
+		MutexLock lock(mutex);
+		Entry *e = entries.getptr(p_resource->get_instance_id());
+		if (!e) {
+			return OK; // Untracked resources are always resident.
+		}
+		switch (e->state) {
+			case STATE_RESIDENT: {
+				e->last_used = ++use_counter;
+				return OK;
+			}
+			case STATE_BUSY: {
+				return ERR_BUSY;
+			}
+			case STATE_EVICTED: {
+				e->state = STATE_BUSY;
+			} break;
+		}
+	}
+
+	Variant payload;
+	Error err = p_resource->load_payload(payload);
+	_finish_restore(p_resource, payload, err);
+	return err;
+}
+
+void ResourceResidency::request_resident(const Ref<Resource> &p_resource) {
+	ERR_FAIL_COND(p_resource.is_null());
+	_reap_restore_tasks();
+
+	const ObjectID id = p_resource->get_instance_id();
+	MutexLock lock(mutex);
+	Entry *e = entries.getptr(id);
+	if (!e) {
+		return;
+	}
+	e->last_used = ++use_counter;
+	if (e->state != STATE_EVICTED) {
+		return;
+	}
+
+	e->state = STATE_BUSY;
+	restore_tasks.push_back(WorkerThreadPool::get_singleton()->add_template_task(this, &ResourceResidency::_load_payload_task, id, false, "ResourceResidency restore"));
+}
+
+void ResourceResidency::touch(const Ref<Resource> &p_resource) {
+	ERR_FAIL_COND(p_resource.is_null());
+	{
+		MutexLock lock(mutex);
+		Entry *e = entries.getptr(p_resource->get_instance_id());
+		if (!e) {
+			return;
+		}
+		e->last_used = ++use_counter;
+		if (e->state != STATE_EVICTED) {
+			return;
+		}
+	}
+
+	request_resident(p_resource);
+}
+
+Dictionary ResourceResidency::get_type_stats() const {
+	HashMap<StringName, Dictionary> stats;
+
+	MutexLock lock(mutex);
+	for (const KeyValue<ObjectID, Entry> &E : entries) {
+		Dictionary *type_stats = stats.getptr(E.value.type);
+		if (!type_stats) {
+			Dictionary d;
+			d["tracked"] = 0;
+			d["resident"] = 0;
+			d["resident_size"] = 0;
+			d["evicted"] = 0;
+			type_stats = &stats.insert(E.value.type, d)->value;
+		}
+
+		(*type_stats)["tracked"] = int64_t((*type_stats)["tracked"]) + 1;
+		if (E.value.state == STATE_RESIDENT) {
+			(*type_stats)["resident"] = int64_t((*type_stats)["resident"]) + 1;
+			(*type_stats)["resident_size"] = int64_t((*type_stats)["resident_size"]) + int64_t(E.value.payload_size);
+		} else if (E.value.state == STATE_EVICTED) {
+			(*type_stats)["evicted"] = int64_t((*type_stats)["evicted"]) + 1;
+		}
+	}
+
+	Dictionary ret;
+	for (const KeyValue<StringName, Dictionary> &E : stats) {
+		ret[E.key] = E.value;
+	}
+	return ret;
+}
+
+void ResourceResidency::_bind_methods() {
+	ClassDB::bind_method(D_METHOD("set_budget", "bytes"), &ResourceResidency::set_budget);
+	ClassDB::bind_method(D_METHOD("get_budget"), &ResourceResidency::get_budget);
+	ClassDB::bind_method(D_METHOD("get_resident_size"), &ResourceResidency::get_resident_size);
+
+	ClassDB::bind_method(D_METHOD("track", "resource"), &ResourceResidency::track);
+	ClassDB::bind_method(D_METHOD("untrack", "resource"), &ResourceResidency::untrack);
+	ClassDB::bind_method(D_METHOD("is_tracked", "resource"), &ResourceResidency::is_tracked);
+	ClassDB::bind_method(D_METHOD("is_resident", "resource"), &ResourceResidency::is_resident);
+
+	ClassDB::bind_method(D_METHOD("load_stub", "path", "type_hint"), &ResourceResidency::load_stub, DEFVAL(""));
+
+	ClassDB::bind_method(D_METHOD("evict", "resource"), &ResourceResidency::evict);
+	ClassDB::bind_method(D_METHOD("make_resident", "resource"), &ResourceResidency::make_resident);
+	ClassDB::bind_method(D_METHOD("request_resident", "resource"), &ResourceResidency::request_resident);
+	ClassDB::bind_method(D_METHOD("touch", "resource"), &ResourceResidency::touch);
+
+	ClassDB::bind_method(D_METHOD("get_type_stats"), &ResourceResidency::get_type_stats);
+
+	ADD_PROPERTY(PropertyInfo(Variant::INT, "budget", PROPERTY_HINT_NONE, "suffix:B"), "set_budget", "get_budget");
+}
+
+ResourceResidency::ResourceResidency() {
+	ERR_FAIL_COND(singleton != nullptr);
+	singleton = this;
+}
+
+ResourceResidency::~ResourceResidency() {
+	for (WorkerThreadPool::TaskID task : restore_tasks) {
+		WorkerThreadPool::get_singleton()->wait_for_task_completion(task);
+	}
+	singleton = nullptr;
+}
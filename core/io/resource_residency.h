@@ -0,0 +1,103 @@
+/**************************************************************************/
+/*  resource_residency.h                                                  */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#pragma once
+
+#include "core/io/resource.h"
+#include "core/object/worker_thread_pool.h"
+#include "core/os/mutex.h"
+#include "core/templates/hash_map.h"
+#include "core/templates/local_vector.h"
+
+class ResourceResidency : public Object {
+	GDCLASS(ResourceResidency, Object);
+
+	static ResourceResidency *singleton;
+
+	enum State {
+		STATE_RESIDENT,
+		STATE_EVICTED,
+		STATE_BUSY, // Being evicted or restored.
+	};
+
+	struct Entry {
+		StringName type;
+		State state = STATE_RESIDENT;
+		uint64_t payload_size = 0; // Last size measured while resident.
+		uint64_t last_used = 0;
+		Variant pending_payload;
+		Error pending_error = OK;
+	};
+
+	mutable Mutex mutex;
+	HashMap<ObjectID, Entry> entries;
+	uint64_t budget = 0;
+	uint64_t resident_size = 0;
+	uint64_t use_counter = 0;
+	LocalVector<WorkerThreadPool::TaskID> restore_tasks;
+
+	void _erase_entry(const ObjectID &p_id);
+	void _reap_restore_tasks();
+	void _evict_payload(const Ref<Resource> &p_resource);
+	void _finish_restore(const Ref<Resource> &p_resource, const Variant &p_payload, Error p_error);
+	void _load_payload_task(ObjectID p_id);
+	void _apply_pending_payload(ObjectID p_id);
+	void _enforce_budget(ObjectID p_keep = ObjectID());
+
+	friend class Resource;
+	void _resource_freed(ObjectID p_id);
+
+protected:
+	static void _bind_methods();
+
+public:
+	static ResourceResidency *get_singleton() { return singleton; }
+
+	void set_budget(uint64_t p_bytes);
+	uint64_t get_budget() const;
+	uint64_t get_resident_size() const;
+
+	bool track(const Ref<Resource> &p_resource);
+	void untrack(const Ref<Resource> &p_resource);
+	bool is_tracked(const Ref<Resource> &p_resource) const;
+	bool is_resident(const Ref<Resource> &p_resource) const;
+
+	Ref<Resource> load_stub(const String &p_path, const String &p_type_hint = "");
+
+	bool evict(const Ref<Resource> &p_resource);
+	Error make_resident(const Ref<Resource> &p_resource);
+	void request_resident(const Ref<Resource> &p_resource);
+	void touch(const Ref<Resource> &p_resource);
+
+	Dictionary get_type_stats() const;
+
+	ResourceResidency();
+	~ResourceResidency();
+};
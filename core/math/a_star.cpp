@@ -32,6 +32,7 @@
 #include "a_star.compat.inc"
 
 #include "core/math/geometry_3d.h"
+#include "core/object/worker_thread_pool.h"
 
 int64_t AStar3D::get_available_point_id() const {
 	if (points.has(last_free_id)) {
@@ -57,14 +58,16 @@ void AStar3D::add_point(int64_t p_id, const Vector3 &p_pos, real_t p_weight_scal
 		pt->id = p_id;
 		pt->pos = p_pos;
 		pt->weight_scale = p_weight_scale;
-		pt->prev_point = nullptr;
-		pt->open_pass = 0;
-		pt->closed_pass = 0;
 		pt->enabled = true;
 		points.set(p_id, pt);
+		_invalidate_snapshot();
 	} else {
 		found_pt->pos = p_pos;
 		found_pt->weight_scale = p_weight_scale;
+		if (!snapshot_dirty.is_set()) {
+			snapshot.positions[found_pt->snapshot_index] = p_pos;
+			snapshot.weight_scales[found_pt->snapshot_index] = p_weight_scale;
+		}
 	}
 }
 
@@ -82,6 +85,9 @@ void AStar3D::set_point_position(int64_t p_id, const Vector3 &p_pos) {
 	ERR_FAIL_COND_MSG(!p_exists, vformat("Can't set point's position. Point with id: %d doesn't exist.", p_id));
 
 	p->pos = p_pos;
+	if (!snapshot_dirty.is_set()) {
+		snapshot.positions[p->snapshot_index] = p_pos;
+	}
 }
 
 real_t AStar3D::get_point_weight_scale(int64_t p_id) const {
@@ -99,6 +105,9 @@ void AStar3D::set_point_weight_scale(int64_t p_id, real_t p_weight_scale) {
 	ERR_FAIL_COND_MSG(p_weight_scale < 0.0, vformat("Can't set point's weight scale less than 0.0: %f.", p_weight_scale));
 
 	p->weight_scale = p_weight_scale;
+	if (!snapshot_dirty.is_set()) {
+		snapshot.weight_scales[p->snapshot_index] = p_weight_scale;
+	}
 }
 
 void AStar3D::remove_point(int64_t p_id) {
@@ -125,6 +134,7 @@ void AStar3D::remove_point(int64_t p_id) {
 	memdelete(p);
 	points.remove(p_id);
 	last_free_id = p_id;
+	_invalidate_snapshot();
 }
 
 void AStar3D::connect_points(int64_t p_id, int64_t p_with_id, bool bidirectional) {
@@ -163,6 +173,7 @@ void AStar3D::connect_points(int64_t p_id, int64_t p_with_id, bool bidirectional
 	}
 
 	segments.insert(s);
+	_invalidate_snapshot();
 }
 
 void AStar3D::disconnect_points(int64_t p_id, int64_t p_with_id, bool bidirectional) {
@@ -202,6 +213,7 @@ void AStar3D::disconnect_points(int64_t p_id, int64_t p_with_id, bool bidirectio
 		if (s.direction != Segment::NONE) {
 			segments.insert(s);
 		}
+		_invalidate_snapshot();
 	}
 }
 
@@ -248,6 +260,8 @@ void AStar3D::clear() {
 	}
 	segments.clear();
 	points.clear();
+	_invalidate_snapshot();
+	_free_search_arenas();
 }
 
 int64_t AStar3D::get_point_count() const {
@@ -313,71 +327,214 @@ Vector3 AStar3D::get_closest_position_in_segment(const Vector3 &p_point) const {
 	return closest_point;
 }
 
-bool AStar3D::_solve(Point *begin_point, Point *end_point, bool p_allow_partial_path) {
-	last_closest_point = nullptr;
-	pass++;
+void AStar3D::_update_snapshot() const {
+	if (!snapshot_dirty.is_set()) {
+		return;
+	}
+
+	MutexLock lock(snapshot_mutex);
+	if (!snapshot_dirty.is_set()) {
+		return; // Another query has rebuilt it in the meantime.
+	}
+
+	const uint32_t point_count = points.get_num_elements();
+	snapshot.ids.resize(point_count);
+	snapshot.positions.resize(point_count);
+	snapshot.weight_scales.resize(point_count);
+	snapshot.enabled.resize(point_count);
+	snapshot.neighbor_offsets.resize(point_count + 1);
+
+	uint32_t index = 0;
+	uint32_t neighbor_count = 0;
+	for (OAHashMap<int64_t, Point *>::Iterator it = points.iter(); it.valid; it = points.next_iter(it)) {
+		Point *p = *(it.value);
+		p->snapshot_index = index;
+		snapshot.ids[index] = p->id;
+		snapshot.positions[index] = p->pos;
+		snapshot.weight_scales[index] = p->weight_scale;
+		snapshot.enabled[index] = p->enabled;
+		snapshot.neighbor_offsets[index] = neighbor_count;
+		neighbor_count += p->neighbors.get_num_elements();
+		index++;
+	}
+	snapshot.neighbor_offsets[point_count] = neighbor_count;
+
+	// Neighbors are stored in the order of the hash maps, so searches break ties the same way as before.
+	snapshot.neighbors.resize(neighbor_count);
+	uint32_t *neighbors = snapshot.neighbors.ptr();
+	for (OAHashMap<int64_t, Point *>::Iterator it = points.iter(); it.valid; it = points.next_iter(it)) {
+		const Point *p = *(it.value);
+		for (OAHashMap<int64_t, Point *>::Iterator nit = p->neighbors.iter(); nit.valid; nit = p->neighbors.next_iter(nit)) {
+			*neighbors++ = (*nit.value)->snapshot_index;
+		}
+	}
+
+	snapshot_dirty.clear();
+}
+
+AStar3D::SearchArena *AStar3D::_acquire_search_arena() const {
+	MutexLock lock(arena_mutex);
+	if (free_arenas.is_empty()) {
+		return memnew(SearchArena);
+	}
+
+	SearchArena *arena = free_arenas[free_arenas.size() - 1];
+	free_arenas.resize(free_arenas.size() - 1);
+	return arena;
+}
+
+void AStar3D::_release_search_arena(SearchArena *p_arena) const {
+	MutexLock lock(arena_mutex);
+	free_arenas.push_back(p_arena);
+}
+
+void AStar3D::_free_search_arenas() {
+	MutexLock lock(arena_mutex);
+	for (SearchArena *arena : free_arenas) {
+		memdelete(arena);
+	}
+	free_arenas.clear();
+}
+
+// Same as SortArray::push_heap(), but keeps track of where the nodes are in the heap.
+void AStar3D::SearchArena::push_open_entry(int64_t p_hole_index, const OpenEntry &p_entry) {
+	SortOpenEntries compare;
+	OpenEntry *entries = open_list.ptr();
+
+	int64_t parent = (p_hole_index - 1) / 2;
+	while (p_hole_index > 0 && compare(entries[parent], p_entry)) {
+		entries[p_hole_index] = entries[parent];
+		nodes[entries[p_hole_index].node].open_index = p_hole_index;
+		p_hole_index = parent;
+		parent = (p_hole_index - 1) / 2;
+	}
+	entries[p_hole_index] = p_entry;
+	nodes[p_entry.node].open_index = p_hole_index;
+}
+
+// Same as SortArray::pop_heap() followed by removing the last entry.
+void AStar3D::SearchArena::pop_open_entry() {
+	const OpenEntry last_entry = open_list[open_list.size() - 1];
+	open_list.resize(open_list.size() - 1);
+	if (open_list.is_empty()) {
+		return;
+	}
+
+	SortOpenEntries compare;
+	OpenEntry *entries = open_list.ptr();
+	const int64_t length = open_list.size();
+
+	int64_t hole_index = 0;
+	int64_t second_child = 2;
+	while (second_child < length) {
+		if (compare(entries[second_child], entries[second_child - 1])) {
+			second_child--;
+		}
+
+		entries[hole_index] = entries[second_child];
+		nodes[entries[hole_index].node].open_index = hole_index;
+		hole_index = second_child;
+		second_child = 2 * (second_child + 1);
+	}
+
+	if (second_child == length) {
+		entries[hole_index] = entries[second_child - 1];
+		nodes[entries[hole_index].node].open_index = hole_index;
+		hole_index = second_child - 1;
+	}
+	push_open_entry(hole_index, last_entry);
+}
+
+template <typename T>
+bool AStar3D::_solve(const T *p_owner, uint32_t p_begin_node, uint32_t p_end_node, bool p_allow_partial_path, SearchArena &r_arena) const {
+	r_arena.last_closest_node = UINT32_MAX;
+	r_arena.open_list.clear();
+	r_arena.pass++;
 
-	if (!end_point->enabled && !p_allow_partial_path) {
+	if (!snapshot.enabled[p_end_node] && !p_allow_partial_path) {
 		return false;
 	}
 
+	// Nodes left over from earlier queries are told apart by their pass, so they never need to be cleared.
+	if (r_arena.nodes.size() < snapshot.ids.size()) {
+		r_arena.nodes.resize(snapshot.ids.size());
+	}
+
 	bool found_route = false;
 
-	LocalVector<Point *> open_list;
-	SortArray<Point *, SortPoints> sorter;
+	const uint64_t pass = r_arena.pass;
+	const int64_t end_id = snapshot.ids[p_end_node];
+	const uint32_t *neighbor_offsets = snapshot.neighbor_offsets.ptr();
+	const uint32_t *neighbors = snapshot.neighbors.ptr();
+	SearchNode *nodes = r_arena.nodes.ptr();
+
+	SearchNode &begin_node = nodes[p_begin_node];
+	begin_node.g_score = 0;
+	begin_node.f_score = p_owner->_estimate_cost(snapshot.ids[p_begin_node], end_id);
+	begin_node.abs_f_score = begin_node.f_score;
+	begin_node.open_pass = pass;
 
-	begin_point->g_score = 0;
-	begin_point->f_score = _estimate_cost(begin_point->id, end_point->id);
-	begin_point->abs_g_score = 0;
-	begin_point->abs_f_score = _estimate_cost(begin_point->id, end_point->id);
-	open_list.push_back(begin_point);
+	OpenEntry begin_entry;
+	begin_entry.node = p_begin_node;
+	begin_entry.f_score = begin_node.f_score;
+	r_arena.open_list.push_back(begin_entry);
+	begin_node.open_index = 0;
 
-	while (!open_list.is_empty()) {
-		Point *p = open_list[0]; // The currently processed point.
+	while (!r_arena.open_list.is_empty()) {
+		const uint32_t p = r_arena.open_list[0].node; // The currently processed point.
 
 		// Find point closer to end_point, or same distance to end_point but closer to begin_point.
-		if (last_closest_point == nullptr || last_closest_point->abs_f_score > p->abs_f_score || (last_closest_point->abs_f_score >= p->abs_f_score && last_closest_point->abs_g_score > p->abs_g_score)) {
-			last_closest_point = p;
+		const uint32_t last_closest_node = r_arena.last_closest_node;
+		if (last_closest_node == UINT32_MAX || nodes[last_closest_node].abs_f_score > nodes[p].abs_f_score || (nodes[last_closest_node].abs_f_score >= nodes[p].abs_f_score && nodes[last_closest_node].g_score > nodes[p].g_score)) {
+			r_arena.last_closest_node = p;
 		}
 
-		if (p == end_point) {
+		if (p == p_end_node) {
 			found_route = true;
 			break;
 		}
 
-		sorter.pop_heap(0, open_list.size(), open_list.ptr()); // Remove the current point from the open list.
-		open_list.remove_at(open_list.size() - 1);
-		p->closed_pass = pass; // Mark the point as closed.
+		r_arena.pop_open_entry(); // Remove the current point from the open list.
+		nodes[p].closed_pass = pass; // Mark the point as closed.
 
-		for (OAHashMap<int64_t, Point *>::Iterator it = p->neighbors.iter(); it.valid; it = p->neighbors.next_iter(it)) {
-			Point *e = *(it.value); // The neighbor point.
+		const int64_t p_id = snapshot.ids[p];
+		const real_t p_g_score = nodes[p].g_score;
 
-			if (!e->enabled || e->closed_pass == pass) {
+		for (uint32_t i = neighbor_offsets[p]; i < neighbor_offsets[p + 1]; i++) {
+			const uint32_t e = neighbors[i]; // The neighbor point.
+			SearchNode &node = nodes[e];
+
+			if (!snapshot.enabled[e] || node.closed_pass == pass) {
 				continue;
 			}
 
-			real_t tentative_g_score = p->g_score + _compute_cost(p->id, e->id) * e->weight_scale;
+			const int64_t e_id = snapshot.ids[e];
+			real_t tentative_g_score = p_g_score + p_owner->_compute_cost(p_id, e_id) * snapshot.weight_scales[e];
 
 			bool new_point = false;
 
-			if (e->open_pass != pass) { // The point wasn't inside the open list.
-				e->open_pass = pass;
-				open_list.push_back(e);
+			if (node.open_pass != pass) { // The point wasn't inside the open list.
+				node.open_pass = pass;
+				r_arena.open_list.push_back(OpenEntry());
 				new_point = true;
-			} else if (tentative_g_score >= e->g_score) { // The new path is worse than the previous.
+			} else if (tentative_g_score >= node.g_score) { // The new path is worse than the previous.
 				continue;
 			}
 
-			e->prev_point = p;
-			e->g_score = tentative_g_score;
-			e->f_score = e->g_score + _estimate_cost(e->id, end_point->id);
-			e->abs_g_score = tentative_g_score;
-			e->abs_f_score = e->f_score - e->g_score;
+			node.prev_node = p;
+			node.g_score = tentative_g_score;
+			node.f_score = node.g_score + p_owner->_estimate_cost(e_id, end_id);
+			node.abs_f_score = node.f_score - node.g_score;
+
+			OpenEntry entry;
+			entry.node = e;
+			entry.g_score = node.g_score;
+			entry.f_score = node.f_score;
 
 			if (new_point) { // The position of the new points is already known.
-				sorter.push_heap(0, open_list.size() - 1, 0, e, open_list.ptr());
+				r_arena.push_open_entry(r_arena.open_list.size() - 1, entry);
 			} else {
-				sorter.push_heap(0, open_list.find(e), 0, e, open_list.ptr());
+				r_arena.push_open_entry(node.open_index, entry);
 			}
 		}
 	}
@@ -385,7 +542,120 @@ bool AStar3D::_solve(Point *begin_point, Point *end_point, bool p_allow_partial_
 	return found_route;
 }
 
-real_t AStar3D::_estimate_cost(int64_t p_from_id, int64_t p_end_id) {
+template <typename T>
+bool AStar3D::_find_path(const T *p_owner, const Point *p_begin_point, const Point *p_end_point, bool p_allow_partial_path, LocalVector<uint32_t> &r_path) const {
+	_update_snapshot();
+
+	const uint32_t begin_node = p_begin_point->snapshot_index;
+	uint32_t end_node = p_end_point->snapshot_index;
+
+	r_path.clear();
+	if (begin_node == end_node) {
+		r_path.push_back(begin_node);
+		return true;
+	}
+
+	SearchArena *arena = _acquire_search_arena();
+
+	bool found_route = _solve(p_owner, begin_node, end_node, p_allow_partial_path, *arena);
+	if (!found_route) {
+		if (!p_allow_partial_path || arena->last_closest_node == UINT32_MAX) {
+			_release_search_arena(arena);
+			return false;
+		}
+
+		// Use closest point instead.
+		end_node = arena->last_closest_node;
+	}
+
+	uint32_t node = end_node;
+	uint32_t pc = 1; // Begin point
+	while (node != begin_node) {
+		pc++;
+		node = arena->nodes[node].prev_node;
+	}
+
+	r_path.resize(pc);
+
+	node = end_node;
+	for (uint32_t idx = pc - 1; idx > 0; idx--) {
+		r_path[idx] = node;
+		node = arena->nodes[node].prev_node;
+	}
+	r_path[0] = begin_node;
+
+	_release_search_arena(arena);
+	return true;
+}
+
+template <typename T>
+Vector<int64_t> AStar3D::_get_id_path(const T *p_owner, int64_t p_from_id, int64_t p_to_id, bool p_allow_partial_path) const {
+	Point *a = nullptr;
+	bool from_exists = points.lookup(p_from_id, a);
+	ERR_FAIL_COND_V_MSG(!from_exists, Vector<int64_t>(), vformat("Can't get id path. Point with id: %d doesn't exist.", p_from_id));
+
+	Point *b = nullptr;
+	bool to_exists = points.lookup(p_to_id, b);
+	ERR_FAIL_COND_V_MSG(!to_exists, Vector<int64_t>(), vformat("Can't get id path. Point with id: %d doesn't exist.", p_to_id));
+
+	LocalVector<uint32_t> path_nodes;
+	if (!_find_path(p_owner, a, b, p_allow_partial_path, path_nodes)) {
+		return Vector<int64_t>();
+	}
+
+	Vector<int64_t> path;
+	path.resize(path_nodes.size());
+
+	int64_t *w = path.ptrw();
+	for (uint32_t i = 0; i < path_nodes.size(); i++) {
+		w[i] = snapshot.ids[path_nodes[i]];
+	}
+
+	return path;
+}
+
+template <typename T>
+void AStar3D::_get_id_paths_batch_query(uint32_t p_index, BatchQueries<T> *p_queries) const {
+	p_queries->results[p_index] = _get_id_path(p_queries->owner, p_queries->from_ids[p_index], p_queries->to_ids[p_index], p_queries->allow_partial_path);
+}
+
+template <typename T>
+TypedArray<PackedInt64Array> AStar3D::_get_id_paths_batch(const T *p_owner, const PackedInt64Array &p_from_ids, const PackedInt64Array &p_to_ids, bool p_allow_partial_path, bool p_use_threads) const {
+	ERR_FAIL_COND_V_MSG(p_from_ids.size() != p_to_ids.size(), TypedArray<PackedInt64Array>(), vformat("Can't get id paths. The number of start ids (%d) doesn't match the number of end ids (%d).", p_from_ids.size(), p_to_ids.size()));
+
+	const int64_t query_count = p_from_ids.size();
+
+	LocalVector<Vector<int64_t>> results;
+	results.resize(query_count);
+
+	BatchQueries<T> queries;
+	queries.owner = p_owner;
+	queries.from_ids = p_from_ids.ptr();
+	queries.to_ids = p_to_ids.ptr();
+	queries.allow_partial_path = p_allow_partial_path;
+	queries.results = results.ptr();
+
+	if (p_use_threads && query_count > 1) {
+		_update_snapshot(); // Build it once up front instead of having the first queries wait for it.
+
+		WorkerThreadPool::GroupID group_task = WorkerThreadPool::get_singleton()->add_template_group_task(this, &AStar3D::_get_id_paths_batch_query<T>, &queries, query_count, -1, true, SNAME("AStarIdPathsBatch"));
+		WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_task);
+	} else {
+		for (int64_t i = 0; i < query_count; i++) {
+			_get_id_paths_batch_query(i, &queries);
+		}
+	}
+
+	TypedArray<PackedInt64Array> paths;
+	paths.resize(query_count);
+	for (int64_t i = 0; i < query_count; i++) {
+		paths[i] = results[i];
+	}
+
+	return paths;
+}
+
+real_t AStar3D::_estimate_cost(int64_t p_from_id, int64_t p_end_id) const {
 	real_t scost;
 	if (GDVIRTUAL_CALL(_estimate_cost, p_from_id, p_end_id, scost)) {
 		return scost;
@@ -402,7 +672,7 @@ real_t AStar3D::_estimate_cost(int64_t p_from_id, int64_t p_end_id) {
 	return from_point->pos.distance_to(end_point->pos);
 }
 
-real_t AStar3D::_compute_cost(int64_t p_from_id, int64_t p_to_id) {
+real_t AStar3D::_compute_cost(int64_t p_from_id, int64_t p_to_id) const {
 	real_t scost;
 	if (GDVIRTUAL_CALL(_compute_cost, p_from_id, p_to_id, scost)) {
 		return scost;
@@ -419,7 +689,7 @@ real_t AStar3D::_compute_cost(int64_t p_from_id, int64_t p_to_id) {
 	return from_point->pos.distance_to(to_point->pos);
 }
 
-Vector<Vector3> AStar3D::get_point_path(int64_t p_from_id, int64_t p_to_id, bool p_allow_partial_path) {
+Vector<Vector3> AStar3D::get_point_path(int64_t p_from_id, int64_t p_to_id, bool p_allow_partial_path) const {
 	Point *a = nullptr;
 	bool from_exists = points.lookup(p_from_id, a);
 	ERR_FAIL_COND_V_MSG(!from_exists, Vector<Vector3>(), vformat("Can't get point path. Point with id: %d doesn't exist.", p_from_id));
@@ -428,103 +698,30 @@ Vector<Vector3> AStar3D::get_point_path(int64_t p_from_id, int64_t p_to_id, bool
 	bool to_exists = points.lookup(p_to_id, b);
 	ERR_FAIL_COND_V_MSG(!to_exists, Vector<Vector3>(), vformat("Can't get point path. Point with id: %d doesn't exist.", p_to_id));
 
-	if (a == b) {
-		Vector<Vector3> ret;
-		ret.push_back(a->pos);
-		return ret;
-	}
-
-	Point *begin_point = a;
-	Point *end_point = b;
-
-	bool found_route = _solve(begin_point, end_point, p_allow_partial_path);
-	if (!found_route) {
-		if (!p_allow_partial_path || last_closest_point == nullptr) {
-			return Vector<Vector3>();
-		}
-
-		// Use closest point instead.
-		end_point = last_closest_point;
-	}
-
-	Point *p = end_point;
-	int64_t pc = 1; // Begin point
-	while (p != begin_point) {
-		pc++;
-		p = p->prev_point;
+	LocalVector<uint32_t> path_nodes;
+	if (!_find_path(this, a, b, p_allow_partial_path, path_nodes)) {
+		return Vector<Vector3>();
 	}
 
 	Vector<Vector3> path;
-	path.resize(pc);
-
-	{
-		Vector3 *w = path.ptrw();
-
-		Point *p2 = end_point;
-		int64_t idx = pc - 1;
-		while (p2 != begin_point) {
-			w[idx--] = p2->pos;
-			p2 = p2->prev_point;
-		}
+	path.resize(path_nodes.size());
 
-		w[0] = p2->pos; // Assign first
+	Vector3 *w = path.ptrw();
+	for (uint32_t i = 0; i < path_nodes.size(); i++) {
+		w[i] = snapshot.positions[path_nodes[i]];
 	}
 
 	return path;
 }
 
-Vector<int64_t> AStar3D::get_id_path(int64_t p_from_id, int64_t p_to_id, bool p_allow_partial_path) {
-	Point *a = nullptr;
-	bool from_exists = points.lookup(p_from_id, a);
-	ERR_FAIL_COND_V_MSG(!from_exists, Vector<int64_t>(), vformat("Can't get id path. Point with id: %d doesn't exist.", p_from_id));
-
-	Point *b = nullptr;
-	bool to_exists = points.lookup(p_to_id, b);
-	ERR_FAIL_COND_V_MSG(!to_exists, Vector<int64_t>(), vformat("Can't get id path. Point with id: %d doesn't exist.", p_to_id));
-
-	if (a == b) {
-		Vector<int64_t> ret;
-		ret.push_back(a->id);
-		return ret;
-	}
-
-	Point *begin_point = a;
-	Point *end_point = b;
-
-	bool found_route = _solve(begin_point, end_point, p_allow_partial_path);
-	if (!found_route) {
-		if (!p_allow_partial_path || last_closest_point == nullptr) {
-			return Vector<int64_t>();
-		}
-
-		// Use closest point instead.
-		end_point = last_closest_point;
-	}
-
-	Point *p = end_point;
-	int64_t pc = 1; // Begin point
-	while (p != begin_point) {
-		pc++;
-		p = p->prev_point;
-	}
-
-	Vector<int64_t> path;
-	path.resize(pc);
-
-	{
-		int64_t *w = path.ptrw();
-
-		p = end_point;
-		int64_t idx = pc - 1;
-		while (p != begin_point) {
-			w[idx--] = p->id;
-			p = p->prev_point;
-		}
-
-		w[0] = p->id; // Assign first
-	}
+Vector<int64_t> AStar3D::get_id_path(int64_t p_from_id, int64_t p_to_id, bool p_allow_partial_path) const {
+	return _get_id_path(this, p_from_id, p_to_id, p_allow_partial_path);
+}
 
-	return path;
+TypedArray<PackedInt64Array> AStar3D::get_id_paths_batch(const PackedInt64Array &p_from_ids, const PackedInt64Array &p_to_ids, bool p_allow_partial_path) const {
+	// Scripted costs are not guaranteed to be safe to call from several threads.
+	const bool use_threads = !GDVIRTUAL_IS_OVERRIDDEN(_estimate_cost) && !GDVIRTUAL_IS_OVERRIDDEN(_compute_cost);
+	return _get_id_paths_batch(this, p_from_ids, p_to_ids, p_allow_partial_path, use_threads);
 }
 
 void AStar3D::set_point_disabled(int64_t p_id, bool p_disabled) {
@@ -533,6 +730,9 @@ void AStar3D::set_point_disabled(int64_t p_id, bool p_disabled) {
 	ERR_FAIL_COND_MSG(!p_exists, vformat("Can't set if point is disabled. Point with id: %d doesn't exist.", p_id));
 
 	p->enabled = !p_disabled;
+	if (!snapshot_dirty.is_set()) {
+		snapshot.enabled[p->snapshot_index] = !p_disabled;
+	}
 }
 
 bool AStar3D::is_point_disabled(int64_t p_id) const {
@@ -572,6 +772,7 @@ void AStar3D::_bind_methods() {
 
 	ClassDB::bind_method(D_METHOD("get_point_path", "from_id", "to_id", "allow_partial_path"), &AStar3D::get_point_path, DEFVAL(false));
 	ClassDB::bind_method(D_METHOD("get_id_path", "from_id", "to_id", "allow_partial_path"), &AStar3D::get_id_path, DEFVAL(false));
+	ClassDB::bind_method(D_METHOD("get_id_paths_batch", "from_ids", "to_ids", "allow_partial_path"), &AStar3D::get_id_paths_batch, DEFVAL(false));
 
 	GDVIRTUAL_BIND(_estimate_cost, "from_id", "end_id")
 	GDVIRTUAL_BIND(_compute_cost, "from_id", "to_id")
@@ -669,7 +870,7 @@ Vector2 AStar2D::get_closest_position_in_segment(const Vector2 &p_point) const {
 	return Vector2(p.x, p.y);
 }
 
-real_t AStar2D::_estimate_cost(int64_t p_from_id, int64_t p_end_id) {
+real_t AStar2D::_estimate_cost(int64_t p_from_id, int64_t p_end_id) const {
 	real_t scost;
 	if (GDVIRTUAL_CALL(_estimate_cost, p_from_id, p_end_id, scost)) {
 		return scost;
@@ -686,7 +887,7 @@ real_t AStar2D::_estimate_cost(int64_t p_from_id, int64_t p_end_id) {
 	return from_point->pos.distance_to(end_point->pos);
 }
 
-real_t AStar2D::_compute_cost(int64_t p_from_id, int64_t p_to_id) {
+real_t AStar2D::_compute_cost(int64_t p_from_id, int64_t p_to_id) const {
 	real_t scost;
 	if (GDVIRTUAL_CALL(_compute_cost, p_from_id, p_to_id, scost)) {
 		return scost;
@@ -703,7 +904,7 @@ real_t AStar2D::_compute_cost(int64_t p_from_id, int64_t p_to_id) {
 	return from_point->pos.distance_to(to_point->pos);
 }
 
-Vector<Vector2> AStar2D::get_point_path(int64_t p_from_id, int64_t p_to_id, bool p_allow_partial_path) {
+Vector<Vector2> AStar2D::get_point_path(int64_t p_from_id, int64_t p_to_id, bool p_allow_partial_path) const {
 	AStar3D::Point *a = nullptr;
 	bool from_exists = astar.points.lookup(p_from_id, a);
 	ERR_FAIL_COND_V_MSG(!from_exists, Vector<Vector2>(), vformat("Can't get point path. Point with id: %d doesn't exist.", p_from_id));
@@ -712,174 +913,31 @@ Vector<Vector2> AStar2D::get_point_path(int64_t p_from_id, int64_t p_to_id, bool
 	bool to_exists = astar.points.lookup(p_to_id, b);
 	ERR_FAIL_COND_V_MSG(!to_exists, Vector<Vector2>(), vformat("Can't get point path. Point with id: %d doesn't exist.", p_to_id));
 
-	if (a == b) {
-		Vector<Vector2> ret = { Vector2(a->pos.x, a->pos.y) };
-		return ret;
-	}
-
-	AStar3D::Point *begin_point = a;
-	AStar3D::Point *end_point = b;
-
-	bool found_route = _solve(begin_point, end_point, p_allow_partial_path);
-	if (!found_route) {
-		if (!p_allow_partial_path || astar.last_closest_point == nullptr) {
-			return Vector<Vector2>();
-		}
-
-		// Use closest point instead.
-		end_point = astar.last_closest_point;
-	}
-
-	AStar3D::Point *p = end_point;
-	int64_t pc = 1; // Begin point
-	while (p != begin_point) {
-		pc++;
-		p = p->prev_point;
+	LocalVector<uint32_t> path_nodes;
+	if (!astar._find_path(this, a, b, p_allow_partial_path, path_nodes)) {
+		return Vector<Vector2>();
 	}
 
 	Vector<Vector2> path;
-	path.resize(pc);
-
-	{
-		Vector2 *w = path.ptrw();
+	path.resize(path_nodes.size());
 
-		AStar3D::Point *p2 = end_point;
-		int64_t idx = pc - 1;
-		while (p2 != begin_point) {
-			w[idx--] = Vector2(p2->pos.x, p2->pos.y);
-			p2 = p2->prev_point;
-		}
-
-		w[0] = Vector2(p2->pos.x, p2->pos.y); // Assign first
+	Vector2 *w = path.ptrw();
+	for (uint32_t i = 0; i < path_nodes.size(); i++) {
+		const Vector3 &pos = astar.snapshot.positions[path_nodes[i]];
+		w[i] = Vector2(pos.x, pos.y);
 	}
 
 	return path;
 }
 
-Vector<int64_t> AStar2D::get_id_path(int64_t p_from_id, int64_t p_to_id, bool p_allow_partial_path) {
-	AStar3D::Point *a = nullptr;
-	bool from_exists = astar.points.lookup(p_from_id, a);
-	ERR_FAIL_COND_V_MSG(!from_exists, Vector<int64_t>(), vformat("Can't get id path. Point with id: %d doesn't exist.", p_from_id));
-
-	AStar3D::Point *b = nullptr;
-	bool to_exists = astar.points.lookup(p_to_id, b);
-	ERR_FAIL_COND_V_MSG(!to_exists, Vector<int64_t>(), vformat("Can't get id path. Point with id: %d doesn't exist.", p_to_id));
-
-	if (a == b) {
-		Vector<int64_t> ret;
-		ret.push_back(a->id);
-		return ret;
-	}
-
-	AStar3D::Point *begin_point = a;
-	AStar3D::Point *end_point = b;
-
-	bool found_route = _solve(begin_point, end_point, p_allow_partial_path);
-	if (!found_route) {
-		if (!p_allow_partial_path || astar.last_closest_point == nullptr) {
-			return Vector<int64_t>();
-		}
-
-		// Use closest point instead.
-		end_point = astar.last_closest_point;
-	}
-
-	AStar3D::Point *p = end_point;
-	int64_t pc = 1; // Begin point
-	while (p != begin_point) {
-		pc++;
-		p = p->prev_point;
-	}
-
-	Vector<int64_t> path;
-	path.resize(pc);
-
-	{
-		int64_t *w = path.ptrw();
-
-		p = end_point;
-		int64_t idx = pc - 1;
-		while (p != begin_point) {
-			w[idx--] = p->id;
-			p = p->prev_point;
-		}
-
-		w[0] = p->id; // Assign first
-	}
-
-	return path;
+Vector<int64_t> AStar2D::get_id_path(int64_t p_from_id, int64_t p_to_id, bool p_allow_partial_path) const {
+	return astar._get_id_path(this, p_from_id, p_to_id, p_allow_partial_path);
 }
 
-bool AStar2D::_solve(AStar3D::Point *begin_point, AStar3D::Point *end_point, bool p_allow_partial_path) {
-	astar.last_closest_point = nullptr;
-	astar.pass++;
-
-	if (!end_point->enabled && !p_allow_partial_path) {
-		return false;
-	}
-
-	bool found_route = false;
-
-	LocalVector<AStar3D::Point *> open_list;
-	SortArray<AStar3D::Point *, AStar3D::SortPoints> sorter;
-
-	begin_point->g_score = 0;
-	begin_point->f_score = _estimate_cost(begin_point->id, end_point->id);
-	begin_point->abs_g_score = 0;
-	begin_point->abs_f_score = _estimate_cost(begin_point->id, end_point->id);
-	open_list.push_back(begin_point);
-
-	while (!open_list.is_empty()) {
-		AStar3D::Point *p = open_list[0]; // The currently processed point.
-
-		// Find point closer to end_point, or same distance to end_point but closer to begin_point.
-		if (astar.last_closest_point == nullptr || astar.last_closest_point->abs_f_score > p->abs_f_score || (astar.last_closest_point->abs_f_score >= p->abs_f_score && astar.last_closest_point->abs_g_score > p->abs_g_score)) {
-			astar.last_closest_point = p;
-		}
-
-		if (p == end_point) {
-			found_route = true;
-			break;
-		}
-
-		sorter.pop_heap(0, open_list.size(), open_list.ptr()); // Remove the current point from the open list.
-		open_list.remove_at(open_list.size() - 1);
-		p->closed_pass = astar.pass; // Mark the point as closed.
-
-		for (OAHashMap<int64_t, AStar3D::Point *>::Iterator it = p->neighbors.iter(); it.valid; it = p->neighbors.next_iter(it)) {
-			AStar3D::Point *e = *(it.value); // The neighbor point.
-
-			if (!e->enabled || e->closed_pass == astar.pass) {
-				continue;
-			}
-
-			real_t tentative_g_score = p->g_score + _compute_cost(p->id, e->id) * e->weight_scale;
-
-			bool new_point = false;
-
-			if (e->open_pass != astar.pass) { // The point wasn't inside the open list.
-				e->open_pass = astar.pass;
-				open_list.push_back(e);
-				new_point = true;
-			} else if (tentative_g_score >= e->g_score) { // The new path is worse than the previous.
-				continue;
-			}
-
-			e->prev_point = p;
-			e->g_score = tentative_g_score;
-			e->f_score = e->g_score + _estimate_cost(e->id, end_point->id);
-			e->abs_g_score = tentative_g_score;
-			e->abs_f_score = e->f_score - e->g_score;
-
-			if (new_point) { // The position of the new points is already known.
-				sorter.push_heap(0, open_list.size() - 1, 0, e, open_list.ptr());
-			} else {
-				sorter.push_heap(0, open_list.find(e), 0, e, open_list.ptr());
-			}
-		}
-	}
-
-	return found_route;
+TypedArray<PackedInt64Array> AStar2D::get_id_paths_batch(const PackedInt64Array &p_from_ids, const PackedInt64Array &p_to_ids, bool p_allow_partial_path) const {
+	// Scripted costs are not guaranteed to be safe to call from several threads.
+	const bool use_threads = !GDVIRTUAL_IS_OVERRIDDEN(_estimate_cost) && !GDVIRTUAL_IS_OVERRIDDEN(_compute_cost);
+	return astar._get_id_paths_batch(this, p_from_ids, p_to_ids, p_allow_partial_path, use_threads);
 }
 
 void AStar2D::_bind_methods() {
@@ -911,6 +969,7 @@ void AStar2D::_bind_methods() {
 
 	ClassDB::bind_method(D_METHOD("get_point_path", "from_id", "to_id", "allow_partial_path"), &AStar2D::get_point_path, DEFVAL(false));
 	ClassDB::bind_method(D_METHOD("get_id_path", "from_id", "to_id", "allow_partial_path"), &AStar2D::get_id_path, DEFVAL(false));
+	ClassDB::bind_method(D_METHOD("get_id_paths_batch", "from_ids", "to_ids", "allow_partial_path"), &AStar2D::get_id_paths_batch, DEFVAL(false));
 
 	GDVIRTUAL_BIND(_estimate_cost, "from_id", "end_id")
 	GDVIRTUAL_BIND(_compute_cost, "from_id", "to_id")
@@ -32,7 +32,10 @@
 
 #include "core/object/gdvirtual.gen.inc"
 #include "core/object/ref_counted.h"
+#include "core/os/mutex.h"
 #include "core/templates/oa_hash_map.h"
+#include "core/templates/safe_refcount.h"
+#include "core/variant/typed_array.h"
 
 /**
 	A* pathfinding algorithm.
@@ -53,30 +56,63 @@ class AStar3D : public RefCounted {
 		OAHashMap<int64_t, Point *> neighbors = 4u;
 		OAHashMap<int64_t, Point *> unlinked_neighbours = 4u;
 
-		// Used for pathfinding.
-		Point *prev_point = nullptr;
+		uint32_t snapshot_index = 0; // Only valid while the snapshot is up to date.
+	};
+
+	// Read-only copy of the graph used by the searches. The neighbors of the point at index i
+	// are neighbors[neighbor_offsets[i]] to neighbors[neighbor_offsets[i + 1] - 1].
+	struct Snapshot {
+		LocalVector<int64_t> ids;
+		LocalVector<Vector3> positions;
+		LocalVector<real_t> weight_scales;
+		LocalVector<bool> enabled;
+		LocalVector<uint32_t> neighbor_offsets;
+		LocalVector<uint32_t> neighbors;
+	};
+
+	struct SearchNode {
+		uint32_t prev_node = 0;
+		uint32_t open_index = 0; // Position in the open list heap.
 		real_t g_score = 0;
 		real_t f_score = 0;
 		uint64_t open_pass = 0;
 		uint64_t closed_pass = 0;
 
-		// Used for getting closest_point_of_last_pathing_call.
-		real_t abs_g_score = 0;
+		// Used for getting last_closest_node.
 		real_t abs_f_score = 0;
 	};
 
-	struct SortPoints {
-		_FORCE_INLINE_ bool operator()(const Point *A, const Point *B) const { // Returns true when the Point A is worse than Point B.
-			if (A->f_score > B->f_score) {
+	// Open list entries carry the scores they are sorted by, so the heap doesn't have to look up the nodes.
+	struct OpenEntry {
+		uint32_t node = 0;
+		real_t g_score = 0;
+		real_t f_score = 0;
+	};
+
+	struct SortOpenEntries {
+		_FORCE_INLINE_ bool operator()(const OpenEntry &A, const OpenEntry &B) const { // Returns true when the entry A is worse than entry B.
+			if (A.f_score > B.f_score) {
 				return true;
-			} else if (A->f_score < B->f_score) {
+			} else if (A.f_score < B.f_score) {
 				return false;
 			} else {
-				return A->g_score < B->g_score; // If the f_costs are the same then prioritize the points that are further away from the start.
+				return A.g_score < B.g_score; // If the f_costs are the same then prioritize the points that are further away from the start.
 			}
 		}
 	};
 
+	// Scratch state of one query. Arenas are pooled, so concurrent queries each get their own
+	// and the nodes are reused between queries instead of being cleared.
+	struct SearchArena {
+		LocalVector<SearchNode> nodes; // Indexed like the snapshot.
+		LocalVector<OpenEntry> open_list;
+		uint64_t pass = 0;
+		uint32_t last_closest_node = UINT32_MAX;
+
+		void push_open_entry(int64_t p_hole_index, const OpenEntry &p_entry);
+		void pop_open_entry();
+	};
+
 	struct Segment {
 		Pair<int64_t, int64_t> key;
 
@@ -108,19 +144,50 @@ class AStar3D : public RefCounted {
 	};
 
 	mutable int64_t last_free_id = 0;
-	uint64_t pass = 1;
 
 	OAHashMap<int64_t, Point *> points;
 	HashSet<Segment, Segment> segments;
-	Point *last_closest_point = nullptr;
 
-	bool _solve(Point *begin_point, Point *end_point, bool p_allow_partial_path);
+	mutable Snapshot snapshot;
+	mutable SafeFlag snapshot_dirty;
+	mutable Mutex snapshot_mutex;
+
+	mutable LocalVector<SearchArena *> free_arenas;
+	mutable Mutex arena_mutex;
+
+	void _invalidate_snapshot() { snapshot_dirty.set(); }
+	void _update_snapshot() const;
+
+	SearchArena *_acquire_search_arena() const;
+	void _release_search_arena(SearchArena *p_arena) const;
+	void _free_search_arenas();
+
+	template <typename T>
+	bool _solve(const T *p_owner, uint32_t p_begin_node, uint32_t p_end_node, bool p_allow_partial_path, SearchArena &r_arena) const;
+	template <typename T>
+	bool _find_path(const T *p_owner, const Point *p_begin_point, const Point *p_end_point, bool p_allow_partial_path, LocalVector<uint32_t> &r_path) const;
+	template <typename T>
+	Vector<int64_t> _get_id_path(const T *p_owner, int64_t p_from_id, int64_t p_to_id, bool p_allow_partial_path) const;
+	template <typename T>
+	TypedArray<PackedInt64Array> _get_id_paths_batch(const T *p_owner, const PackedInt64Array &p_from_ids, const PackedInt64Array &p_to_ids, bool p_allow_partial_path, bool p_use_threads) const;
+
+	template <typename T>
+	struct BatchQueries {
+		const T *owner = nullptr;
+		const int64_t *from_ids = nullptr;
+		const int64_t *to_ids = nullptr;
+		bool allow_partial_path = false;
+		Vector<int64_t> *results = nullptr;
+	};
+
+	template <typename T>
+	void _get_id_paths_batch_query(uint32_t p_index, BatchQueries<T> *p_queries) const;
 
 protected:
 	static void _bind_methods();
 
-	virtual real_t _estimate_cost(int64_t p_from_id, int64_t p_end_id);
-	virtual real_t _compute_cost(int64_t p_from_id, int64_t p_to_id);
+	virtual real_t _estimate_cost(int64_t p_from_id, int64_t p_end_id) const;
+	virtual real_t _compute_cost(int64_t p_from_id, int64_t p_to_id) const;
 
 	GDVIRTUAL2RC(real_t, _estimate_cost, int64_t, int64_t)
 	GDVIRTUAL2RC(real_t, _compute_cost, int64_t, int64_t)
@@ -128,6 +195,8 @@ protected:
 #ifndef DISABLE_DEPRECATED
 	Vector<int64_t> _get_id_path_bind_compat_88047(int64_t p_from_id, int64_t p_to_id);
 	Vector<Vector3> _get_point_path_bind_compat_88047(int64_t p_from_id, int64_t p_to_id);
+	Vector<int64_t> _get_id_path_bind_compat_non_const(int64_t p_from_id, int64_t p_to_id, bool p_allow_partial_path);
+	Vector<Vector3> _get_point_path_bind_compat_non_const(int64_t p_from_id, int64_t p_to_id, bool p_allow_partial_path);
 	static void _bind_compatibility_methods();
 #endif
 
@@ -159,8 +228,9 @@ public:
 	int64_t get_closest_point(const Vector3 &p_point, bool p_include_disabled = false) const;
 	Vector3 get_closest_position_in_segment(const Vector3 &p_point) const;
 
-	Vector<Vector3> get_point_path(int64_t p_from_id, int64_t p_to_id, bool p_allow_partial_path = false);
-	Vector<int64_t> get_id_path(int64_t p_from_id, int64_t p_to_id, bool p_allow_partial_path = false);
+	Vector<Vector3> get_point_path(int64_t p_from_id, int64_t p_to_id, bool p_allow_partial_path = false) const;
+	Vector<int64_t> get_id_path(int64_t p_from_id, int64_t p_to_id, bool p_allow_partial_path = false) const;
+	TypedArray<PackedInt64Array> get_id_paths_batch(const PackedInt64Array &p_from_ids, const PackedInt64Array &p_to_ids, bool p_allow_partial_path = false) const;
 
 	AStar3D() {}
 	~AStar3D();
@@ -168,15 +238,15 @@ public:
 
 class AStar2D : public RefCounted {
 	GDCLASS(AStar2D, RefCounted);
-	AStar3D astar;
+	friend class AStar3D;
 
-	bool _solve(AStar3D::Point *begin_point, AStar3D::Point *end_point, bool p_allow_partial_path);
+	AStar3D astar;
 
 protected:
 	static void _bind_methods();
 
-	virtual real_t _estimate_cost(int64_t p_from_id, int64_t p_end_id);
-	virtual real_t _compute_cost(int64_t p_from_id, int64_t p_to_id);
+	virtual real_t _estimate_cost(int64_t p_from_id, int64_t p_end_id) const;
+	virtual real_t _compute_cost(int64_t p_from_id, int64_t p_to_id) const;
 
 	GDVIRTUAL2RC(real_t, _estimate_cost, int64_t, int64_t)
 	GDVIRTUAL2RC(real_t, _compute_cost, int64_t, int64_t)
@@ -184,6 +254,8 @@ protected:
 #ifndef DISABLE_DEPRECATED
 	Vector<int64_t> _get_id_path_bind_compat_88047(int64_t p_from_id, int64_t p_to_id);
 	Vector<Vector2> _get_point_path_bind_compat_88047(int64_t p_from_id, int64_t p_to_id);
+	Vector<int64_t> _get_id_path_bind_compat_non_const(int64_t p_from_id, int64_t p_to_id, bool p_allow_partial_path);
+	Vector<Vector2> _get_point_path_bind_compat_non_const(int64_t p_from_id, int64_t p_to_id, bool p_allow_partial_path);
 	static void _bind_compatibility_methods();
 #endif
 
@@ -215,8 +287,9 @@ public:
 	int64_t get_closest_point(const Vector2 &p_point, bool p_include_disabled = false) const;
 	Vector2 get_closest_position_in_segment(const Vector2 &p_point) const;
 
-	Vector<Vector2> get_point_path(int64_t p_from_id, int64_t p_to_id, bool p_allow_partial_path = false);
-	Vector<int64_t> get_id_path(int64_t p_from_id, int64_t p_to_id, bool p_allow_partial_path = false);
+	Vector<Vector2> get_point_path(int64_t p_from_id, int64_t p_to_id, bool p_allow_partial_path = false) const;
+	Vector<int64_t> get_id_path(int64_t p_from_id, int64_t p_to_id, bool p_allow_partial_path = false) const;
+	TypedArray<PackedInt64Array> get_id_paths_batch(const PackedInt64Array &p_from_ids, const PackedInt64Array &p_to_ids, bool p_allow_partial_path = false) const;
 
 	AStar2D() {}
 	~AStar2D() {}
@@ -121,53 +121,72 @@ AStarGrid2D::CellShape AStarGrid2D::get_cell_shape() const {
 	return cell_shape;
 }
 
+Vector2 AStarGrid2D::_get_point_position_unchecked(const Vector2i &p_id) const {
+	const Vector2 half_cell_size = cell_size / 2;
+	Vector2 v = offset;
+	switch (cell_shape) {
+		case CELL_SHAPE_ISOMETRIC_RIGHT:
+			v += half_cell_size + Vector2(p_id.x + p_id.y, p_id.y - p_id.x) * half_cell_size;
+			break;
+		case CELL_SHAPE_ISOMETRIC_DOWN:
+			v += half_cell_size + Vector2(p_id.x - p_id.y, p_id.x + p_id.y) * half_cell_size;
+			break;
+		case CELL_SHAPE_SQUARE:
+			v += Vector2(p_id.x, p_id.y) * cell_size;
+			break;
+		default:
+			break;
+	}
+	return v;
+}
+
 void AStarGrid2D::update() {
 	if (!dirty) {
 		return;
 	}
 
-	points.clear();
-	solid_mask.clear();
+	const int64_t mask_size = int64_t(region.size.x + 2) * (region.size.y + 2);
+	solid_mask.resize((mask_size + 63) / 64);
+	for (uint64_t &bits : solid_mask) {
+		bits = 0;
+	}
 
 	const int32_t end_x = region.get_end().x;
 	const int32_t end_y = region.get_end().y;
-	const Vector2 half_cell_size = cell_size / 2;
-	for (int32_t x = region.position.x; x < end_x + 2; x++) {
-		solid_mask.push_back(true);
+	for (int32_t x = region.position.x - 1; x < end_x + 1; x++) {
+		_set_solid_unchecked(x, region.position.y - 1, true);
+		_set_solid_unchecked(x, end_y, true);
 	}
-
 	for (int32_t y = region.position.y; y < end_y; y++) {
-		LocalVector<Point> line;
-		solid_mask.push_back(true);
-		for (int32_t x = region.position.x; x < end_x; x++) {
-			Vector2 v = offset;
-			switch (cell_shape) {
-				case CELL_SHAPE_ISOMETRIC_RIGHT:
-					v += half_cell_size + Vector2(x + y, y - x) * half_cell_size;
-					break;
-				case CELL_SHAPE_ISOMETRIC_DOWN:
-					v += half_cell_size + Vector2(x - y, x + y) * half_cell_size;
-					break;
-				case CELL_SHAPE_SQUARE:
-					v += Vector2(x, y) * cell_size;
-					break;
-				default:
-					break;
-			}
-			line.push_back(Point(Vector2i(x, y), v));
-			solid_mask.push_back(false);
-		}
-		solid_mask.push_back(true);
-		points.push_back(line);
+		_set_solid_unchecked(region.position.x - 1, y, true);
+		_set_solid_unchecked(end_x, y, true);
 	}
 
-	for (int32_t x = region.position.x; x < end_x + 2; x++) {
-		solid_mask.push_back(true);
-	}
+	weight_scales.reset();
+	_reset_search_data();
 
 	dirty = false;
 }
 
+void AStarGrid2D::_allocate_weight_scales() {
+	weight_scales.resize(region.size.x * region.size.y);
+	for (real_t &weight_scale : weight_scales) {
+		weight_scale = 1.0;
+	}
+}
+
+void AStarGrid2D::_reset_search_data() {
+	search_nodes.reset();
+	search_node_indices.reset();
+	open_list.reset();
+	last_closest_node = UINT32_MAX;
+	for (int i = 0; i < 2; i++) {
+		for (int j = 0; j < JUMP_AXIS_MAX; j++) {
+			jump_tables[i][j] = JumpTable();
+		}
+	}
+}
+
 bool AStarGrid2D::is_in_bounds(int32_t p_x, int32_t p_y) const {
 	return region.has_point(Vector2i(p_x, p_y));
 }
@@ -218,7 +237,10 @@ AStarGrid2D::Heuristic AStarGrid2D::get_default_estimate_heuristic() const {
 void AStarGrid2D::set_point_solid(const Vector2i &p_id, bool p_solid) {
 	ERR_FAIL_COND_MSG(dirty, "Grid is not initialized. Call the update method.");
 	ERR_FAIL_COND_MSG(!is_in_boundsv(p_id), vformat("Can't set if point is disabled. Point %s out of bounds %s.", p_id, region));
-	_set_solid_unchecked(p_id, p_solid);
+	if (_get_solid_unchecked(p_id) != p_solid) {
+		_set_solid_unchecked(p_id, p_solid);
+		_invalidate_jump_tables(Rect2i(p_id, Vector2i(1, 1)));
+	}
 }
 
 bool AStarGrid2D::is_point_solid(const Vector2i &p_id) const {
@@ -231,13 +253,19 @@ void AStarGrid2D::set_point_weight_scale(const Vector2i &p_id, real_t p_weight_s
 	ERR_FAIL_COND_MSG(dirty, "Grid is not initialized. Call the update method.");
 	ERR_FAIL_COND_MSG(!is_in_boundsv(p_id), vformat("Can't set point's weight scale. Point %s out of bounds %s.", p_id, region));
 	ERR_FAIL_COND_MSG(p_weight_scale < 0.0, vformat("Can't set point's weight scale less than 0.0: %f.", p_weight_scale));
-	_get_point_unchecked(p_id)->weight_scale = p_weight_scale;
+	if (weight_scales.is_empty()) {
+		if (p_weight_scale == 1.0) {
+			return;
+		}
+		_allocate_weight_scales();
+	}
+	weight_scales[_to_cell_index(p_id.x, p_id.y)] = p_weight_scale;
 }
 
 real_t AStarGrid2D::get_point_weight_scale(const Vector2i &p_id) const {
 	ERR_FAIL_COND_V_MSG(dirty, 0, "Grid is not initialized. Call the update method.");
 	ERR_FAIL_COND_V_MSG(!is_in_boundsv(p_id), 0, vformat("Can't get point's weight scale. Point %s out of bounds %s.", p_id, region));
-	return _get_point_unchecked(p_id)->weight_scale;
+	return _get_weight_scale_unchecked(p_id);
 }
 
 void AStarGrid2D::fill_solid_region(const Rect2i &p_region, bool p_solid) {
@@ -252,6 +280,10 @@ void AStarGrid2D::fill_solid_region(const Rect2i &p_region, bool p_solid) {
 			_set_solid_unchecked(x, y, p_solid);
 		}
 	}
+
+	if (safe_region.has_area()) {
+		_invalidate_jump_tables(safe_region);
+	}
 }
 
 void AStarGrid2D::fill_weight_scale_region(const Rect2i &p_region, real_t p_weight_scale) {
@@ -262,39 +294,157 @@ void AStarGrid2D::fill_weight_scale_region(const Rect2i &p_region, real_t p_weig
 	const int32_t end_x = safe_region.get_end().x;
 	const int32_t end_y = safe_region.get_end().y;
 
+	if (weight_scales.is_empty()) {
+		if (p_weight_scale == 1.0 || !safe_region.has_area()) {
+			return;
+		}
+		_allocate_weight_scales();
+	}
+
 	for (int32_t y = safe_region.position.y; y < end_y; y++) {
 		for (int32_t x = safe_region.position.x; x < end_x; x++) {
-			_get_point_unchecked(x, y)->weight_scale = p_weight_scale;
+			weight_scales[_to_cell_index(x, y)] = p_weight_scale;
+		}
+	}
+}
+
+void AStarGrid2D::_invalidate_jump_tables(const Rect2i &p_region) {
+	for (int i = 0; i < 2; i++) {
+		for (int j = 0; j < JUMP_AXIS_MAX; j++) {
+			JumpTable &jump_table = jump_tables[i][j];
+			if (jump_table.distances.is_empty()) {
+				continue;
+			}
+
+			// Jumps along a line also depend on the cells of both neighboring lines.
+			const int32_t begin_line = j == JUMP_AXIS_HORIZONTAL ? p_region.position.y - region.position.y : p_region.position.x - region.position.x;
+			const int32_t end_line = j == JUMP_AXIS_HORIZONTAL ? p_region.get_end().y - region.position.y : p_region.get_end().x - region.position.x;
+			for (int32_t line = MAX(begin_line - 1, 0); line < MIN(end_line + 1, (int32_t)jump_table.dirty_lines.size()); line++) {
+				jump_table.dirty_lines[line] = true;
+			}
+			jump_table.dirty = true;
+		}
+	}
+}
+
+bool AStarGrid2D::_is_jump_point(int32_t p_x, int32_t p_y, int32_t p_dx, int32_t p_dy, bool p_inclusive) const {
+	// A side of the scan opens up after an obstacle. Scans that include their start cell stop on the opened cell, others on the cell before it.
+	if (p_inclusive) {
+		return (_is_walkable(p_x - p_dy, p_y - p_dx) && !_is_walkable(p_x - p_dx - p_dy, p_y - p_dy - p_dx)) || (_is_walkable(p_x + p_dy, p_y + p_dx) && !_is_walkable(p_x - p_dx + p_dy, p_y - p_dy + p_dx));
+	}
+	return (_is_walkable(p_x + p_dx - p_dy, p_y + p_dy - p_dx) && !_is_walkable(p_x - p_dy, p_y - p_dx)) || (_is_walkable(p_x + p_dx + p_dy, p_y + p_dy + p_dx) && !_is_walkable(p_x + p_dy, p_y + p_dx));
+}
+
+void AStarGrid2D::_update_jump_table(bool p_inclusive, JumpAxis p_axis) {
+	JumpTable &jump_table = jump_tables[p_inclusive][p_axis];
+	const int32_t line_count = p_axis == JUMP_AXIS_HORIZONTAL ? region.size.y : region.size.x;
+	const int32_t line_length = p_axis == JUMP_AXIS_HORIZONTAL ? region.size.x : region.size.y;
+
+	if (jump_table.distances.is_empty()) {
+		jump_table.distances.resize(region.size.x * region.size.y * 2);
+		jump_table.dirty_lines.resize(line_count);
+		for (uint32_t line = 0; line < jump_table.dirty_lines.size(); line++) {
+			jump_table.dirty_lines[line] = true;
 		}
+		jump_table.dirty = true;
+	}
+
+	if (!jump_table.dirty) {
+		return;
+	}
+
+	for (int32_t line = 0; line < line_count; line++) {
+		if (!jump_table.dirty_lines[line]) {
+			continue;
+		}
+		jump_table.dirty_lines[line] = false;
+
+		for (uint32_t direction = 0; direction < 2; direction++) {
+			const int32_t step = direction == 0 ? 1 : -1;
+			const int32_t dx = p_axis == JUMP_AXIS_HORIZONTAL ? step : 0;
+			const int32_t dy = p_axis == JUMP_AXIS_VERTICAL ? step : 0;
+
+			// Walk against the scan direction, so each cell continues from the cell after it.
+			int16_t next_distance = -1;
+			for (int32_t i = 0; i < line_length; i++) {
+				const int32_t offset = direction == 0 ? line_length - 1 - i : i;
+				const int32_t x = region.position.x + (p_axis == JUMP_AXIS_HORIZONTAL ? offset : line);
+				const int32_t y = region.position.y + (p_axis == JUMP_AXIS_HORIZONTAL ? line : offset);
+
+				int16_t distance;
+				if (!_is_walkable(x, y)) {
+					distance = -1;
+				} else if (_is_jump_point(x, y, dx, dy, p_inclusive)) {
+					distance = 1;
+				} else if (next_distance == JUMP_DISTANCE_CONTINUE) {
+					distance = JUMP_DISTANCE_CONTINUE;
+				} else if (next_distance > 0) {
+					distance = next_distance == INT16_MAX ? JUMP_DISTANCE_CONTINUE : next_distance + 1;
+				} else {
+					distance = next_distance - 1; // Turns into JUMP_DISTANCE_CONTINUE once the wall is out of reach.
+				}
+
+				jump_table.distances[_to_cell_index(x, y) * 2 + direction] = distance;
+				next_distance = distance;
+			}
+		}
+	}
+
+	jump_table.dirty = false;
+}
+
+void AStarGrid2D::_update_jump_tables() {
+	switch (diagonal_mode) {
+		case DIAGONAL_MODE_ALWAYS:
+		case DIAGONAL_MODE_AT_LEAST_ONE_WALKABLE: {
+			_update_jump_table(false, JUMP_AXIS_HORIZONTAL);
+			_update_jump_table(false, JUMP_AXIS_VERTICAL);
+		} break;
+		case DIAGONAL_MODE_ONLY_IF_NO_OBSTACLES: {
+			_update_jump_table(false, JUMP_AXIS_HORIZONTAL);
+			_update_jump_table(false, JUMP_AXIS_VERTICAL);
+			_update_jump_table(true, JUMP_AXIS_HORIZONTAL);
+			_update_jump_table(true, JUMP_AXIS_VERTICAL);
+		} break;
+		case DIAGONAL_MODE_NEVER: {
+			_update_jump_table(true, JUMP_AXIS_HORIZONTAL);
+		} break;
+		default:
+			break;
 	}
 }
 
-AStarGrid2D::Point *AStarGrid2D::_jump(Point *p_from, Point *p_to) {
-	int32_t from_x = p_from->id.x;
-	int32_t from_y = p_from->id.y;
+bool AStarGrid2D::_jump(const Vector2i &p_from, const Vector2i &p_to, Vector2i &r_jump_point) const {
+	int32_t from_x = p_from.x;
+	int32_t from_y = p_from.y;
 
-	int32_t to_x = p_to->id.x;
-	int32_t to_y = p_to->id.y;
+	int32_t to_x = p_to.x;
+	int32_t to_y = p_to.y;
 
 	int32_t dx = to_x - from_x;
 	int32_t dy = to_y - from_y;
 
+	Vector2i successor;
+
 	if (diagonal_mode == DIAGONAL_MODE_ALWAYS || diagonal_mode == DIAGONAL_MODE_AT_LEAST_ONE_WALKABLE) {
 		if (dx == 0 || dy == 0) {
-			return _forced_successor(to_x, to_y, dx, dy);
+			return _forced_successor(to_x, to_y, dx, dy, r_jump_point);
 		}
 
 		while (_is_walkable(to_x, to_y) && (diagonal_mode == DIAGONAL_MODE_ALWAYS || _is_walkable(to_x, to_y - dy) || _is_walkable(to_x - dx, to_y))) {
-			if (end->id.x == to_x && end->id.y == to_y) {
-				return end;
+			if (end_id.x == to_x && end_id.y == to_y) {
+				r_jump_point = end_id;
+				return true;
 			}
 
 			if ((_is_walkable(to_x - dx, to_y + dy) && !_is_walkable(to_x - dx, to_y)) || (_is_walkable(to_x + dx, to_y - dy) && !_is_walkable(to_x, to_y - dy))) {
-				return _get_point_unchecked(to_x, to_y);
+				r_jump_point = Vector2i(to_x, to_y);
+				return true;
 			}
 
-			if (_forced_successor(to_x + dx, to_y, dx, 0) != nullptr || _forced_successor(to_x, to_y + dy, 0, dy) != nullptr) {
-				return _get_point_unchecked(to_x, to_y);
+			if (_forced_successor(to_x + dx, to_y, dx, 0, successor) || _forced_successor(to_x, to_y + dy, 0, dy, successor)) {
+				r_jump_point = Vector2i(to_x, to_y);
+				return true;
 			}
 
 			to_x += dx;
@@ -303,20 +453,23 @@ AStarGrid2D::Point *AStarGrid2D::_jump(Point *p_from, Point *p_to) {
 
 	} else if (diagonal_mode == DIAGONAL_MODE_ONLY_IF_NO_OBSTACLES) {
 		if (dx == 0 || dy == 0) {
-			return _forced_successor(from_x, from_y, dx, dy, true);
+			return _forced_successor(from_x, from_y, dx, dy, r_jump_point, true);
 		}
 
 		while (_is_walkable(to_x, to_y) && _is_walkable(to_x, to_y - dy) && _is_walkable(to_x - dx, to_y)) {
-			if (end->id.x == to_x && end->id.y == to_y) {
-				return end;
+			if (end_id.x == to_x && end_id.y == to_y) {
+				r_jump_point = end_id;
+				return true;
 			}
 
 			if ((_is_walkable(to_x + dx, to_y + dy) && !_is_walkable(to_x, to_y + dy)) || !_is_walkable(to_x + dx, to_y)) {
-				return _get_point_unchecked(to_x, to_y);
+				r_jump_point = Vector2i(to_x, to_y);
+				return true;
 			}
 
-			if (_forced_successor(to_x, to_y, dx, 0) != nullptr || _forced_successor(to_x, to_y, 0, dy) != nullptr) {
-				return _get_point_unchecked(to_x, to_y);
+			if (_forced_successor(to_x, to_y, dx, 0, successor) || _forced_successor(to_x, to_y, 0, dy, successor)) {
+				r_jump_point = Vector2i(to_x, to_y);
+				return true;
 			}
 
 			to_x += dx;
@@ -325,130 +478,102 @@ AStarGrid2D::Point *AStarGrid2D::_jump(Point *p_from, Point *p_to) {
 
 	} else { // DIAGONAL_MODE_NEVER
 		if (dy == 0) {
-			return _forced_successor(from_x, from_y, dx, 0, true);
+			return _forced_successor(from_x, from_y, dx, 0, r_jump_point, true);
 		}
 
 		while (_is_walkable(to_x, to_y)) {
-			if (end->id.x == to_x && end->id.y == to_y) {
-				return end;
+			if (end_id.x == to_x && end_id.y == to_y) {
+				r_jump_point = end_id;
+				return true;
 			}
 
 			if ((_is_walkable(to_x - 1, to_y) && !_is_walkable(to_x - 1, to_y - dy)) || (_is_walkable(to_x + 1, to_y) && !_is_walkable(to_x + 1, to_y - dy))) {
-				return _get_point_unchecked(to_x, to_y);
+				r_jump_point = Vector2i(to_x, to_y);
+				return true;
 			}
 
-			if (_forced_successor(to_x, to_y, 1, 0, true) != nullptr || _forced_successor(to_x, to_y, -1, 0, true) != nullptr) {
-				return _get_point_unchecked(to_x, to_y);
+			if (_forced_successor(to_x, to_y, 1, 0, successor, true) || _forced_successor(to_x, to_y, -1, 0, successor, true)) {
+				r_jump_point = Vector2i(to_x, to_y);
+				return true;
 			}
 
 			to_y += dy;
 		}
 	}
 
-	return nullptr;
+	return false;
 }
 
-AStarGrid2D::Point *AStarGrid2D::_forced_successor(int32_t p_x, int32_t p_y, int32_t p_dx, int32_t p_dy, bool p_inclusive) {
-	// Remembering previous results can improve performance.
-	bool l_prev = false, r_prev = false, l = false, r = false;
-
+bool AStarGrid2D::_forced_successor(int32_t p_x, int32_t p_y, int32_t p_dx, int32_t p_dy, Vector2i &r_successor, bool p_inclusive) const {
 	int32_t o_x = p_x, o_y = p_y;
 	if (p_inclusive) {
 		o_x += p_dx;
 		o_y += p_dy;
 	}
 
-	int32_t l_x = p_x - p_dy, l_y = p_y - p_dx;
-	int32_t r_x = p_x + p_dy, r_y = p_y + p_dx;
+	// The jump tables replace walking the line cell by cell, see _update_jump_table().
+	const JumpTable &jump_table = jump_tables[p_inclusive][p_dy == 0 ? JUMP_AXIS_HORIZONTAL : JUMP_AXIS_VERTICAL];
+	const uint32_t direction = p_dx + p_dy > 0 ? 0 : 1;
 
 	while (_is_walkable(o_x, o_y)) {
-		if (end->id.x == o_x && end->id.y == o_y) {
-			return end;
+		const int16_t distance = jump_table.distances[_to_cell_index(o_x, o_y) * 2 + direction];
+
+		// The number of walkable cells in reach of this lookup.
+		int32_t reach = INT16_MAX;
+		if (distance > 0) {
+			reach = distance;
+		} else if (distance != JUMP_DISTANCE_CONTINUE) {
+			reach = -distance - 1;
 		}
 
-		l_prev = l || _is_walkable(l_x, l_y);
-		r_prev = r || _is_walkable(r_x, r_y);
-
-		l_x += p_dx;
-		l_y += p_dy;
-		r_x += p_dx;
-		r_y += p_dy;
-
-		l = _is_walkable(l_x, l_y);
-		r = _is_walkable(r_x, r_y);
+		int32_t end_offset = -1;
+		if (p_dy == 0 && end_id.y == o_y) {
+			end_offset = (end_id.x - o_x) * p_dx;
+		} else if (p_dx == 0 && end_id.x == o_x) {
+			end_offset = (end_id.y - o_y) * p_dy;
+		}
+		if (end_offset >= 0 && end_offset < reach) {
+			r_successor = end_id;
+			return true;
+		}
 
-		if ((l && !l_prev) || (r && !r_prev)) {
-			return _get_point_unchecked(o_x, o_y);
+		if (distance > 0) {
+			r_successor = Vector2i(o_x + p_dx * (distance - 1), o_y + p_dy * (distance - 1));
+			return true;
+		} else if (distance != JUMP_DISTANCE_CONTINUE) {
+			return false;
 		}
 
-		o_x += p_dx;
-		o_y += p_dy;
+		o_x += p_dx * INT16_MAX;
+		o_y += p_dy * INT16_MAX;
 	}
-	return nullptr;
+	return false;
 }
 
-void AStarGrid2D::_get_nbors(Point *p_point, LocalVector<Point *> &r_nbors) {
+void AStarGrid2D::_get_nbors(const Vector2i &p_id, LocalVector<Vector2i> &r_nbors) const {
+	// The solid border around the region keeps the neighbors of any cell in bounds.
+	const int32_t x = p_id.x;
+	const int32_t y = p_id.y;
+
 	bool ts0 = false, td0 = false,
 		 ts1 = false, td1 = false,
 		 ts2 = false, td2 = false,
 		 ts3 = false, td3 = false;
 
-	Point *left = nullptr;
-	Point *right = nullptr;
-	Point *top = nullptr;
-	Point *bottom = nullptr;
-
-	Point *top_left = nullptr;
-	Point *top_right = nullptr;
-	Point *bottom_left = nullptr;
-	Point *bottom_right = nullptr;
-
-	{
-		bool has_left = false;
-		bool has_right = false;
-
-		if (p_point->id.x - 1 >= region.position.x) {
-			left = _get_point_unchecked(p_point->id.x - 1, p_point->id.y);
-			has_left = true;
-		}
-		if (p_point->id.x + 1 < region.position.x + region.size.width) {
-			right = _get_point_unchecked(p_point->id.x + 1, p_point->id.y);
-			has_right = true;
-		}
-		if (p_point->id.y - 1 >= region.position.y) {
-			top = _get_point_unchecked(p_point->id.x, p_point->id.y - 1);
-			if (has_left) {
-				top_left = _get_point_unchecked(p_point->id.x - 1, p_point->id.y - 1);
-			}
-			if (has_right) {
-				top_right = _get_point_unchecked(p_point->id.x + 1, p_point->id.y - 1);
-			}
-		}
-		if (p_point->id.y + 1 < region.position.y + region.size.height) {
-			bottom = _get_point_unchecked(p_point->id.x, p_point->id.y + 1);
-			if (has_left) {
-				bottom_left = _get_point_unchecked(p_point->id.x - 1, p_point->id.y + 1);
-			}
-			if (has_right) {
-				bottom_right = _get_point_unchecked(p_point->id.x + 1, p_point->id.y + 1);
-			}
-		}
-	}
-
-	if (top && !_get_solid_unchecked(top->id)) {
-		r_nbors.push_back(top);
+	if (_is_walkable(x, y - 1)) {
+		r_nbors.push_back(Vector2i(x, y - 1));
 		ts0 = true;
 	}
-	if (right && !_get_solid_unchecked(right->id)) {
-		r_nbors.push_back(right);
+	if (_is_walkable(x + 1, y)) {
+		r_nbors.push_back(Vector2i(x + 1, y));
 		ts1 = true;
 	}
-	if (bottom && !_get_solid_unchecked(bottom->id)) {
-		r_nbors.push_back(bottom);
+	if (_is_walkable(x, y + 1)) {
+		r_nbors.push_back(Vector2i(x, y + 1));
 		ts2 = true;
 	}
-	if (left && !_get_solid_unchecked(left->id)) {
-		r_nbors.push_back(left);
+	if (_is_walkable(x - 1, y)) {
+		r_nbors.push_back(Vector2i(x - 1, y));
 		ts3 = true;
 	}
 
@@ -477,99 +602,180 @@ void AStarGrid2D::_get_nbors(Point *p_point, LocalVector<Point *> &r_nbors) {
 			break;
 	}
 
-	if (td0 && (top_left && !_get_solid_unchecked(top_left->id))) {
-		r_nbors.push_back(top_left);
+	if (td0 && _is_walkable(x - 1, y - 1)) {
+		r_nbors.push_back(Vector2i(x - 1, y - 1));
 	}
-	if (td1 && (top_right && !_get_solid_unchecked(top_right->id))) {
-		r_nbors.push_back(top_right);
+	if (td1 && _is_walkable(x + 1, y - 1)) {
+		r_nbors.push_back(Vector2i(x + 1, y - 1));
 	}
-	if (td2 && (bottom_right && !_get_solid_unchecked(bottom_right->id))) {
-		r_nbors.push_back(bottom_right);
+	if (td2 && _is_walkable(x + 1, y + 1)) {
+		r_nbors.push_back(Vector2i(x + 1, y + 1));
 	}
-	if (td3 && (bottom_left && !_get_solid_unchecked(bottom_left->id))) {
-		r_nbors.push_back(bottom_left);
+	if (td3 && _is_walkable(x - 1, y + 1)) {
+		r_nbors.push_back(Vector2i(x - 1, y + 1));
 	}
 }
 
-bool AStarGrid2D::_solve(Point *p_begin_point, Point *p_end_point, bool p_allow_partial_path) {
-	last_closest_point = nullptr;
-	pass++;
+uint32_t AStarGrid2D::_add_search_node(const Vector2i &p_id) {
+	const uint32_t node_index = search_nodes.size();
+	SearchNode node;
+	node.id = p_id;
+	search_nodes.push_back(node);
+	search_node_indices[_to_cell_index(p_id.x, p_id.y)] = node_index;
+	return node_index;
+}
+
+// Same as SortArray::push_heap(), but also tracks where the nodes are in the open list.
+void AStarGrid2D::_push_open_entry(int64_t p_hole_index, const OpenEntry &p_entry) {
+	SortOpenEntries compare;
+	OpenEntry *entries = open_list.ptr();
+
+	int64_t parent = (p_hole_index - 1) / 2;
+	while (p_hole_index > 0 && compare(entries[parent], p_entry)) {
+		entries[p_hole_index] = entries[parent];
+		search_nodes[entries[p_hole_index].node].open_index = p_hole_index;
+		p_hole_index = parent;
+		parent = (p_hole_index - 1) / 2;
+	}
+	entries[p_hole_index] = p_entry;
+	search_nodes[p_entry.node].open_index = p_hole_index;
+}
+
+// Same as SortArray::pop_heap() followed by removing the last entry.
+void AStarGrid2D::_pop_open_entry() {
+	const OpenEntry last_entry = open_list[open_list.size() - 1];
+	open_list.resize(open_list.size() - 1);
+	if (open_list.is_empty()) {
+		return;
+	}
+
+	SortOpenEntries compare;
+	OpenEntry *entries = open_list.ptr();
+	const int64_t length = open_list.size();
+
+	int64_t hole_index = 0;
+	int64_t second_child = 2;
+	while (second_child < length) {
+		if (compare(entries[second_child], entries[second_child - 1])) {
+			second_child--;
+		}
+
+		entries[hole_index] = entries[second_child];
+		search_nodes[entries[hole_index].node].open_index = hole_index;
+		hole_index = second_child;
+		second_child = 2 * (second_child + 1);
+	}
+
+	if (second_child == length) {
+		entries[hole_index] = entries[second_child - 1];
+		search_nodes[entries[hole_index].node].open_index = hole_index;
+		hole_index = second_child - 1;
+	}
+	_push_open_entry(hole_index, last_entry);
+}
 
-	if (_get_solid_unchecked(p_end_point->id) && !p_allow_partial_path) {
+bool AStarGrid2D::_solve(const Vector2i &p_begin_id, const Vector2i &p_end_id, bool p_allow_partial_path) {
+	last_closest_node = UINT32_MAX;
+	search_nodes.clear();
+	open_list.clear();
+
+	if (_get_solid_unchecked(p_end_id) && !p_allow_partial_path) {
 		return false;
 	}
 
+	if (search_node_indices.is_empty()) {
+		search_node_indices.resize(region.size.x * region.size.y);
+		for (uint32_t &node_index : search_node_indices) {
+			node_index = UINT32_MAX;
+		}
+	}
+
+	if (jumping_enabled) {
+		_update_jump_tables();
+	}
+
 	bool found_route = false;
 
-	LocalVector<Point *> open_list;
-	SortArray<Point *, SortPoints> sorter;
-	LocalVector<Point *> nbors;
+	LocalVector<Vector2i> nbors;
 
-	p_begin_point->g_score = 0;
-	p_begin_point->f_score = _estimate_cost(p_begin_point->id, p_end_point->id);
-	p_begin_point->abs_g_score = 0;
-	p_begin_point->abs_f_score = _estimate_cost(p_begin_point->id, p_end_point->id);
-	open_list.push_back(p_begin_point);
-	end = p_end_point;
+	end_id = p_end_id;
+	const uint32_t begin_node = _add_search_node(p_begin_id);
+	search_nodes[begin_node].f_score = _estimate_cost(p_begin_id, p_end_id);
+	search_nodes[begin_node].abs_f_score = search_nodes[begin_node].f_score;
+	OpenEntry begin_entry;
+	begin_entry.node = begin_node;
+	begin_entry.f_score = search_nodes[begin_node].f_score;
+	open_list.push_back(begin_entry);
 
 	while (!open_list.is_empty()) {
-		Point *p = open_list[0]; // The currently processed point.
+		const uint32_t p = open_list[0].node; // The currently processed node.
 
 		// Find point closer to end_point, or same distance to end_point but closer to begin_point.
-		if (last_closest_point == nullptr || last_closest_point->abs_f_score > p->abs_f_score || (last_closest_point->abs_f_score >= p->abs_f_score && last_closest_point->abs_g_score > p->abs_g_score)) {
-			last_closest_point = p;
+		if (last_closest_node == UINT32_MAX || search_nodes[last_closest_node].abs_f_score > search_nodes[p].abs_f_score || (search_nodes[last_closest_node].abs_f_score >= search_nodes[p].abs_f_score && search_nodes[last_closest_node].abs_g_score > search_nodes[p].abs_g_score)) {
+			last_closest_node = p;
 		}
 
-		if (p == p_end_point) {
+		if (search_nodes[p].id == p_end_id) {
 			found_route = true;
 			break;
 		}
 
-		sorter.pop_heap(0, open_list.size(), open_list.ptr()); // Remove the current point from the open list.
-		open_list.remove_at(open_list.size() - 1);
-		p->closed_pass = pass; // Mark the point as closed.
+		_pop_open_entry(); // Remove the current point from the open list.
+		search_nodes[p].closed = true; // Mark the point as closed.
+
+		// Adding nodes may reallocate them, so keep what is needed of the current one.
+		const Vector2i p_id = search_nodes[p].id;
+		const real_t p_g_score = search_nodes[p].g_score;
 
 		nbors.clear();
-		_get_nbors(p, nbors);
+		_get_nbors(p_id, nbors);
 
-		for (Point *e : nbors) {
+		for (const Vector2i &nbor_id : nbors) {
+			Vector2i e_id = nbor_id;
 			real_t weight_scale = 1.0;
 
 			if (jumping_enabled) {
 				// TODO: Make it works with weight_scale.
-				e = _jump(p, e);
-				if (!e || e->closed_pass == pass) {
+				if (!_jump(p_id, nbor_id, e_id)) {
 					continue;
 				}
 			} else {
-				if (_get_solid_unchecked(e->id) || e->closed_pass == pass) {
-					continue;
-				}
-				weight_scale = e->weight_scale;
+				weight_scale = _get_weight_scale_unchecked(e_id);
+			}
+
+			uint32_t e = _get_search_node_index(e_id);
+			if (e != UINT32_MAX && search_nodes[e].closed) {
+				continue;
 			}
 
-			real_t tentative_g_score = p->g_score + _compute_cost(p->id, e->id) * weight_scale;
+			real_t tentative_g_score = p_g_score + _compute_cost(p_id, e_id) * weight_scale;
 			bool new_point = false;
 
-			if (e->open_pass != pass) { // The point wasn't inside the open list.
-				e->open_pass = pass;
-				open_list.push_back(e);
+			if (e == UINT32_MAX) { // The point wasn't inside the open list.
+				e = _add_search_node(e_id);
+				open_list.push_back(OpenEntry());
 				new_point = true;
-			} else if (tentative_g_score >= e->g_score) { // The new path is worse than the previous.
+			} else if (tentative_g_score >= search_nodes[e].g_score) { // The new path is worse than the previous.
 				continue;
 			}
 
-			e->prev_point = p;
-			e->g_score = tentative_g_score;
-			e->f_score = e->g_score + _estimate_cost(e->id, p_end_point->id);
+			SearchNode &node = search_nodes[e];
+			node.prev_node = p;
+			node.g_score = tentative_g_score;
+			node.f_score = node.g_score + _estimate_cost(e_id, p_end_id);
 
-			e->abs_g_score = tentative_g_score;
-			e->abs_f_score = e->f_score - e->g_score;
+			node.abs_g_score = tentative_g_score;
+			node.abs_f_score = node.f_score - node.g_score;
+
+			OpenEntry entry;
+			entry.node = e;
+			entry.g_score = node.g_score;
+			entry.f_score = node.f_score;
 
 			if (new_point) { // The position of the new points is already known.
-				sorter.push_heap(0, open_list.size() - 1, 0, e, open_list.ptr());
+				_push_open_entry(open_list.size() - 1, entry);
 			} else {
-				sorter.push_heap(0, open_list.find(e), 0, e, open_list.ptr());
+				_push_open_entry(node.open_index, entry);
 			}
 		}
 	}
@@ -594,36 +800,36 @@ real_t AStarGrid2D::_compute_cost(const Vector2i &p_from_id, const Vector2i &p_t
 }
 
 void AStarGrid2D::clear() {
-	points.clear();
+	solid_mask.reset();
+	weight_scales.reset();
+	_reset_search_data();
 	region = Rect2i();
 }
 
 Vector2 AStarGrid2D::get_point_position(const Vector2i &p_id) const {
 	ERR_FAIL_COND_V_MSG(dirty, Vector2(), "Grid is not initialized. Call the update method.");
 	ERR_FAIL_COND_V_MSG(!is_in_boundsv(p_id), Vector2(), vformat("Can't get point's position. Point %s out of bounds %s.", p_id, region));
-	return _get_point_unchecked(p_id)->pos;
+	return _get_point_position_unchecked(p_id);
 }
 
 TypedArray<Dictionary> AStarGrid2D::get_point_data_in_region(const Rect2i &p_region) const {
 	ERR_FAIL_COND_V_MSG(dirty, TypedArray<Dictionary>(), "Grid is not initialized. Call the update method.");
 	const Rect2i inter_region = region.intersection(p_region);
 
-	const int32_t start_x = inter_region.position.x - region.position.x;
-	const int32_t start_y = inter_region.position.y - region.position.y;
-	const int32_t end_x = inter_region.get_end().x - region.position.x;
-	const int32_t end_y = inter_region.get_end().y - region.position.y;
+	const int32_t end_x = inter_region.get_end().x;
+	const int32_t end_y = inter_region.get_end().y;
 
 	TypedArray<Dictionary> data;
 
-	for (int32_t y = start_y; y < end_y; y++) {
-		for (int32_t x = start_x; x < end_x; x++) {
-			const Point &p = points[y][x];
+	for (int32_t y = inter_region.position.y; y < end_y; y++) {
+		for (int32_t x = inter_region.position.x; x < end_x; x++) {
+			const Vector2i id = Vector2i(x, y);
 
 			Dictionary dict;
-			dict["id"] = p.id;
-			dict["position"] = p.pos;
-			dict["solid"] = _get_solid_unchecked(p.id);
-			dict["weight_scale"] = p.weight_scale;
+			dict["id"] = id;
+			dict["position"] = _get_point_position_unchecked(id);
+			dict["solid"] = _get_solid_unchecked(id);
+			dict["weight_scale"] = _get_weight_scale_unchecked(id);
 			data.push_back(dict);
 		}
 	}
@@ -636,33 +842,32 @@ Vector<Vector2> AStarGrid2D::get_point_path(const Vector2i &p_from_id, const Vec
 	ERR_FAIL_COND_V_MSG(!is_in_boundsv(p_from_id), Vector<Vector2>(), vformat("Can't get id path. Point %s out of bounds %s.", p_from_id, region));
 	ERR_FAIL_COND_V_MSG(!is_in_boundsv(p_to_id), Vector<Vector2>(), vformat("Can't get id path. Point %s out of bounds %s.", p_to_id, region));
 
-	Point *a = _get_point(p_from_id.x, p_from_id.y);
-	Point *b = _get_point(p_to_id.x, p_to_id.y);
-
-	if (a == b) {
+	if (p_from_id == p_to_id) {
 		Vector<Vector2> ret;
-		ret.push_back(a->pos);
+		ret.push_back(_get_point_position_unchecked(p_from_id));
 		return ret;
 	}
 
-	Point *begin_point = a;
-	Point *end_point = b;
+	const uint32_t begin_node = 0; // Always the first node of the search.
+	uint32_t end_node;
 
-	bool found_route = _solve(begin_point, end_point, p_allow_partial_path);
-	if (!found_route) {
-		if (!p_allow_partial_path || last_closest_point == nullptr) {
+	bool found_route = _solve(p_from_id, p_to_id, p_allow_partial_path);
+	if (found_route) {
+		end_node = _get_search_node_index(p_to_id);
+	} else {
+		if (!p_allow_partial_path || last_closest_node == UINT32_MAX) {
 			return Vector<Vector2>();
 		}
 
 		// Use closest point instead.
-		end_point = last_closest_point;
+		end_node = last_closest_node;
 	}
 
-	Point *p = end_point;
+	uint32_t p = end_node;
 	int32_t pc = 1;
-	while (p != begin_point) {
+	while (p != begin_node) {
 		pc++;
-		p = p->prev_point;
+		p = search_nodes[p].prev_node;
 	}
 
 	Vector<Vector2> path;
@@ -671,14 +876,14 @@ Vector<Vector2> AStarGrid2D::get_point_path(const Vector2i &p_from_id, const Vec
 	{
 		Vector2 *w = path.ptrw();
 
-		p = end_point;
+		p = end_node;
 		int32_t idx = pc - 1;
-		while (p != begin_point) {
-			w[idx--] = p->pos;
-			p = p->prev_point;
+		while (p != begin_node) {
+			w[idx--] = _get_point_position_unchecked(search_nodes[p].id);
+			p = search_nodes[p].prev_node;
 		}
 
-		w[0] = p->pos;
+		w[0] = _get_point_position_unchecked(search_nodes[p].id);
 	}
 
 	return path;
@@ -689,47 +894,46 @@ TypedArray<Vector2i> AStarGrid2D::get_id_path(const Vector2i &p_from_id, const V
 	ERR_FAIL_COND_V_MSG(!is_in_boundsv(p_from_id), TypedArray<Vector2i>(), vformat("Can't get id path. Point %s out of bounds %s.", p_from_id, region));
 	ERR_FAIL_COND_V_MSG(!is_in_boundsv(p_to_id), TypedArray<Vector2i>(), vformat("Can't get id path. Point %s out of bounds %s.", p_to_id, region));
 
-	Point *a = _get_point(p_from_id.x, p_from_id.y);
-	Point *b = _get_point(p_to_id.x, p_to_id.y);
-
-	if (a == b) {
+	if (p_from_id == p_to_id) {
 		TypedArray<Vector2i> ret;
-		ret.push_back(a->id);
+		ret.push_back(p_from_id);
 		return ret;
 	}
 
-	Point *begin_point = a;
-	Point *end_point = b;
+	const uint32_t begin_node = 0; // Always the first node of the search.
+	uint32_t end_node;
 
-	bool found_route = _solve(begin_point, end_point, p_allow_partial_path);
-	if (!found_route) {
-		if (!p_allow_partial_path || last_closest_point == nullptr) {
+	bool found_route = _solve(p_from_id, p_to_id, p_allow_partial_path);
+	if (found_route) {
+		end_node = _get_search_node_index(p_to_id);
+	} else {
+		if (!p_allow_partial_path || last_closest_node == UINT32_MAX) {
 			return TypedArray<Vector2i>();
 		}
 
 		// Use closest point instead.
-		end_point = last_closest_point;
+		end_node = last_closest_node;
 	}
 
-	Point *p = end_point;
+	uint32_t p = end_node;
 	int32_t pc = 1;
-	while (p != begin_point) {
+	while (p != begin_node) {
 		pc++;
-		p = p->prev_point;
+		p = search_nodes[p].prev_node;
 	}
 
 	TypedArray<Vector2i> path;
 	path.resize(pc);
 
 	{
-		p = end_point;
+		p = end_node;
 		int32_t idx = pc - 1;
-		while (p != begin_point) {
-			path[idx--] = p->id;
-			p = p->prev_point;
+		while (p != begin_node) {
+			path[idx--] = search_nodes[p].id;
+			p = search_nodes[p].prev_node;
 		}
 
-		path[0] = p->id;
+		path[0] = search_nodes[p].id;
 	}
 
 	return path;
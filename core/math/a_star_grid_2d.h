@@ -73,92 +73,133 @@ private:
 	Heuristic default_compute_heuristic = HEURISTIC_EUCLIDEAN;
 	Heuristic default_estimate_heuristic = HEURISTIC_EUCLIDEAN;
 
-	struct Point {
+	// Search state of the cells visited by a query. The nodes and the open list are kept between queries to reuse their memory.
+	struct SearchNode {
 		Vector2i id;
-
-		Vector2 pos;
-		real_t weight_scale = 1.0;
-
-		// Used for pathfinding.
-		Point *prev_point = nullptr;
+		uint32_t prev_node = 0;
+		uint32_t open_index = 0; // Position in the open list heap.
 		real_t g_score = 0;
 		real_t f_score = 0;
-		uint64_t open_pass = 0;
-		uint64_t closed_pass = 0;
+		bool closed = false;
 
-		// Used for getting last_closest_point.
+		// Used for getting last_closest_node.
 		real_t abs_g_score = 0;
 		real_t abs_f_score = 0;
+	};
 
-		Point() {}
-
-		Point(const Vector2i &p_id, const Vector2 &p_pos) :
-				id(p_id), pos(p_pos) {}
+	// Open list entries carry the scores they are sorted by, so the heap doesn't have to look up the nodes.
+	struct OpenEntry {
+		uint32_t node = 0;
+		real_t g_score = 0;
+		real_t f_score = 0;
 	};
 
-	struct SortPoints {
-		_FORCE_INLINE_ bool operator()(const Point *A, const Point *B) const { // Returns true when the Point A is worse than Point B.
-			if (A->f_score > B->f_score) {
+	struct SortOpenEntries {
+		_FORCE_INLINE_ bool operator()(const OpenEntry &A, const OpenEntry &B) const { // Returns true when the entry A is worse than entry B.
+			if (A.f_score > B.f_score) {
 				return true;
-			} else if (A->f_score < B->f_score) {
+			} else if (A.f_score < B.f_score) {
 				return false;
 			} else {
-				return A->g_score < B->g_score; // If the f_costs are the same then prioritize the points that are further away from the start.
+				return A.g_score < B.g_score; // If the f_costs are the same then prioritize the points that are further away from the start.
 			}
 		}
 	};
 
-	LocalVector<bool> solid_mask;
-	LocalVector<LocalVector<Point>> points;
-	Point *end = nullptr;
-	Point *last_closest_point = nullptr;
+	// Precomputed straight jumps along one axis. Per cell, the positive and the negative direction each store
+	// the distance to the next jump point (> 0), to the next wall (< 0) or JUMP_DISTANCE_CONTINUE if neither is in reach.
+	struct JumpTable {
+		LocalVector<int16_t> distances;
+		LocalVector<bool> dirty_lines; // Rows of the horizontal and columns of the vertical axis.
+		bool dirty = false;
+	};
+
+	enum JumpAxis {
+		JUMP_AXIS_HORIZONTAL,
+		JUMP_AXIS_VERTICAL,
+		JUMP_AXIS_MAX,
+	};
+
+	static constexpr int16_t JUMP_DISTANCE_CONTINUE = INT16_MIN;
+
+	// One bit per cell, with a solid border around the region.
+	LocalVector<uint64_t> solid_mask;
+	// Empty while all cells have the default weight scale.
+	LocalVector<real_t> weight_scales;
 
-	uint64_t pass = 1;
+	LocalVector<SearchNode> search_nodes;
+	LocalVector<uint32_t> search_node_indices; // Per cell, only valid if the node refers back to the cell.
+	LocalVector<OpenEntry> open_list;
+	uint32_t last_closest_node = UINT32_MAX;
+	Vector2i end_id;
+
+	// Indexed by whether the scan includes its starting cell and by axis, only allocated once a jumping query needs them.
+	JumpTable jump_tables[2][JUMP_AXIS_MAX];
 
 private: // Internal routines.
 	_FORCE_INLINE_ size_t _to_mask_index(int32_t p_x, int32_t p_y) const {
 		return ((p_y - region.position.y + 1) * (region.size.x + 2)) + p_x - region.position.x + 1;
 	}
 
-	_FORCE_INLINE_ bool _is_walkable(int32_t p_x, int32_t p_y) const {
-		return !solid_mask[_to_mask_index(p_x, p_y)];
+	_FORCE_INLINE_ uint32_t _to_cell_index(int32_t p_x, int32_t p_y) const {
+		return (p_y - region.position.y) * region.size.x + p_x - region.position.x;
 	}
 
-	_FORCE_INLINE_ Point *_get_point(int32_t p_x, int32_t p_y) {
-		if (region.has_point(Vector2i(p_x, p_y))) {
-			return &points[p_y - region.position.y][p_x - region.position.x];
+	_FORCE_INLINE_ bool _get_mask_bit(size_t p_index) const {
+		return (solid_mask[p_index >> 6] >> (p_index & 63)) & 1;
+	}
+
+	_FORCE_INLINE_ void _set_mask_bit(size_t p_index, bool p_solid) {
+		if (p_solid) {
+			solid_mask[p_index >> 6] |= uint64_t(1) << (p_index & 63);
+		} else {
+			solid_mask[p_index >> 6] &= ~(uint64_t(1) << (p_index & 63));
 		}
-		return nullptr;
+	}
+
+	_FORCE_INLINE_ bool _is_walkable(int32_t p_x, int32_t p_y) const {
+		return !_get_mask_bit(_to_mask_index(p_x, p_y));
 	}
 
 	_FORCE_INLINE_ void _set_solid_unchecked(int32_t p_x, int32_t p_y, bool p_solid) {
-		solid_mask[_to_mask_index(p_x, p_y)] = p_solid;
+		_set_mask_bit(_to_mask_index(p_x, p_y), p_solid);
 	}
 
 	_FORCE_INLINE_ void _set_solid_unchecked(const Vector2i &p_id, bool p_solid) {
-		solid_mask[_to_mask_index(p_id.x, p_id.y)] = p_solid;
+		_set_mask_bit(_to_mask_index(p_id.x, p_id.y), p_solid);
 	}
 
 	_FORCE_INLINE_ bool _get_solid_unchecked(const Vector2i &p_id) const {
-		return solid_mask[_to_mask_index(p_id.x, p_id.y)];
+		return _get_mask_bit(_to_mask_index(p_id.x, p_id.y));
 	}
 
-	_FORCE_INLINE_ Point *_get_point_unchecked(int32_t p_x, int32_t p_y) {
-		return &points[p_y - region.position.y][p_x - region.position.x];
+	_FORCE_INLINE_ real_t _get_weight_scale_unchecked(const Vector2i &p_id) const {
+		return weight_scales.is_empty() ? 1.0 : weight_scales[_to_cell_index(p_id.x, p_id.y)];
 	}
 
-	_FORCE_INLINE_ Point *_get_point_unchecked(const Vector2i &p_id) {
-		return &points[p_id.y - region.position.y][p_id.x - region.position.x];
-	}
-
-	_FORCE_INLINE_ const Point *_get_point_unchecked(const Vector2i &p_id) const {
-		return &points[p_id.y - region.position.y][p_id.x - region.position.x];
+	_FORCE_INLINE_ uint32_t _get_search_node_index(const Vector2i &p_id) const {
+		const uint32_t node_index = search_node_indices[_to_cell_index(p_id.x, p_id.y)];
+		if (node_index < search_nodes.size() && search_nodes[node_index].id == p_id) {
+			return node_index;
+		}
+		return UINT32_MAX;
 	}
 
-	void _get_nbors(Point *p_point, LocalVector<Point *> &r_nbors);
-	Point *_jump(Point *p_from, Point *p_to);
-	bool _solve(Point *p_begin_point, Point *p_end_point, bool p_allow_partial_path);
-	Point *_forced_successor(int32_t p_x, int32_t p_y, int32_t p_dx, int32_t p_dy, bool p_inclusive = false);
+	Vector2 _get_point_position_unchecked(const Vector2i &p_id) const;
+	void _allocate_weight_scales();
+	void _reset_search_data();
+	uint32_t _add_search_node(const Vector2i &p_id);
+	void _push_open_entry(int64_t p_hole_index, const OpenEntry &p_entry);
+	void _pop_open_entry();
+	void _invalidate_jump_tables(const Rect2i &p_region);
+	void _update_jump_table(bool p_inclusive, JumpAxis p_axis);
+	void _update_jump_tables();
+	bool _is_jump_point(int32_t p_x, int32_t p_y, int32_t p_dx, int32_t p_dy, bool p_inclusive) const;
+
+	void _get_nbors(const Vector2i &p_id, LocalVector<Vector2i> &r_nbors) const;
+	bool _jump(const Vector2i &p_from, const Vector2i &p_to, Vector2i &r_jump_point) const;
+	bool _solve(const Vector2i &p_begin_id, const Vector2i &p_end_id, bool p_allow_partial_path);
+	bool _forced_successor(int32_t p_x, int32_t p_y, int32_t p_dx, int32_t p_dy, Vector2i &r_successor, bool p_inclusive = false) const;
 
 protected:
 	static void _bind_methods();
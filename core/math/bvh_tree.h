@@ -177,6 +177,7 @@ public:
 	BVH_Tree() {
 		for (int n = 0; n < NUM_TREES; n++) {
 			_root_node_id[n] = BVHCommon::INVALID;
+			_tree_dirty[n] = false;
 		}
 
 		// disallow zero leaf ids
@@ -360,6 +361,7 @@ private:
 			// we defer the refit updates until the update function is called once per frame
 			if (refit) {
 				leaf.set_dirty(true);
+				_tree_dirty[p_tree_id] = true;
 			}
 		} else {
 			// remove node if empty
@@ -176,6 +176,11 @@ public:
 	virtual Error close_dynamic_library(void *p_library_handle) { return ERR_UNAVAILABLE; }
 	virtual Error get_dynamic_library_symbol_handle(void *p_library_handle, const String &p_name, void *&p_symbol_handle, bool p_optional = false) { return ERR_UNAVAILABLE; }
 
+	// Maps a whole file read-only into memory, returns `nullptr` if unsupported or on failure.
+	// Mappings are shared with the OS page cache, so the same file mapped by several processes only occupies memory once.
+	virtual const uint8_t *map_file(const String &p_path, uint64_t &r_size) { return nullptr; }
+	virtual void unmap_file(const uint8_t *p_data, uint64_t p_size) {}
+
 	virtual void set_low_processor_usage_mode(bool p_enabled);
 	virtual bool is_in_low_processor_usage_mode() const;
 	virtual void set_low_processor_usage_mode_sleep_usec(int p_usec);
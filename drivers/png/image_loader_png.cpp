@@ -35,6 +35,12 @@
 #include <string.h>
 
 Error ImageLoaderPNG::load_image(Ref<Image> p_image, Ref<FileAccess> f, BitField<ImageFormatLoader::LoaderFlags> p_flags, float p_scale) {
+	const Span<uint8_t> mapped = f->get_mapped_span();
+	if (!mapped.is_empty()) {
+		// Decode in place, no need to copy the file.
+		return PNGDriverCommon::png_to_image(mapped.ptr(), mapped.size(), p_flags & FLAG_FORCE_LINEAR, p_image);
+	}
+
 	const uint64_t buffer_size = f->get_length();
 	Vector<uint8_t> file_buffer;
 	Error err = file_buffer.resize(buffer_size);
@@ -70,12 +70,14 @@
 
 #include <dlfcn.h>
 #include <errno.h>
+#include <fcntl.h>
 #include <poll.h>
 #include <signal.h>
 #include <stdarg.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
+#include <sys/mman.h>
 #include <sys/resource.h>
 #include <sys/stat.h>
 #include <sys/time.h>
@@ -104,10 +106,6 @@
 #define UNIX_GET_ENTROPY
 #endif
 
-#if !defined(UNIX_GET_ENTROPY) && !defined(NO_URANDOM)
-#include <fcntl.h>
-#endif
-
 /// Clock Setup function (used by get_ticks_usec)
 static uint64_t _clock_start = 0;
 #if defined(__APPLE__)
@@ -1072,6 +1070,40 @@ Error OS_Unix::get_dynamic_library_symbol_handle(void *p_library_handle, const S
 	return OK;
 }
 
+const uint8_t *OS_Unix::map_file(const String &p_path, uint64_t &r_size) {
+#ifdef WEB_ENABLED
+	// Emscripten emulates mmap() by copying the file, nothing to gain there.
+	return nullptr;
+#else
+	int fd = ::open(p_path.utf8().get_data(), O_RDONLY | O_CLOEXEC);
+	if (fd < 0) {
+		return nullptr;
+	}
+
+	struct stat st;
+	if (fstat(fd, &st) != 0 || !S_ISREG(st.st_mode) || st.st_size <= 0) {
+		::close(fd);
+		return nullptr;
+	}
+
+	void *data = mmap(nullptr, st.st_size, PROT_READ, MAP_SHARED, fd, 0);
+	::close(fd); // The mapping keeps its own reference to the file.
+	if (data == MAP_FAILED) {
+		return nullptr;
+	}
+
+	r_size = st.st_size;
+	return (const uint8_t *)data;
+#endif
+}
+
+void OS_Unix::unmap_file(const uint8_t *p_data, uint64_t p_size) {
+#ifndef WEB_ENABLED
+	ERR_FAIL_NULL(p_data);
+	munmap((void *)p_data, p_size);
+#endif
+}
+
 Error OS_Unix::set_cwd(const String &p_cwd) {
 	if (chdir(p_cwd.utf8().get_data()) != 0) {
 		return ERR_CANT_OPEN;
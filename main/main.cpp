@@ -46,6 +46,7 @@
 #include "core/io/image_loader.h"
 #include "core/io/ip.h"
 #include "core/io/resource_loader.h"
+#include "core/io/resource_persistent_cache.h"
 #include "core/object/message_queue.h"
 #include "core/object/script_language.h"
 #include "core/os/os.h"
@@ -760,6 +761,7 @@ Error Main::test_setup() {
 	ResourceLoader::load_translation_remaps(); //load remaps for resources
 
 	ResourceLoader::load_path_remaps();
+	ResourcePersistentCache::initialize();
 
 	// Initialize ThemeDB early so that scene types can register their theme items.
 	// Default theme will be initialized later, after modules and ScriptServer are ready.
@@ -3476,6 +3478,7 @@ Error Main::setup2(bool p_show_boot_logo) {
 		ResourceLoader::load_translation_remaps(); //load remaps for resources
 
 		ResourceLoader::load_path_remaps();
+		ResourcePersistentCache::initialize();
 
 		OS::get_singleton()->benchmark_end_measure("Startup", "Translations and Remaps");
 	}
@@ -4898,6 +4901,7 @@ void Main::cleanup(bool p_force) {
 		movie_writer->end();
 	}
 
+	ResourcePersistentCache::flush();
 	ResourceLoader::clear_thread_load_tasks();
 
 	ResourceLoader::remove_custom_loaders();
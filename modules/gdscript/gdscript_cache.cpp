@@ -268,13 +268,22 @@ String GDScriptCache::get_source_code(const String &p_path) {
 	Ref<FileAccess> f = FileAccess::open(p_path, FileAccess::READ, &err);
 	ERR_FAIL_COND_V(err, "");
 
+	String source;
+	const Span<uint8_t> mapped = f->get_mapped_span();
+	if (!mapped.is_empty()) {
+		// Parse straight from memory, skipping the intermediate buffer.
+		if (source.append_utf8((const char *)mapped.ptr(), mapped.size()) != OK) {
+			ERR_FAIL_V_MSG("", "Script '" + p_path + "' contains invalid unicode (UTF-8), so it was not loaded. Please ensure that scripts are saved in valid UTF-8 unicode.");
+		}
+		return source;
+	}
+
 	uint64_t len = f->get_length();
 	source_file.resize(len + 1);
 	uint64_t r = f->get_buffer(source_file.ptrw(), len);
 	ERR_FAIL_COND_V(r != len, "");
 	source_file.write[len] = 0;
 
-	String source;
 	if (source.append_utf8((const char *)source_file.ptr(), len) != OK) {
 		ERR_FAIL_V_MSG("", "Script '" + p_path + "' contains invalid unicode (UTF-8), so it was not loaded. Please ensure that scripts are saved in valid UTF-8 unicode.");
 	}
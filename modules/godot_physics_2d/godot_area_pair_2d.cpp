@@ -91,6 +91,14 @@ void GodotAreaPair2D::solve(real_t p_step) {
 	// Nothing to do.
 }
 
+GodotConstraint2D::OrderKey GodotAreaPair2D::get_order_key() const {
+	// The body is already compared as the constraint's only body.
+	OrderKey key;
+	key.ids[0] = area->get_self().get_id();
+	key.shapes = ((uint64_t)body_shape << 32) | (uint32_t)area_shape;
+	return key;
+}
+
 GodotAreaPair2D::GodotAreaPair2D(GodotBody2D *p_body, int p_body_shape, GodotArea2D *p_area, int p_area_shape) {
 	body = p_body;
 	area = p_area;
@@ -174,6 +182,14 @@ void GodotArea2Pair2D::solve(real_t p_step) {
 	// Nothing to do.
 }
 
+GodotConstraint2D::OrderKey GodotArea2Pair2D::get_order_key() const {
+	OrderKey key;
+	key.ids[0] = area_a->get_self().get_id();
+	key.ids[1] = area_b->get_self().get_id();
+	key.shapes = ((uint64_t)shape_a << 32) | (uint32_t)shape_b;
+	return key;
+}
+
 GodotArea2Pair2D::GodotArea2Pair2D(GodotArea2D *p_area_a, int p_shape_a, GodotArea2D *p_area_b, int p_shape_b) {
 	area_a = p_area_a;
 	area_b = p_area_b;
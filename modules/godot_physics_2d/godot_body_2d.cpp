@@ -612,6 +612,30 @@ void GodotBody2D::integrate_forces(real_t p_step) {
 	contact_count = 0;
 }
 
+void GodotBody2D::_deterministic_sin_cos(real_t p_angle, real_t &r_sin, real_t &r_cos) {
+	// Only basic arithmetic, which is exactly rounded: halve the angle until the series converges quickly,
+	// then double it back.
+	int halvings = 0;
+	real_t x = p_angle;
+	while (Math::abs(x) > 0.125 && halvings < 32) {
+		x *= 0.5;
+		halvings++;
+	}
+
+	real_t x2 = x * x;
+	real_t s = x * (1.0 - x2 / 6.0 * (1.0 - x2 / 20.0 * (1.0 - x2 / 42.0 * (1.0 - x2 / 72.0))));
+	real_t c = 1.0 - x2 / 2.0 * (1.0 - x2 / 12.0 * (1.0 - x2 / 30.0 * (1.0 - x2 / 56.0)));
+
+	for (int i = 0; i < halvings; i++) {
+		real_t s2 = 2.0 * s * c;
+		c = c * c - s * s;
+		s = s2;
+	}
+
+	r_sin = s;
+	r_cos = c;
+}
+
 void GodotBody2D::integrate_velocities(real_t p_step) {
 	if (mode == PhysicsServer2D::BODY_MODE_STATIC) {
 		return;
@@ -636,15 +660,36 @@ void GodotBody2D::integrate_velocities(real_t p_step) {
 	Vector2 total_linear_velocity = linear_velocity + biased_linear_velocity;
 
 	real_t angle_delta = total_angular_velocity * p_step;
-	real_t angle = get_transform().get_rotation() + angle_delta;
 	Vector2 pos = get_transform().get_origin() + total_linear_velocity * p_step;
 
-	if (center_of_mass.length_squared() > CMP_EPSILON2) {
-		// Calculate displacement due to center of mass offset.
-		pos += center_of_mass - center_of_mass.rotated(angle_delta);
+	Transform2D transform;
+	if (get_space()->is_deterministic()) {
+		// Rotate the basis directly, so no libm call (which may differ between platforms) is involved.
+		real_t sin_delta, cos_delta;
+		_deterministic_sin_cos(angle_delta, sin_delta, cos_delta);
+
+		const Vector2 &x = get_transform().columns[0];
+		Vector2 axis_x = Vector2(x.x * cos_delta - x.y * sin_delta, x.x * sin_delta + x.y * cos_delta).normalized();
+		transform.columns[0] = axis_x;
+		transform.columns[1] = Vector2(-axis_x.y, axis_x.x);
+
+		if (center_of_mass.length_squared() > CMP_EPSILON2) {
+			// Calculate displacement due to center of mass offset.
+			pos += center_of_mass - Vector2(center_of_mass.x * cos_delta - center_of_mass.y * sin_delta, center_of_mass.x * sin_delta + center_of_mass.y * cos_delta);
+		}
+		transform.columns[2] = pos;
+	} else {
+		real_t angle = get_transform().get_rotation() + angle_delta;
+
+		if (center_of_mass.length_squared() > CMP_EPSILON2) {
+			// Calculate displacement due to center of mass offset.
+			pos += center_of_mass - center_of_mass.rotated(angle_delta);
+		}
+
+		transform = Transform2D(angle, pos);
 	}
 
-	_set_transform(Transform2D(angle, pos), continuous_cd_mode == PhysicsServer2D::CCD_MODE_DISABLED);
+	_set_transform(transform, continuous_cd_mode == PhysicsServer2D::CCD_MODE_DISABLED);
 	_set_inv_transform(get_transform().inverse());
 
 	if (continuous_cd_mode != PhysicsServer2D::CCD_MODE_DISABLED) {
@@ -152,6 +152,7 @@ class GodotBody2D : public GodotCollisionObject2D {
 	uint64_t island_step = 0;
 
 	void _update_transform_dependent();
+	static void _deterministic_sin_cos(real_t p_angle, real_t &r_sin, real_t &r_cos);
 
 	friend class GodotPhysicsDirectBodyState2D; // i give up, too many functions to expose
 
@@ -37,6 +37,7 @@
 
 #define MIN_VELOCITY 0.001
 #define MAX_BIAS_ROTATION (Math_PI / 8)
+#define CONTACT_RECYCLE_NORMAL_DOT 0.9
 
 void GodotBodyPair2D::_add_contact(const Vector2 &p_point_A, const Vector2 &p_point_B, void *p_self) {
 	GodotBodyPair2D *self = static_cast<GodotBodyPair2D *>(p_self);
@@ -45,8 +46,14 @@ void GodotBodyPair2D::_add_contact(const Vector2 &p_point_A, const Vector2 &p_po
 }
 
 void GodotBodyPair2D::_contact_added_callback(const Vector2 &p_point_A, const Vector2 &p_point_B) {
-	Vector2 local_A = A->get_inv_transform().basis_xform(p_point_A);
-	Vector2 local_B = B->get_inv_transform().basis_xform(p_point_B - offset_B);
+	Vector2 normal = (p_point_A - p_point_B).normalized();
+
+	// Speculative contacts are detected on shapes grown by the margin, move the points back onto the actual shapes.
+	Vector2 point_A = p_point_A - normal * speculative_margin;
+	Vector2 point_B = p_point_B + normal * speculative_margin;
+
+	Vector2 local_A = A->get_inv_transform().basis_xform(point_A);
+	Vector2 local_B = B->get_inv_transform().basis_xform(point_B - offset_B);
 
 	int new_index = contact_count;
 
@@ -55,25 +62,46 @@ void GodotBodyPair2D::_contact_added_callback(const Vector2 &p_point_A, const Ve
 	Contact contact;
 	contact.local_A = local_A;
 	contact.local_B = local_B;
-	contact.normal = (p_point_A - p_point_B).normalized();
+	contact.normal = normal;
 	contact.used = true;
 
 	// Attempt to determine if the contact will be reused.
+	// The closest previous contact that was not matched yet and whose normal still agrees wins, so that
+	// contacts keep their identity (and accumulated impulses) even when several are within the radius.
 	real_t recycle_radius_2 = space->get_contact_recycle_radius() * space->get_contact_recycle_radius();
 
+	int recycle_index = -1;
+	real_t recycle_dist_2 = 0.0;
+
 	for (int i = 0; i < contact_count; i++) {
-		Contact &c = contacts[i];
-		if (c.local_A.distance_squared_to(local_A) < (recycle_radius_2) &&
-				c.local_B.distance_squared_to(local_B) < (recycle_radius_2)) {
-			contact.acc_normal_impulse = c.acc_normal_impulse;
-			contact.acc_tangent_impulse = c.acc_tangent_impulse;
-			contact.acc_bias_impulse = c.acc_bias_impulse;
-			contact.acc_bias_impulse_center_of_mass = c.acc_bias_impulse_center_of_mass;
-			c = contact;
-			return;
+		const Contact &c = contacts[i];
+		if (c.used || c.normal.dot(normal) < CONTACT_RECYCLE_NORMAL_DOT) {
+			// Already matched this frame, or belongs to a different feature.
+			continue;
+		}
+
+		real_t dist_A_2 = c.local_A.distance_squared_to(local_A);
+		real_t dist_B_2 = c.local_B.distance_squared_to(local_B);
+		if (dist_A_2 >= recycle_radius_2 || dist_B_2 >= recycle_radius_2) {
+			continue;
+		}
+
+		if (recycle_index == -1 || dist_A_2 + dist_B_2 < recycle_dist_2) {
+			recycle_index = i;
+			recycle_dist_2 = dist_A_2 + dist_B_2;
 		}
 	}
 
+	if (recycle_index != -1) {
+		Contact &c = contacts[recycle_index];
+		contact.acc_normal_impulse = c.acc_normal_impulse;
+		contact.acc_tangent_impulse = c.acc_tangent_impulse;
+		contact.acc_bias_impulse = c.acc_bias_impulse;
+		contact.acc_bias_impulse_center_of_mass = c.acc_bias_impulse_center_of_mass;
+		c = contact;
+		return;
+	}
+
 	// Figure out if the contact amount must be reduced to fit the new contact.
 	if (new_index == MAX_CONTACTS) {
 		// Remove the contact with the minimum depth.
@@ -295,7 +323,14 @@ bool GodotBodyPair2D::setup(real_t p_step) {
 
 	bool prev_collided = collided;
 
-	collided = GodotCollisionSolver2D::solve(shape_A_ptr, xform_A, motion_A, shape_B_ptr, xform_B, motion_B, _add_contact, this, &sep_axis);
+	// Speculative contacts are generated for shapes that are closer than the maximum separation, so resting
+	// contacts don't flicker in and out of existence and approaching bodies are stopped at the surface.
+	speculative_margin = 0.0;
+	if (space->is_speculative_contacts_enabled() && !report_contacts_only && combine_bounce(A, B) == 0.0) {
+		speculative_margin = space->get_contact_max_separation() * 0.5;
+	}
+
+	collided = GodotCollisionSolver2D::solve(shape_A_ptr, xform_A, motion_A, shape_B_ptr, xform_B, motion_B, _add_contact, this, &sep_axis, speculative_margin, speculative_margin);
 	if (!collided) {
 		oneway_disabled = false;
 
@@ -425,7 +460,8 @@ bool GodotBodyPair2D::pre_solve(real_t p_step) {
 		Vector2 axis = global_A - global_B;
 		real_t depth = axis.dot(c.normal);
 
-		if (depth <= 0.0) {
+		c.speculative = depth <= 0.0;
+		if (c.speculative && speculative_margin == 0.0) {
 			continue;
 		}
 
@@ -460,6 +496,26 @@ bool GodotBodyPair2D::pre_solve(real_t p_step) {
 
 		c.acc_impulse -= P;
 
+		if (c.speculative) {
+			// Not touching yet: no position correction, and the bodies may close the gap within this step.
+			// Speculative pairs never bounce (see setup()), so the bounce term holds the allowed approach velocity.
+			c.bias = 0.0;
+			c.bounce = -depth * inv_dt;
+
+#ifdef ACCUMULATE_IMPULSES
+			if (collide_A) {
+				A->apply_impulse(-P, c.rA + A->get_center_of_mass());
+			}
+			if (collide_B) {
+				B->apply_impulse(P, c.rB + B->get_center_of_mass());
+			}
+#endif
+
+			c.active = true;
+			do_process = true;
+			continue;
+		}
+
 		if (A->can_report_contacts() || B->can_report_contacts()) {
 			Vector2 crB = Vector2(-B->get_angular_velocity() * c.rB.y, B->get_angular_velocity() * c.rB.x) + B->get_linear_velocity();
 			Vector2 crA = Vector2(-A->get_angular_velocity() * c.rA.y, A->get_angular_velocity() * c.rA.x) + A->get_linear_velocity();
@@ -536,6 +592,11 @@ void GodotBodyPair2D::solve(real_t p_step) {
 		Vector2 tangent = c.normal.orthogonal();
 		real_t vt = dv.dot(tangent);
 
+		if (c.speculative) {
+			_solve_velocity(c, vn, vt, tangent);
+			continue;
+		}
+
 		real_t jbn = (c.bias - vbn) * c.mass_normal;
 		real_t jbnOld = c.acc_bias_impulse;
 		c.acc_bias_impulse = MAX(jbnOld + jbn, 0.0f);
@@ -570,27 +631,33 @@ void GodotBodyPair2D::solve(real_t p_step) {
 			}
 		}
 
-		real_t jn = -(c.bounce + vn) * c.mass_normal;
-		real_t jnOld = c.acc_normal_impulse;
-		c.acc_normal_impulse = MAX(jnOld + jn, 0.0f);
+		_solve_velocity(c, vn, vt, tangent);
+	}
+}
 
-		real_t friction = combine_friction(A, B);
+void GodotBodyPair2D::_solve_velocity(Contact &p_contact, real_t p_vn, real_t p_vt, const Vector2 &p_tangent) {
+	Contact &c = p_contact;
 
-		real_t jtMax = friction * c.acc_normal_impulse;
-		real_t jt = -vt * c.mass_tangent;
-		real_t jtOld = c.acc_tangent_impulse;
-		c.acc_tangent_impulse = CLAMP(jtOld + jt, -jtMax, jtMax);
+	real_t jn = -(c.bounce + p_vn) * c.mass_normal;
+	real_t jnOld = c.acc_normal_impulse;
+	c.acc_normal_impulse = MAX(jnOld + jn, 0.0f);
 
-		Vector2 j = c.normal * (c.acc_normal_impulse - jnOld) + tangent * (c.acc_tangent_impulse - jtOld);
+	real_t friction = combine_friction(A, B);
 
-		if (collide_A) {
-			A->apply_impulse(-j, c.rA + A->get_center_of_mass());
-		}
-		if (collide_B) {
-			B->apply_impulse(j, c.rB + B->get_center_of_mass());
-		}
-		c.acc_impulse -= j;
+	real_t jtMax = friction * c.acc_normal_impulse;
+	real_t jt = -p_vt * c.mass_tangent;
+	real_t jtOld = c.acc_tangent_impulse;
+	c.acc_tangent_impulse = CLAMP(jtOld + jt, -jtMax, jtMax);
+
+	Vector2 j = c.normal * (c.acc_normal_impulse - jnOld) + p_tangent * (c.acc_tangent_impulse - jtOld);
+
+	if (collide_A) {
+		A->apply_impulse(-j, c.rA + A->get_center_of_mass());
+	}
+	if (collide_B) {
+		B->apply_impulse(j, c.rB + B->get_center_of_mass());
 	}
+	c.acc_impulse -= j;
 }
 
 GodotBodyPair2D::GodotBodyPair2D(GodotBody2D *p_A, int p_shape_A, GodotBody2D *p_B, int p_shape_B) :
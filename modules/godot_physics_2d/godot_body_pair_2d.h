@@ -69,6 +69,7 @@ class GodotBodyPair2D : public GodotConstraint2D {
 		real_t depth = 0.0;
 		bool active = false;
 		bool used = false;
+		bool speculative = false; // Separated but within the speculative margin, only limits the approach velocity.
 		Vector2 rA, rB;
 		real_t bounce = 0.0;
 	};
@@ -82,13 +83,21 @@ class GodotBodyPair2D : public GodotConstraint2D {
 	bool check_ccd = false;
 	bool oneway_disabled = false;
 	bool report_contacts_only = false;
+	real_t speculative_margin = 0.0;
 
 	bool _test_ccd(real_t p_step, GodotBody2D *p_A, int p_shape_A, const Transform2D &p_xform_A, GodotBody2D *p_B, int p_shape_B, const Transform2D &p_xform_B);
 	void _validate_contacts();
 	static void _add_contact(const Vector2 &p_point_A, const Vector2 &p_point_B, void *p_self);
 	_FORCE_INLINE_ void _contact_added_callback(const Vector2 &p_point_A, const Vector2 &p_point_B);
+	_FORCE_INLINE_ void _solve_velocity(Contact &p_contact, real_t p_vn, real_t p_vt, const Vector2 &p_tangent);
 
 public:
+	virtual OrderKey get_order_key() const override {
+		OrderKey key;
+		key.shapes = ((uint64_t)shape_A << 32) | (uint32_t)shape_B;
+		return key;
+	}
+
 	virtual bool setup(real_t p_step) override;
 	virtual bool pre_solve(real_t p_step) override;
 	virtual void solve(real_t p_step) override;
@@ -59,6 +59,29 @@ public:
 	_FORCE_INLINE_ void disable_collisions_between_bodies(const bool p_disabled) { disabled_collisions_between_bodies = p_disabled; }
 	_FORCE_INLINE_ bool is_disabled_collisions_between_bodies() const { return disabled_collisions_between_bodies; }
 
+	// Orders constraints that share the same bodies in deterministic spaces. Values are only compared with each other,
+	// so the order follows the creation order of the objects and doesn't depend on memory addresses or absolute RID values.
+	struct OrderKey {
+		uint64_t ids[2] = {};
+		uint64_t shapes = 0;
+
+		_FORCE_INLINE_ bool operator<(const OrderKey &p_other) const {
+			if (ids[0] != p_other.ids[0]) {
+				return ids[0] < p_other.ids[0];
+			}
+			if (ids[1] != p_other.ids[1]) {
+				return ids[1] < p_other.ids[1];
+			}
+			return shapes < p_other.shapes;
+		}
+	};
+
+	virtual OrderKey get_order_key() const {
+		OrderKey key;
+		key.ids[0] = self.get_id();
+		return key;
+	}
+
 	virtual bool setup(real_t p_step) = 0;
 	virtual bool pre_solve(real_t p_step) = 0;
 	virtual void solve(real_t p_step) = 0;
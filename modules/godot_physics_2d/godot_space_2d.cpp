@@ -1013,13 +1013,15 @@ bool GodotSpace2D::test_body_motion(GodotBody2D *p_body, const PhysicsServer2D::
 void *GodotSpace2D::_broadphase_pair(GodotCollisionObject2D *A, int p_subindex_A, GodotCollisionObject2D *B, int p_subindex_B, void *p_self) {
 	GodotCollisionObject2D::Type type_A = A->get_type();
 	GodotCollisionObject2D::Type type_B = B->get_type();
-	if (type_A > type_B) {
+	GodotSpace2D *self = static_cast<GodotSpace2D *>(p_self);
+
+	// Deterministic spaces don't let the broadphase traversal order decide which object is A.
+	if (type_A > type_B || (type_A == type_B && self->deterministic && A->get_self().get_id() > B->get_self().get_id())) {
 		SWAP(A, B);
 		SWAP(p_subindex_A, p_subindex_B);
 		SWAP(type_A, type_B);
 	}
 
-	GodotSpace2D *self = static_cast<GodotSpace2D *>(p_self);
 	self->collision_pairs++;
 
 	if (type_A == GodotCollisionObject2D::TYPE_AREA) {
@@ -1055,6 +1057,73 @@ const SelfList<GodotBody2D>::List &GodotSpace2D::get_active_body_list() const {
 	return active_list;
 }
 
+void GodotSpace2D::sort_active_body_list() {
+	struct BodyRIDComparator {
+		_FORCE_INLINE_ bool operator()(const SelfList<GodotBody2D> *p_a, const SelfList<GodotBody2D> *p_b) const {
+			return p_a->self()->get_self().get_id() < p_b->self()->get_self().get_id();
+		}
+	};
+
+	LocalVector<SelfList<GodotBody2D> *> sorted;
+	while (active_list.first()) {
+		SelfList<GodotBody2D> *E = active_list.first();
+		sorted.push_back(E);
+		active_list.remove(E);
+	}
+
+	sorted.sort_custom<BodyRIDComparator>();
+
+	for (SelfList<GodotBody2D> *E : sorted) {
+		active_list.add_last(E);
+	}
+}
+
+static _FORCE_INLINE_ uint64_t _hash_real_bits(real_t p_value, uint64_t p_prev) {
+	// Hash the exact bit pattern, any divergence between peers has to show up in the hash.
+	uint64_t bits = 0;
+	memcpy(&bits, &p_value, sizeof(real_t));
+	return hash64_murmur3_64(bits, p_prev);
+}
+
+uint64_t GodotSpace2D::get_state_hash() const {
+	struct BodyRIDComparator {
+		_FORCE_INLINE_ bool operator()(const GodotBody2D *p_a, const GodotBody2D *p_b) const {
+			return p_a->get_self().get_id() < p_b->get_self().get_id();
+		}
+	};
+
+	LocalVector<const GodotBody2D *> bodies;
+	for (const GodotCollisionObject2D *E : objects) {
+		if (E->get_type() == GodotCollisionObject2D::TYPE_BODY) {
+			bodies.push_back(static_cast<const GodotBody2D *>(E));
+		}
+	}
+
+	// RID values come from a process-wide counter and differ between peers, only their order is shared
+	// when the bodies are created in the same order. So bodies are hashed by their position in that order.
+	bodies.sort_custom<BodyRIDComparator>();
+
+	uint64_t hash = hash64_murmur3_64(bodies.size(), HASH_MURMUR3_SEED);
+	for (uint32_t body_index = 0; body_index < bodies.size(); body_index++) {
+		const GodotBody2D *body = bodies[body_index];
+		hash = hash64_murmur3_64(body_index, hash);
+		hash = hash64_murmur3_64(((uint64_t)body->get_mode() << 1) | (body->is_active() ? 1 : 0), hash);
+
+		const Transform2D &transform = body->get_transform();
+		for (int i = 0; i < 3; i++) {
+			hash = _hash_real_bits(transform.columns[i].x, hash);
+			hash = _hash_real_bits(transform.columns[i].y, hash);
+		}
+
+		const Vector2 linear_velocity = body->get_linear_velocity();
+		hash = _hash_real_bits(linear_velocity.x, hash);
+		hash = _hash_real_bits(linear_velocity.y, hash);
+		hash = _hash_real_bits(body->get_angular_velocity(), hash);
+	}
+
+	return hash;
+}
+
 void GodotSpace2D::body_add_to_active_list(SelfList<GodotBody2D> *p_body) {
 	active_list.add(p_body);
 }
@@ -1225,6 +1294,8 @@ GodotSpace2D::GodotSpace2D() {
 	contact_max_separation = GLOBAL_GET("physics/2d/solver/contact_max_separation");
 	contact_max_allowed_penetration = GLOBAL_GET("physics/2d/solver/contact_max_allowed_penetration");
 	contact_bias = GLOBAL_GET("physics/2d/solver/default_contact_bias");
+	speculative_contacts = GLOBAL_GET("physics/2d/solver/speculative_contacts");
+	deterministic = GLOBAL_GET("physics/2d/deterministic");
 	constraint_bias = GLOBAL_GET("physics/2d/solver/default_constraint_bias");
 
 	broadphase = GodotBroadPhase2D::create_func();
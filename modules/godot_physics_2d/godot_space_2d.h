@@ -97,6 +97,8 @@ private:
 	real_t contact_max_separation = 0.0;
 	real_t contact_max_allowed_penetration = 0.0;
 	real_t contact_bias = 0.0;
+	bool speculative_contacts = true;
+	bool deterministic = false;
 	real_t constraint_bias = 0.0;
 
 	enum {
@@ -133,6 +135,7 @@ public:
 	GodotArea2D *get_default_area() const { return area; }
 
 	const SelfList<GodotBody2D>::List &get_active_body_list() const;
+	void sort_active_body_list();
 	void body_add_to_active_list(SelfList<GodotBody2D> *p_body);
 	void body_remove_from_active_list(SelfList<GodotBody2D> *p_body);
 	void body_add_to_mass_properties_update_list(SelfList<GodotBody2D> *p_body);
@@ -158,6 +161,8 @@ public:
 	_FORCE_INLINE_ real_t get_contact_max_separation() const { return contact_max_separation; }
 	_FORCE_INLINE_ real_t get_contact_max_allowed_penetration() const { return contact_max_allowed_penetration; }
 	_FORCE_INLINE_ real_t get_contact_bias() const { return contact_bias; }
+	_FORCE_INLINE_ bool is_speculative_contacts_enabled() const { return speculative_contacts; }
+	_FORCE_INLINE_ bool is_deterministic() const { return deterministic; }
 	_FORCE_INLINE_ real_t get_constraint_bias() const { return constraint_bias; }
 	_FORCE_INLINE_ real_t get_body_linear_velocity_sleep_threshold() const { return body_linear_velocity_sleep_threshold; }
 	_FORCE_INLINE_ real_t get_body_angular_velocity_sleep_threshold() const { return body_angular_velocity_sleep_threshold; }
@@ -185,6 +190,8 @@ public:
 
 	int get_collision_pairs() const { return collision_pairs; }
 
+	uint64_t get_state_hash() const;
+
 	bool test_body_motion(GodotBody2D *p_body, const PhysicsServer2D::MotionParameters &p_parameters, PhysicsServer2D::MotionResult *r_result);
 
 	void set_debug_contacts(int p_amount) { contact_debug.resize(p_amount); }
@@ -40,6 +40,22 @@
 #define ISLAND_SIZE_RESERVE 512
 #define CONSTRAINT_COUNT_RESERVE 1024
 
+struct GodotConstraint2DOrder {
+	_FORCE_INLINE_ bool operator()(const GodotConstraint2D *p_a, const GodotConstraint2D *p_b) const {
+		if (p_a->get_body_count() != p_b->get_body_count()) {
+			return p_a->get_body_count() < p_b->get_body_count();
+		}
+		for (int i = 0; i < p_a->get_body_count(); i++) {
+			uint64_t id_a = p_a->get_body_ptr()[i]->get_self().get_id();
+			uint64_t id_b = p_b->get_body_ptr()[i]->get_self().get_id();
+			if (id_a != id_b) {
+				return id_a < id_b;
+			}
+		}
+		return p_a->get_order_key() < p_b->get_order_key();
+	}
+};
+
 void GodotStep2D::_populate_island(GodotBody2D *p_body, LocalVector<GodotBody2D *> &p_body_island, LocalVector<GodotConstraint2D *> &p_constraint_island) {
 	p_body->set_island_step(_step);
 
@@ -136,6 +152,12 @@ void GodotStep2D::step(GodotSpace2D *p_space, real_t p_delta) {
 	iterations = p_space->get_solver_iterations();
 	delta = p_delta;
 
+	bool deterministic = p_space->is_deterministic();
+	if (deterministic) {
+		// Bodies are woken up in whatever order the game touched them, use an order every peer agrees on.
+		p_space->sort_active_body_list();
+	}
+
 	const SelfList<GodotBody2D>::List *body_list = &p_space->get_active_body_list();
 
 	/* INTEGRATE FORCES */
@@ -219,6 +241,11 @@ void GodotStep2D::step(GodotSpace2D *p_space, real_t p_delta) {
 
 			_populate_island(body, body_island, constraint_island);
 
+			if (deterministic) {
+				// The constraint lists follow broadphase pairing order, which depends on the tree layout.
+				constraint_island.sort_custom<GodotConstraint2DOrder>();
+			}
+
 			if (body_island.is_empty()) {
 				--body_island_count;
 			}
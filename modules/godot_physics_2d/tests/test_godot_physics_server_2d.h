@@ -0,0 +1,138 @@
+/**************************************************************************/
+/*  test_godot_physics_server_2d.h                                        */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#pragma once
+
+#include "../godot_physics_server_2d.h"
+
+#include "core/config/project_settings.h"
+#include "tests/test_macros.h"
+
+namespace TestGodotPhysicsServer2D {
+
+// A static floor with a pile of boxes and circles dropped on it, close enough to land on each other.
+// The bodies are created in the same relative order every time, but their initial state is set in
+// forward or reverse order, which changes the order they are woken up and added to the active list.
+LocalVector<RID> create_pile(PhysicsServer2D *p_server, RID p_space, RID p_floor_shape, RID p_box_shape, RID p_circle_shape, bool p_reverse_setup) {
+	LocalVector<RID> bodies;
+
+	RID floor = p_server->body_create();
+	p_server->body_set_mode(floor, PhysicsServer2D::BODY_MODE_STATIC);
+	p_server->body_set_space(floor, p_space);
+	p_server->body_add_shape(floor, p_floor_shape, Transform2D(), false);
+	bodies.push_back(floor);
+
+	const int body_count = 12;
+	for (int i = 0; i < body_count; i++) {
+		RID body = p_server->body_create();
+		p_server->body_set_mode(body, PhysicsServer2D::BODY_MODE_RIGID);
+		p_server->body_set_space(body, p_space);
+		p_server->body_add_shape(body, i % 2 ? p_box_shape : p_circle_shape, Transform2D(), false);
+		bodies.push_back(body);
+	}
+
+	for (int j = 0; j < body_count; j++) {
+		const int i = p_reverse_setup ? body_count - 1 - j : j;
+		RID body = bodies[i + 1];
+		p_server->body_set_state(body, PhysicsServer2D::BODY_STATE_TRANSFORM, Transform2D(0.1 * i, Vector2((i % 4) * 15.0, -20.0 - (i / 4) * 25.0)));
+		p_server->body_set_state(body, PhysicsServer2D::BODY_STATE_LINEAR_VELOCITY, Vector2((i % 3) * 10.0 - 10.0, 0.0));
+		p_server->body_set_state(body, PhysicsServer2D::BODY_STATE_ANGULAR_VELOCITY, 0.5 * (i % 5) - 1.0);
+	}
+
+	return bodies;
+}
+
+TEST_CASE("[GodotPhysics2D] Deterministic spaces match regardless of RID values and wake-up order") {
+	const Variant previous_deterministic = GLOBAL_GET("physics/2d/deterministic");
+	ProjectSettings::get_singleton()->set_setting("physics/2d/deterministic", true);
+
+	GodotPhysicsServer2D *server = memnew(GodotPhysicsServer2D(false));
+	server->init();
+
+	RID floor_shape = server->rectangle_shape_create();
+	server->shape_set_data(floor_shape, Vector2(200, 10));
+	RID box_shape = server->rectangle_shape_create();
+	server->shape_set_data(box_shape, Vector2(8, 8));
+	RID circle_shape = server->circle_shape_create();
+	server->shape_set_data(circle_shape, 8.0);
+
+	RID space_a = server->space_create();
+	server->space_set_active(space_a, true);
+	LocalVector<RID> bodies_a = create_pile(server, space_a, floor_shape, box_shape, circle_shape, false);
+
+	// Unrelated objects in between give the second pile different RID values, with different gaps between them.
+	LocalVector<RID> spacers;
+	for (int i = 0; i < 7; i++) {
+		spacers.push_back(server->circle_shape_create());
+	}
+
+	RID space_b = server->space_create();
+	server->space_set_active(space_b, true);
+	LocalVector<RID> bodies_b = create_pile(server, space_b, floor_shape, box_shape, circle_shape, true);
+
+	REQUIRE(bodies_a[1].get_id() != bodies_b[1].get_id());
+
+	const uint64_t initial_hash = server->space_get_state_hash(space_a);
+	CHECK(initial_hash == server->space_get_state_hash(space_b));
+
+	for (int i = 0; i < 180; i++) {
+		server->step(1.0 / 60.0);
+		const uint64_t hash_a = server->space_get_state_hash(space_a);
+		const uint64_t hash_b = server->space_get_state_hash(space_b);
+		if (hash_a != hash_b) {
+			FAIL_CHECK(vformat("The spaces diverged at step %d.", i + 1));
+			break;
+		}
+	}
+
+	CHECK(server->space_get_state_hash(space_a) != initial_hash);
+
+	for (const RID &body : bodies_a) {
+		server->free(body);
+	}
+	for (const RID &body : bodies_b) {
+		server->free(body);
+	}
+	for (const RID &spacer : spacers) {
+		server->free(spacer);
+	}
+	server->free(space_a);
+	server->free(space_b);
+	server->free(circle_shape);
+	server->free(box_shape);
+	server->free(floor_shape);
+
+	server->finish();
+	memdelete(server);
+
+	ProjectSettings::get_singleton()->set_setting("physics/2d/deterministic", previous_deterministic);
+}
+
+} // namespace TestGodotPhysicsServer2D
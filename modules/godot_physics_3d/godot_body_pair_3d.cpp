@@ -33,9 +33,6 @@
 #include "godot_collision_solver_3d.h"
 #include "godot_space_3d.h"
 
-#define MIN_VELOCITY 0.0001
-#define MAX_BIAS_ROTATION (Math_PI / 8)
-
 void GodotBodyPair3D::_contact_added_callback(const Vector3 &p_point_A, int p_index_A, const Vector3 &p_point_B, int p_index_B, const Vector3 &normal, void *p_userdata) {
 	GodotBodyPair3D *pair = static_cast<GodotBodyPair3D *>(p_userdata);
 	pair->contact_added_callback(p_point_A, p_index_A, p_point_B, p_index_B, normal);
@@ -159,95 +156,70 @@ void GodotBodyPair3D::validate_contacts() {
 	}
 }
 
-// `_test_ccd` prevents tunneling by slowing down a high velocity body that is about to collide so
-// that next frame it will be at an appropriate location to collide (i.e. slight overlap).
-// WARNING: The way velocity is adjusted down to cause a collision means the momentum will be
-// weaker than it should for a bounce!
-// Process: Only proceed if body A's motion is high relative to its size.
-// Cast forward along motion vector to see if A is going to enter/pass B's collider next frame, only proceed if it does.
-// Adjust the velocity of A down so that it will just slightly intersect the collider instead of blowing right past it.
-bool GodotBodyPair3D::_test_ccd(real_t p_step, GodotBody3D *p_A, int p_shape_A, const Transform3D &p_xform_A, GodotBody3D *p_B, int p_shape_B, const Transform3D &p_xform_B) {
-	GodotShape3D *shape_A_ptr = p_A->get_shape(p_shape_A);
-
-	Vector3 motion = p_A->get_linear_velocity() * p_step;
-	real_t mlen = motion.length();
-	if (mlen < CMP_EPSILON) {
-		return false;
+GodotCollisionSolver3D::Sweep GodotBodyPair3D::_get_ccd_sweep(const GodotBody3D *p_body, int p_shape, real_t p_step) const {
+	GodotCollisionSolver3D::Sweep sweep;
+	sweep.transform = p_body->get_transform() * p_body->get_shape_transform(p_shape);
+	sweep.center = p_body->get_transform().origin + p_body->get_center_of_mass();
+
+	// Static bodies stay in place. Kinematic bodies are swept with the velocities of their latest motion,
+	// so fast bodies don't tunnel through moving platforms and doors.
+	if (p_body->get_mode() >= PhysicsServer3D::BODY_MODE_KINEMATIC) {
+		sweep.linear_motion = p_body->get_linear_velocity() * p_step;
+		sweep.angular_motion = p_body->get_angular_velocity() * p_step;
 	}
 
-	Vector3 mnormal = motion / mlen;
+	const AABB aabb = sweep.transform.xform(p_body->get_shape(p_shape)->get_aabb());
+	sweep.radius = (aabb.get_center() - sweep.center).length() + aabb.size.length() * 0.5;
 
-	real_t min = 0.0, max = 0.0;
-	shape_A_ptr->project_range(mnormal, p_xform_A, min, max);
+	return sweep;
+}
 
-	// Did it move enough in this direction to even attempt raycast?
-	// Let's say it should move more than 1/3 the size of the object in that axis.
-	bool fast_object = mlen > (max - min) * 0.3;
-	if (!fast_object) {
-		return false; // moving slow enough that there's no chance of tunneling.
-	}
+void GodotBodyPair3D::solve_ccd(real_t p_step) {
+	ccd_hit = false;
 
-	// A is moving fast enough that tunneling might occur. See if it's really about to collide.
-
-	// Roughly predict body B's position in the next frame (ignoring collisions).
-	Transform3D predicted_xform_B = p_xform_B.translated(p_B->get_linear_velocity() * p_step);
-
-	// Support points are the farthest forward points on A in the direction of the motion vector.
-	// i.e. the candidate points of which one should hit B first if any collision does occur.
-	static const int max_supports = 16;
-	Vector3 supports_A[max_supports];
-	int support_count_A;
-	GodotShape3D::FeatureType support_type_A;
-	// Convert mnormal into body A's local xform because get_supports requires (and returns) local coordinates.
-	shape_A_ptr->get_supports(p_xform_A.basis.xform_inv(mnormal).normalized(), max_supports, supports_A, support_count_A, support_type_A);
-
-	// Cast a segment from each support point of A in the motion direction.
-	int segment_support_idx = -1;
-	float segment_hit_length = FLT_MAX;
-	Vector3 segment_hit_local;
-	for (int i = 0; i < support_count_A; i++) {
-		supports_A[i] = p_xform_A.xform(supports_A[i]);
-
-		Vector3 from = supports_A[i];
-		Vector3 to = from + motion;
-
-		Transform3D from_inv = predicted_xform_B.affine_inverse();
-
-		// Back up 10% of the per-frame motion behind the support point and use that as the beginning of our cast.
-		// At high speeds, this may mean we're actually casting from well behind the body instead of inside it, which is odd.
-		// But it still works out.
-		Vector3 local_from = from_inv.xform(from - motion * 0.1);
-		Vector3 local_to = from_inv.xform(to);
-
-		Vector3 rpos, rnorm;
-		int fi = -1;
-		if (p_B->get_shape(p_shape_B)->intersect_segment(local_from, local_to, rpos, rnorm, fi, true)) {
-			float hit_length = local_from.distance_to(rpos);
-			if (hit_length < segment_hit_length) {
-				segment_support_idx = i;
-				segment_hit_length = hit_length;
-				segment_hit_local = rpos;
-			}
-		}
+	const GodotCollisionSolver3D::Sweep sweep_A = _get_ccd_sweep(A, shape_A, p_step);
+	const GodotCollisionSolver3D::Sweep sweep_B = _get_ccd_sweep(B, shape_B, p_step);
+
+	const real_t tolerance = space->get_contact_max_allowed_penetration() * 0.5;
+
+	real_t fraction = 0.0;
+	if (!GodotCollisionSolver3D::solve_time_of_impact(A->get_shape(shape_A), sweep_A, B->get_shape(shape_B), sweep_B, tolerance, fraction, ccd_normal)) {
+		return;
 	}
 
-	if (segment_support_idx == -1) {
-		// There was no hit. Since the segment is the length of per-frame motion, this means the bodies will not
-		// actually collide yet on next frame. We'll probably check again next frame once they're closer.
-		return false;
+	// How much the bodies can close in along the normal before they touch. Other pairs may slow the bodies
+	// down before `apply_ccd()` is called, so this is what's stored rather than the fraction.
+	ccd_gap = MAX(0.0, (sweep_A.linear_motion - sweep_B.linear_motion).dot(ccd_normal) * fraction);
+	ccd_hit = true;
+}
+
+// Only the velocity along the normal is reduced, and only by what it takes for the bodies to end the step
+// overlapping by about the allowed penetration, so that contacts pick the collision up on the next step.
+// Grazing bodies keep their tangential motion.
+// WARNING: The way velocity is adjusted down to cause a collision means the momentum will be
+// weaker than it should for a bounce!
+void GodotBodyPair3D::apply_ccd(real_t p_step) {
+	if (!ccd_hit) {
+		return;
 	}
 
-	Vector3 hitpos = predicted_xform_B.xform(segment_hit_local);
+	const real_t allowed_penetration = space->get_contact_max_allowed_penetration();
+	const real_t depth = (A->get_linear_velocity() - B->get_linear_velocity()).dot(ccd_normal) * p_step - ccd_gap;
+	if (depth <= allowed_penetration) {
+		return;
+	}
 
-	real_t newlen = hitpos.distance_to(supports_A[segment_support_idx]);
-	// Adding 1% of body length to the distance between collision and support point
-	// should cause body A's support point to arrive just within B's collider next frame.
-	newlen += (max - min) * 0.01;
-	// FIXME: This doesn't always work well when colliding with a triangle face of a trimesh shape.
+	const bool clip_A = collide_A && A->is_continuous_collision_detection_enabled();
+	const bool clip_B = collide_B && B->is_continuous_collision_detection_enabled();
+	const real_t velocity_change = (depth - allowed_penetration) / p_step / ((clip_A && clip_B) ? 2.0 : 1.0);
 
-	p_A->set_linear_velocity((mnormal * newlen) / p_step);
+	if (clip_A) {
+		A->set_linear_velocity(A->get_linear_velocity() - ccd_normal * velocity_change);
+	}
 
-	return true;
+	if (clip_B) {
+		B->set_linear_velocity(B->get_linear_velocity() + ccd_normal * velocity_change);
+	}
 }
 
 real_t combine_bounce(GodotBody3D *A, GodotBody3D *B) {
@@ -315,24 +287,6 @@ bool GodotBodyPair3D::setup(real_t p_step) {
 
 bool GodotBodyPair3D::pre_solve(real_t p_step) {
 	if (!collided) {
-		if (check_ccd) {
-			const Vector3 &offset_A = A->get_transform().get_origin();
-			Transform3D xform_Au = Transform3D(A->get_transform().basis, Vector3());
-			Transform3D xform_A = xform_Au * A->get_shape_transform(shape_A);
-
-			Transform3D xform_Bu = B->get_transform();
-			xform_Bu.origin -= offset_A;
-			Transform3D xform_B = xform_Bu * B->get_shape_transform(shape_B);
-
-			if (A->is_continuous_collision_detection_enabled() && collide_A) {
-				_test_ccd(p_step, A, shape_A, xform_A, B, shape_B, xform_B);
-			}
-
-			if (B->is_continuous_collision_detection_enabled() && collide_B) {
-				_test_ccd(p_step, B, shape_B, xform_B, A, shape_A, xform_A);
-			}
-		}
-
 		return false;
 	}
 
@@ -595,6 +549,36 @@ void GodotBodyPair3D::solve(real_t p_step) {
 	}
 }
 
+void GodotBodyPair3D::save_snapshot_state(SnapshotState &r_state) const {
+	r_state.body_A = A->get_self().get_id();
+	r_state.body_B = B->get_self().get_id();
+	r_state.shape_A = shape_A;
+	r_state.shape_B = shape_B;
+	r_state.sep_axis = sep_axis;
+	r_state.contact_count = contact_count;
+	r_state.collided = collided;
+	for (int i = 0; i < contact_count; i++) {
+		r_state.contacts[i] = contacts[i];
+	}
+}
+
+void GodotBodyPair3D::restore_snapshot_state(const SnapshotState &p_state) {
+	ERR_FAIL_INDEX(p_state.contact_count, MAX_CONTACTS + 1);
+
+	sep_axis = p_state.sep_axis;
+	contact_count = p_state.contact_count;
+	collided = p_state.collided;
+	for (int i = 0; i < contact_count; i++) {
+		contacts[i] = p_state.contacts[i];
+	}
+}
+
+void GodotBodyPair3D::clear_snapshot_state() {
+	sep_axis = Vector3();
+	contact_count = 0;
+	collided = false;
+}
+
 GodotBodyPair3D::GodotBodyPair3D(GodotBody3D *p_A, int p_shape_A, GodotBody3D *p_B, int p_shape_B) :
 		GodotBodyContact3D(_arr, 2) {
 	A = p_A;
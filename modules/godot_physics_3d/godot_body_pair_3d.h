@@ -31,13 +31,19 @@
 #pragma once
 
 #include "godot_body_3d.h"
+#include "godot_collision_solver_3d.h"
 #include "godot_constraint_3d.h"
 #include "godot_soft_body_3d.h"
 
 #include "core/templates/local_vector.h"
 
 class GodotBodyContact3D : public GodotConstraint3D {
+	friend class GodotContactSolver3D;
+
 protected:
+	static constexpr real_t MIN_VELOCITY = 0.0001;
+	static constexpr real_t MAX_BIAS_ROTATION = Math_PI / 8;
+
 	struct Contact {
 		Vector3 position;
 		Vector3 normal;
@@ -70,6 +76,8 @@ protected:
 };
 
 class GodotBodyPair3D : public GodotBodyContact3D {
+	friend class GodotContactSolver3D;
+
 	enum {
 		MAX_CONTACTS = 4
 	};
@@ -96,18 +104,53 @@ class GodotBodyPair3D : public GodotBodyContact3D {
 	Contact contacts[MAX_CONTACTS];
 	int contact_count = 0;
 
+	// Result of continuous collision detection, see `solve_ccd()`.
+	bool ccd_hit = false;
+	real_t ccd_gap = 0.0;
+	Vector3 ccd_normal;
+
 	static void _contact_added_callback(const Vector3 &p_point_A, int p_index_A, const Vector3 &p_point_B, int p_index_B, const Vector3 &normal, void *p_userdata);
 
 	void contact_added_callback(const Vector3 &p_point_A, int p_index_A, const Vector3 &p_point_B, int p_index_B, const Vector3 &normal);
 
 	void validate_contacts();
-	bool _test_ccd(real_t p_step, GodotBody3D *p_A, int p_shape_A, const Transform3D &p_xform_A, GodotBody3D *p_B, int p_shape_B, const Transform3D &p_xform_B);
+	GodotCollisionSolver3D::Sweep _get_ccd_sweep(const GodotBody3D *p_body, int p_shape, real_t p_step) const;
 
 public:
 	virtual bool setup(real_t p_step) override;
 	virtual bool pre_solve(real_t p_step) override;
 	virtual void solve(real_t p_step) override;
 
+	virtual GodotBodyPair3D *as_body_pair() override { return this; }
+
+	// Set by `setup()` when the bodies don't touch yet, but at least one of them uses continuous collision detection.
+	_FORCE_INLINE_ bool is_ccd_pending() const { return check_ccd; }
+	// Finds when the bodies would hit each other during the step. Only reads the bodies, safe to call from any thread.
+	void solve_ccd(real_t p_step);
+	// Slows the bodies down so that they end the step slightly overlapping instead of passing through each other.
+	void apply_ccd(real_t p_step);
+
+	// Contact cache (warm starting) carried between steps, copied as-is by space snapshots.
+	struct SnapshotState {
+		uint64_t body_A = 0;
+		uint64_t body_B = 0;
+		int shape_A = 0;
+		int shape_B = 0;
+		Vector3 sep_axis;
+		int contact_count = 0;
+		bool collided = false;
+		Contact contacts[MAX_CONTACTS];
+	};
+
+	_FORCE_INLINE_ GodotBody3D *get_body_A() const { return A; }
+	_FORCE_INLINE_ bool matches_snapshot_state(const SnapshotState &p_state) const {
+		return A->get_self().get_id() == p_state.body_A && B->get_self().get_id() == p_state.body_B && shape_A == p_state.shape_A && shape_B == p_state.shape_B;
+	}
+
+	void save_snapshot_state(SnapshotState &r_state) const;
+	void restore_snapshot_state(const SnapshotState &p_state);
+	void clear_snapshot_state();
+
 	GodotBodyPair3D(GodotBody3D *p_A, int p_shape_A, GodotBody3D *p_B, int p_shape_B);
 	~GodotBodyPair3D();
 };
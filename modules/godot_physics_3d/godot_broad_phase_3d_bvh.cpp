@@ -32,10 +32,14 @@
 
 #include "godot_collision_object_3d.h"
 
+uint32_t GodotBroadPhase3DBVH::_get_tree_collision_mask(uint32_t p_tree_id) {
+	// Sleeping bodies pair with the same objects as awake ones, so that resting contacts survive falling asleep.
+	return p_tree_id == TREE_STATIC ? (TREE_FLAG_DYNAMIC | TREE_FLAG_SLEEPING) : (TREE_FLAG_STATIC | TREE_FLAG_DYNAMIC | TREE_FLAG_SLEEPING);
+}
+
 GodotBroadPhase3DBVH::ID GodotBroadPhase3DBVH::create(GodotCollisionObject3D *p_object, int p_subindex, const AABB &p_aabb, bool p_static) {
 	uint32_t tree_id = p_static ? TREE_STATIC : TREE_DYNAMIC;
-	uint32_t tree_collision_mask = p_static ? TREE_FLAG_DYNAMIC : (TREE_FLAG_STATIC | TREE_FLAG_DYNAMIC);
-	ID oid = bvh.create(p_object, true, tree_id, tree_collision_mask, p_aabb, p_subindex); // Pair everything, don't care?
+	ID oid = bvh.create(p_object, true, tree_id, _get_tree_collision_mask(tree_id), p_aabb, p_subindex); // Pair everything, don't care?
 	return oid + 1;
 }
 
@@ -47,13 +51,25 @@ void GodotBroadPhase3DBVH::move(ID p_id, const AABB &p_aabb) {
 void GodotBroadPhase3DBVH::set_static(ID p_id, bool p_static) {
 	ERR_FAIL_COND(!p_id);
 	uint32_t tree_id = p_static ? TREE_STATIC : TREE_DYNAMIC;
-	uint32_t tree_collision_mask = p_static ? TREE_FLAG_DYNAMIC : (TREE_FLAG_STATIC | TREE_FLAG_DYNAMIC);
-	bvh.set_tree(p_id - 1, tree_id, tree_collision_mask, false);
+	bvh.set_tree(p_id - 1, tree_id, _get_tree_collision_mask(tree_id), false);
+}
+
+void GodotBroadPhase3DBVH::set_sleeping(ID p_id, bool p_sleeping) {
+	ERR_FAIL_COND(!p_id);
+	pending_sleep.push_back({ p_id, p_sleeping });
 }
 
 void GodotBroadPhase3DBVH::remove(ID p_id) {
 	ERR_FAIL_COND(!p_id);
 	bvh.erase(p_id - 1);
+
+	// The ID may be reused before the next update.
+	for (uint32_t i = 0; i < pending_sleep.size(); i++) {
+		if (pending_sleep[i].id == p_id) {
+			pending_sleep.remove_at(i);
+			i--;
+		}
+	}
 }
 
 GodotCollisionObject3D *GodotBroadPhase3DBVH::get_object(ID p_id) const {
@@ -116,6 +132,21 @@ void GodotBroadPhase3DBVH::set_unpair_callback(UnpairCallback p_unpair_callback,
 
 void GodotBroadPhase3DBVH::update() {
 	bvh.update();
+
+	// Applied in order, so that the last change made to an object wins.
+	for (const PendingSleep &pending : pending_sleep) {
+		uint32_t tree_id = bvh.get_tree_id(pending.id - 1);
+		if (tree_id == TREE_STATIC) {
+			// Static objects stay in the static tree.
+			continue;
+		}
+
+		uint32_t new_tree_id = pending.sleeping ? TREE_SLEEPING : TREE_DYNAMIC;
+		if (new_tree_id != tree_id) {
+			bvh.set_tree(pending.id - 1, new_tree_id, _get_tree_collision_mask(new_tree_id), false);
+		}
+	}
+	pending_sleep.clear();
 }
 
 GodotBroadPhase3D *GodotBroadPhase3DBVH::_create() {
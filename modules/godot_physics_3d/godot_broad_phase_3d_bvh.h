@@ -33,6 +33,7 @@
 #include "godot_broad_phase_3d.h"
 
 #include "core/math/bvh.h"
+#include "core/templates/local_vector.h"
 
 class GodotBroadPhase3DBVH : public GodotBroadPhase3D {
 	template <typename T>
@@ -52,17 +53,32 @@ class GodotBroadPhase3DBVH : public GodotBroadPhase3D {
 		}
 	};
 
+	// Sleeping bodies get their own tree, so that the dynamic tree only holds what actually moves and is the
+	// only one that needs refitting every step. Static and sleeping objects don't move, so they never trigger
+	// pair checks themselves, they're only found by the checks of moving objects.
 	enum Tree {
 		TREE_STATIC = 0,
 		TREE_DYNAMIC = 1,
+		TREE_SLEEPING = 2,
 	};
 
 	enum TreeFlag {
 		TREE_FLAG_STATIC = 1 << TREE_STATIC,
 		TREE_FLAG_DYNAMIC = 1 << TREE_DYNAMIC,
+		TREE_FLAG_SLEEPING = 1 << TREE_SLEEPING,
 	};
 
-	BVH_Manager<GodotCollisionObject3D, 2, true, 128, UserPairTestFunction<GodotCollisionObject3D>, UserCullTestFunction<GodotCollisionObject3D>> bvh;
+	BVH_Manager<GodotCollisionObject3D, 3, true, 128, UserPairTestFunction<GodotCollisionObject3D>, UserCullTestFunction<GodotCollisionObject3D>> bvh;
+
+	// Bodies fall asleep and wake up in the middle of stepping, including from pair callbacks, so moving them
+	// between trees is deferred to `update()`.
+	struct PendingSleep {
+		ID id = 0;
+		bool sleeping = false;
+	};
+	LocalVector<PendingSleep> pending_sleep;
+
+	static uint32_t _get_tree_collision_mask(uint32_t p_tree_id);
 
 	static void *_pair_callback(void *, uint32_t, GodotCollisionObject3D *, int, uint32_t, GodotCollisionObject3D *, int);
 	static void _unpair_callback(void *, uint32_t, GodotCollisionObject3D *, int, uint32_t, GodotCollisionObject3D *, int, void *);
@@ -77,6 +93,7 @@ public:
 	virtual ID create(GodotCollisionObject3D *p_object, int p_subindex = 0, const AABB &p_aabb = AABB(), bool p_static = false) override;
 	virtual void move(ID p_id, const AABB &p_aabb) override;
 	virtual void set_static(ID p_id, bool p_static) override;
+	virtual void set_sleeping(ID p_id, bool p_sleeping) override;
 	virtual void remove(ID p_id) override;
 
 	virtual GodotCollisionObject3D *get_object(ID p_id) const override;
@@ -587,3 +587,177 @@ bool GodotCollisionSolver3D::solve_distance(const GodotShape3D *p_shape_A, const
 		return gjk_epa_calculate_distance(p_shape_A, p_transform_A, p_shape_B, p_transform_B, r_point_A, r_point_B); //should pass sepaxis..
 	}
 }
+
+Transform3D GodotCollisionSolver3D::Sweep::get_transform(real_t p_fraction) const {
+	Transform3D xform = transform;
+
+	const real_t angle = angular_motion.length() * p_fraction;
+	if (!Math::is_zero_approx(angle)) {
+		// Same as the integration of GodotBody3D, which rotates around the center of mass.
+		const Basis rot(angular_motion.normalized(), angle);
+		xform.basis = rot * xform.basis;
+		xform.origin = center + rot.xform(xform.origin - center);
+	}
+
+	xform.origin += linear_motion * p_fraction;
+	return xform;
+}
+
+AABB GodotCollisionSolver3D::Sweep::get_swept_aabb(const AABB &p_local_aabb) const {
+	AABB aabb = transform.xform(p_local_aabb);
+	aabb.merge_with(AABB(aabb.position + linear_motion, aabb.size));
+
+	// While rotating by an angle, a point at distance r from the center moves by at most r * angle.
+	const real_t angle = angular_motion.length();
+	if (!Math::is_zero_approx(angle)) {
+		aabb.grow_by(radius * MIN(angle, (real_t)2.0));
+	}
+
+	return aabb;
+}
+
+// Conservative advancement: repeatedly measure the distance between the shapes and advance by the largest
+// fraction of the sweeps that can't make them touch, given an upper bound of how fast that distance can shrink.
+// Unlike casting rays from a few points, this can't step over thin geometry.
+bool GodotCollisionSolver3D::solve_conservative_advancement(const GodotShape3D *p_shape_A, const Sweep &p_sweep_A, const GodotShape3D *p_shape_B, const Sweep &p_sweep_B, real_t p_tolerance, real_t p_max_fraction, real_t &r_fraction, Vector3 &r_normal) {
+	static const int max_iterations = 32;
+
+	const Vector3 relative_motion = p_sweep_A.linear_motion - p_sweep_B.linear_motion;
+	const real_t angular_bound = p_sweep_A.angular_motion.length() * p_sweep_A.radius + p_sweep_B.angular_motion.length() * p_sweep_B.radius;
+	const bool world_boundary_B = p_shape_B->get_type() == PhysicsServer3D::SHAPE_WORLD_BOUNDARY;
+
+	real_t fraction = 0.0;
+	Vector3 normal;
+
+	for (int i = 0; i < max_iterations; i++) {
+		const Transform3D transform_A = p_sweep_A.get_transform(fraction);
+		const Transform3D transform_B = p_sweep_B.get_transform(fraction);
+
+		Vector3 point_A, point_B;
+		bool separated = false;
+		if (world_boundary_B) {
+			separated = !solve_distance_world_boundary(p_shape_B, transform_B, p_shape_A, transform_A, point_B, point_A);
+		} else {
+			separated = gjk_epa_calculate_distance(p_shape_A, transform_A, p_shape_B, transform_B, point_A, point_B);
+		}
+
+		if (!separated) {
+			if (i == 0) {
+				// Overlapping from the start, regular contacts take care of this.
+				return false;
+			}
+
+			// Only happens through rounding errors, the previous iteration was close enough.
+			break;
+		}
+
+		const Vector3 delta = point_B - point_A;
+		const real_t distance = delta.length();
+		if (distance <= p_tolerance) {
+			if (i == 0) {
+				return false;
+			}
+			if (distance > CMP_EPSILON) {
+				normal = delta / distance;
+			}
+			break;
+		}
+
+		normal = delta / distance;
+
+		const real_t approach = relative_motion.dot(normal) + angular_bound;
+		if (approach <= CMP_EPSILON) {
+			// Moving apart.
+			return false;
+		}
+
+		// Aim for the middle of the tolerance, so that the next iteration doesn't have to take a tiny step.
+		fraction += (distance - p_tolerance * 0.5) / approach;
+		if (fraction > p_max_fraction) {
+			return false;
+		}
+	}
+
+	// Running out of iterations (which can happen with fast rotations) leaves us short of the actual impact,
+	// which errs on the safe side.
+	r_fraction = fraction;
+	r_normal = normal;
+	return true;
+}
+
+struct _ConcaveTimeOfImpactInfo {
+	const GodotShape3D *shape_A = nullptr;
+	const GodotCollisionSolver3D::Sweep *sweep_A = nullptr;
+	const GodotCollisionSolver3D::Sweep *sweep_B = nullptr;
+	real_t tolerance = 0.0;
+	real_t fraction = 1.0;
+	Vector3 normal;
+	bool hit = false;
+};
+
+bool GodotCollisionSolver3D::concave_time_of_impact_callback(void *p_userdata, GodotShape3D *p_convex) {
+	_ConcaveTimeOfImpactInfo &info = *(static_cast<_ConcaveTimeOfImpactInfo *>(p_userdata));
+
+	real_t fraction = 0.0;
+	Vector3 normal;
+	if (solve_conservative_advancement(info.shape_A, *info.sweep_A, p_convex, *info.sweep_B, info.tolerance, info.fraction, fraction, normal)) {
+		info.fraction = fraction;
+		info.normal = normal;
+		info.hit = true;
+	}
+
+	return false;
+}
+
+bool GodotCollisionSolver3D::solve_time_of_impact(const GodotShape3D *p_shape_A, const Sweep &p_sweep_A, const GodotShape3D *p_shape_B, const Sweep &p_sweep_B, real_t p_tolerance, real_t &r_fraction, Vector3 &r_normal) {
+	PhysicsServer3D::ShapeType type_A = p_shape_A->get_type();
+	PhysicsServer3D::ShapeType type_B = p_shape_B->get_type();
+
+	if (type_A == PhysicsServer3D::SHAPE_SEPARATION_RAY || type_B == PhysicsServer3D::SHAPE_SEPARATION_RAY || type_A == PhysicsServer3D::SHAPE_SOFT_BODY || type_B == PhysicsServer3D::SHAPE_SOFT_BODY) {
+		return false;
+	}
+
+	// Keep the concave or unbounded shape as B.
+	bool non_convex_A = p_shape_A->is_concave() || type_A == PhysicsServer3D::SHAPE_WORLD_BOUNDARY;
+	bool non_convex_B = p_shape_B->is_concave() || type_B == PhysicsServer3D::SHAPE_WORLD_BOUNDARY;
+	if (non_convex_A) {
+		if (non_convex_B) {
+			return false;
+		}
+
+		if (solve_time_of_impact(p_shape_B, p_sweep_B, p_shape_A, p_sweep_A, p_tolerance, r_fraction, r_normal)) {
+			r_normal = -r_normal;
+			return true;
+		}
+		return false;
+	}
+
+	if (!p_shape_B->is_concave()) {
+		return solve_conservative_advancement(p_shape_A, p_sweep_A, p_shape_B, p_sweep_B, p_tolerance, 1.0, r_fraction, r_normal);
+	}
+
+	const GodotConcaveShape3D *concave_B = static_cast<const GodotConcaveShape3D *>(p_shape_B);
+
+	// Only the faces that the swept shape A can reach.
+	const AABB swept_aabb = p_sweep_A.get_swept_aabb(p_shape_A->get_aabb()).grow(p_tolerance);
+	AABB local_aabb = p_sweep_B.transform.affine_inverse().xform(swept_aabb);
+	if (!p_sweep_B.linear_motion.is_zero_approx() || !p_sweep_B.angular_motion.is_zero_approx()) {
+		local_aabb.merge_with(p_sweep_B.get_transform(1.0).affine_inverse().xform(swept_aabb));
+	}
+
+	_ConcaveTimeOfImpactInfo info;
+	info.shape_A = p_shape_A;
+	info.sweep_A = &p_sweep_A;
+	info.sweep_B = &p_sweep_B;
+	info.tolerance = p_tolerance;
+
+	concave_B->cull(local_aabb, concave_time_of_impact_callback, &info, false);
+
+	if (!info.hit) {
+		return false;
+	}
+
+	r_fraction = info.fraction;
+	r_normal = info.normal;
+	return true;
+}
@@ -36,6 +36,18 @@ class GodotCollisionSolver3D {
 public:
 	typedef void (*CallbackResult)(const Vector3 &p_point_A, int p_index_A, const Vector3 &p_point_B, int p_index_B, const Vector3 &normal, void *p_userdata);
 
+	// Motion of a shape over a step, for time of impact queries.
+	struct Sweep {
+		Transform3D transform; // Shape transform at the start of the step.
+		Vector3 center; // Point the shape rotates around (the body's center of mass).
+		Vector3 linear_motion;
+		Vector3 angular_motion; // Rotation axis scaled by the angle.
+		real_t radius = 0.0; // Upper bound of the distance between `center` and any point of the shape.
+
+		Transform3D get_transform(real_t p_fraction) const;
+		AABB get_swept_aabb(const AABB &p_local_aabb) const;
+	};
+
 private:
 	static bool soft_body_query_callback(uint32_t p_node_index, void *p_userdata);
 	static void soft_body_contact_callback(const Vector3 &p_point_A, int p_index_A, const Vector3 &p_point_B, int p_index_B, const Vector3 &normal, void *p_userdata);
@@ -47,8 +59,13 @@ private:
 	static bool solve_concave(const GodotShape3D *p_shape_A, const Transform3D &p_transform_A, const GodotShape3D *p_shape_B, const Transform3D &p_transform_B, CallbackResult p_result_callback, void *p_userdata, bool p_swap_result, real_t p_margin_A = 0, real_t p_margin_B = 0);
 	static bool concave_distance_callback(void *p_userdata, GodotShape3D *p_convex);
 	static bool solve_distance_world_boundary(const GodotShape3D *p_shape_A, const Transform3D &p_transform_A, const GodotShape3D *p_shape_B, const Transform3D &p_transform_B, Vector3 &r_point_A, Vector3 &r_point_B);
+	static bool concave_time_of_impact_callback(void *p_userdata, GodotShape3D *p_convex);
+	static bool solve_conservative_advancement(const GodotShape3D *p_shape_A, const Sweep &p_sweep_A, const GodotShape3D *p_shape_B, const Sweep &p_sweep_B, real_t p_tolerance, real_t p_max_fraction, real_t &r_fraction, Vector3 &r_normal);
 
 public:
 	static bool solve_static(const GodotShape3D *p_shape_A, const Transform3D &p_transform_A, const GodotShape3D *p_shape_B, const Transform3D &p_transform_B, CallbackResult p_result_callback, void *p_userdata, Vector3 *r_sep_axis = nullptr, real_t p_margin_A = 0, real_t p_margin_B = 0);
 	static bool solve_distance(const GodotShape3D *p_shape_A, const Transform3D &p_transform_A, const GodotShape3D *p_shape_B, const Transform3D &p_transform_B, Vector3 &r_point_A, Vector3 &r_point_B, const AABB &p_concave_hint, Vector3 *r_sep_axis = nullptr);
+	// Finds the fraction of the sweeps at which the shapes first come within `p_tolerance` of each other,
+	// and the normal pointing from A to B at that point. Returns false if they don't, or already overlap.
+	static bool solve_time_of_impact(const GodotShape3D *p_shape_A, const Sweep &p_sweep_A, const GodotShape3D *p_shape_B, const Sweep &p_sweep_B, real_t p_tolerance, real_t &r_fraction, Vector3 &r_normal);
 };
@@ -0,0 +1,553 @@
+/**************************************************************************/
+/*  godot_contact_solver_3d.cpp                                           */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#include "godot_contact_solver_3d.h"
+
+#include "godot_body_pair_3d.h"
+
+#if !defined(REAL_T_IS_DOUBLE) && (defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2))
+#define CONTACT_SOLVER_SSE2
+#include <emmintrin.h>
+#elif !defined(REAL_T_IS_DOUBLE) && defined(__aarch64__) && defined(__ARM_NEON)
+#define CONTACT_SOLVER_NEON
+#include <arm_neon.h>
+#endif
+
+namespace {
+
+constexpr uint32_t LANE_COUNT = 4;
+
+// Minimal 4-wide float abstraction, only what the contact solver needs.
+
+#if defined(CONTACT_SOLVER_SSE2)
+
+struct Mask4 {
+	__m128 v;
+
+	_FORCE_INLINE_ Mask4 operator&(const Mask4 &p_other) const { return { _mm_and_ps(v, p_other.v) }; }
+	_FORCE_INLINE_ Mask4 operator|(const Mask4 &p_other) const { return { _mm_or_ps(v, p_other.v) }; }
+	_FORCE_INLINE_ bool any() const { return _mm_movemask_ps(v) != 0; }
+	_FORCE_INLINE_ bool get(uint32_t p_lane) const { return (_mm_movemask_ps(v) >> p_lane) & 1; }
+
+	static _FORCE_INLINE_ Mask4 from_bools(const bool *p_values) {
+		return { _mm_castsi128_ps(_mm_set_epi32(-int(p_values[3]), -int(p_values[2]), -int(p_values[1]), -int(p_values[0]))) };
+	}
+};
+
+struct Real4 {
+	__m128 v;
+
+	Real4() = default;
+	_FORCE_INLINE_ Real4(__m128 p_v) :
+			v(p_v) {}
+	_FORCE_INLINE_ Real4(real_t p_value) :
+			v(_mm_set1_ps(p_value)) {}
+
+	static _FORCE_INLINE_ Real4 load(const real_t *p_values) { return _mm_loadu_ps(p_values); }
+	_FORCE_INLINE_ void store(real_t *r_values) const { _mm_storeu_ps(r_values, v); }
+
+	_FORCE_INLINE_ Real4 operator+(const Real4 &p_other) const { return _mm_add_ps(v, p_other.v); }
+	_FORCE_INLINE_ Real4 operator-(const Real4 &p_other) const { return _mm_sub_ps(v, p_other.v); }
+	_FORCE_INLINE_ Real4 operator*(const Real4 &p_other) const { return _mm_mul_ps(v, p_other.v); }
+	_FORCE_INLINE_ Real4 operator/(const Real4 &p_other) const { return _mm_div_ps(v, p_other.v); }
+	_FORCE_INLINE_ Real4 operator-() const { return _mm_xor_ps(v, _mm_set1_ps(-0.0f)); }
+	_FORCE_INLINE_ Mask4 operator>(const Real4 &p_other) const { return { _mm_cmpgt_ps(v, p_other.v) }; }
+
+	static _FORCE_INLINE_ Real4 max(const Real4 &p_a, const Real4 &p_b) { return _mm_max_ps(p_a.v, p_b.v); }
+	static _FORCE_INLINE_ Real4 abs(const Real4 &p_a) { return _mm_andnot_ps(_mm_set1_ps(-0.0f), p_a.v); }
+	static _FORCE_INLINE_ Real4 sqrt(const Real4 &p_a) { return _mm_sqrt_ps(p_a.v); }
+	static _FORCE_INLINE_ Real4 select(const Mask4 &p_mask, const Real4 &p_a, const Real4 &p_b) {
+		return _mm_or_ps(_mm_and_ps(p_mask.v, p_a.v), _mm_andnot_ps(p_mask.v, p_b.v));
+	}
+};
+
+#elif defined(CONTACT_SOLVER_NEON)
+
+struct Mask4 {
+	uint32x4_t v;
+
+	_FORCE_INLINE_ Mask4 operator&(const Mask4 &p_other) const { return { vandq_u32(v, p_other.v) }; }
+	_FORCE_INLINE_ Mask4 operator|(const Mask4 &p_other) const { return { vorrq_u32(v, p_other.v) }; }
+	_FORCE_INLINE_ bool any() const { return vmaxvq_u32(v) != 0; }
+	_FORCE_INLINE_ bool get(uint32_t p_lane) const {
+		uint32_t values[LANE_COUNT];
+		vst1q_u32(values, v);
+		return values[p_lane] != 0;
+	}
+
+	static _FORCE_INLINE_ Mask4 from_bools(const bool *p_values) {
+		const uint32_t values[LANE_COUNT] = { p_values[0] ? UINT32_MAX : 0, p_values[1] ? UINT32_MAX : 0, p_values[2] ? UINT32_MAX : 0, p_values[3] ? UINT32_MAX : 0 };
+		return { vld1q_u32(values) };
+	}
+};
+
+struct Real4 {
+	float32x4_t v;
+
+	Real4() = default;
+	_FORCE_INLINE_ Real4(float32x4_t p_v) :
+			v(p_v) {}
+	_FORCE_INLINE_ Real4(real_t p_value) :
+			v(vdupq_n_f32(p_value)) {}
+
+	static _FORCE_INLINE_ Real4 load(const real_t *p_values) { return vld1q_f32(p_values); }
+	_FORCE_INLINE_ void store(real_t *r_values) const { vst1q_f32(r_values, v); }
+
+	_FORCE_INLINE_ Real4 operator+(const Real4 &p_other) const { return vaddq_f32(v, p_other.v); }
+	_FORCE_INLINE_ Real4 operator-(const Real4 &p_other) const { return vsubq_f32(v, p_other.v); }
+	_FORCE_INLINE_ Real4 operator*(const Real4 &p_other) const { return vmulq_f32(v, p_other.v); }
+	_FORCE_INLINE_ Real4 operator/(const Real4 &p_other) const { return vdivq_f32(v, p_other.v); }
+	_FORCE_INLINE_ Real4 operator-() const { return vnegq_f32(v); }
+	_FORCE_INLINE_ Mask4 operator>(const Real4 &p_other) const { return { vcgtq_f32(v, p_other.v) }; }
+
+	static _FORCE_INLINE_ Real4 max(const Real4 &p_a, const Real4 &p_b) { return vmaxnmq_f32(p_a.v, p_b.v); }
+	static _FORCE_INLINE_ Real4 abs(const Real4 &p_a) { return vabsq_f32(p_a.v); }
+	static _FORCE_INLINE_ Real4 sqrt(const Real4 &p_a) { return vsqrtq_f32(p_a.v); }
+	static _FORCE_INLINE_ Real4 select(const Mask4 &p_mask, const Real4 &p_a, const Real4 &p_b) { return vbslq_f32(p_mask.v, p_a.v, p_b.v); }
+};
+
+#else
+
+// Scalar fallback, also used with double precision. Simple enough for compilers to vectorize.
+struct Mask4 {
+	bool v[LANE_COUNT];
+
+	_FORCE_INLINE_ Mask4 operator&(const Mask4 &p_other) const { return { { v[0] && p_other.v[0], v[1] && p_other.v[1], v[2] && p_other.v[2], v[3] && p_other.v[3] } }; }
+	_FORCE_INLINE_ Mask4 operator|(const Mask4 &p_other) const { return { { v[0] || p_other.v[0], v[1] || p_other.v[1], v[2] || p_other.v[2], v[3] || p_other.v[3] } }; }
+	_FORCE_INLINE_ bool any() const { return v[0] || v[1] || v[2] || v[3]; }
+	_FORCE_INLINE_ bool get(uint32_t p_lane) const { return v[p_lane]; }
+
+	static _FORCE_INLINE_ Mask4 from_bools(const bool *p_values) { return { { p_values[0], p_values[1], p_values[2], p_values[3] } }; }
+};
+
+struct Real4 {
+	real_t v[LANE_COUNT];
+
+	Real4() = default;
+	_FORCE_INLINE_ Real4(real_t p_value) :
+			v{ p_value, p_value, p_value, p_value } {}
+
+	static _FORCE_INLINE_ Real4 load(const real_t *p_values) {
+		Real4 r;
+		for (uint32_t i = 0; i < LANE_COUNT; i++) {
+			r.v[i] = p_values[i];
+		}
+		return r;
+	}
+	_FORCE_INLINE_ void store(real_t *r_values) const {
+		for (uint32_t i = 0; i < LANE_COUNT; i++) {
+			r_values[i] = v[i];
+		}
+	}
+
+#define REAL4_BINARY_OP(m_op)                                        \
+	_FORCE_INLINE_ Real4 operator m_op(const Real4 &p_other) const { \
+		Real4 r;                                                     \
+		for (uint32_t i = 0; i < LANE_COUNT; i++) {                  \
+			r.v[i] = v[i] m_op p_other.v[i];                         \
+		}                                                            \
+		return r;                                                    \
+	}
+
+	REAL4_BINARY_OP(+)
+	REAL4_BINARY_OP(-)
+	REAL4_BINARY_OP(*)
+	REAL4_BINARY_OP(/)
+
+#undef REAL4_BINARY_OP
+
+	_FORCE_INLINE_ Real4 operator-() const { return Real4(0.0) - *this; }
+	_FORCE_INLINE_ Mask4 operator>(const Real4 &p_other) const { return { { v[0] > p_other.v[0], v[1] > p_other.v[1], v[2] > p_other.v[2], v[3] > p_other.v[3] } }; }
+
+	static _FORCE_INLINE_ Real4 max(const Real4 &p_a, const Real4 &p_b) {
+		Real4 r;
+		for (uint32_t i = 0; i < LANE_COUNT; i++) {
+			r.v[i] = MAX(p_a.v[i], p_b.v[i]);
+		}
+		return r;
+	}
+	static _FORCE_INLINE_ Real4 abs(const Real4 &p_a) {
+		Real4 r;
+		for (uint32_t i = 0; i < LANE_COUNT; i++) {
+			r.v[i] = Math::abs(p_a.v[i]);
+		}
+		return r;
+	}
+	static _FORCE_INLINE_ Real4 sqrt(const Real4 &p_a) {
+		Real4 r;
+		for (uint32_t i = 0; i < LANE_COUNT; i++) {
+			r.v[i] = Math::sqrt(p_a.v[i]);
+		}
+		return r;
+	}
+	static _FORCE_INLINE_ Real4 select(const Mask4 &p_mask, const Real4 &p_a, const Real4 &p_b) {
+		Real4 r;
+		for (uint32_t i = 0; i < LANE_COUNT; i++) {
+			r.v[i] = p_mask.v[i] ? p_a.v[i] : p_b.v[i];
+		}
+		return r;
+	}
+};
+
+#endif
+
+struct Vector3x4 {
+	Real4 x, y, z;
+
+	_FORCE_INLINE_ Vector3x4 operator+(const Vector3x4 &p_other) const { return { x + p_other.x, y + p_other.y, z + p_other.z }; }
+	_FORCE_INLINE_ Vector3x4 operator-(const Vector3x4 &p_other) const { return { x - p_other.x, y - p_other.y, z - p_other.z }; }
+	_FORCE_INLINE_ Vector3x4 operator*(const Real4 &p_scalar) const { return { x * p_scalar, y * p_scalar, z * p_scalar }; }
+	_FORCE_INLINE_ Vector3x4 operator/(const Real4 &p_scalar) const { return { x / p_scalar, y / p_scalar, z / p_scalar }; }
+	_FORCE_INLINE_ Vector3x4 operator-() const { return { -x, -y, -z }; }
+
+	_FORCE_INLINE_ Real4 dot(const Vector3x4 &p_other) const { return x * p_other.x + y * p_other.y + z * p_other.z; }
+	_FORCE_INLINE_ Vector3x4 cross(const Vector3x4 &p_other) const {
+		return { y * p_other.z - z * p_other.y, z * p_other.x - x * p_other.z, x * p_other.y - y * p_other.x };
+	}
+	_FORCE_INLINE_ Real4 length() const { return Real4::sqrt(dot(*this)); }
+
+	static _FORCE_INLINE_ Vector3x4 select(const Mask4 &p_mask, const Vector3x4 &p_a, const Vector3x4 &p_b) {
+		return { Real4::select(p_mask, p_a.x, p_b.x), Real4::select(p_mask, p_a.y, p_b.y), Real4::select(p_mask, p_a.z, p_b.z) };
+	}
+
+	static Vector3x4 gather(const Vector3 *p_values) {
+		real_t xs[LANE_COUNT], ys[LANE_COUNT], zs[LANE_COUNT];
+		for (uint32_t i = 0; i < LANE_COUNT; i++) {
+			xs[i] = p_values[i].x;
+			ys[i] = p_values[i].y;
+			zs[i] = p_values[i].z;
+		}
+		return { Real4::load(xs), Real4::load(ys), Real4::load(zs) };
+	}
+
+	void scatter(Vector3 *r_values) const {
+		real_t xs[LANE_COUNT], ys[LANE_COUNT], zs[LANE_COUNT];
+		x.store(xs);
+		y.store(ys);
+		z.store(zs);
+		for (uint32_t i = 0; i < LANE_COUNT; i++) {
+			r_values[i] = Vector3(xs[i], ys[i], zs[i]);
+		}
+	}
+};
+
+struct Basisx4 {
+	Vector3x4 rows[3];
+
+	_FORCE_INLINE_ Vector3x4 xform(const Vector3x4 &p_vector) const { return { rows[0].dot(p_vector), rows[1].dot(p_vector), rows[2].dot(p_vector) }; }
+};
+
+// Velocity state of the A or B bodies of a batch. Lanes of bodies the pair doesn't write to have
+// zero inverse mass and inertia, like in `GodotBodyPair3D::solve`.
+struct BodyLanes {
+	Vector3x4 linear_velocity;
+	Vector3x4 angular_velocity;
+	Vector3x4 biased_linear_velocity;
+	Vector3x4 biased_angular_velocity;
+	Vector3x4 center_of_mass;
+	Real4 inv_mass;
+	Basisx4 inv_inertia_tensor;
+
+	void gather(GodotBody3D *const *p_bodies, const bool *p_collides) {
+		Vector3 lv[LANE_COUNT], av[LANE_COUNT], blv[LANE_COUNT], bav[LANE_COUNT], com[LANE_COUNT];
+		Vector3 inertia_rows[3][LANE_COUNT];
+		real_t im[LANE_COUNT];
+
+		for (uint32_t i = 0; i < LANE_COUNT; i++) {
+			const GodotBody3D *body = p_bodies[i];
+			if (!body) {
+				im[i] = 0.0;
+				continue;
+			}
+			lv[i] = body->get_linear_velocity();
+			av[i] = body->get_angular_velocity();
+			blv[i] = body->get_biased_linear_velocity();
+			bav[i] = body->get_biased_angular_velocity();
+			com[i] = body->get_center_of_mass();
+			im[i] = p_collides[i] ? body->get_inv_mass() : 0.0;
+			if (p_collides[i]) {
+				const Basis &inv_inertia_tensor = body->get_inv_inertia_tensor();
+				for (int row = 0; row < 3; row++) {
+					inertia_rows[row][i] = inv_inertia_tensor.rows[row];
+				}
+			}
+		}
+
+		linear_velocity = Vector3x4::gather(lv);
+		angular_velocity = Vector3x4::gather(av);
+		biased_linear_velocity = Vector3x4::gather(blv);
+		biased_angular_velocity = Vector3x4::gather(bav);
+		center_of_mass = Vector3x4::gather(com);
+		inv_mass = Real4::load(im);
+		for (int row = 0; row < 3; row++) {
+			inv_inertia_tensor.rows[row] = Vector3x4::gather(inertia_rows[row]);
+		}
+	}
+
+	void scatter(GodotBody3D *const *p_bodies, const bool *p_collides) const {
+		Vector3 lv[LANE_COUNT], av[LANE_COUNT], blv[LANE_COUNT], bav[LANE_COUNT];
+		linear_velocity.scatter(lv);
+		angular_velocity.scatter(av);
+		biased_linear_velocity.scatter(blv);
+		biased_angular_velocity.scatter(bav);
+
+		for (uint32_t i = 0; i < LANE_COUNT; i++) {
+			GodotBody3D *body = p_bodies[i];
+			if (!body || !p_collides[i]) {
+				continue;
+			}
+			body->set_linear_velocity(lv[i]);
+			body->set_angular_velocity(av[i]);
+			body->set_biased_linear_velocity(blv[i]);
+			body->set_biased_angular_velocity(bav[i]);
+		}
+	}
+
+	_FORCE_INLINE_ void apply_impulse(const Vector3x4 &p_impulse, const Vector3x4 &p_position) {
+		linear_velocity = linear_velocity + p_impulse * inv_mass;
+		angular_velocity = angular_velocity + inv_inertia_tensor.xform((p_position - center_of_mass).cross(p_impulse));
+	}
+
+	_FORCE_INLINE_ void apply_bias_impulse(const Vector3x4 &p_impulse, const Vector3x4 &p_position, real_t p_max_delta_av) {
+		biased_linear_velocity = biased_linear_velocity + p_impulse * inv_mass;
+		if (p_max_delta_av != 0.0) {
+			Vector3x4 delta_av = inv_inertia_tensor.xform((p_position - center_of_mass).cross(p_impulse));
+			if (p_max_delta_av > 0) {
+				const Real4 max_delta_av = p_max_delta_av;
+				const Real4 delta_av_length = delta_av.length();
+				delta_av = Vector3x4::select(delta_av_length > max_delta_av, (delta_av / delta_av_length) * max_delta_av, delta_av);
+			}
+			biased_angular_velocity = biased_angular_velocity + delta_av;
+		}
+	}
+};
+
+} // namespace
+
+void GodotContactSolver3D::solve(GodotBodyPair3D *const *p_pairs, uint32_t p_pair_count, real_t p_step) {
+	const real_t max_bias_av = GodotBodyContact3D::MAX_BIAS_ROTATION / p_step;
+	const Real4 min_velocity = GodotBodyContact3D::MIN_VELOCITY;
+	const Real4 cmp_epsilon = CMP_EPSILON;
+	const Real4 zero = 0.0;
+
+	for (uint32_t batch_begin = 0; batch_begin < p_pair_count; batch_begin += LANE_COUNT) {
+		GodotBodyPair3D *pairs[LANE_COUNT] = {};
+		GodotBody3D *bodies_A[LANE_COUNT] = {};
+		GodotBody3D *bodies_B[LANE_COUNT] = {};
+		bool collides_A[LANE_COUNT] = {};
+		bool collides_B[LANE_COUNT] = {};
+		real_t frictions[LANE_COUNT] = {};
+		int max_contact_count = 0;
+
+		const uint32_t lane_count = MIN(LANE_COUNT, p_pair_count - batch_begin);
+		for (uint32_t lane = 0; lane < lane_count; lane++) {
+			GodotBodyPair3D *pair = p_pairs[batch_begin + lane];
+			if (!pair->collided || pair->contact_count == 0) {
+				continue;
+			}
+			pairs[lane] = pair;
+			bodies_A[lane] = pair->A;
+			bodies_B[lane] = pair->B;
+			collides_A[lane] = pair->collide_A;
+			collides_B[lane] = pair->collide_B;
+			frictions[lane] = Math::abs(MIN(pair->A->get_friction(), pair->B->get_friction()));
+			max_contact_count = MAX(max_contact_count, pair->contact_count);
+		}
+
+		if (max_contact_count == 0) {
+			continue;
+		}
+
+		BodyLanes A;
+		BodyLanes B;
+		A.gather(bodies_A, collides_A);
+		B.gather(bodies_B, collides_B);
+
+		const Real4 inv_mass_sum = A.inv_mass + B.inv_mass;
+		const Real4 friction = Real4::load(frictions);
+
+		// Every lane goes through the contacts of its pair in order, like the scalar solver.
+		for (int contact_index = 0; contact_index < max_contact_count; contact_index++) {
+			bool lane_active[LANE_COUNT] = {};
+			Vector3 normals[LANE_COUNT], rAs[LANE_COUNT], rBs[LANE_COUNT], acc_impulses[LANE_COUNT], acc_tangent_impulses[LANE_COUNT];
+			real_t biases[LANE_COUNT] = {}, bounces[LANE_COUNT] = {}, mass_normals[LANE_COUNT] = {};
+			real_t acc_bias_impulses[LANE_COUNT] = {}, acc_bias_impulses_com[LANE_COUNT] = {}, acc_normal_impulses[LANE_COUNT] = {};
+
+			bool any_active = false;
+			for (uint32_t lane = 0; lane < LANE_COUNT; lane++) {
+				if (!pairs[lane] || contact_index >= pairs[lane]->contact_count) {
+					continue;
+				}
+				const GodotBodyContact3D::Contact &c = pairs[lane]->contacts[contact_index];
+				if (!c.active) {
+					continue;
+				}
+				lane_active[lane] = true;
+				any_active = true;
+				normals[lane] = c.normal;
+				rAs[lane] = c.rA;
+				rBs[lane] = c.rB;
+				acc_impulses[lane] = c.acc_impulse;
+				acc_tangent_impulses[lane] = c.acc_tangent_impulse;
+				biases[lane] = c.bias;
+				bounces[lane] = c.bounce;
+				mass_normals[lane] = c.mass_normal;
+				acc_bias_impulses[lane] = c.acc_bias_impulse;
+				acc_bias_impulses_com[lane] = c.acc_bias_impulse_center_of_mass;
+				acc_normal_impulses[lane] = c.acc_normal_impulse;
+			}
+
+			if (!any_active) {
+				continue;
+			}
+
+			const Mask4 active = Mask4::from_bools(lane_active);
+			const Vector3x4 normal = Vector3x4::gather(normals);
+			const Vector3x4 rA = Vector3x4::gather(rAs);
+			const Vector3x4 rB = Vector3x4::gather(rBs);
+			const Vector3x4 position_A = rA + A.center_of_mass;
+			const Vector3x4 position_B = rB + B.center_of_mass;
+			const Real4 bias = Real4::load(biases);
+			const Real4 bounce = Real4::load(bounces);
+			const Real4 mass_normal = Real4::load(mass_normals);
+			Vector3x4 acc_impulse = Vector3x4::gather(acc_impulses);
+			Vector3x4 acc_tangent_impulse = Vector3x4::gather(acc_tangent_impulses);
+			Real4 acc_bias_impulse = Real4::load(acc_bias_impulses);
+			Real4 acc_bias_impulse_com = Real4::load(acc_bias_impulses_com);
+			Real4 acc_normal_impulse = Real4::load(acc_normal_impulses);
+
+			// Bias impulse.
+
+			Vector3x4 dbv = B.biased_linear_velocity + B.biased_angular_velocity.cross(rB) - A.biased_linear_velocity - A.biased_angular_velocity.cross(rA);
+			Real4 vbn = dbv.dot(normal);
+
+			const Mask4 bias_mask = active & (Real4::abs(-vbn + bias) > min_velocity);
+			{
+				const Real4 jbn = (-vbn + bias) * mass_normal;
+				const Real4 jbn_old = acc_bias_impulse;
+				acc_bias_impulse = Real4::select(bias_mask, Real4::max(jbn_old + jbn, zero), jbn_old);
+
+				const Vector3x4 jb = normal * (acc_bias_impulse - jbn_old);
+				A.apply_bias_impulse(-jb, position_A, max_bias_av);
+				B.apply_bias_impulse(jb, position_B, max_bias_av);
+
+				dbv = B.biased_linear_velocity + B.biased_angular_velocity.cross(rB) - A.biased_linear_velocity - A.biased_angular_velocity.cross(rA);
+				vbn = dbv.dot(normal);
+
+				const Mask4 bias_com_mask = bias_mask & (Real4::abs(-vbn + bias) > min_velocity);
+				const Real4 jbn_com = (-vbn + bias) / inv_mass_sum;
+				const Real4 jbn_com_old = acc_bias_impulse_com;
+				acc_bias_impulse_com = Real4::select(bias_com_mask, Real4::max(jbn_com_old + jbn_com, zero), jbn_com_old);
+
+				const Vector3x4 jb_com = normal * (acc_bias_impulse_com - jbn_com_old);
+				A.apply_bias_impulse(-jb_com, A.center_of_mass, 0.0);
+				B.apply_bias_impulse(jb_com, B.center_of_mass, 0.0);
+			}
+
+			// Normal impulse.
+
+			const Vector3x4 dv = B.linear_velocity + B.angular_velocity.cross(rB) - A.linear_velocity - A.angular_velocity.cross(rA);
+			const Real4 vn = dv.dot(normal);
+
+			const Mask4 normal_mask = active & (Real4::abs(vn) > min_velocity);
+			{
+				const Real4 jn = -(bounce + vn) * mass_normal;
+				const Real4 jn_old = acc_normal_impulse;
+				acc_normal_impulse = Real4::select(normal_mask, Real4::max(jn_old + jn, zero), jn_old);
+
+				const Vector3x4 j = normal * (acc_normal_impulse - jn_old);
+				A.apply_impulse(-j, position_A);
+				B.apply_impulse(j, position_B);
+				acc_impulse = acc_impulse - j;
+			}
+
+			// Friction impulse.
+
+			const Vector3x4 lvA = A.linear_velocity + A.angular_velocity.cross(rA);
+			const Vector3x4 lvB = B.linear_velocity + B.angular_velocity.cross(rB);
+
+			const Vector3x4 dtv = lvB - lvA;
+			const Real4 tn = normal.dot(dtv);
+
+			// Tangential velocity.
+			Vector3x4 tv = dtv - normal * tn;
+			const Real4 tvl = tv.length();
+
+			const Mask4 friction_mask = active & (tvl > min_velocity);
+			{
+				tv = tv / tvl;
+
+				const Vector3x4 temp1 = A.inv_inertia_tensor.xform(rA.cross(tv));
+				const Vector3x4 temp2 = B.inv_inertia_tensor.xform(rB.cross(tv));
+
+				const Real4 t = -tvl / (inv_mass_sum + tv.dot(temp1.cross(rA) + temp2.cross(rB)));
+
+				const Vector3x4 jt_old = acc_tangent_impulse;
+				acc_tangent_impulse = Vector3x4::select(friction_mask, acc_tangent_impulse + tv * t, acc_tangent_impulse);
+
+				const Real4 fi_len = acc_tangent_impulse.length();
+				const Real4 jt_max = acc_normal_impulse * friction;
+
+				const Mask4 clamp_mask = friction_mask & (fi_len > cmp_epsilon) & (fi_len > jt_max);
+				acc_tangent_impulse = Vector3x4::select(clamp_mask, acc_tangent_impulse * (jt_max / fi_len), acc_tangent_impulse);
+
+				const Vector3x4 jt = acc_tangent_impulse - jt_old;
+				A.apply_impulse(-jt, position_A);
+				B.apply_impulse(jt, position_B);
+				acc_impulse = acc_impulse - jt;
+			}
+
+			// Write back the accumulated impulses. Contacts deactivate themselves unless an impulse was needed.
+			const Mask4 still_active = bias_mask | normal_mask | friction_mask;
+
+			acc_impulse.scatter(acc_impulses);
+			acc_tangent_impulse.scatter(acc_tangent_impulses);
+			acc_bias_impulse.store(acc_bias_impulses);
+			acc_bias_impulse_com.store(acc_bias_impulses_com);
+			acc_normal_impulse.store(acc_normal_impulses);
+
+			for (uint32_t lane = 0; lane < LANE_COUNT; lane++) {
+				if (!lane_active[lane]) {
+					continue;
+				}
+				GodotBodyContact3D::Contact &c = pairs[lane]->contacts[contact_index];
+				c.acc_impulse = acc_impulses[lane];
+				c.acc_tangent_impulse = acc_tangent_impulses[lane];
+				c.acc_bias_impulse = acc_bias_impulses[lane];
+				c.acc_bias_impulse_center_of_mass = acc_bias_impulses_com[lane];
+				c.acc_normal_impulse = acc_normal_impulses[lane];
+				c.active = still_active.get(lane);
+			}
+		}
+
+		A.scatter(bodies_A, collides_A);
+		B.scatter(bodies_B, collides_B);
+	}
+}
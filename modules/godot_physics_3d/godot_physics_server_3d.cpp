@@ -38,7 +38,9 @@
 #include "joints/godot_pin_joint_3d.h"
 #include "joints/godot_slider_joint_3d.h"
 
+#include "core/config/project_settings.h"
 #include "core/debugger/engine_debugger.h"
+#include "core/object/worker_thread_pool.h"
 #include "core/os/os.h"
 
 #define FLUSH_QUERY_CHECK(m_object) \
@@ -196,6 +198,22 @@ PhysicsDirectSpaceState3D *GodotPhysicsServer3D::space_get_direct_state(RID p_sp
 	return space->get_direct_state();
 }
 
+PackedByteArray GodotPhysicsServer3D::space_snapshot(RID p_space) {
+	GodotSpace3D *space = space_owner.get_or_null(p_space);
+	ERR_FAIL_NULL_V(space, PackedByteArray());
+	ERR_FAIL_COND_V_MSG((using_threads && !doing_sync) || space->is_locked(), PackedByteArray(), "Space state is inaccessible right now, wait for iteration or physics process notification.");
+
+	return space->save_snapshot();
+}
+
+bool GodotPhysicsServer3D::space_restore(RID p_space, const PackedByteArray &p_snapshot) {
+	GodotSpace3D *space = space_owner.get_or_null(p_space);
+	ERR_FAIL_NULL_V(space, false);
+	ERR_FAIL_COND_V_MSG((using_threads && !doing_sync) || space->is_locked(), false, "Space state is inaccessible right now, wait for iteration or physics process notification.");
+
+	return space->restore_snapshot(p_snapshot);
+}
+
 void GodotPhysicsServer3D::space_set_debug_contacts(RID p_space, int p_max_contacts) {
 	GodotSpace3D *space = space_owner.get_or_null(p_space);
 	ERR_FAIL_NULL(space);
@@ -214,6 +232,12 @@ int GodotPhysicsServer3D::space_get_contact_count(RID p_space) const {
 	return space->get_debug_contact_count();
 }
 
+double GodotPhysicsServer3D::space_get_step_time(RID p_space) const {
+	const GodotSpace3D *space = space_owner.get_or_null(p_space);
+	ERR_FAIL_NULL_V(space, 0.0);
+	return USEC_TO_SEC(space->get_step_time());
+}
+
 RID GodotPhysicsServer3D::area_create() {
 	GodotArea3D *area = memnew(GodotArea3D);
 	RID rid = area_owner.make_rid(area);
@@ -1625,7 +1649,18 @@ void GodotPhysicsServer3D::set_active(bool p_active) {
 }
 
 void GodotPhysicsServer3D::init() {
-	stepper = memnew(GodotStep3D);
+	steppers.push_back(memnew(GodotStep3D));
+	parallel_space_step = GLOBAL_GET("physics/3d/step_spaces_in_parallel");
+}
+
+void GodotPhysicsServer3D::_step_space(GodotSpace3D *p_space, GodotStep3D *p_stepper) {
+	const uint64_t time_beg = OS::get_singleton()->get_ticks_usec();
+	p_stepper->step(p_space, step_delta);
+	p_space->set_step_time(OS::get_singleton()->get_ticks_usec() - time_beg);
+}
+
+void GodotPhysicsServer3D::_step_space_task(uint32_t p_index, void *p_userdata) {
+	_step_space(step_spaces[p_index], steppers[p_index]);
 }
 
 void GodotPhysicsServer3D::step(real_t p_step) {
@@ -1635,11 +1670,49 @@ void GodotPhysicsServer3D::step(real_t p_step) {
 
 	_update_shapes();
 
+	step_delta = p_step;
+
+	// Stepping a space waits on group tasks of its own, and such waits don't run other tasks in the meantime.
+	// At least one pool thread must stay free to run them, and the calling thread doesn't count if it's one
+	// of the pool's, otherwise every thread could end up waiting on tasks that no thread is left to run.
+	int max_concurrent_spaces = 0;
+	if (parallel_space_step && active_spaces.size() > 1) {
+		max_concurrent_spaces = WorkerThreadPool::get_singleton()->get_thread_count() - 1;
+		if (WorkerThreadPool::get_singleton()->get_thread_index() != -1) {
+			max_concurrent_spaces--;
+		}
+	}
+
+	if (max_concurrent_spaces > 1) {
+		// Spaces don't share any simulation state, so each of them can be stepped by its own stepper.
+		step_spaces.clear();
+		for (GodotSpace3D *E : active_spaces) {
+			step_spaces.push_back(E);
+		}
+
+		// Start with the spaces that took the longest last time, so that a slow one isn't left running alone at the end.
+		struct StepTimeOrder {
+			_FORCE_INLINE_ bool operator()(const GodotSpace3D *p_a, const GodotSpace3D *p_b) const { return p_a->get_step_time() > p_b->get_step_time(); }
+		};
+		step_spaces.sort_custom<StepTimeOrder>();
+
+		while (steppers.size() < step_spaces.size()) {
+			steppers.push_back(memnew(GodotStep3D));
+		}
+
+		const int task_count = MIN((int)step_spaces.size(), max_concurrent_spaces);
+		WorkerThreadPool::GroupID group_task = WorkerThreadPool::get_singleton()->add_template_group_task(this, &GodotPhysicsServer3D::_step_space_task, nullptr, step_spaces.size(), task_count, true, SNAME("Physics3DStepSpaces"));
+		WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_task);
+	} else {
+		for (GodotSpace3D *E : active_spaces) {
+			_step_space(E, steppers[0]);
+		}
+	}
+
 	island_count = 0;
 	active_objects = 0;
 	collision_pairs = 0;
-	for (GodotSpace3D *E : active_spaces) {
-		stepper->step(E, p_step);
+	for (const GodotSpace3D *E : active_spaces) {
 		island_count += E->get_island_count();
 		active_objects += E->get_active_objects();
 		collision_pairs += E->get_collision_pairs();
@@ -1705,7 +1778,10 @@ void GodotPhysicsServer3D::end_sync() {
 }
 
 void GodotPhysicsServer3D::finish() {
-	memdelete(stepper);
+	for (GodotStep3D *stepper : steppers) {
+		memdelete(stepper);
+	}
+	steppers.clear();
 }
 
 int GodotPhysicsServer3D::get_process_info(ProcessInfo p_info) {
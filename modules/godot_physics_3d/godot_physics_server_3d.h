@@ -52,9 +52,17 @@ class GodotPhysicsServer3D : public PhysicsServer3D {
 	bool doing_sync = false;
 	bool flushing_queries = false;
 
-	GodotStep3D *stepper = nullptr;
+	// One stepper per space that can be stepped at the same time, since they hold per-step scratch data.
+	LocalVector<GodotStep3D *> steppers;
 	HashSet<GodotSpace3D *> active_spaces;
 
+	bool parallel_space_step = false;
+	LocalVector<GodotSpace3D *> step_spaces;
+	real_t step_delta = 0.0;
+
+	void _step_space(GodotSpace3D *p_space, GodotStep3D *p_stepper);
+	void _step_space_task(uint32_t p_index, void *p_userdata = nullptr);
+
 	mutable RID_PtrOwner<GodotShape3D, true> shape_owner;
 	mutable RID_PtrOwner<GodotSpace3D, true> space_owner;
 	mutable RID_PtrOwner<GodotArea3D, true> area_owner;
@@ -116,6 +124,11 @@ public:
 	virtual Vector<Vector3> space_get_contacts(RID p_space) const override;
 	virtual int space_get_contact_count(RID p_space) const override;
 
+	virtual PackedByteArray space_snapshot(RID p_space) override;
+	virtual bool space_restore(RID p_space, const PackedByteArray &p_snapshot) override;
+
+	virtual double space_get_step_time(RID p_space) const override;
+
 	/* AREA API */
 
 	virtual RID area_create() override;
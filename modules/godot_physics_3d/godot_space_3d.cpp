@@ -34,12 +34,36 @@
 #include "godot_physics_server_3d.h"
 
 #include "core/config/project_settings.h"
+#include "core/object/worker_thread_pool.h"
+#include "core/templates/local_vector.h"
 #include "godot_area_pair_3d.h"
 #include "godot_body_pair_3d.h"
 
 #define TEST_MOTION_MARGIN_MIN_VALUE 0.0001
 #define TEST_MOTION_MIN_CONTACT_DEPTH_FACTOR 0.05
 
+#define SNAPSHOT_MAGIC 0x33535047 // "GPS3"
+#define SNAPSHOT_VERSION 1
+
+// Snapshots are a header followed by two arrays of plain structs, so saving and restoring is mostly memcpy.
+// They are only meant to be restored by the same build on the same space.
+struct GodotSpace3DSnapshotHeader {
+	uint32_t magic = SNAPSHOT_MAGIC;
+	uint32_t version = SNAPSHOT_VERSION;
+	uint32_t body_count = 0;
+	uint32_t pair_count = 0;
+};
+
+struct GodotSpace3DSnapshotBody {
+	uint64_t rid = 0;
+	GodotBody3D::SnapshotState state;
+};
+
+struct GodotSpace3DSnapshotPair {
+	uint32_t body_index = 0; // Index of body A in the snapshot body array.
+	GodotBodyPair3D::SnapshotState state;
+};
+
 _FORCE_INLINE_ static bool _can_collide_with(GodotCollisionObject3D *p_object, uint32_t p_collision_mask, bool p_collide_with_bodies, bool p_collide_with_areas) {
 	if (!(p_object->get_collision_layer() & p_collision_mask)) {
 		return false;
@@ -107,16 +131,10 @@ int GodotPhysicsDirectSpaceState3D::intersect_point(const PointParameters &p_par
 	return cc;
 }
 
-bool GodotPhysicsDirectSpaceState3D::intersect_ray(const RayParameters &p_parameters, RayResult &r_result) {
-	ERR_FAIL_COND_V(space->locked, false);
-
-	Vector3 begin, end;
-	Vector3 normal;
-	begin = p_parameters.from;
-	end = p_parameters.to;
-	normal = (end - begin).normalized();
-
-	int amount = space->broadphase->cull_segment(begin, end, space->intersection_query_results, GodotSpace3D::INTERSECTION_QUERY_MAX, space->intersection_query_subindex_results);
+bool GodotPhysicsDirectSpaceState3D::_intersect_ray_candidates(const RayParameters &p_parameters, const Vector3 &p_from, const Vector3 &p_to, GodotCollisionObject3D *const *p_objects, const int *p_shape_indices, int p_amount, RayResult &r_result) const {
+	const Vector3 &begin = p_from;
+	const Vector3 &end = p_to;
+	Vector3 normal = (end - begin).normalized();
 
 	//todo, create another array that references results, compute AABBs and check closest point to ray origin, sort, and stop evaluating results when beyond first collision
 
@@ -127,22 +145,22 @@ bool GodotPhysicsDirectSpaceState3D::intersect_ray(const RayParameters &p_parame
 	const GodotCollisionObject3D *res_obj = nullptr;
 	real_t min_d = 1e10;
 
-	for (int i = 0; i < amount; i++) {
-		if (!_can_collide_with(space->intersection_query_results[i], p_parameters.collision_mask, p_parameters.collide_with_bodies, p_parameters.collide_with_areas)) {
+	for (int i = 0; i < p_amount; i++) {
+		if (!_can_collide_with(p_objects[i], p_parameters.collision_mask, p_parameters.collide_with_bodies, p_parameters.collide_with_areas)) {
 			continue;
 		}
 
-		if (p_parameters.pick_ray && !(space->intersection_query_results[i]->is_ray_pickable())) {
+		if (p_parameters.pick_ray && !(p_objects[i]->is_ray_pickable())) {
 			continue;
 		}
 
-		if (p_parameters.exclude.has(space->intersection_query_results[i]->get_self())) {
+		if (p_parameters.exclude.has(p_objects[i]->get_self())) {
 			continue;
 		}
 
-		const GodotCollisionObject3D *col_obj = space->intersection_query_results[i];
+		const GodotCollisionObject3D *col_obj = p_objects[i];
 
-		int shape_idx = space->intersection_query_subindex_results[i];
+		int shape_idx = p_shape_indices[i];
 		Transform3D inv_xform = col_obj->get_shape_inv_transform(shape_idx) * col_obj->get_inv_transform();
 
 		Vector3 local_from = inv_xform.xform(begin);
@@ -207,6 +225,70 @@ bool GodotPhysicsDirectSpaceState3D::intersect_ray(const RayParameters &p_parame
 	return true;
 }
 
+bool GodotPhysicsDirectSpaceState3D::intersect_ray(const RayParameters &p_parameters, RayResult &r_result) {
+	ERR_FAIL_COND_V(space->locked, false);
+
+	int amount = space->broadphase->cull_segment(p_parameters.from, p_parameters.to, space->intersection_query_results, GodotSpace3D::INTERSECTION_QUERY_MAX, space->intersection_query_subindex_results);
+
+	return _intersect_ray_candidates(p_parameters, p_parameters.from, p_parameters.to, space->intersection_query_results, space->intersection_query_subindex_results, amount, r_result);
+}
+
+void GodotPhysicsDirectSpaceState3D::_intersect_rays_chunk(uint32_t p_chunk, RayBatch *p_batch) {
+	const int chunk_begin = p_chunk * RAY_BATCH_CHUNK_SIZE;
+	const int chunk_end = MIN(chunk_begin + RAY_BATCH_CHUNK_SIZE, p_batch->count);
+
+	// The space's query buffers are shared, so every chunk culls into its own.
+	LocalVector<GodotCollisionObject3D *> ray_objects;
+	LocalVector<int> ray_shape_indices;
+	ray_objects.resize(GodotSpace3D::INTERSECTION_QUERY_MAX);
+	ray_shape_indices.resize(GodotSpace3D::INTERSECTION_QUERY_MAX);
+
+	// Every ray walks the broadphase on its own, so it only visits the nodes it crosses. The broadphase
+	// serializes these walks, the narrow phase tests against the shapes run in parallel across chunks.
+	int hit_count = 0;
+
+	for (int i = chunk_begin; i < chunk_end; i++) {
+		const Vector3 &from = p_batch->from[i];
+		const Vector3 &to = p_batch->to[i];
+
+		const int amount = space->broadphase->cull_segment(from, to, ray_objects.ptr(), GodotSpace3D::INTERSECTION_QUERY_MAX, ray_shape_indices.ptr());
+
+		p_batch->hits[i] = _intersect_ray_candidates(*p_batch->parameters, from, to, ray_objects.ptr(), ray_shape_indices.ptr(), amount, p_batch->results[i]);
+		if (p_batch->hits[i]) {
+			hit_count++;
+		}
+	}
+
+	p_batch->hit_count.add(hit_count);
+}
+
+int GodotPhysicsDirectSpaceState3D::intersect_rays(const RayParameters &p_parameters, const Vector3 *p_from, const Vector3 *p_to, int p_count, RayResult *r_results, bool *r_hits) {
+	ERR_FAIL_COND_V(space->locked, 0);
+
+	if (p_count <= 0) {
+		return 0;
+	}
+
+	RayBatch batch;
+	batch.parameters = &p_parameters;
+	batch.from = p_from;
+	batch.to = p_to;
+	batch.results = r_results;
+	batch.hits = r_hits;
+	batch.count = p_count;
+
+	const uint32_t chunk_count = (p_count + RAY_BATCH_CHUNK_SIZE - 1) / RAY_BATCH_CHUNK_SIZE;
+
+	if (chunk_count == 1) {
+		_intersect_rays_chunk(0, &batch);
+	} else {
+		WorkerThreadPool::GroupID group_task = WorkerThreadPool::get_singleton()->add_template_group_task(this, &GodotPhysicsDirectSpaceState3D::_intersect_rays_chunk, &batch, chunk_count, -1, true, SNAME("Physics3DIntersectRays"));
+		WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_task);
+	}
+
+	return batch.hit_count.get();
+}
+
 int GodotPhysicsDirectSpaceState3D::intersect_shape(const ShapeParameters &p_parameters, ShapeResult *r_results, int p_result_max) {
 	if (p_result_max <= 0) {
 		return 0;
@@ -1189,6 +1271,146 @@ void GodotSpace3D::update() {
 	broadphase->update();
 }
 
+PackedByteArray GodotSpace3D::save_snapshot() const {
+	GodotSpace3DSnapshotHeader header;
+
+	for (const GodotCollisionObject3D *E : objects) {
+		if (E->get_type() != GodotCollisionObject3D::TYPE_BODY) {
+			continue;
+		}
+		const GodotBody3D *body = static_cast<const GodotBody3D *>(E);
+		header.body_count++;
+
+		for (const KeyValue<GodotConstraint3D *, int> &C : body->get_constraint_map()) {
+			const GodotBodyPair3D *pair = C.key->as_body_pair();
+			if (pair && pair->get_body_A() == body) {
+				header.pair_count++;
+			}
+		}
+	}
+
+	PackedByteArray snapshot;
+	snapshot.resize(sizeof(GodotSpace3DSnapshotHeader) + header.body_count * sizeof(GodotSpace3DSnapshotBody) + header.pair_count * sizeof(GodotSpace3DSnapshotPair));
+
+	uint8_t *w = snapshot.ptrw();
+	memcpy(w, &header, sizeof(GodotSpace3DSnapshotHeader));
+
+	uint8_t *w_body = w + sizeof(GodotSpace3DSnapshotHeader);
+	uint8_t *w_pair = w_body + header.body_count * sizeof(GodotSpace3DSnapshotBody);
+
+	uint32_t body_index = 0;
+	for (const GodotCollisionObject3D *E : objects) {
+		if (E->get_type() != GodotCollisionObject3D::TYPE_BODY) {
+			continue;
+		}
+		const GodotBody3D *body = static_cast<const GodotBody3D *>(E);
+
+		GodotSpace3DSnapshotBody body_entry;
+		body_entry.rid = body->get_self().get_id();
+		body->save_snapshot_state(body_entry.state);
+		memcpy(w_body, &body_entry, sizeof(GodotSpace3DSnapshotBody));
+		w_body += sizeof(GodotSpace3DSnapshotBody);
+
+		for (const KeyValue<GodotConstraint3D *, int> &C : body->get_constraint_map()) {
+			const GodotBodyPair3D *pair = C.key->as_body_pair();
+			if (pair && pair->get_body_A() == body) {
+				GodotSpace3DSnapshotPair pair_entry;
+				pair_entry.body_index = body_index;
+				pair->save_snapshot_state(pair_entry.state);
+				memcpy(w_pair, &pair_entry, sizeof(GodotSpace3DSnapshotPair));
+				w_pair += sizeof(GodotSpace3DSnapshotPair);
+			}
+		}
+
+		body_index++;
+	}
+
+	return snapshot;
+}
+
+bool GodotSpace3D::restore_snapshot(const PackedByteArray &p_snapshot) {
+	ERR_FAIL_COND_V_MSG(p_snapshot.size() < (int64_t)sizeof(GodotSpace3DSnapshotHeader), false, "Invalid physics space snapshot.");
+
+	const uint8_t *r = p_snapshot.ptr();
+
+	GodotSpace3DSnapshotHeader header;
+	memcpy(&header, r, sizeof(GodotSpace3DSnapshotHeader));
+	ERR_FAIL_COND_V_MSG(header.magic != SNAPSHOT_MAGIC || header.version != SNAPSHOT_VERSION, false, "Invalid physics space snapshot.");
+	ERR_FAIL_COND_V_MSG(p_snapshot.size() != (int64_t)(sizeof(GodotSpace3DSnapshotHeader) + header.body_count * sizeof(GodotSpace3DSnapshotBody) + header.pair_count * sizeof(GodotSpace3DSnapshotPair)), false, "Invalid physics space snapshot.");
+
+	const uint8_t *r_body = r + sizeof(GodotSpace3DSnapshotHeader);
+	const uint8_t *r_pair = r_body + header.body_count * sizeof(GodotSpace3DSnapshotBody);
+
+	LocalVector<GodotBody3D *> current_bodies;
+	current_bodies.reserve(header.body_count);
+	for (GodotCollisionObject3D *E : objects) {
+		if (E->get_type() == GodotCollisionObject3D::TYPE_BODY) {
+			current_bodies.push_back(static_cast<GodotBody3D *>(E));
+		}
+	}
+
+	// Resolve every body before modifying anything, so a stale snapshot leaves the space untouched.
+	// When no body was added or removed since the snapshot, the space iterates them in the same order.
+	LocalVector<GodotBody3D *> bodies;
+	bodies.resize(header.body_count);
+
+	HashMap<uint64_t, GodotBody3D *> body_lookup;
+	for (uint32_t i = 0; i < header.body_count; i++) {
+		uint64_t rid = 0;
+		memcpy(&rid, r_body + i * sizeof(GodotSpace3DSnapshotBody) + offsetof(GodotSpace3DSnapshotBody, rid), sizeof(uint64_t));
+
+		if (i < current_bodies.size() && current_bodies[i]->get_self().get_id() == rid) {
+			bodies[i] = current_bodies[i];
+			continue;
+		}
+
+		if (body_lookup.is_empty()) {
+			for (GodotBody3D *body : current_bodies) {
+				body_lookup.insert(body->get_self().get_id(), body);
+			}
+		}
+
+		HashMap<uint64_t, GodotBody3D *>::Iterator E = body_lookup.find(rid);
+		ERR_FAIL_COND_V_MSG(!E, false, "Physics space snapshot references a body that is no longer in the space.");
+		bodies[i] = E->value;
+	}
+
+	for (uint32_t i = 0; i < header.body_count; i++) {
+		GodotSpace3DSnapshotBody body_entry;
+		memcpy(&body_entry, r_body + i * sizeof(GodotSpace3DSnapshotBody), sizeof(GodotSpace3DSnapshotBody));
+		bodies[i]->restore_snapshot_state(body_entry.state);
+	}
+
+	// Create the pairs for the restored positions, then replace their contact caches.
+	update();
+
+	for (GodotBody3D *body : current_bodies) {
+		for (const KeyValue<GodotConstraint3D *, int> &C : body->get_constraint_map()) {
+			GodotBodyPair3D *pair = C.key->as_body_pair();
+			if (pair && pair->get_body_A() == body) {
+				pair->clear_snapshot_state();
+			}
+		}
+	}
+
+	for (uint32_t i = 0; i < header.pair_count; i++) {
+		GodotSpace3DSnapshotPair pair_entry;
+		memcpy(&pair_entry, r_pair + i * sizeof(GodotSpace3DSnapshotPair), sizeof(GodotSpace3DSnapshotPair));
+		ERR_CONTINUE(pair_entry.body_index >= header.body_count);
+
+		// Pairs the broadphase recreated with A and B swapped simply start without warm starting.
+		for (const KeyValue<GodotConstraint3D *, int> &C : bodies[pair_entry.body_index]->get_constraint_map()) {
+			GodotBodyPair3D *pair = C.key->as_body_pair();
+			if (pair && pair->matches_snapshot_state(pair_entry.state)) {
+				pair->restore_snapshot_state(pair_entry.state);
+				break;
+			}
+		}
+	}
+
+	return true;
+}
+
 void GodotSpace3D::set_param(PhysicsServer3D::SpaceParameter p_param, real_t p_value) {
 	switch (p_param) {
 		case PhysicsServer3D::SPACE_PARAM_CONTACT_RECYCLE_RADIUS:
@@ -1265,6 +1487,7 @@ GodotSpace3D::GodotSpace3D() {
 	contact_max_separation = GLOBAL_GET("physics/3d/solver/contact_max_separation");
 	contact_max_allowed_penetration = GLOBAL_GET("physics/3d/solver/contact_max_allowed_penetration");
 	contact_bias = GLOBAL_GET("physics/3d/solver/default_contact_bias");
+	simd_contact_solver = GLOBAL_GET("physics/3d/solver/use_simd_contact_solver");
 
 	broadphase = GodotBroadPhase3D::create_func();
 	broadphase->set_pair_callback(_broadphase_pair, this);
@@ -30,6 +30,8 @@
 
 #include "godot_step_3d.h"
 
+#include "godot_body_pair_3d.h"
+#include "godot_contact_solver_3d.h"
 #include "godot_joint_3d.h"
 
 #include "core/object/worker_thread_pool.h"
@@ -40,6 +42,13 @@
 #define ISLAND_COUNT_RESERVE 128
 #define ISLAND_SIZE_RESERVE 512
 #define CONSTRAINT_COUNT_RESERVE 1024
+#define ACTIVE_BODY_COUNT_RESERVE 1024
+
+// Islands with at least this many constraints are solved by several threads, see `_solve_large_island`.
+#define LARGE_ISLAND_CONSTRAINT_COUNT 1024
+// Colors are tracked per body as a 64-bit mask, constraints that don't fit are solved serially.
+#define MAX_CONSTRAINT_COLORS 64
+#define CONSTRAINT_COLOR_CHUNK_SIZE 32
 
 void GodotStep3D::_populate_island(GodotBody3D *p_body, LocalVector<GodotBody3D *> &p_body_island, LocalVector<GodotConstraint3D *> &p_constraint_island) {
 	p_body->set_island_step(_step);
@@ -112,11 +121,23 @@ void GodotStep3D::_populate_island_soft_body(GodotSoftBody3D *p_soft_body, Local
 	}
 }
 
+void GodotStep3D::_integrate_forces(uint32_t p_body_index, void *p_userdata) {
+	active_bodies[p_body_index]->integrate_forces(delta);
+}
+
+void GodotStep3D::_integrate_velocities(uint32_t p_body_index, void *p_userdata) {
+	active_bodies[p_body_index]->integrate_velocities(delta);
+}
+
 void GodotStep3D::_setup_constraint(uint32_t p_constraint_index, void *p_userdata) {
 	GodotConstraint3D *constraint = all_constraints[p_constraint_index];
 	constraint->setup(delta);
 }
 
+void GodotStep3D::_solve_ccd_pair(uint32_t p_pair_index, void *p_userdata) {
+	ccd_pairs[p_pair_index]->solve_ccd(delta);
+}
+
 void GodotStep3D::_pre_solve_island(LocalVector<GodotConstraint3D *> &p_constraint_island) const {
 	uint32_t constraint_count = p_constraint_island.size();
 	uint32_t valid_constraint_count = 0;
@@ -130,17 +151,15 @@ void GodotStep3D::_pre_solve_island(LocalVector<GodotConstraint3D *> &p_constrai
 	p_constraint_island.resize(valid_constraint_count);
 }
 
-void GodotStep3D::_solve_island(uint32_t p_island_index, void *p_userdata) {
-	LocalVector<GodotConstraint3D *> &constraint_island = constraint_islands[p_island_index];
-
-	int current_priority = 1;
+void GodotStep3D::_solve_constraints(LocalVector<GodotConstraint3D *> &p_constraints, uint32_t p_constraint_count, int p_priority) const {
+	int current_priority = p_priority;
 
-	uint32_t constraint_count = constraint_island.size();
+	uint32_t constraint_count = p_constraint_count;
 	while (constraint_count > 0) {
 		for (int i = 0; i < iterations; i++) {
 			// Go through all iterations.
 			for (uint32_t constraint_index = 0; constraint_index < constraint_count; ++constraint_index) {
-				constraint_island[constraint_index]->solve(delta);
+				p_constraints[constraint_index]->solve(delta);
 			}
 		}
 
@@ -148,16 +167,142 @@ void GodotStep3D::_solve_island(uint32_t p_island_index, void *p_userdata) {
 		uint32_t priority_constraint_count = 0;
 		++current_priority;
 		for (uint32_t constraint_index = 0; constraint_index < constraint_count; ++constraint_index) {
-			GodotConstraint3D *constraint = constraint_island[constraint_index];
+			GodotConstraint3D *constraint = p_constraints[constraint_index];
 			if (constraint->get_priority() >= current_priority) {
 				// Keep this constraint for the next iteration.
-				constraint_island[priority_constraint_count++] = constraint;
+				p_constraints[priority_constraint_count++] = constraint;
 			}
 		}
 		constraint_count = priority_constraint_count;
 	}
 }
 
+void GodotStep3D::_solve_island(uint32_t p_order_index, void *p_userdata) {
+	LocalVector<GodotConstraint3D *> &constraint_island = constraint_islands[island_order[p_order_index].index];
+	_solve_constraints(constraint_island, constraint_island.size(), 1);
+}
+
+void GodotStep3D::_color_island(const LocalVector<GodotConstraint3D *> &p_constraint_island) {
+	// Greedy coloring: constraints with the same color don't share any body the solver writes to.
+	// Static and kinematic bodies are only read, so they don't restrict the coloring.
+	for (uint32_t color = 0; color < color_count; ++color) {
+		constraint_colors[color].clear();
+	}
+	color_count = 0;
+	uncolored_constraints.clear();
+	body_colors.clear();
+
+	for (GodotConstraint3D *constraint : p_constraint_island) {
+		uint64_t used_colors = 0;
+
+		for (int i = 0; i < constraint->get_body_count(); i++) {
+			const GodotBody3D *body = constraint->get_body_ptr()[i];
+			if (body->get_mode() > PhysicsServer3D::BODY_MODE_KINEMATIC) {
+				const uint64_t *body_used_colors = body_colors.getptr(body);
+				if (body_used_colors) {
+					used_colors |= *body_used_colors;
+				}
+			}
+		}
+		for (int i = 0; i < constraint->get_soft_body_count(); i++) {
+			const uint64_t *body_used_colors = body_colors.getptr(constraint->get_soft_body_ptr(i));
+			if (body_used_colors) {
+				used_colors |= *body_used_colors;
+			}
+		}
+
+		uint32_t color = 0;
+		while (color < MAX_CONSTRAINT_COLORS && (used_colors & (uint64_t(1) << color))) {
+			++color;
+		}
+		if (color == MAX_CONSTRAINT_COLORS) {
+			uncolored_constraints.push_back(constraint);
+			continue;
+		}
+
+		if (color >= color_count) {
+			color_count = color + 1;
+			if (constraint_colors.size() < color_count) {
+				constraint_colors.resize(color_count);
+			}
+		}
+		constraint_colors[color].push_back(constraint);
+
+		const uint64_t color_bit = uint64_t(1) << color;
+		for (int i = 0; i < constraint->get_body_count(); i++) {
+			const GodotBody3D *body = constraint->get_body_ptr()[i];
+			if (body->get_mode() > PhysicsServer3D::BODY_MODE_KINEMATIC) {
+				if (uint64_t *body_used_colors = body_colors.getptr(body)) {
+					*body_used_colors |= color_bit;
+				} else {
+					body_colors.insert(body, color_bit);
+				}
+			}
+		}
+		for (int i = 0; i < constraint->get_soft_body_count(); i++) {
+			const GodotSoftBody3D *soft_body = constraint->get_soft_body_ptr(i);
+			if (uint64_t *body_used_colors = body_colors.getptr(soft_body)) {
+				*body_used_colors |= color_bit;
+			} else {
+				body_colors.insert(soft_body, color_bit);
+			}
+		}
+	}
+}
+
+void GodotStep3D::_solve_color_chunk(uint32_t p_chunk_index, void *p_userdata) {
+	const LocalVector<GodotConstraint3D *> &constraints = *(const LocalVector<GodotConstraint3D *> *)p_userdata;
+
+	const uint32_t begin = p_chunk_index * CONSTRAINT_COLOR_CHUNK_SIZE;
+	const uint32_t end = MIN(begin + CONSTRAINT_COLOR_CHUNK_SIZE, constraints.size());
+
+	// Constraints of a color share no bodies, so their body pairs can be batched into SIMD lanes.
+	GodotBodyPair3D *pairs[CONSTRAINT_COLOR_CHUNK_SIZE];
+	uint32_t pair_count = 0;
+
+	for (uint32_t constraint_index = begin; constraint_index < end; ++constraint_index) {
+		GodotConstraint3D *constraint = constraints[constraint_index];
+		GodotBodyPair3D *pair = use_simd_contact_solver ? constraint->as_body_pair() : nullptr;
+		if (pair) {
+			pairs[pair_count++] = pair;
+		} else {
+			constraint->solve(delta);
+		}
+	}
+
+	if (pair_count > 0) {
+		GodotContactSolver3D::solve(pairs, pair_count, delta);
+	}
+}
+
+void GodotStep3D::_solve_large_island(LocalVector<GodotConstraint3D *> &p_constraint_island) {
+	_color_island(p_constraint_island);
+
+	// Same iterations as `_solve_constraints`, but the constraints of each color are solved in parallel.
+	for (int i = 0; i < iterations; i++) {
+		for (uint32_t color = 0; color < color_count; ++color) {
+			LocalVector<GodotConstraint3D *> &constraints = constraint_colors[color];
+			uint32_t chunk_count = (constraints.size() + CONSTRAINT_COLOR_CHUNK_SIZE - 1) / CONSTRAINT_COLOR_CHUNK_SIZE;
+			WorkerThreadPool::GroupID group_task = WorkerThreadPool::get_singleton()->add_template_group_task(this, &GodotStep3D::_solve_color_chunk, (void *)&constraints, chunk_count, -1, true, SNAME("Physics3DConstraintSolveColor"));
+			WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_task);
+		}
+		for (GodotConstraint3D *constraint : uncolored_constraints) {
+			constraint->solve(delta);
+		}
+	}
+
+	// Only few constraints have a higher priority, solve their extra passes serially.
+	uint32_t constraint_count = p_constraint_island.size();
+	uint32_t priority_constraint_count = 0;
+	for (uint32_t constraint_index = 0; constraint_index < constraint_count; ++constraint_index) {
+		GodotConstraint3D *constraint = p_constraint_island[constraint_index];
+		if (constraint->get_priority() >= 2) {
+			p_constraint_island[priority_constraint_count++] = constraint;
+		}
+	}
+	_solve_constraints(p_constraint_island, priority_constraint_count, 2);
+}
+
 void GodotStep3D::_check_suspend(const LocalVector<GodotBody3D *> &p_body_island) const {
 	bool can_sleep = true;
 
@@ -183,6 +328,8 @@ void GodotStep3D::_check_suspend(const LocalVector<GodotBody3D *> &p_body_island
 }
 
 void GodotStep3D::step(GodotSpace3D *p_space, real_t p_delta) {
+	_step = next_step.fetch_add(1);
+
 	p_space->lock(); // can't access space during this
 
 	p_space->setup(); //update inertias, etc
@@ -191,6 +338,7 @@ void GodotStep3D::step(GodotSpace3D *p_space, real_t p_delta) {
 
 	iterations = p_space->get_solver_iterations();
 	delta = p_delta;
+	use_simd_contact_solver = p_space->is_simd_contact_solver_enabled();
 
 	const SelfList<GodotBody3D>::List *body_list = &p_space->get_active_body_list();
 
@@ -201,13 +349,21 @@ void GodotStep3D::step(GodotSpace3D *p_space, real_t p_delta) {
 	uint64_t profile_begtime = OS::get_singleton()->get_ticks_usec();
 	uint64_t profile_endtime = 0;
 
-	int active_count = 0;
+	active_bodies.clear();
 
 	const SelfList<GodotBody3D> *b = body_list->first();
 	while (b) {
-		b->self()->integrate_forces(p_delta);
+		active_bodies.push_back(b->self());
 		b = b->next();
-		active_count++;
+	}
+
+	int active_count = active_bodies.size();
+
+	WorkerThreadPool::GroupID group_task = WorkerThreadPool::get_singleton()->add_template_group_task(this, &GodotStep3D::_integrate_forces, nullptr, active_bodies.size(), -1, true, SNAME("Physics3DIntegrateForces"));
+	WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_task);
+
+	for (GodotBody3D *body : active_bodies) {
+		body->finish_integrate_forces();
 	}
 
 	/* UPDATE SOFT BODY MOTION */
@@ -344,7 +500,7 @@ void GodotStep3D::step(GodotSpace3D *p_space, real_t p_delta) {
 	/* SETUP CONSTRAINTS / PROCESS COLLISIONS */
 
 	uint32_t total_constraint_count = all_constraints.size();
-	WorkerThreadPool::GroupID group_task = WorkerThreadPool::get_singleton()->add_template_group_task(this, &GodotStep3D::_setup_constraint, nullptr, total_constraint_count, -1, true, SNAME("Physics3DConstraintSetup"));
+	group_task = WorkerThreadPool::get_singleton()->add_template_group_task(this, &GodotStep3D::_setup_constraint, nullptr, total_constraint_count, -1, true, SNAME("Physics3DConstraintSetup"));
 	WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_task);
 
 	{ //profile
@@ -353,6 +509,27 @@ void GodotStep3D::step(GodotSpace3D *p_space, real_t p_delta) {
 		profile_begtime = profile_endtime;
 	}
 
+	/* CONTINUOUS COLLISION DETECTION */
+
+	// Times of impact are found in parallel for all pairs at once, then applied on this thread,
+	// since a body can be part of several pairs.
+	ccd_pairs.clear();
+	for (GodotConstraint3D *constraint : all_constraints) {
+		GodotBodyPair3D *body_pair = constraint->as_body_pair();
+		if (body_pair && body_pair->is_ccd_pending()) {
+			ccd_pairs.push_back(body_pair);
+		}
+	}
+
+	if (!ccd_pairs.is_empty()) {
+		group_task = WorkerThreadPool::get_singleton()->add_template_group_task(this, &GodotStep3D::_solve_ccd_pair, nullptr, ccd_pairs.size(), -1, true, SNAME("Physics3DContinuousCollision"));
+		WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_task);
+
+		for (GodotBodyPair3D *body_pair : ccd_pairs) {
+			body_pair->apply_ccd(delta);
+		}
+	}
+
 	/* PRE-SOLVE CONSTRAINT ISLANDS */
 
 	// WARNING: This doesn't run on threads, because it involves thread-unsafe processing.
@@ -362,9 +539,31 @@ void GodotStep3D::step(GodotSpace3D *p_space, real_t p_delta) {
 
 	/* SOLVE CONSTRAINT ISLANDS */
 
+	// Islands are independent and solved in parallel, biggest first so that a large island picked up
+	// last doesn't leave the other threads idle. Islands too large for a single thread are split
+	// further by `_solve_large_island` on this thread, while the others are being solved.
+	island_order.clear();
+	large_islands.clear();
+
+	bool split_large_islands = WorkerThreadPool::get_singleton()->get_thread_count() > 1;
+	for (uint32_t island_index = 0; island_index < island_count; ++island_index) {
+		uint32_t constraint_count = constraint_islands[island_index].size();
+		if (split_large_islands && constraint_count >= LARGE_ISLAND_CONSTRAINT_COUNT) {
+			large_islands.push_back(island_index);
+		} else {
+			island_order.push_back({ island_index, constraint_count });
+		}
+	}
+	island_order.sort();
+
 	// WARNING: `_solve_island` modifies the constraint islands for optimization purpose,
 	// their content is not reliable after these calls and shouldn't be used anymore.
-	group_task = WorkerThreadPool::get_singleton()->add_template_group_task(this, &GodotStep3D::_solve_island, nullptr, island_count, -1, true, SNAME("Physics3DConstraintSolveIslands"));
+	group_task = WorkerThreadPool::get_singleton()->add_template_group_task(this, &GodotStep3D::_solve_island, nullptr, island_order.size(), -1, true, SNAME("Physics3DConstraintSolveIslands"));
+
+	for (uint32_t island_index : large_islands) {
+		_solve_large_island(constraint_islands[island_index]);
+	}
+
 	WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_task);
 
 	{ //profile
@@ -375,11 +574,12 @@ void GodotStep3D::step(GodotSpace3D *p_space, real_t p_delta) {
 
 	/* INTEGRATE VELOCITIES */
 
-	b = body_list->first();
-	while (b) {
-		const SelfList<GodotBody3D> *n = b->next();
-		b->self()->integrate_velocities(p_delta);
-		b = n;
+	group_task = WorkerThreadPool::get_singleton()->add_template_group_task(this, &GodotStep3D::_integrate_velocities, nullptr, active_bodies.size(), -1, true, SNAME("Physics3DIntegrateVelocities"));
+	WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_task);
+
+	// Can remove bodies from the active list, which is why the bodies were gathered beforehand.
+	for (GodotBody3D *body : active_bodies) {
+		body->finish_integrate_velocities();
 	}
 
 	/* SLEEP / WAKE UP ISLANDS */
@@ -403,15 +603,16 @@ void GodotStep3D::step(GodotSpace3D *p_space, real_t p_delta) {
 	}
 
 	all_constraints.clear();
+	active_bodies.clear();
 
 	p_space->unlock();
-	_step++;
 }
 
 GodotStep3D::GodotStep3D() {
 	body_islands.reserve(BODY_ISLAND_COUNT_RESERVE);
 	constraint_islands.reserve(ISLAND_COUNT_RESERVE);
 	all_constraints.reserve(CONSTRAINT_COUNT_RESERVE);
+	active_bodies.reserve(ACTIVE_BODY_COUNT_RESERVE);
 }
 
 GodotStep3D::~GodotStep3D() {
@@ -32,23 +32,58 @@
 
 #include "godot_space_3d.h"
 
+#include "core/templates/hash_map.h"
 #include "core/templates/local_vector.h"
 
+#include <atomic>
+
+class GodotBodyPair3D;
+
 class GodotStep3D {
-	uint64_t _step = 1;
+	struct IslandOrder {
+		uint32_t index = 0;
+		uint32_t constraint_count = 0;
+
+		// Biggest islands first.
+		bool operator<(const IslandOrder &p_other) const { return constraint_count > p_other.constraint_count; }
+	};
+
+	// Shared by all steppers, so that island markers left on a body by one stepper are never mistaken for
+	// the current step of another when the body moves between spaces.
+	inline static std::atomic<uint64_t> next_step = 1;
+
+	uint64_t _step = 0;
 
 	int iterations = 0;
 	real_t delta = 0.0;
+	bool use_simd_contact_solver = false;
 
+	LocalVector<GodotBody3D *> active_bodies;
 	LocalVector<LocalVector<GodotBody3D *>> body_islands;
 	LocalVector<LocalVector<GodotConstraint3D *>> constraint_islands;
 	LocalVector<GodotConstraint3D *> all_constraints;
+	LocalVector<GodotBodyPair3D *> ccd_pairs;
+	LocalVector<IslandOrder> island_order;
+	LocalVector<uint32_t> large_islands;
+
+	// Scratch data for coloring large islands.
+	LocalVector<LocalVector<GodotConstraint3D *>> constraint_colors;
+	LocalVector<GodotConstraint3D *> uncolored_constraints;
+	HashMap<const void *, uint64_t> body_colors;
+	uint32_t color_count = 0;
 
 	void _populate_island(GodotBody3D *p_body, LocalVector<GodotBody3D *> &p_body_island, LocalVector<GodotConstraint3D *> &p_constraint_island);
 	void _populate_island_soft_body(GodotSoftBody3D *p_soft_body, LocalVector<GodotBody3D *> &p_body_island, LocalVector<GodotConstraint3D *> &p_constraint_island);
+	void _integrate_forces(uint32_t p_body_index, void *p_userdata = nullptr);
+	void _integrate_velocities(uint32_t p_body_index, void *p_userdata = nullptr);
 	void _setup_constraint(uint32_t p_constraint_index, void *p_userdata = nullptr);
+	void _solve_ccd_pair(uint32_t p_pair_index, void *p_userdata = nullptr);
 	void _pre_solve_island(LocalVector<GodotConstraint3D *> &p_constraint_island) const;
-	void _solve_island(uint32_t p_island_index, void *p_userdata = nullptr);
+	void _solve_constraints(LocalVector<GodotConstraint3D *> &p_constraints, uint32_t p_constraint_count, int p_priority) const;
+	void _solve_island(uint32_t p_order_index, void *p_userdata = nullptr);
+	void _color_island(const LocalVector<GodotConstraint3D *> &p_constraint_island);
+	void _solve_color_chunk(uint32_t p_chunk_index, void *p_userdata);
+	void _solve_large_island(LocalVector<GodotConstraint3D *> &p_constraint_island);
 	void _check_suspend(const LocalVector<GodotBody3D *> &p_body_island) const;
 
 public:
@@ -0,0 +1,402 @@
+/**************************************************************************/
+/*  test_godot_physics_server_3d.h                                        */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#pragma once
+
+#include "../godot_body_pair_3d.h"
+#include "../godot_contact_solver_3d.h"
+#include "../godot_physics_server_3d.h"
+#include "../godot_shape_3d.h"
+#include "../godot_space_3d.h"
+
+#include "core/object/worker_thread_pool.h"
+#include "tests/test_macros.h"
+
+namespace TestGodotPhysicsServer3D {
+
+// Adds a static floor, whose top is at a height of zero, and a box starting at `p_position` above it.
+// Both bodies are added to `r_bodies`, the box is returned.
+RID add_falling_box(PhysicsServer3D *p_server, RID p_space, RID p_floor_shape, RID p_box_shape, const Vector3 &p_position, LocalVector<RID> &r_bodies) {
+	RID floor = p_server->body_create();
+	p_server->body_set_mode(floor, PhysicsServer3D::BODY_MODE_STATIC);
+	p_server->body_set_space(floor, p_space);
+	p_server->body_add_shape(floor, p_floor_shape);
+	p_server->body_set_state(floor, PhysicsServer3D::BODY_STATE_TRANSFORM, Transform3D(Basis(), Vector3(p_position.x, -0.5, p_position.z)));
+
+	RID box = p_server->body_create();
+	p_server->body_set_mode(box, PhysicsServer3D::BODY_MODE_RIGID);
+	p_server->body_set_space(box, p_space);
+	p_server->body_add_shape(box, p_box_shape);
+	p_server->body_set_state(box, PhysicsServer3D::BODY_STATE_TRANSFORM, Transform3D(Basis(), p_position));
+
+	r_bodies.push_back(floor);
+	r_bodies.push_back(box);
+	return box;
+}
+
+TEST_CASE("[GodotPhysics3D] Step more spaces than there are worker threads") {
+	GodotPhysicsServer3D *server = memnew(GodotPhysicsServer3D(false));
+	server->init();
+
+	RID floor_shape = server->box_shape_create();
+	server->shape_set_data(floor_shape, Vector3(10, 0.5, 10));
+	RID box_shape = server->box_shape_create();
+	server->shape_set_data(box_shape, Vector3(0.5, 0.5, 0.5));
+
+	// Every space is stepped on a worker thread that waits for the tasks of that space's step, so there
+	// must always be a thread left to run them.
+	const int space_count = WorkerThreadPool::get_singleton()->get_thread_count() + 2;
+
+	LocalVector<RID> spaces;
+	LocalVector<RID> bodies;
+	LocalVector<RID> boxes;
+	for (int i = 0; i < space_count; i++) {
+		RID space = server->space_create();
+		server->space_set_active(space, true);
+		spaces.push_back(space);
+		boxes.push_back(add_falling_box(server, space, floor_shape, box_shape, Vector3(0, 3, 0), bodies));
+	}
+
+	for (int i = 0; i < 60; i++) {
+		server->step(1.0 / 60.0);
+	}
+
+	// All spaces hold the same scene, which must end up in the same state no matter which thread stepped it.
+	const Transform3D first_transform = server->body_get_state(boxes[0], PhysicsServer3D::BODY_STATE_TRANSFORM);
+	CHECK_MESSAGE(first_transform.origin.y < 1.0, "The box should have fallen onto the floor.");
+	CHECK_MESSAGE(first_transform.origin.y > 0.0, "The box should rest on top of the floor.");
+	for (int i = 1; i < space_count; i++) {
+		const Transform3D transform = server->body_get_state(boxes[i], PhysicsServer3D::BODY_STATE_TRANSFORM);
+		CHECK(transform.origin.is_equal_approx(first_transform.origin));
+	}
+
+	for (const RID &body : bodies) {
+		server->free(body);
+	}
+	for (const RID &space : spaces) {
+		server->free(space);
+	}
+	server->free(box_shape);
+	server->free(floor_shape);
+
+	server->finish();
+	memdelete(server);
+}
+
+TEST_CASE("[GodotPhysics3D] Snapshot and restore a space") {
+	GodotPhysicsServer3D *server = memnew(GodotPhysicsServer3D(false));
+	server->init();
+
+	RID floor_shape = server->box_shape_create();
+	server->shape_set_data(floor_shape, Vector3(10, 0.5, 10));
+	RID box_shape = server->box_shape_create();
+	server->shape_set_data(box_shape, Vector3(0.5, 0.5, 0.5));
+
+	RID space = server->space_create();
+	server->space_set_active(space, true);
+
+	LocalVector<RID> bodies;
+	RID box = add_falling_box(server, space, floor_shape, box_shape, Vector3(0, 3, 0), bodies);
+
+	for (int i = 0; i < 20; i++) {
+		server->step(1.0 / 60.0);
+	}
+
+	SUBCASE("Restoring a snapshot rewinds the space") {
+		const Transform3D saved_transform = server->body_get_state(box, PhysicsServer3D::BODY_STATE_TRANSFORM);
+		const Vector3 saved_velocity = server->body_get_state(box, PhysicsServer3D::BODY_STATE_LINEAR_VELOCITY);
+		const PackedByteArray snapshot = server->space_snapshot(space);
+		REQUIRE_FALSE(snapshot.is_empty());
+
+		for (int i = 0; i < 40; i++) {
+			server->step(1.0 / 60.0);
+		}
+		const Transform3D stepped_transform = server->body_get_state(box, PhysicsServer3D::BODY_STATE_TRANSFORM);
+		CHECK_FALSE(stepped_transform.origin.is_equal_approx(saved_transform.origin));
+
+		CHECK(server->space_restore(space, snapshot));
+		const Transform3D restored_transform = server->body_get_state(box, PhysicsServer3D::BODY_STATE_TRANSFORM);
+		const Vector3 restored_velocity = server->body_get_state(box, PhysicsServer3D::BODY_STATE_LINEAR_VELOCITY);
+		CHECK(restored_transform.origin.is_equal_approx(saved_transform.origin));
+		CHECK(restored_velocity.is_equal_approx(saved_velocity));
+
+		// Stepping again from the restored state must replay the same simulation.
+		for (int i = 0; i < 40; i++) {
+			server->step(1.0 / 60.0);
+		}
+		const Transform3D replayed_transform = server->body_get_state(box, PhysicsServer3D::BODY_STATE_TRANSFORM);
+		CHECK(replayed_transform.origin.is_equal_approx(stepped_transform.origin));
+	}
+
+	SUBCASE("Restoring a snapshot that references a removed body fails without changes") {
+		RID extra_box = server->body_create();
+		server->body_set_mode(extra_box, PhysicsServer3D::BODY_MODE_RIGID);
+		server->body_set_space(extra_box, space);
+		server->body_add_shape(extra_box, box_shape, Transform3D(), false);
+		server->body_set_state(extra_box, PhysicsServer3D::BODY_STATE_TRANSFORM, Transform3D(Basis(), Vector3(3, 3, 0)));
+
+		const PackedByteArray snapshot = server->space_snapshot(space);
+		REQUIRE_FALSE(snapshot.is_empty());
+
+		server->free(extra_box);
+		for (int i = 0; i < 10; i++) {
+			server->step(1.0 / 60.0);
+		}
+		const Transform3D current_transform = server->body_get_state(box, PhysicsServer3D::BODY_STATE_TRANSFORM);
+
+		ERR_PRINT_OFF;
+		CHECK_FALSE(server->space_restore(space, snapshot));
+		ERR_PRINT_ON;
+
+		const Transform3D transform = server->body_get_state(box, PhysicsServer3D::BODY_STATE_TRANSFORM);
+		CHECK(transform.origin == current_transform.origin);
+	}
+
+	for (const RID &body : bodies) {
+		server->free(body);
+	}
+	server->free(space);
+	server->free(box_shape);
+	server->free(floor_shape);
+
+	server->finish();
+	memdelete(server);
+}
+
+// Boxes resting on a shared static floor, with one body pair per box that's set up and ready to be solved.
+// Each box penetrates the floor by a different depth and moves in a different direction.
+struct ContactSolverScene {
+	GodotSpace3D *space = nullptr;
+	GodotBoxShape3D *floor_shape = nullptr;
+	GodotBoxShape3D *box_shape = nullptr;
+	GodotBody3D *floor = nullptr;
+	LocalVector<GodotBody3D *> boxes;
+	LocalVector<GodotBodyPair3D *> pairs;
+
+	GodotBody3D *add_body(GodotShape3D *p_shape, PhysicsServer3D::BodyMode p_mode, const Transform3D &p_transform) {
+		GodotBody3D *body = memnew(GodotBody3D);
+		body->set_mode(p_mode);
+		body->add_shape(p_shape);
+		body->set_space(space);
+		body->set_state(PhysicsServer3D::BODY_STATE_TRANSFORM, p_transform);
+		return body;
+	}
+
+	ContactSolverScene(int p_box_count, real_t p_step) {
+		space = memnew(GodotSpace3D);
+		floor_shape = memnew(GodotBoxShape3D);
+		floor_shape->set_data(Vector3(50, 0.5, 50));
+		box_shape = memnew(GodotBoxShape3D);
+		box_shape->set_data(Vector3(0.5, 0.5, 0.5));
+
+		floor = add_body(floor_shape, PhysicsServer3D::BODY_MODE_STATIC, Transform3D(Basis(), Vector3(0, -0.5, 0)));
+
+		for (int i = 0; i < p_box_count; i++) {
+			const Basis basis = Basis::from_euler(Vector3(0.02 * i, 0.3 * i, -0.01 * i));
+			GodotBody3D *box = add_body(box_shape, PhysicsServer3D::BODY_MODE_RIGID, Transform3D(basis, Vector3(i * 3.0, 0.5 - 0.01 * (i + 1), 0)));
+			box->set_state(PhysicsServer3D::BODY_STATE_LINEAR_VELOCITY, Vector3(i % 2 ? 1.0 : -0.5, -2.0 - 0.5 * i, 0.25 * i));
+			box->set_state(PhysicsServer3D::BODY_STATE_ANGULAR_VELOCITY, Vector3(0.3, 0.1 * i, -0.2));
+			boxes.push_back(box);
+		}
+
+		space->setup();
+
+		for (GodotBody3D *box : boxes) {
+			GodotBodyPair3D *pair = memnew(GodotBodyPair3D(box, 0, floor, 0));
+			pair->setup(p_step);
+			pair->pre_solve(p_step);
+			pairs.push_back(pair);
+		}
+	}
+
+	~ContactSolverScene() {
+		for (GodotBodyPair3D *pair : pairs) {
+			memdelete(pair);
+		}
+		for (GodotBody3D *box : boxes) {
+			box->set_space(nullptr);
+			box->remove_shape(0);
+			memdelete(box);
+		}
+		floor->set_space(nullptr);
+		floor->remove_shape(0);
+		memdelete(floor);
+		memdelete(box_shape);
+		memdelete(floor_shape);
+		memdelete(space);
+	}
+};
+
+bool is_close(const Vector3 &p_a, const Vector3 &p_b) {
+	return p_a.distance_to(p_b) <= 1e-4 * MAX(1.0, p_a.length());
+}
+
+bool is_close(real_t p_a, real_t p_b) {
+	return Math::abs(p_a - p_b) <= 1e-4 * MAX(1.0, Math::abs(p_a));
+}
+
+TEST_CASE("[GodotPhysics3D] SIMD contact solver matches the scalar solver") {
+	// Bodies and their shapes report their changes to the server.
+	GodotPhysicsServer3D *server = memnew(GodotPhysicsServer3D(false));
+	server->init();
+
+	const real_t step = 1.0 / 60.0;
+	const int iterations = 16;
+
+	{
+		// Six pairs fill one batch of four lanes and leave a partial one.
+		ContactSolverScene scalar_scene(6, step);
+		ContactSolverScene simd_scene(6, step);
+
+		for (int i = 0; i < iterations; i++) {
+			for (GodotBodyPair3D *pair : scalar_scene.pairs) {
+				pair->solve(step);
+			}
+			GodotContactSolver3D::solve(simd_scene.pairs.ptr(), simd_scene.pairs.size(), step);
+		}
+
+		for (uint32_t i = 0; i < scalar_scene.boxes.size(); i++) {
+			const GodotBody3D *scalar_box = scalar_scene.boxes[i];
+			const GodotBody3D *simd_box = simd_scene.boxes[i];
+			CHECK(is_close(scalar_box->get_linear_velocity(), simd_box->get_linear_velocity()));
+			CHECK(is_close(scalar_box->get_angular_velocity(), simd_box->get_angular_velocity()));
+			CHECK(is_close(scalar_box->get_biased_linear_velocity(), simd_box->get_biased_linear_velocity()));
+			CHECK(is_close(scalar_box->get_biased_angular_velocity(), simd_box->get_biased_angular_velocity()));
+
+			GodotBodyPair3D::SnapshotState scalar_state;
+			GodotBodyPair3D::SnapshotState simd_state;
+			scalar_scene.pairs[i]->save_snapshot_state(scalar_state);
+			simd_scene.pairs[i]->save_snapshot_state(simd_state);
+
+			REQUIRE(scalar_state.contact_count > 0);
+			REQUIRE(scalar_state.contact_count == simd_state.contact_count);
+			for (int j = 0; j < scalar_state.contact_count; j++) {
+				CHECK(is_close(scalar_state.contacts[j].acc_normal_impulse, simd_state.contacts[j].acc_normal_impulse));
+				CHECK(is_close(scalar_state.contacts[j].acc_tangent_impulse, simd_state.contacts[j].acc_tangent_impulse));
+				CHECK(is_close(scalar_state.contacts[j].acc_impulse, simd_state.contacts[j].acc_impulse));
+				CHECK(is_close(scalar_state.contacts[j].acc_bias_impulse, simd_state.contacts[j].acc_bias_impulse));
+				CHECK(is_close(scalar_state.contacts[j].acc_bias_impulse_center_of_mass, simd_state.contacts[j].acc_bias_impulse_center_of_mass));
+			}
+		}
+
+		// The boxes were moving into the floor, so the solver must have pushed them out.
+		CHECK(scalar_scene.boxes[0]->get_linear_velocity().y > -2.0);
+	}
+
+	server->finish();
+	memdelete(server);
+}
+
+TEST_CASE("[GodotPhysics3D] Batched ray queries match single ray queries") {
+	GodotPhysicsServer3D *server = memnew(GodotPhysicsServer3D(false));
+	server->init();
+
+	RID box_shape = server->box_shape_create();
+	server->shape_set_data(box_shape, Vector3(0.5, 0.5, 0.5));
+	RID sphere_shape = server->sphere_shape_create();
+	server->shape_set_data(sphere_shape, 0.75);
+
+	RID space = server->space_create();
+	server->space_set_active(space, true);
+
+	// A grid of static boxes and spheres around the origin, with gaps and at different heights.
+	LocalVector<RID> bodies;
+	for (int x = -4; x <= 4; x++) {
+		for (int z = -4; z <= 4; z++) {
+			if ((x + z) % 3 == 0 || (x == 0 && z == 0)) {
+				continue;
+			}
+			RID body = server->body_create();
+			server->body_set_mode(body, PhysicsServer3D::BODY_MODE_STATIC);
+			server->body_set_space(body, space);
+			server->body_add_shape(body, (x + z) % 2 ? box_shape : sphere_shape, Transform3D(), false);
+			server->body_set_state(body, PhysicsServer3D::BODY_STATE_TRANSFORM, Transform3D(Basis(), Vector3(x * 2.5, (x * z) % 3 * 0.5, z * 2.5)));
+			bodies.push_back(body);
+		}
+	}
+
+	// Adds the bodies to the broadphase.
+	server->step(1.0 / 60.0);
+
+	// A fan of rays from the origin, enough for several chunks of the batch. Every tenth one points up and misses.
+	const int ray_count = 300;
+	LocalVector<Vector3> from;
+	LocalVector<Vector3> to;
+	for (int i = 0; i < ray_count; i++) {
+		const real_t angle = Math_TAU * i / ray_count;
+		from.push_back(Vector3(0, 0.25, 0));
+		if (i % 10 == 0) {
+			to.push_back(Vector3(Math::cos(angle), 15.0, Math::sin(angle)));
+		} else {
+			to.push_back(Vector3(Math::cos(angle) * 15.0, 0.25 + Math::sin(angle * 7.0), Math::sin(angle) * 15.0));
+		}
+	}
+
+	PhysicsDirectSpaceState3D *space_state = server->space_get_direct_state(space);
+	REQUIRE(space_state != nullptr);
+
+	PhysicsDirectSpaceState3D::RayParameters parameters;
+	LocalVector<PhysicsDirectSpaceState3D::RayResult> results;
+	results.resize(ray_count);
+	bool hits[ray_count] = {};
+	const int hit_count = space_state->intersect_rays(parameters, from.ptr(), to.ptr(), ray_count, results.ptr(), hits);
+
+	int expected_hit_count = 0;
+	for (int i = 0; i < ray_count; i++) {
+		parameters.from = from[i];
+		parameters.to = to[i];
+		PhysicsDirectSpaceState3D::RayResult expected;
+		const bool expected_hit = space_state->intersect_ray(parameters, expected);
+
+		CHECK(hits[i] == expected_hit);
+		if (expected_hit && hits[i]) {
+			expected_hit_count++;
+			CHECK(results[i].rid == expected.rid);
+			CHECK(results[i].shape == expected.shape);
+			CHECK(results[i].position.is_equal_approx(expected.position));
+			CHECK(results[i].normal.is_equal_approx(expected.normal));
+		}
+	}
+	CHECK(hit_count == expected_hit_count);
+	CHECK_MESSAGE(hit_count > 0, "Some rays should hit the grid.");
+	CHECK_MESSAGE(hit_count < ray_count, "The rays pointing up should miss.");
+
+	for (const RID &body : bodies) {
+		server->free(body);
+	}
+	server->free(space);
+	server->free(sphere_shape);
+	server->free(box_shape);
+
+	server->finish();
+	memdelete(server);
+}
+
+} // namespace TestGodotPhysicsServer3D
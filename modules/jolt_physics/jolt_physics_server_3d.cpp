@@ -53,6 +53,10 @@
 #include "spaces/jolt_physics_direct_space_state_3d.h"
 #include "spaces/jolt_space_3d.h"
 
+#include "core/config/project_settings.h"
+#include "core/object/worker_thread_pool.h"
+#include "core/os/os.h"
+
 JoltPhysicsServer3D::JoltPhysicsServer3D(bool p_on_separate_thread) :
 		on_separate_thread(p_on_separate_thread) {
 	singleton = this;
@@ -236,6 +240,22 @@ PhysicsDirectSpaceState3D *JoltPhysicsServer3D::space_get_direct_state(RID p_spa
 	return space->get_direct_state();
 }
 
+PackedByteArray JoltPhysicsServer3D::space_snapshot(RID p_space) {
+	JoltSpace3D *space = space_owner.get_or_null(p_space);
+	ERR_FAIL_NULL_V(space, PackedByteArray());
+	ERR_FAIL_COND_V_MSG((on_separate_thread && !doing_sync) || space->is_stepping(), PackedByteArray(), "Space state is inaccessible right now, wait for iteration or physics process notification.");
+
+	return space->save_snapshot();
+}
+
+bool JoltPhysicsServer3D::space_restore(RID p_space, const PackedByteArray &p_snapshot) {
+	JoltSpace3D *space = space_owner.get_or_null(p_space);
+	ERR_FAIL_NULL_V(space, false);
+	ERR_FAIL_COND_V_MSG((on_separate_thread && !doing_sync) || space->is_stepping(), false, "Space state is inaccessible right now, wait for iteration or physics process notification.");
+
+	return space->restore_snapshot(p_snapshot);
+}
+
 void JoltPhysicsServer3D::space_set_debug_contacts(RID p_space, int p_max_contacts) {
 #ifdef DEBUG_ENABLED
 	JoltSpace3D *space = space_owner.get_or_null(p_space);
@@ -267,6 +287,13 @@ int JoltPhysicsServer3D::space_get_contact_count(RID p_space) const {
 #endif
 }
 
+double JoltPhysicsServer3D::space_get_step_time(RID p_space) const {
+	const JoltSpace3D *space = space_owner.get_or_null(p_space);
+	ERR_FAIL_NULL_V(space, 0.0);
+
+	return USEC_TO_SEC(space->get_step_time());
+}
+
 RID JoltPhysicsServer3D::area_create() {
 	JoltArea3D *area = memnew(JoltArea3D);
 	RID rid = area_owner.make_rid(area);
@@ -1561,7 +1588,18 @@ void JoltPhysicsServer3D::set_active(bool p_active) {
 }
 
 void JoltPhysicsServer3D::init() {
-	job_system = new JoltJobSystem();
+	// Each space that steps at the same time makes the job system reserve room for another step's worth of
+	// jobs and barriers. Every step already spreads its jobs across all threads, so there's no point in
+	// letting more spaces than this run at once.
+	constexpr int MAX_CONCURRENT_STEPS = 16;
+
+	if (GLOBAL_GET("physics/3d/step_spaces_in_parallel")) {
+		max_concurrent_steps = CLAMP(WorkerThreadPool::get_singleton()->get_thread_count(), 1, MAX_CONCURRENT_STEPS);
+	} else {
+		max_concurrent_steps = 1;
+	}
+
+	job_system = new JoltJobSystem(max_concurrent_steps);
 }
 
 void JoltPhysicsServer3D::finish() {
@@ -1576,15 +1614,46 @@ void JoltPhysicsServer3D::step(real_t p_step) {
 		return;
 	}
 
-	for (JoltSpace3D *active_space : active_spaces) {
-		job_system->pre_step();
+	step_delta = (float)p_step;
 
-		active_space->step((float)p_step);
+	if (max_concurrent_steps > 1 && active_spaces.size() > 1) {
+		step_spaces.clear();
+		for (JoltSpace3D *active_space : active_spaces) {
+			step_spaces.push_back(active_space);
+		}
 
-		job_system->post_step();
+		// Start with the spaces that took the longest last time, so that a slow one isn't left running alone at the end.
+		struct StepTimeOrder {
+			_FORCE_INLINE_ bool operator()(const JoltSpace3D *p_a, const JoltSpace3D *p_b) const { return p_a->get_step_time() > p_b->get_step_time(); }
+		};
+		step_spaces.sort_custom<StepTimeOrder>();
+
+		const int task_count = MIN((int)step_spaces.size(), max_concurrent_steps);
+		WorkerThreadPool::GroupID group_task = WorkerThreadPool::get_singleton()->add_template_group_task(this, &JoltPhysicsServer3D::_step_space_task, nullptr, step_spaces.size(), task_count, true, SNAME("Jolt Physics Spaces"));
+		WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_task);
+	} else {
+		for (JoltSpace3D *active_space : active_spaces) {
+			_step_space(active_space);
+		}
 	}
 }
 
+void JoltPhysicsServer3D::_step_space(JoltSpace3D *p_space) {
+	const uint64_t time_begin = OS::get_singleton()->get_ticks_usec();
+
+	job_system->pre_step();
+
+	p_space->step(step_delta);
+
+	job_system->post_step();
+
+	p_space->set_step_time(OS::get_singleton()->get_ticks_usec() - time_begin);
+}
+
+void JoltPhysicsServer3D::_step_space_task(uint32_t p_index, void *p_userdata) {
+	_step_space(step_spaces[p_index]);
+}
+
 void JoltPhysicsServer3D::sync() {
 	doing_sync = true;
 }
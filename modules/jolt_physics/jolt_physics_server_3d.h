@@ -30,6 +30,7 @@
 
 #pragma once
 
+#include "core/templates/local_vector.h"
 #include "core/templates/rid_owner.h"
 #include "servers/physics_server_3d.h"
 
@@ -57,11 +58,18 @@ class JoltPhysicsServer3D final : public PhysicsServer3D {
 
 	JoltJobSystem *job_system = nullptr;
 
+	LocalVector<JoltSpace3D *> step_spaces;
+	int max_concurrent_steps = 1;
+	float step_delta = 0.0f;
+
 	bool on_separate_thread = false;
 	bool active = true;
 	bool flushing_queries = false;
 	bool doing_sync = false;
 
+	void _step_space(JoltSpace3D *p_space);
+	void _step_space_task(uint32_t p_index, void *p_userdata = nullptr);
+
 public:
 	enum HingeJointParamJolt {
 		HINGE_JOINT_LIMIT_SPRING_FREQUENCY = 100,
@@ -162,6 +170,11 @@ public:
 	virtual PackedVector3Array space_get_contacts(RID p_space) const override;
 	virtual int space_get_contact_count(RID p_space) const override;
 
+	virtual PackedByteArray space_snapshot(RID p_space) override;
+	virtual bool space_restore(RID p_space, const PackedByteArray &p_snapshot) override;
+
+	virtual double space_get_step_time(RID p_space) const override;
+
 	virtual RID area_create() override;
 
 	virtual void area_set_space(RID p_area, RID p_space) override;
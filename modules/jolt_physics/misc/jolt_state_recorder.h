@@ -0,0 +1,83 @@
+/**************************************************************************/
+/*  jolt_state_recorder.h                                                 */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#pragma once
+
+#include "core/templates/local_vector.h"
+
+#include "Jolt/Jolt.h"
+
+#include "Jolt/Physics/StateRecorder.h"
+
+// Writes to a reusable buffer or reads from raw memory, unlike `JPH::StateRecorderImpl`, which goes through a `std::stringstream`.
+class JoltStateRecorder final : public JPH::StateRecorder {
+	LocalVector<uint8_t> *write_buffer = nullptr;
+	const uint8_t *read_data = nullptr;
+	size_t read_size = 0;
+	size_t read_offset = 0;
+	bool failed = false;
+
+public:
+	explicit JoltStateRecorder(LocalVector<uint8_t> &p_write_buffer) :
+			write_buffer(&p_write_buffer) {}
+
+	JoltStateRecorder(const uint8_t *p_read_data, size_t p_read_size) :
+			read_data(p_read_data), read_size(p_read_size) {}
+
+	virtual void WriteBytes(const void *p_data, size_t p_bytes) override {
+		if (unlikely(write_buffer == nullptr)) {
+			failed = true;
+			return;
+		}
+
+		const uint32_t offset = write_buffer->size();
+		write_buffer->resize(offset + (uint32_t)p_bytes);
+		memcpy(write_buffer->ptr() + offset, p_data, p_bytes);
+	}
+
+	virtual void ReadBytes(void *p_data, size_t p_bytes) override {
+		if (unlikely(read_data == nullptr || read_offset + p_bytes > read_size)) {
+			failed = true;
+			memset(p_data, 0, p_bytes);
+			return;
+		}
+
+		memcpy(p_data, read_data + read_offset, p_bytes);
+		read_offset += p_bytes;
+	}
+
+	virtual bool IsEOF() const override {
+		return read_offset >= read_size;
+	}
+
+	virtual bool IsFailed() const override {
+		return failed;
+	}
+};
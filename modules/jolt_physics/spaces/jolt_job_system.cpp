@@ -39,27 +39,6 @@
 
 #include "Jolt/Physics/PhysicsSettings.h"
 
-void JoltJobSystem::Job::_execute(void *p_user_data) {
-	Job *job = static_cast<Job *>(p_user_data);
-
-#ifdef DEBUG_ENABLED
-	const uint64_t time_start = Time::get_singleton()->get_ticks_usec();
-#endif
-
-	job->Execute();
-
-#ifdef DEBUG_ENABLED
-	const uint64_t time_end = Time::get_singleton()->get_ticks_usec();
-	const uint64_t time_elapsed = time_end - time_start;
-
-	timings_lock.lock();
-	timings_by_job[job->name] += time_elapsed;
-	timings_lock.unlock();
-#endif
-
-	job->Release();
-}
-
 JoltJobSystem::Job::Job(const char *p_name, JPH::ColorArg p_color, JPH::JobSystem *p_job_system, const JPH::JobSystem::JobFunction &p_job_function, JPH::uint32 p_dependency_count) :
 		JPH::JobSystem::Job(p_name, p_color, p_job_system, p_job_function, p_dependency_count)
 #ifdef DEBUG_ENABLED
@@ -69,12 +48,6 @@ JoltJobSystem::Job::Job(const char *p_name, JPH::ColorArg p_color, JPH::JobSyste
 {
 }
 
-JoltJobSystem::Job::~Job() {
-	if (task_id != -1) {
-		WorkerThreadPool::get_singleton()->wait_for_task_completion(task_id);
-	}
-}
-
 void JoltJobSystem::Job::push_completed(Job *p_job) {
 	Job *prev_head = nullptr;
 
@@ -97,14 +70,118 @@ JoltJobSystem::Job *JoltJobSystem::Job::pop_completed() {
 	return prev_head;
 }
 
-void JoltJobSystem::Job::queue() {
-	AddRef();
+void JoltJobSystem::Job::execute() {
+#ifdef DEBUG_ENABLED
+	const uint64_t time_start = Time::get_singleton()->get_ticks_usec();
+#endif
+
+	Execute();
+
+#ifdef DEBUG_ENABLED
+	const uint64_t time_end = Time::get_singleton()->get_ticks_usec();
+	const uint64_t time_elapsed = time_end - time_start;
+
+	timings_lock.lock();
+	timings_by_job[name] += time_elapsed;
+	timings_lock.unlock();
+#endif
+
+	// Release the reference that was added when the job was queued.
+	Release();
+}
+
+void JoltJobSystem::_worker(void *p_user_data) {
+	JoltJobSystem *job_system = static_cast<JoltJobSystem *>(p_user_data);
+
+	while (true) {
+		while (Job *job = job_system->_pop_job()) {
+			job->execute();
+		}
+
+		int active_count = job_system->active_workers.fetch_sub(1) - 1;
+
+		// A job may have been queued after we found the queue empty but before we stopped counting as an active
+		// worker, in which case whoever queued it will have assumed that we would pick it up, so check once more.
+		if (!job_system->_has_queued_jobs()) {
+			break;
+		}
 
+		bool resumed = false;
+
+		while (active_count < job_system->thread_count) {
+			if (job_system->active_workers.compare_exchange_weak(active_count, active_count + 1)) {
+				resumed = true;
+				break;
+			}
+		}
+
+		if (!resumed) {
+			// The other workers will drain the queue.
+			break;
+		}
+	}
+}
+
+JoltJobSystem::Job *JoltJobSystem::_pop_job() {
+	Job *job = nullptr;
+
+	queue_lock.lock();
+
+	if (queue_head < queue.size()) {
+		job = queue[queue_head++];
+
+		if (queue_head == queue.size()) {
+			queue.clear();
+			queue_head = 0;
+		}
+	}
+
+	queue_lock.unlock();
+
+	return job;
+}
+
+bool JoltJobSystem::_has_queued_jobs() {
+	queue_lock.lock();
+	const bool has_jobs = queue_head < queue.size();
+	queue_lock.unlock();
+
+	return has_jobs;
+}
+
+void JoltJobSystem::_start_workers(int p_queued_count) {
 	// Ideally we would use Jolt's actual job name here, but I'd rather not incur the overhead of a memory allocation or
-	// thread-safe lookup every time we create/queue a task. So instead we use the same cached description for all of them.
+	// thread-safe lookup every time we start a task. So instead we use the same cached description for all of them.
 	static const String task_name("Jolt Physics");
 
-	task_id = WorkerThreadPool::get_singleton()->add_native_task(&_execute, this, true, task_name);
+	const int desired_count = MIN(p_queued_count, thread_count);
+	int active_count = active_workers.load();
+
+	while (active_count < desired_count) {
+		if (!active_workers.compare_exchange_weak(active_count, active_count + 1)) {
+			continue;
+		}
+
+		const WorkerThreadPool::TaskID task_id = WorkerThreadPool::get_singleton()->add_native_task(&_worker, this, true, task_name);
+
+		worker_tasks_lock.lock();
+		worker_tasks.push_back(task_id);
+		worker_tasks_lock.unlock();
+
+		active_count += 1;
+	}
+}
+
+void JoltJobSystem::_wait_for_workers() {
+	LocalVector<WorkerThreadPool::TaskID> tasks;
+
+	worker_tasks_lock.lock();
+	SWAP(tasks, worker_tasks);
+	worker_tasks_lock.unlock();
+
+	for (WorkerThreadPool::TaskID task_id : tasks) {
+		WorkerThreadPool::get_singleton()->wait_for_task_completion(task_id);
+	}
 }
 
 int JoltJobSystem::GetMaxConcurrency() const {
@@ -140,13 +217,23 @@ JPH::JobHandle JoltJobSystem::CreateJob(const char *p_name, JPH::ColorArg p_colo
 }
 
 void JoltJobSystem::QueueJob(JPH::JobSystem::Job *p_job) {
-	static_cast<Job *>(p_job)->queue();
+	QueueJobs(&p_job, 1);
 }
 
 void JoltJobSystem::QueueJobs(JPH::JobSystem::Job **p_jobs, JPH::uint p_job_count) {
+	queue_lock.lock();
+
 	for (JPH::uint i = 0; i < p_job_count; ++i) {
-		QueueJob(p_jobs[i]);
+		// The queue holds a reference to the job until it has been executed.
+		p_jobs[i]->AddRef();
+		queue.push_back(static_cast<Job *>(p_jobs[i]));
 	}
+
+	const int queued_count = int(queue.size() - queue_head);
+
+	queue_lock.unlock();
+
+	_start_workers(queued_count);
 }
 
 void JoltJobSystem::FreeJob(JPH::JobSystem::Job *p_job) {
@@ -154,15 +241,26 @@ void JoltJobSystem::FreeJob(JPH::JobSystem::Job *p_job) {
 }
 
 void JoltJobSystem::_reclaim_jobs() {
+	MutexLock reclaim_lock(reclaim_mutex);
+
 	while (Job *job = Job::pop_completed()) {
 		jobs.DestructObject(job);
 	}
 }
 
-JoltJobSystem::JoltJobSystem() :
-		JPH::JobSystemWithBarrier(JPH::cMaxPhysicsBarriers),
+JoltJobSystem::JoltJobSystem(int p_max_concurrent_steps) :
+		JPH::JobSystemWithBarrier(JPH::cMaxPhysicsBarriers * MAX(1, p_max_concurrent_steps)),
 		thread_count(MAX(1, WorkerThreadPool::get_singleton()->get_thread_count())) {
-	jobs.Init(JPH::cMaxPhysicsJobs, JPH::cMaxPhysicsJobs);
+	// Every space that is stepping at the same time needs its own share of jobs and barriers. The pages of
+	// the free list are only allocated once they're needed, so this costs nothing when stepping serially.
+	const JPH::uint max_jobs = JPH::cMaxPhysicsJobs * (JPH::uint)MAX(1, p_max_concurrent_steps);
+	jobs.Init(max_jobs, JPH::cMaxPhysicsJobs);
+	queue.reserve(JPH::cMaxPhysicsJobs);
+}
+
+JoltJobSystem::~JoltJobSystem() {
+	_wait_for_workers();
+	_reclaim_jobs();
 }
 
 void JoltJobSystem::pre_step() {
@@ -170,6 +268,8 @@ void JoltJobSystem::pre_step() {
 }
 
 void JoltJobSystem::post_step() {
+	// All jobs will have finished by now, but the workers that ran them might still be on their way out.
+	_wait_for_workers();
 	_reclaim_jobs();
 }
 
@@ -30,8 +30,11 @@
 
 #pragma once
 
+#include "core/object/worker_thread_pool.h"
+#include "core/os/mutex.h"
 #include "core/os/spin_lock.h"
 #include "core/templates/hash_map.h"
+#include "core/templates/local_vector.h"
 
 #include "Jolt/Jolt.h"
 
@@ -48,22 +51,17 @@ class JoltJobSystem final : public JPH::JobSystemWithBarrier {
 		const char *name = nullptr;
 #endif
 
-		int64_t task_id = -1;
-
 		std::atomic<Job *> completed_next = nullptr;
 
-		static void _execute(void *p_user_data);
-
 	public:
 		Job(const char *p_name, JPH::ColorArg p_color, JPH::JobSystem *p_job_system, const JPH::JobSystem::JobFunction &p_job_function, JPH::uint32 p_dependency_count);
 		Job(const Job &p_other) = delete;
 		Job(Job &&p_other) = delete;
-		~Job();
 
 		static void push_completed(Job *p_job);
 		static Job *pop_completed();
 
-		void queue();
+		void execute();
 
 		Job &operator=(const Job &p_other) = delete;
 		Job &operator=(Job &&p_other) = delete;
@@ -80,8 +78,25 @@ class JoltJobSystem final : public JPH::JobSystemWithBarrier {
 
 	JPH::FixedSizeFreeList<Job> jobs;
 
+	// Completed jobs are pushed from any thread, but must only be popped by one thread at a time.
+	BinaryMutex reclaim_mutex;
+
+	// Rather than handing every job to the worker thread pool as its own task, queued jobs go into this
+	// queue and are drained by at most `thread_count` worker tasks, which are only started when there
+	// are more queued jobs than there are workers currently draining them.
+	LocalVector<Job *> queue;
+	uint32_t queue_head = 0;
+	SpinLock queue_lock;
+
+	LocalVector<WorkerThreadPool::TaskID> worker_tasks;
+	SpinLock worker_tasks_lock;
+
+	std::atomic<int> active_workers = 0;
+
 	int thread_count = 0;
 
+	static void _worker(void *p_user_data);
+
 	virtual int GetMaxConcurrency() const override;
 
 	virtual JPH::JobHandle CreateJob(const char *p_name, JPH::ColorArg p_color, const JPH::JobSystem::JobFunction &p_job_function, JPH::uint32 p_dependency_count = 0) override;
@@ -89,10 +104,16 @@ class JoltJobSystem final : public JPH::JobSystemWithBarrier {
 	virtual void QueueJobs(JPH::JobSystem::Job **p_jobs, JPH::uint p_job_count) override;
 	virtual void FreeJob(JPH::JobSystem::Job *p_job) override;
 
+	Job *_pop_job();
+	bool _has_queued_jobs();
+	void _start_workers(int p_queued_count);
+	void _wait_for_workers();
+
 	void _reclaim_jobs();
 
 public:
-	JoltJobSystem();
+	explicit JoltJobSystem(int p_max_concurrent_steps = 1);
+	~JoltJobSystem();
 
 	void pre_step();
 	void post_step();
@@ -33,6 +33,7 @@
 #include "../joints/jolt_joint_3d.h"
 #include "../jolt_physics_server_3d.h"
 #include "../jolt_project_settings.h"
+#include "../misc/jolt_state_recorder.h"
 #include "../misc/jolt_stream_wrappers.h"
 #include "../objects/jolt_area_3d.h"
 #include "../objects/jolt_body_3d.h"
@@ -48,6 +49,7 @@
 #include "core/string/print_string.h"
 #include "core/variant/variant_utility.h"
 
+#include "Jolt/Physics/Constraints/TwoBodyConstraint.h"
 #include "Jolt/Physics/PhysicsScene.h"
 
 namespace {
@@ -60,6 +62,8 @@ constexpr double DEFAULT_SLEEP_THRESHOLD_LINEAR = 0.1;
 constexpr double DEFAULT_SLEEP_THRESHOLD_ANGULAR = 8.0 * Math_PI / 180;
 constexpr double DEFAULT_SOLVER_ITERATIONS = 8;
 
+constexpr uint32_t SNAPSHOT_MAGIC = 0x33534a47; // "GJS3"
+
 } // namespace
 
 void JoltSpace3D::_pre_step(float p_step) {
@@ -206,6 +210,131 @@ void JoltSpace3D::call_queries() {
 	}
 }
 
+PackedByteArray JoltSpace3D::save_snapshot() {
+	// Jolt's own state covers bodies, contact caches (warm starting) and constraints. It's preceded by the list of
+	// bodies and constraints it references, so that restoring can validate them before Jolt modifies anything.
+	snapshot_buffer.clear();
+
+	JoltStateRecorder recorder(snapshot_buffer);
+	recorder.Write(SNAPSHOT_MAGIC);
+
+	JPH::BodyIDVector body_ids;
+	physics_system->GetBodies(body_ids);
+
+	const JPH::BodyLockInterface &lock_iface = get_lock_iface();
+
+	LocalVector<JPH::BodyID> saved_body_ids;
+	saved_body_ids.reserve((uint32_t)body_ids.size());
+
+	for (const JPH::BodyID &body_id : body_ids) {
+		const JPH::BodyLockRead lock(lock_iface, body_id);
+		if (lock.Succeeded() && lock.GetBody().IsInBroadPhase()) {
+			saved_body_ids.push_back(body_id);
+		}
+	}
+
+	recorder.Write((uint32_t)saved_body_ids.size());
+	for (const JPH::BodyID &body_id : saved_body_ids) {
+		recorder.Write(body_id);
+	}
+
+	const JPH::Constraints constraints = physics_system->GetConstraints();
+
+	recorder.Write((uint32_t)constraints.size());
+	for (const JPH::Ref<JPH::Constraint> &constraint : constraints) {
+		_write_constraint_header(recorder, *constraint);
+	}
+
+	physics_system->SaveState(recorder);
+
+	ERR_FAIL_COND_V(recorder.IsFailed(), PackedByteArray());
+
+	PackedByteArray snapshot;
+	snapshot.resize(snapshot_buffer.size());
+	memcpy(snapshot.ptrw(), snapshot_buffer.ptr(), snapshot_buffer.size());
+
+	return snapshot;
+}
+
+bool JoltSpace3D::restore_snapshot(const PackedByteArray &p_snapshot) {
+	JoltStateRecorder recorder(p_snapshot.ptr(), (size_t)p_snapshot.size());
+
+	uint32_t magic = 0;
+	recorder.Read(magic);
+	ERR_FAIL_COND_V_MSG(recorder.IsFailed() || magic != SNAPSHOT_MAGIC, false, "Invalid physics space snapshot.");
+
+	// `PhysicsSystem::RestoreState` bails out halfway through when it runs into a body or constraint that no longer
+	// exists, leaving the bodies before it overwritten and the broadphase out of date, so everything is checked up front.
+	const JPH::BodyLockInterface &lock_iface = get_lock_iface();
+
+	uint32_t body_count = 0;
+	recorder.Read(body_count);
+	ERR_FAIL_COND_V_MSG(recorder.IsFailed(), false, "Invalid physics space snapshot.");
+
+	for (uint32_t i = 0; i < body_count; i++) {
+		JPH::BodyID body_id;
+		recorder.Read(body_id);
+		ERR_FAIL_COND_V_MSG(recorder.IsFailed(), false, "Invalid physics space snapshot.");
+
+		const JPH::BodyLockRead lock(lock_iface, body_id);
+		ERR_FAIL_COND_V_MSG(!lock.Succeeded() || !lock.GetBody().IsInBroadPhase(), false, "Failed to restore physics space snapshot. It references a body that has been removed since it was taken.");
+	}
+
+	const JPH::Constraints constraints = physics_system->GetConstraints();
+
+	uint32_t constraint_count = 0;
+	recorder.Read(constraint_count);
+	ERR_FAIL_COND_V_MSG(recorder.IsFailed(), false, "Invalid physics space snapshot.");
+	ERR_FAIL_COND_V_MSG(constraint_count > constraints.size(), false, "Failed to restore physics space snapshot. It references a joint that has been removed since it was taken.");
+
+	for (uint32_t i = 0; i < constraint_count; i++) {
+		ERR_FAIL_COND_V_MSG(!_read_constraint_header(recorder, *constraints[i]), false, "Failed to restore physics space snapshot. It references a joint that has been removed since it was taken.");
+	}
+
+	const bool restored = physics_system->RestoreState(recorder);
+	ERR_FAIL_COND_V_MSG(!restored || recorder.IsFailed(), false, "Failed to restore physics space snapshot.");
+
+	return true;
+}
+
+void JoltSpace3D::_write_constraint_header(JoltStateRecorder &p_recorder, const JPH::Constraint &p_constraint) {
+	p_recorder.Write(p_constraint.GetSubType());
+
+	JPH::BodyID body_id1;
+	JPH::BodyID body_id2;
+
+	if (p_constraint.GetType() == JPH::EConstraintType::TwoBodyConstraint) {
+		const JPH::TwoBodyConstraint &two_body_constraint = static_cast<const JPH::TwoBodyConstraint &>(p_constraint);
+		body_id1 = two_body_constraint.GetBody1()->GetID();
+		body_id2 = two_body_constraint.GetBody2()->GetID();
+	}
+
+	p_recorder.Write(body_id1);
+	p_recorder.Write(body_id2);
+}
+
+bool JoltSpace3D::_read_constraint_header(JoltStateRecorder &p_recorder, const JPH::Constraint &p_constraint) {
+	// Constraints are removed by swapping in the last one, so an index alone can end up pointing at another joint.
+	JPH::EConstraintSubType sub_type = JPH::EConstraintSubType::User1;
+	JPH::BodyID body_id1;
+	JPH::BodyID body_id2;
+
+	p_recorder.Read(sub_type);
+	p_recorder.Read(body_id1);
+	p_recorder.Read(body_id2);
+
+	if (p_recorder.IsFailed() || sub_type != p_constraint.GetSubType()) {
+		return false;
+	}
+
+	if (p_constraint.GetType() == JPH::EConstraintType::TwoBodyConstraint) {
+		const JPH::TwoBodyConstraint &two_body_constraint = static_cast<const JPH::TwoBodyConstraint &>(p_constraint);
+		return body_id1 == two_body_constraint.GetBody1()->GetID() && body_id2 == two_body_constraint.GetBody2()->GetID();
+	}
+
+	return body_id1.IsInvalid() && body_id2.IsInvalid();
+}
+
 double JoltSpace3D::get_param(PhysicsServer3D::SpaceParameter p_param) const {
 	switch (p_param) {
 		case PhysicsServer3D::SPACE_PARAM_CONTACT_RECYCLE_RADIUS: {
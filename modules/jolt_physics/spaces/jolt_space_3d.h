@@ -32,6 +32,7 @@
 
 #include "jolt_body_accessor_3d.h"
 
+#include "core/templates/local_vector.h"
 #include "servers/physics_server_3d.h"
 
 #include "Jolt/Jolt.h"
@@ -52,6 +53,7 @@ class JoltLayers;
 class JoltObject3D;
 class JoltPhysicsDirectSpaceState3D;
 class JoltShapedObject3D;
+class JoltStateRecorder;
 
 class JoltSpace3D {
 	SelfList<JoltBody3D>::List body_call_queries_list;
@@ -69,8 +71,12 @@ class JoltSpace3D {
 	JoltPhysicsDirectSpaceState3D *direct_state = nullptr;
 	JoltArea3D *default_area = nullptr;
 
+	LocalVector<uint8_t> snapshot_buffer;
+
 	float last_step = 0.0f;
 
+	uint64_t step_time = 0;
+
 	int bodies_added_since_optimizing = 0;
 
 	bool active = false;
@@ -79,6 +85,9 @@ class JoltSpace3D {
 	void _pre_step(float p_step);
 	void _post_step(float p_step);
 
+	static void _write_constraint_header(JoltStateRecorder &p_recorder, const JPH::Constraint &p_constraint);
+	static bool _read_constraint_header(JoltStateRecorder &p_recorder, const JPH::Constraint &p_constraint);
+
 public:
 	explicit JoltSpace3D(JPH::JobSystem *p_job_system);
 	~JoltSpace3D();
@@ -87,6 +96,9 @@ public:
 
 	void call_queries();
 
+	PackedByteArray save_snapshot();
+	bool restore_snapshot(const PackedByteArray &p_snapshot);
+
 	RID get_rid() const { return rid; }
 	void set_rid(const RID &p_rid) { rid = p_rid; }
 
@@ -128,6 +140,9 @@ public:
 
 	float get_last_step() const { return last_step; }
 
+	void set_step_time(uint64_t p_usec) { step_time = p_usec; }
+	uint64_t get_step_time() const { return step_time; }
+
 	JPH::BodyID add_rigid_body(const JoltObject3D &p_object, const JPH::BodyCreationSettings &p_settings, bool p_sleeping = false);
 	JPH::BodyID add_soft_body(const JoltObject3D &p_object, const JPH::SoftBodyCreationSettings &p_settings, bool p_sleeping = false);
 
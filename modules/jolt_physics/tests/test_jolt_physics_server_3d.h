@@ -0,0 +1,139 @@
+/**************************************************************************/
+/*  test_jolt_physics_server_3d.h                                         */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#pragma once
+
+#include "../jolt_physics_server_3d.h"
+
+#include "tests/test_macros.h"
+
+namespace TestJoltPhysicsServer3D {
+
+// Adds a static floor, whose top is at a height of zero, and a box starting at `p_position` above it.
+// Both bodies are added to `r_bodies`, the box is returned.
+RID add_falling_box(PhysicsServer3D *p_server, RID p_space, RID p_floor_shape, RID p_box_shape, const Vector3 &p_position, LocalVector<RID> &r_bodies) {
+	RID floor = p_server->body_create();
+	p_server->body_set_mode(floor, PhysicsServer3D::BODY_MODE_STATIC);
+	p_server->body_set_space(floor, p_space);
+	p_server->body_add_shape(floor, p_floor_shape);
+	p_server->body_set_state(floor, PhysicsServer3D::BODY_STATE_TRANSFORM, Transform3D(Basis(), Vector3(p_position.x, -0.5, p_position.z)));
+
+	RID box = p_server->body_create();
+	p_server->body_set_mode(box, PhysicsServer3D::BODY_MODE_RIGID);
+	p_server->body_set_space(box, p_space);
+	p_server->body_add_shape(box, p_box_shape);
+	p_server->body_set_state(box, PhysicsServer3D::BODY_STATE_TRANSFORM, Transform3D(Basis(), p_position));
+
+	r_bodies.push_back(floor);
+	r_bodies.push_back(box);
+	return box;
+}
+
+TEST_CASE("[JoltPhysics] Snapshot and restore a space") {
+	JoltPhysicsServer3D *server = memnew(JoltPhysicsServer3D(false));
+	server->init();
+
+	RID floor_shape = server->box_shape_create();
+	server->shape_set_data(floor_shape, Vector3(10, 0.5, 10));
+	RID box_shape = server->box_shape_create();
+	server->shape_set_data(box_shape, Vector3(0.5, 0.5, 0.5));
+
+	RID space = server->space_create();
+	server->space_set_active(space, true);
+
+	LocalVector<RID> bodies;
+	RID box = add_falling_box(server, space, floor_shape, box_shape, Vector3(0, 3, 0), bodies);
+
+	for (int i = 0; i < 20; i++) {
+		server->step(1.0 / 60.0);
+	}
+
+	SUBCASE("Restoring a snapshot rewinds the space") {
+		const Transform3D saved_transform = server->body_get_state(box, PhysicsServer3D::BODY_STATE_TRANSFORM);
+		const Vector3 saved_velocity = server->body_get_state(box, PhysicsServer3D::BODY_STATE_LINEAR_VELOCITY);
+		const PackedByteArray snapshot = server->space_snapshot(space);
+		REQUIRE_FALSE(snapshot.is_empty());
+
+		for (int i = 0; i < 40; i++) {
+			server->step(1.0 / 60.0);
+		}
+		const Transform3D stepped_transform = server->body_get_state(box, PhysicsServer3D::BODY_STATE_TRANSFORM);
+		CHECK_FALSE(stepped_transform.origin.is_equal_approx(saved_transform.origin));
+
+		CHECK(server->space_restore(space, snapshot));
+		const Transform3D restored_transform = server->body_get_state(box, PhysicsServer3D::BODY_STATE_TRANSFORM);
+		const Vector3 restored_velocity = server->body_get_state(box, PhysicsServer3D::BODY_STATE_LINEAR_VELOCITY);
+		CHECK(restored_transform.origin.is_equal_approx(saved_transform.origin));
+		CHECK(restored_velocity.is_equal_approx(saved_velocity));
+
+		// Stepping again from the restored state must replay the same simulation.
+		for (int i = 0; i < 40; i++) {
+			server->step(1.0 / 60.0);
+		}
+		const Transform3D replayed_transform = server->body_get_state(box, PhysicsServer3D::BODY_STATE_TRANSFORM);
+		CHECK(replayed_transform.origin.is_equal_approx(stepped_transform.origin));
+	}
+
+	SUBCASE("Restoring a snapshot that references a removed body fails without changes") {
+		RID extra_box = server->body_create();
+		server->body_set_mode(extra_box, PhysicsServer3D::BODY_MODE_RIGID);
+		server->body_set_space(extra_box, space);
+		server->body_add_shape(extra_box, box_shape, Transform3D(), false);
+		server->body_set_state(extra_box, PhysicsServer3D::BODY_STATE_TRANSFORM, Transform3D(Basis(), Vector3(3, 3, 0)));
+
+		const PackedByteArray snapshot = server->space_snapshot(space);
+		REQUIRE_FALSE(snapshot.is_empty());
+
+		server->free(extra_box);
+		for (int i = 0; i < 10; i++) {
+			server->step(1.0 / 60.0);
+		}
+		const Transform3D current_transform = server->body_get_state(box, PhysicsServer3D::BODY_STATE_TRANSFORM);
+
+		ERR_PRINT_OFF;
+		CHECK_FALSE(server->space_restore(space, snapshot));
+		ERR_PRINT_ON;
+
+		const Transform3D transform = server->body_get_state(box, PhysicsServer3D::BODY_STATE_TRANSFORM);
+		CHECK(transform.origin == current_transform.origin);
+	}
+
+	for (const RID &body : bodies) {
+		server->free(body);
+	}
+	server->free(space);
+	server->free(box_shape);
+	server->free(floor_shape);
+
+	server->finish();
+	memdelete(server);
+}
+
+} // namespace TestJoltPhysicsServer3D
@@ -103,6 +103,12 @@ Error jpeg_load_image_from_buffer(Image *p_image, const uint8_t *p_buffer, int p
 }
 
 Error ImageLoaderJPG::load_image(Ref<Image> p_image, Ref<FileAccess> f, BitField<ImageFormatLoader::LoaderFlags> p_flags, float p_scale) {
+	const Span<uint8_t> mapped = f->get_mapped_span();
+	if (!mapped.is_empty()) {
+		// Decode in place, no need to copy the file.
+		return jpeg_load_image_from_buffer(p_image.ptr(), mapped.ptr(), mapped.size());
+	}
+
 	Vector<uint8_t> src_image;
 	uint64_t src_image_len = f->get_length();
 	ERR_FAIL_COND_V(src_image_len == 0, ERR_FILE_CORRUPT);
@@ -61,6 +61,8 @@ void NavMapBuilder2D::build_navmap_iteration(NavMapIterationBuild2D &r_build) {
 
 	_build_step_gather_region_polygons(r_build);
 
+	_build_step_polygon_bvh(r_build);
+
 	_build_step_find_edge_connection_pairs(r_build);
 
 	_build_step_merge_edge_connection_pairs(r_build);
@@ -102,6 +104,23 @@ void NavMapBuilder2D::_build_step_gather_region_polygons(NavMapIterationBuild2D
 	r_build.polygon_count = polygon_count;
 }
 
+void NavMapBuilder2D::_build_step_polygon_bvh(NavMapIterationBuild2D &r_build) {
+	NavMapIteration2D *map_iteration = r_build.map_iteration;
+
+	LocalVector<const Polygon *> polygons;
+	polygons.reserve(r_build.polygon_count);
+	for (const NavRegionIteration2D &region : map_iteration->region_iterations) {
+		if (!region.get_enabled()) {
+			continue;
+		}
+		for (const Polygon &polygon : region.navmesh_polygons) {
+			polygons.push_back(&polygon);
+		}
+	}
+
+	map_iteration->polygon_bvh.build(polygons);
+}
+
 void NavMapBuilder2D::_build_step_find_edge_connection_pairs(NavMapIterationBuild2D &r_build) {
 	PerformanceData &performance_data = r_build.performance_data;
 	NavMapIteration2D *map_iteration = r_build.map_iteration;
@@ -36,6 +36,7 @@ struct NavMapIterationBuild2D;
 
 class NavMapBuilder2D {
 	static void _build_step_gather_region_polygons(NavMapIterationBuild2D &r_build);
+	static void _build_step_polygon_bvh(NavMapIterationBuild2D &r_build);
 	static void _build_step_find_edge_connection_pairs(NavMapIterationBuild2D &r_build);
 	static void _build_step_merge_edge_connection_pairs(NavMapIterationBuild2D &r_build);
 	static void _build_step_edge_connection_margin_connections(NavMapIterationBuild2D &r_build);
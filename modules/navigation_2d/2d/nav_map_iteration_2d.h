@@ -33,6 +33,7 @@
 #include "../nav_rid_2d.h"
 #include "../nav_utils_2d.h"
 #include "nav_mesh_queries_2d.h"
+#include "nav_polygon_bvh_2d.h"
 
 #include "core/math/math_defs.h"
 #include "core/os/semaphore.h"
@@ -84,6 +85,9 @@ struct NavMapIteration2D {
 	int navmesh_polygon_count = 0;
 	int link_polygon_count = 0;
 
+	// Spatial index over all region polygons, used by the closest point and path start/end lookups.
+	NavPolygonBVH2D polygon_bvh;
+
 	// The edge connections that the map builds on top with the edge connection margin.
 	HashMap<uint32_t, LocalVector<nav_2d::Edge::Connection>> external_region_connections;
 
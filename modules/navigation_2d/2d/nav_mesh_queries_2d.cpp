@@ -33,6 +33,8 @@
 #include "../nav_base_2d.h"
 #include "../nav_map_2d.h"
 #include "../triangle2.h"
+#include "nav_map_iteration_2d.h"
+#include "nav_polygon_bvh_2d.h"
 #include "nav_region_iteration_2d.h"
 
 #include "core/math/geometry_2d.h"
@@ -231,52 +233,45 @@ void NavMeshQueries2D::map_query_path(NavMap2D *p_map, const Ref<NavigationPathQ
 }
 
 void NavMeshQueries2D::_query_task_find_start_end_positions(NavMeshPathQueryTask2D &p_query_task, const NavMapIteration2D &p_map_iteration) {
-	real_t begin_d = FLT_MAX;
-	real_t end_d = FLT_MAX;
-
-	const LocalVector<NavRegionIteration2D> &regions = p_map_iteration.region_iterations;
-
-	for (const NavRegionIteration2D &region : regions) {
-		if (!region.get_enabled()) {
-			continue;
-		}
-
-		if (p_query_task.exclude_regions && p_query_task.excluded_regions.has(region.get_self())) {
-			continue;
-		}
-		if (p_query_task.include_regions && !p_query_task.included_regions.has(region.get_self())) {
-			continue;
-		}
-
-		// Find the initial poly and the end poly on this map.
-		for (const Polygon &p : region.get_navmesh_polygons()) {
+	// Find the initial poly and the end poly on this map.
+	auto find_closest_polygon = [&p_query_task, &p_map_iteration](const Vector2 &p_position, const Polygon *&r_polygon, Vector2 &r_closest_point) {
+		real_t closest_distance_squared = FLT_MAX;
+		p_map_iteration.polygon_bvh.cull_nearest(p_position, closest_distance_squared, [&](const Polygon &p_polygon, real_t &r_distance_squared) {
+			const NavBaseIteration2D *owner = p_polygon.owner;
+			if (!owner->get_enabled()) {
+				return true;
+			}
+			if (p_query_task.exclude_regions && p_query_task.excluded_regions.has(owner->get_self())) {
+				return true;
+			}
+			if (p_query_task.include_regions && !p_query_task.included_regions.has(owner->get_self())) {
+				return true;
+			}
 			// Only consider the polygon if it in a region with compatible layers.
-			if ((p_query_task.navigation_layers & p.owner->get_navigation_layers()) == 0) {
-				continue;
+			if ((p_query_task.navigation_layers & owner->get_navigation_layers()) == 0) {
+				return true;
 			}
 
-			// For each triangle check the distance between the origin/destination.
-			for (uint32_t point_id = 2; point_id < p.points.size(); point_id++) {
-				const Triangle2 triangle(p.points[0].pos, p.points[point_id - 1].pos, p.points[point_id].pos);
-
-				Vector2 point = triangle.get_closest_point_to(p_query_task.start_position);
-				real_t distance_to_point = point.distance_to(p_query_task.start_position);
-				if (distance_to_point < begin_d) {
-					begin_d = distance_to_point;
-					p_query_task.begin_polygon = &p;
-					p_query_task.begin_position = point;
-				}
+			// For each triangle check the distance to the position.
+			for (uint32_t point_id = 2; point_id < p_polygon.points.size(); point_id++) {
+				const Triangle2 triangle(p_polygon.points[0].pos, p_polygon.points[point_id - 1].pos, p_polygon.points[point_id].pos);
 
-				point = triangle.get_closest_point_to(p_query_task.target_position);
-				distance_to_point = point.distance_to(p_query_task.target_position);
-				if (distance_to_point < end_d) {
-					end_d = distance_to_point;
-					p_query_task.end_polygon = &p;
-					p_query_task.end_position = point;
+				const Vector2 point = triangle.get_closest_point_to(p_position);
+				const real_t distance_squared = point.distance_squared_to(p_position);
+				if (distance_squared < r_distance_squared) {
+					r_distance_squared = distance_squared;
+					r_polygon = &p_polygon;
+					r_closest_point = point;
 				}
 			}
-		}
-	}
+
+			// Nothing can be closer than a polygon the position is on.
+			return r_distance_squared > 0.0;
+		});
+	};
+
+	find_closest_polygon(p_query_task.start_position, p_query_task.begin_polygon, p_query_task.begin_position);
+	find_closest_polygon(p_query_task.target_position, p_query_task.end_polygon, p_query_task.end_position);
 }
 
 void NavMeshQueries2D::_query_task_build_path_corridor(NavMeshPathQueryTask2D &p_query_task) {
@@ -728,70 +723,7 @@ RID NavMeshQueries2D::map_iteration_get_closest_point_owner(const NavMapIteratio
 }
 
 ClosestPointQueryResult NavMeshQueries2D::map_iteration_get_closest_point_info(const NavMapIteration2D &p_map_iteration, const Vector2 &p_point) {
-	ClosestPointQueryResult result;
-	real_t closest_point_distance_squared = FLT_MAX;
-
-	// TODO: Check for further 2D improvements.
-
-	const LocalVector<NavRegionIteration2D> &regions = p_map_iteration.region_iterations;
-	for (const NavRegionIteration2D &region : regions) {
-		for (const Polygon &polygon : region.get_navmesh_polygons()) {
-			real_t cross = (polygon.points[1].pos - polygon.points[0].pos).cross(polygon.points[2].pos - polygon.points[0].pos);
-			Vector2 closest_on_polygon;
-			real_t closest = FLT_MAX;
-			bool inside = true;
-			Vector2 previous = polygon.points[polygon.points.size() - 1].pos;
-			for (uint32_t point_id = 0; point_id < polygon.points.size(); ++point_id) {
-				Vector2 edge = polygon.points[point_id].pos - previous;
-				Vector2 to_point = p_point - previous;
-				real_t edge_to_point_cross = edge.cross(to_point);
-				bool clockwise = (edge_to_point_cross * cross) > 0;
-				// If we are not clockwise, the point will never be inside the polygon and so the closest point will be on an edge.
-				if (!clockwise) {
-					inside = false;
-					real_t point_projected_on_edge = edge.dot(to_point);
-					real_t edge_square = edge.length_squared();
-
-					if (point_projected_on_edge > edge_square) {
-						real_t distance = polygon.points[point_id].pos.distance_squared_to(p_point);
-						if (distance < closest) {
-							closest_on_polygon = polygon.points[point_id].pos;
-							closest = distance;
-						}
-					} else if (point_projected_on_edge < 0.0) {
-						real_t distance = previous.distance_squared_to(p_point);
-						if (distance < closest) {
-							closest_on_polygon = previous;
-							closest = distance;
-						}
-					} else {
-						// If we project on this edge, this will be the closest point.
-						real_t percent = point_projected_on_edge / edge_square;
-						closest_on_polygon = previous + percent * edge;
-						break;
-					}
-				}
-				previous = polygon.points[point_id].pos;
-			}
-
-			if (inside) {
-				closest_point_distance_squared = 0.0;
-				result.point = p_point;
-				result.owner = polygon.owner->get_self();
-
-				break;
-			} else {
-				real_t distance = closest_on_polygon.distance_squared_to(p_point);
-				if (distance < closest_point_distance_squared) {
-					closest_point_distance_squared = distance;
-					result.point = closest_on_polygon;
-					result.owner = polygon.owner->get_self();
-				}
-			}
-		}
-	}
-
-	return result;
+	return polygon_bvh_get_closest_point_info(p_map_iteration.polygon_bvh, p_point);
 }
 
 Vector2 NavMeshQueries2D::map_iteration_get_random_point(const NavMapIteration2D &p_map_iteration, uint32_t p_navigation_layers, bool p_uniformly) {
@@ -865,65 +797,26 @@ ClosestPointQueryResult NavMeshQueries2D::polygons_get_closest_point_info(const
 	ClosestPointQueryResult result;
 	real_t closest_point_distance_squared = FLT_MAX;
 
-	// TODO: Check for further 2D improvements.
-
 	for (const Polygon &polygon : p_polygons) {
-		real_t cross = (polygon.points[1].pos - polygon.points[0].pos).cross(polygon.points[2].pos - polygon.points[0].pos);
-		Vector2 closest_on_polygon;
-		real_t closest = FLT_MAX;
-		bool inside = true;
-		Vector2 previous = polygon.points[polygon.points.size() - 1].pos;
-		for (uint32_t point_id = 0; point_id < polygon.points.size(); ++point_id) {
-			Vector2 edge = polygon.points[point_id].pos - previous;
-			Vector2 to_point = p_point - previous;
-			real_t edge_to_point_cross = edge.cross(to_point);
-			bool clockwise = (edge_to_point_cross * cross) > 0;
-			// If we are not clockwise, the point will never be inside the polygon and so the closest point will be on an edge.
-			if (!clockwise) {
-				inside = false;
-				real_t point_projected_on_edge = edge.dot(to_point);
-				real_t edge_square = edge.length_squared();
-
-				if (point_projected_on_edge > edge_square) {
-					real_t distance = polygon.points[point_id].pos.distance_squared_to(p_point);
-					if (distance < closest) {
-						closest_on_polygon = polygon.points[point_id].pos;
-						closest = distance;
-					}
-				} else if (point_projected_on_edge < 0.0) {
-					real_t distance = previous.distance_squared_to(p_point);
-					if (distance < closest) {
-						closest_on_polygon = previous;
-						closest = distance;
-					}
-				} else {
-					// If we project on this edge, this will be the closest point.
-					real_t percent = point_projected_on_edge / edge_square;
-					closest_on_polygon = previous + percent * edge;
-					break;
-				}
-			}
-			previous = polygon.points[point_id].pos;
-		}
-
-		if (inside) {
-			closest_point_distance_squared = 0.0;
-			result.point = p_point;
-			result.owner = polygon.owner->get_self();
+		if (_polygon_get_closest_point_info(polygon, p_point, closest_point_distance_squared, result)) {
 			break;
-		} else {
-			real_t distance = closest_on_polygon.distance_squared_to(p_point);
-			if (distance < closest_point_distance_squared) {
-				closest_point_distance_squared = distance;
-				result.point = closest_on_polygon;
-				result.owner = polygon.owner->get_self();
-			}
 		}
 	}
 
 	return result;
 }
 
+ClosestPointQueryResult NavMeshQueries2D::polygon_bvh_get_closest_point_info(const NavPolygonBVH2D &p_polygon_bvh, const Vector2 &p_point) {
+	ClosestPointQueryResult result;
+	real_t closest_point_distance_squared = FLT_MAX;
+
+	p_polygon_bvh.cull_nearest(p_point, closest_point_distance_squared, [&](const Polygon &p_polygon, real_t &r_distance_squared) {
+		return !_polygon_get_closest_point_info(p_polygon, p_point, r_distance_squared, result);
+	});
+
+	return result;
+}
+
 RID NavMeshQueries2D::polygons_get_closest_point_owner(const LocalVector<Polygon> &p_polygons, const Vector2 &p_point) {
 	ClosestPointQueryResult cp = polygons_get_closest_point_info(p_polygons, p_point);
 	return cp.owner;
@@ -1056,3 +949,60 @@ void NavMeshQueries2D::simplify_path_segment(int p_start_inx, int p_end_inx, con
 		simplify_path_segment(point_max_index, p_end_inx, p_points, p_epsilon, r_simplified_path_indices);
 	}
 }
+
+bool NavMeshQueries2D::_polygon_get_closest_point_info(const Polygon &p_polygon, const Vector2 &p_point, real_t &r_closest_point_distance_squared, ClosestPointQueryResult &r_result) {
+	real_t cross = (p_polygon.points[1].pos - p_polygon.points[0].pos).cross(p_polygon.points[2].pos - p_polygon.points[0].pos);
+	Vector2 closest_on_polygon;
+	real_t closest = FLT_MAX;
+	bool inside = true;
+	Vector2 previous = p_polygon.points[p_polygon.points.size() - 1].pos;
+	for (uint32_t point_id = 0; point_id < p_polygon.points.size(); ++point_id) {
+		Vector2 edge = p_polygon.points[point_id].pos - previous;
+		Vector2 to_point = p_point - previous;
+		real_t edge_to_point_cross = edge.cross(to_point);
+		bool clockwise = (edge_to_point_cross * cross) > 0;
+		// If we are not clockwise, the point will never be inside the polygon and so the closest point will be on an edge.
+		if (!clockwise) {
+			inside = false;
+			real_t point_projected_on_edge = edge.dot(to_point);
+			real_t edge_square = edge.length_squared();
+
+			if (point_projected_on_edge > edge_square) {
+				real_t distance = p_polygon.points[point_id].pos.distance_squared_to(p_point);
+				if (distance < closest) {
+					closest_on_polygon = p_polygon.points[point_id].pos;
+					closest = distance;
+				}
+			} else if (point_projected_on_edge < 0.0) {
+				real_t distance = previous.distance_squared_to(p_point);
+				if (distance < closest) {
+					closest_on_polygon = previous;
+					closest = distance;
+				}
+			} else {
+				// If we project on this edge, this will be the closest point.
+				real_t percent = point_projected_on_edge / edge_square;
+				closest_on_polygon = previous + percent * edge;
+				break;
+			}
+		}
+		previous = p_polygon.points[point_id].pos;
+	}
+
+	if (inside) {
+		r_closest_point_distance_squared = 0.0;
+		r_result.point = p_point;
+		r_result.owner = p_polygon.owner->get_self();
+		// The point is on the polygon, nothing can be closer.
+		return true;
+	} else {
+		real_t distance = closest_on_polygon.distance_squared_to(p_point);
+		if (distance < r_closest_point_distance_squared) {
+			r_closest_point_distance_squared = distance;
+			r_result.point = closest_on_polygon;
+			r_result.owner = p_polygon.owner->get_self();
+		}
+	}
+
+	return false;
+}
@@ -40,6 +40,7 @@ using namespace NavigationUtilities;
 
 class NavMap2D;
 struct NavMapIteration2D;
+class NavPolygonBVH2D;
 
 class NavMeshQueries2D {
 public:
@@ -118,6 +119,8 @@ public:
 	static nav_2d::ClosestPointQueryResult polygons_get_closest_point_info(const LocalVector<nav_2d::Polygon> &p_polygons, const Vector2 &p_point);
 	static RID polygons_get_closest_point_owner(const LocalVector<nav_2d::Polygon> &p_polygons, const Vector2 &p_point);
 
+	static nav_2d::ClosestPointQueryResult polygon_bvh_get_closest_point_info(const NavPolygonBVH2D &p_polygon_bvh, const Vector2 &p_point);
+
 	static Vector2 map_iteration_get_closest_point(const NavMapIteration2D &p_map_iteration, const Vector2 &p_point);
 	static RID map_iteration_get_closest_point_owner(const NavMapIteration2D &p_map_iteration, const Vector2 &p_point);
 	static nav_2d::ClosestPointQueryResult map_iteration_get_closest_point_info(const NavMapIteration2D &p_map_iteration, const Vector2 &p_point);
@@ -135,6 +138,7 @@ public:
 	static void _query_task_clip_path(NavMeshPathQueryTask2D &p_query_task, const nav_2d::NavigationPoly *p_from_poly, const Vector2 &p_to_point, const nav_2d::NavigationPoly *p_to_poly);
 	static void _query_task_simplified_path_points(NavMeshPathQueryTask2D &p_query_task);
 	static bool _query_task_is_connection_owner_usable(const NavMeshPathQueryTask2D &p_query_task, const NavBaseIteration2D *p_owner);
+	static bool _polygon_get_closest_point_info(const nav_2d::Polygon &p_polygon, const Vector2 &p_point, real_t &r_closest_point_distance_squared, nav_2d::ClosestPointQueryResult &r_result);
 
 	static void simplify_path_segment(int p_start_inx, int p_end_inx, const LocalVector<Vector2> &p_points, real_t p_epsilon, LocalVector<uint32_t> &r_simplified_path_indices);
 	static LocalVector<uint32_t> get_simplified_path_indices(const LocalVector<Vector2> &p_path, real_t p_epsilon);
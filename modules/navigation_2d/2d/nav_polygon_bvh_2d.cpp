@@ -0,0 +1,103 @@
+/**************************************************************************/
+/*  nav_polygon_bvh_2d.cpp                                                */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#include "nav_polygon_bvh_2d.h"
+
+#include "core/templates/sort_array.h"
+
+using namespace nav_2d;
+
+void NavPolygonBVH2D::clear() {
+	nodes.clear();
+	polygons.clear();
+}
+
+void NavPolygonBVH2D::build(const LocalVector<const Polygon *> &p_polygons) {
+	clear();
+
+	LocalVector<BuildItem> items;
+	items.reserve(p_polygons.size());
+	for (const Polygon *polygon : p_polygons) {
+		if (polygon->points.size() < 3) {
+			continue;
+		}
+
+		BuildItem item;
+		item.polygon = polygon;
+		item.bounds.position = polygon->points[0].pos;
+		for (uint32_t i = 1; i < polygon->points.size(); i++) {
+			item.bounds.expand_to(polygon->points[i].pos);
+		}
+		item.center = item.bounds.get_center();
+		items.push_back(item);
+	}
+
+	if (items.is_empty()) {
+		return;
+	}
+
+	nodes.reserve(2 * (items.size() / MAX_LEAF_POLYGONS + 1));
+	polygons.reserve(items.size());
+	nodes.resize(1);
+	_build_node(items, 0, items.size(), 0);
+}
+
+void NavPolygonBVH2D::_build_node(LocalVector<BuildItem> &r_items, uint32_t p_from, uint32_t p_to, uint32_t p_node) {
+	Rect2 bounds = r_items[p_from].bounds;
+	Rect2 center_bounds(r_items[p_from].center, Vector2());
+	for (uint32_t i = p_from + 1; i < p_to; i++) {
+		bounds = bounds.merge(r_items[i].bounds);
+		center_bounds.expand_to(r_items[i].center);
+	}
+	nodes[p_node].bounds = bounds;
+
+	if (p_to - p_from <= MAX_LEAF_POLYGONS) {
+		nodes[p_node].first = polygons.size();
+		nodes[p_node].count = p_to - p_from;
+		for (uint32_t i = p_from; i < p_to; i++) {
+			polygons.push_back(r_items[i].polygon);
+		}
+		return;
+	}
+
+	// Split at the median along the longest axis of the polygon centers.
+	uint32_t middle = (p_from + p_to) / 2;
+	SortArray<BuildItem, BuildItemAxisCompare> sorter;
+	sorter.compare.axis = center_bounds.size.max_axis_index();
+	sorter.nth_element(p_from, p_to, middle, r_items.ptr());
+
+	uint32_t first_child = nodes.size();
+	nodes.resize(first_child + 2);
+	nodes[p_node].first = first_child;
+	nodes[p_node].count = 0;
+
+	_build_node(r_items, p_from, middle, first_child);
+	_build_node(r_items, middle, p_to, first_child + 1);
+}
@@ -114,7 +114,7 @@ void NavRegion2D::set_navigation_polygon(Ref<NavigationPolygon> p_navigation_pol
 ClosestPointQueryResult NavRegion2D::get_closest_point_info(const Vector2 &p_point) const {
 	RWLockRead read_lock(region_rwlock);
 
-	return NavMeshQueries2D::polygons_get_closest_point_info(get_polygons(), p_point);
+	return NavMeshQueries2D::polygon_bvh_get_closest_point_info(polygon_bvh, p_point);
 }
 
 Vector2 NavRegion2D::get_random_point(uint32_t p_navigation_layers, bool p_uniformly) const {
@@ -186,6 +186,7 @@ void NavRegion2D::update_polygons() {
 		return;
 	}
 	navmesh_polygons.clear();
+	polygon_bvh.clear();
 	surface_area = 0.0;
 	bounds = Rect2();
 	polygons_dirty = false;
@@ -272,6 +273,13 @@ void NavRegion2D::update_polygons() {
 
 	surface_area = _new_region_surface_area;
 	bounds = _new_bounds;
+
+	LocalVector<const Polygon *> polygons;
+	polygons.reserve(navmesh_polygons.size());
+	for (const Polygon &polygon : navmesh_polygons) {
+		polygons.push_back(&polygon);
+	}
+	polygon_bvh.build(polygons);
 }
 
 void NavRegion2D::get_iteration_update(NavRegionIteration2D &r_iteration) {
@@ -30,6 +30,7 @@
 
 #pragma once
 
+#include "2d/nav_polygon_bvh_2d.h"
 #include "nav_base_2d.h"
 #include "nav_utils_2d.h"
 
@@ -51,6 +52,7 @@ class NavRegion2D : public NavBase2D {
 	bool polygons_dirty = true;
 
 	LocalVector<nav_2d::Polygon> navmesh_polygons;
+	NavPolygonBVH2D polygon_bvh;
 
 	real_t surface_area = 0.0;
 	Rect2 bounds;
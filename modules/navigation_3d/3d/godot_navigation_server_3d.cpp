@@ -235,6 +235,34 @@ real_t GodotNavigationServer3D::map_get_link_connection_radius(RID p_map) const
 	return map->get_link_connection_radius();
 }
 
+COMMAND_2(map_set_use_hierarchical_pathfinding, RID, p_map, bool, p_enabled) {
+	NavMap3D *map = map_owner.get_or_null(p_map);
+	ERR_FAIL_NULL(map);
+
+	map->set_use_hierarchical_pathfinding(p_enabled);
+}
+
+bool GodotNavigationServer3D::map_get_use_hierarchical_pathfinding(RID p_map) const {
+	const NavMap3D *map = map_owner.get_or_null(p_map);
+	ERR_FAIL_NULL_V(map, false);
+
+	return map->get_use_hierarchical_pathfinding();
+}
+
+COMMAND_2(map_set_hierarchical_pathfinding_cluster_size, RID, p_map, real_t, p_cluster_size) {
+	NavMap3D *map = map_owner.get_or_null(p_map);
+	ERR_FAIL_NULL(map);
+
+	map->set_hierarchical_pathfinding_cluster_size(p_cluster_size);
+}
+
+real_t GodotNavigationServer3D::map_get_hierarchical_pathfinding_cluster_size(RID p_map) const {
+	const NavMap3D *map = map_owner.get_or_null(p_map);
+	ERR_FAIL_NULL_V(map, 0);
+
+	return map->get_hierarchical_pathfinding_cluster_size();
+}
+
 Vector<Vector3> GodotNavigationServer3D::map_get_path(RID p_map, Vector3 p_origin, Vector3 p_destination, bool p_optimize, uint32_t p_navigation_layers) {
 	const NavMap3D *map = map_owner.get_or_null(p_map);
 	ERR_FAIL_NULL_V(map, Vector<Vector3>());
@@ -1006,6 +1034,25 @@ real_t GodotNavigationServer3D::agent_get_avoidance_priority(RID p_agent) const
 	return agent->get_avoidance_priority();
 }
 
+COMMAND_2(agent_set_flow_field, RID, p_agent, RID, p_flow_field) {
+	NavAgent3D *agent = agent_owner.get_or_null(p_agent);
+	ERR_FAIL_NULL(agent);
+
+	NavFlowField3D *flow_field = flow_field_owner.get_or_null(p_flow_field);
+
+	agent->set_flow_field(flow_field);
+}
+
+RID GodotNavigationServer3D::agent_get_flow_field(RID p_agent) const {
+	NavAgent3D *agent = agent_owner.get_or_null(p_agent);
+	ERR_FAIL_NULL_V(agent, RID());
+
+	if (agent->get_flow_field()) {
+		return agent->get_flow_field()->get_self();
+	}
+	return RID();
+}
+
 RID GodotNavigationServer3D::obstacle_create() {
 	MutexLock lock(operations_mutex);
 
@@ -1163,6 +1210,74 @@ uint32_t GodotNavigationServer3D::obstacle_get_avoidance_layers(RID p_obstacle)
 	return obstacle->get_avoidance_layers();
 }
 
+RID GodotNavigationServer3D::flow_field_create() {
+	MutexLock lock(operations_mutex);
+
+	RID rid = flow_field_owner.make_rid();
+	NavFlowField3D *flow_field = flow_field_owner.get_or_null(rid);
+	flow_field->set_self(rid);
+	return rid;
+}
+
+COMMAND_2(flow_field_set_map, RID, p_flow_field, RID, p_map) {
+	NavFlowField3D *flow_field = flow_field_owner.get_or_null(p_flow_field);
+	ERR_FAIL_NULL(flow_field);
+
+	NavMap3D *map = map_owner.get_or_null(p_map);
+
+	flow_field->set_map(map);
+}
+
+RID GodotNavigationServer3D::flow_field_get_map(RID p_flow_field) const {
+	NavFlowField3D *flow_field = flow_field_owner.get_or_null(p_flow_field);
+	ERR_FAIL_NULL_V(flow_field, RID());
+
+	if (flow_field->get_map()) {
+		return flow_field->get_map()->get_self();
+	}
+	return RID();
+}
+
+COMMAND_2(flow_field_set_target_position, RID, p_flow_field, Vector3, p_position) {
+	NavFlowField3D *flow_field = flow_field_owner.get_or_null(p_flow_field);
+	ERR_FAIL_NULL(flow_field);
+
+	flow_field->set_target_position(p_position);
+}
+
+Vector3 GodotNavigationServer3D::flow_field_get_target_position(RID p_flow_field) const {
+	NavFlowField3D *flow_field = flow_field_owner.get_or_null(p_flow_field);
+	ERR_FAIL_NULL_V(flow_field, Vector3());
+
+	return flow_field->get_target_position();
+}
+
+COMMAND_2(flow_field_set_navigation_layers, RID, p_flow_field, uint32_t, p_navigation_layers) {
+	NavFlowField3D *flow_field = flow_field_owner.get_or_null(p_flow_field);
+	ERR_FAIL_NULL(flow_field);
+
+	flow_field->set_navigation_layers(p_navigation_layers);
+}
+
+uint32_t GodotNavigationServer3D::flow_field_get_navigation_layers(RID p_flow_field) const {
+	NavFlowField3D *flow_field = flow_field_owner.get_or_null(p_flow_field);
+	ERR_FAIL_NULL_V(flow_field, 0);
+
+	return flow_field->get_navigation_layers();
+}
+
+Vector3 GodotNavigationServer3D::flow_field_get_direction(RID p_flow_field, const Vector3 &p_position) const {
+	NavFlowField3D *flow_field = flow_field_owner.get_or_null(p_flow_field);
+	ERR_FAIL_NULL_V(flow_field, Vector3());
+
+	const NavMap3D *map = flow_field->get_map();
+	if (map == nullptr) {
+		return Vector3();
+	}
+
+	return map->get_flow_field_direction(flow_field, p_position);
+}
+
 void GodotNavigationServer3D::parse_source_geometry_data(const Ref<NavigationMesh> &p_navigation_mesh, const Ref<NavigationMeshSourceGeometryData3D> &p_source_geometry_data, Node *p_root_node, const Callable &p_callback) {
 	ERR_FAIL_COND_MSG(!Thread::is_main_thread(), "The SceneTree can only be parsed on the main thread. Call this function from the main thread or use call_deferred().");
 	ERR_FAIL_COND_MSG(p_navigation_mesh.is_null(), "Invalid navigation mesh.");
@@ -1221,6 +1336,12 @@ COMMAND_1(free, RID, p_object) {
 			obstacle->set_map(nullptr);
 		}
 
+		// Remove any assigned flow fields
+		const LocalVector<NavFlowField3D *> flow_fields = map->get_flow_fields();
+		for (NavFlowField3D *flow_field : flow_fields) {
+			flow_field->set_map(nullptr);
+		}
+
 		int map_index = active_maps.find(map);
 		if (map_index >= 0) {
 			active_maps.remove_at(map_index);
@@ -1256,6 +1377,9 @@ COMMAND_1(free, RID, p_object) {
 	} else if (obstacle_owner.owns(p_object)) {
 		internal_free_obstacle(p_object);
 
+	} else if (flow_field_owner.owns(p_object)) {
+		internal_free_flow_field(p_object);
+
 	} else if (geometry_parser_owner.owns(p_object)) {
 		RWLockWrite write_lock(geometry_parser_rwlock);
 
@@ -1299,6 +1423,27 @@ void GodotNavigationServer3D::internal_free_obstacle(RID p_object) {
 	}
 }
 
+void GodotNavigationServer3D::internal_free_flow_field(RID p_object) {
+	NavFlowField3D *flow_field = flow_field_owner.get_or_null(p_object);
+	if (flow_field) {
+		// Stop the agents that follow this flow field.
+		List<RID> agents;
+		agent_owner.get_owned_list(&agents);
+		for (const RID &agent_rid : agents) {
+			NavAgent3D *agent = agent_owner.get_or_null(agent_rid);
+			if (agent->get_flow_field() == flow_field) {
+				agent->set_flow_field(nullptr);
+			}
+		}
+
+		if (flow_field->get_map() != nullptr) {
+			flow_field->get_map()->remove_flow_field(flow_field);
+			flow_field->set_map(nullptr);
+		}
+		flow_field_owner.free(p_object);
+	}
+}
+
 void GodotNavigationServer3D::set_active(bool p_active) {
 	MutexLock lock(operations_mutex);
 
@@ -1431,6 +1576,28 @@ void GodotNavigationServer3D::query_path(const Ref<NavigationPathQueryParameters
 	NavMeshQueries3D::map_query_path(map, p_query_parameters, p_query_result, p_callback);
 }
 
+void GodotNavigationServer3D::query_paths_batch(const TypedArray<NavigationPathQueryParameters3D> &p_query_parameters, const TypedArray<NavigationPathQueryResult3D> &p_query_results) {
+	ERR_FAIL_COND_MSG(p_query_parameters.size() != p_query_results.size(), "The query parameters and results arrays need to have the same size.");
+
+	// The queries of each map run together.
+	HashMap<RID, LocalVector<uint32_t>> map_query_indices;
+	for (int i = 0; i < p_query_parameters.size(); i++) {
+		const Ref<NavigationPathQueryParameters3D> query_parameters = p_query_parameters[i];
+		const Ref<NavigationPathQueryResult3D> query_result = p_query_results[i];
+		ERR_CONTINUE(query_parameters.is_null());
+		ERR_CONTINUE(query_result.is_null());
+
+		map_query_indices[query_parameters->get_map()].push_back(i);
+	}
+
+	for (const KeyValue<RID, LocalVector<uint32_t>> &E : map_query_indices) {
+		NavMap3D *map = map_owner.get_or_null(E.key);
+		ERR_CONTINUE(map == nullptr);
+
+		NavMeshQueries3D::map_query_paths_batch(map, p_query_parameters, p_query_results, E.value);
+	}
+}
+
 RID GodotNavigationServer3D::source_geometry_parser_create() {
 	RWLockWrite write_lock(geometry_parser_rwlock);
 
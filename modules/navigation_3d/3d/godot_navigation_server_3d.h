@@ -31,6 +31,7 @@
 #pragma once
 
 #include "../nav_agent_3d.h"
+#include "../nav_flow_field_3d.h"
 #include "../nav_link_3d.h"
 #include "../nav_map_3d.h"
 #include "../nav_obstacle_3d.h"
@@ -76,6 +77,7 @@ class GodotNavigationServer3D : public NavigationServer3D {
 	mutable RID_Owner<NavRegion3D> region_owner;
 	mutable RID_Owner<NavAgent3D> agent_owner;
 	mutable RID_Owner<NavObstacle3D> obstacle_owner;
+	mutable RID_Owner<NavFlowField3D> flow_field_owner;
 
 	bool active = true;
 	LocalVector<NavMap3D *> active_maps;
@@ -127,6 +129,12 @@ public:
 	COMMAND_2(map_set_link_connection_radius, RID, p_map, real_t, p_connection_radius);
 	virtual real_t map_get_link_connection_radius(RID p_map) const override;
 
+	COMMAND_2(map_set_use_hierarchical_pathfinding, RID, p_map, bool, p_enabled);
+	virtual bool map_get_use_hierarchical_pathfinding(RID p_map) const override;
+
+	COMMAND_2(map_set_hierarchical_pathfinding_cluster_size, RID, p_map, real_t, p_cluster_size);
+	virtual real_t map_get_hierarchical_pathfinding_cluster_size(RID p_map) const override;
+
 	virtual Vector<Vector3> map_get_path(RID p_map, Vector3 p_origin, Vector3 p_destination, bool p_optimize, uint32_t p_navigation_layers = 1) override;
 
 	virtual Vector3 map_get_closest_point_to_segment(RID p_map, const Vector3 &p_from, const Vector3 &p_to, const bool p_use_collision = false) const override;
@@ -241,6 +249,8 @@ public:
 	virtual uint32_t agent_get_avoidance_mask(RID p_agent) const override;
 	COMMAND_2(agent_set_avoidance_priority, RID, p_agent, real_t, p_priority);
 	virtual real_t agent_get_avoidance_priority(RID p_agent) const override;
+	COMMAND_2(agent_set_flow_field, RID, p_agent, RID, p_flow_field);
+	virtual RID agent_get_flow_field(RID p_agent) const override;
 
 	virtual RID obstacle_create() override;
 	COMMAND_2(obstacle_set_avoidance_enabled, RID, p_obstacle, bool, p_enabled);
@@ -264,6 +274,15 @@ public:
 	COMMAND_2(obstacle_set_avoidance_layers, RID, p_obstacle, uint32_t, p_layers);
 	virtual uint32_t obstacle_get_avoidance_layers(RID p_obstacle) const override;
 
+	virtual RID flow_field_create() override;
+	COMMAND_2(flow_field_set_map, RID, p_flow_field, RID, p_map);
+	virtual RID flow_field_get_map(RID p_flow_field) const override;
+	COMMAND_2(flow_field_set_target_position, RID, p_flow_field, Vector3, p_position);
+	virtual Vector3 flow_field_get_target_position(RID p_flow_field) const override;
+	COMMAND_2(flow_field_set_navigation_layers, RID, p_flow_field, uint32_t, p_navigation_layers);
+	virtual uint32_t flow_field_get_navigation_layers(RID p_flow_field) const override;
+	virtual Vector3 flow_field_get_direction(RID p_flow_field, const Vector3 &p_position) const override;
+
 	virtual void parse_source_geometry_data(const Ref<NavigationMesh> &p_navigation_mesh, const Ref<NavigationMeshSourceGeometryData3D> &p_source_geometry_data, Node *p_root_node, const Callable &p_callback = Callable()) override;
 	virtual void bake_from_source_geometry_data(const Ref<NavigationMesh> &p_navigation_mesh, const Ref<NavigationMeshSourceGeometryData3D> &p_source_geometry_data, const Callable &p_callback = Callable()) override;
 	virtual void bake_from_source_geometry_data_async(const Ref<NavigationMesh> &p_navigation_mesh, const Ref<NavigationMeshSourceGeometryData3D> &p_source_geometry_data, const Callable &p_callback = Callable()) override;
@@ -288,12 +307,14 @@ public:
 	virtual void finish() override;
 
 	virtual void query_path(const Ref<NavigationPathQueryParameters3D> &p_query_parameters, Ref<NavigationPathQueryResult3D> p_query_result, const Callable &p_callback = Callable()) override;
+	virtual void query_paths_batch(const TypedArray<NavigationPathQueryParameters3D> &p_query_parameters, const TypedArray<NavigationPathQueryResult3D> &p_query_results) override;
 
 	int get_process_info(ProcessInfo p_info) const override;
 
 private:
 	void internal_free_agent(RID p_object);
 	void internal_free_obstacle(RID p_object);
+	void internal_free_flow_field(RID p_object);
 };
 
 #undef COMMAND_1
@@ -62,6 +62,10 @@ void NavMapBuilder3D::build_navmap_iteration(NavMapIterationBuild3D &r_build) {
 
 	_build_step_gather_region_polygons(r_build);
 
+	_build_step_region_edge_connections(r_build);
+
+	_build_step_polygon_bvh(r_build);
+
 	_build_step_find_edge_connection_pairs(r_build);
 
 	_build_step_merge_edge_connection_pairs(r_build);
@@ -70,6 +74,8 @@ void NavMapBuilder3D::build_navmap_iteration(NavMapIterationBuild3D &r_build) {
 
 	_build_step_navlink_connections(r_build);
 
+	_build_step_hierarchical_clusters(r_build);
+
 	_build_update_map_iteration(r_build);
 }
 
@@ -86,7 +92,7 @@ void NavMapBuilder3D::_build_step_gather_region_polygons(NavMapIterationBuild3D
 		region_external_connections[region.id] = LocalVector<Edge::Connection>();
 	}
 
-	// Copy all region polygons in the map.
+	// Number all region polygons in the map.
 	int polygon_count = 0;
 	for (NavRegionIteration3D &region : regions) {
 		if (!region.get_enabled()) {
@@ -95,6 +101,8 @@ void NavMapBuilder3D::_build_step_gather_region_polygons(NavMapIterationBuild3D
 		LocalVector<Polygon> &polygons_source = region.navmesh_polygons;
 		for (uint32_t n = 0; n < polygons_source.size(); n++) {
 			polygons_source[n].id = polygon_count;
+			// Polygons kept from an earlier iteration still point to the region iteration they were copied into.
+			polygons_source[n].owner = &region;
 			polygon_count++;
 		}
 	}
@@ -103,6 +111,135 @@ void NavMapBuilder3D::_build_step_gather_region_polygons(NavMapIterationBuild3D
 	r_build.polygon_count = polygon_count;
 }
 
+void NavMapBuilder3D::_build_region_edges(NavRegionIteration3D &r_region) {
+	struct EdgeOccurrences {
+		uint32_t polygons[2] = {};
+		uint32_t edges[2] = {};
+		int size = 0;
+	};
+
+	LocalVector<Polygon> &polygons = r_region.navmesh_polygons;
+
+	// Group the region's edges per key, like the map does for the edges between regions.
+	HashMap<EdgeKey, EdgeOccurrences, EdgeKey> region_edges;
+	region_edges.reserve(polygons.size());
+
+	for (uint32_t polygon_index = 0; polygon_index < polygons.size(); polygon_index++) {
+		const Polygon &poly = polygons[polygon_index];
+		for (uint32_t p = 0; p < poly.points.size(); p++) {
+			const int next_point = (p + 1) % poly.points.size();
+			const EdgeKey ek(poly.points[p].key, poly.points[next_point].key);
+
+			HashMap<EdgeKey, EdgeOccurrences, EdgeKey>::Iterator edge_it = region_edges.find(ek);
+			if (!edge_it) {
+				edge_it = region_edges.insert(ek, EdgeOccurrences());
+			}
+			EdgeOccurrences &occurrences = edge_it->value;
+			if (occurrences.size < 2) {
+				occurrences.polygons[occurrences.size] = polygon_index;
+				occurrences.edges[occurrences.size] = p;
+				++occurrences.size;
+			} else {
+				// The edge is already connected with another edge, skip.
+				ERR_PRINT_ONCE("Navigation map synchronization error. Attempted to merge a navigation mesh polygon edge with another already-merged edge. This is usually caused by crossing edges, overlapping polygons, or a mismatch of the NavigationMesh / NavigationPolygon baked 'cell_size' and navigation map 'cell_size'. If you're certain none of above is the case, change 'navigation/3d/merge_rasterizer_cell_scale' to 0.001.");
+			}
+		}
+	}
+
+	r_region.internal_edge_connections.clear();
+	r_region.boundary_edges.clear();
+
+	for (const KeyValue<EdgeKey, EdgeOccurrences> &edge_it : region_edges) {
+		const EdgeOccurrences &occurrences = edge_it.value;
+		if (occurrences.size == 2) {
+			NavRegionIteration3D::InternalEdgeConnection internal_edge_connection;
+			internal_edge_connection.polygon = occurrences.polygons[0];
+			internal_edge_connection.edge = occurrences.edges[0];
+			internal_edge_connection.other_polygon = occurrences.polygons[1];
+			internal_edge_connection.other_edge = occurrences.edges[1];
+			r_region.internal_edge_connections.push_back(internal_edge_connection);
+		} else {
+			NavRegionIteration3D::BoundaryEdge boundary_edge;
+			boundary_edge.polygon = occurrences.polygons[0];
+			boundary_edge.edge = occurrences.edges[0];
+			boundary_edge.key = edge_it.key;
+			r_region.boundary_edges.push_back(boundary_edge);
+		}
+	}
+
+	LocalVector<const Polygon *> bvh_polygons;
+	bvh_polygons.reserve(polygons.size());
+	for (const Polygon &polygon : polygons) {
+		bvh_polygons.push_back(&polygon);
+	}
+	r_region.polygon_bvh.build(bvh_polygons);
+}
+
+void NavMapBuilder3D::_build_step_region_edge_connections(NavMapIterationBuild3D &r_build) {
+	PerformanceData &performance_data = r_build.performance_data;
+	NavMapIteration3D *map_iteration = r_build.map_iteration;
+
+	for (NavRegionIteration3D &region : map_iteration->region_iterations) {
+		if (!region.get_enabled()) {
+			continue;
+		}
+
+		LocalVector<Polygon> &polygons = region.navmesh_polygons;
+
+		if (region.polygons_reused) {
+			// Drop the connections of the previous build, they may lead to polygons that are gone now.
+			for (Polygon &polygon : polygons) {
+				for (Edge &edge : polygon.edges) {
+					edge.connections.clear();
+				}
+			}
+		} else {
+			_build_region_edges(region);
+		}
+
+		// Connect the edges shared inside the region, only the boundary edges are left for the map to connect.
+		for (const NavRegionIteration3D::InternalEdgeConnection &internal_edge_connection : region.internal_edge_connections) {
+			Polygon &polygon = polygons[internal_edge_connection.polygon];
+			Polygon &other_polygon = polygons[internal_edge_connection.other_polygon];
+			const uint32_t edge = internal_edge_connection.edge;
+			const uint32_t other_edge = internal_edge_connection.other_edge;
+
+			Edge::Connection connection;
+			connection.polygon = &other_polygon;
+			connection.edge = other_edge;
+			connection.pathway_start = other_polygon.points[other_edge].pos;
+			connection.pathway_end = other_polygon.points[(other_edge + 1) % other_polygon.points.size()].pos;
+			polygon.edges[edge].connections.push_back(connection);
+
+			Edge::Connection other_connection;
+			other_connection.polygon = &polygon;
+			other_connection.edge = edge;
+			other_connection.pathway_start = polygon.points[edge].pos;
+			other_connection.pathway_end = polygon.points[(edge + 1) % polygon.points.size()].pos;
+			other_polygon.edges[other_edge].connections.push_back(other_connection);
+		}
+
+		performance_data.pm_edge_count += region.internal_edge_connections.size();
+		performance_data.pm_edge_merge_count += region.internal_edge_connections.size();
+	}
+}
+
+void NavMapBuilder3D::_build_step_polygon_bvh(NavMapIterationBuild3D &r_build) {
+	NavMapIteration3D *map_iteration = r_build.map_iteration;
+
+	// The regions keep their trees while their polygons don't change, so only the regions are sorted here.
+	LocalVector<const NavPolygonBVH3D *> region_bvhs;
+	region_bvhs.reserve(map_iteration->region_iterations.size());
+	for (const NavRegionIteration3D &region : map_iteration->region_iterations) {
+		if (!region.get_enabled()) {
+			continue;
+		}
+		region_bvhs.push_back(&region.polygon_bvh);
+	}
+
+	map_iteration->polygon_bvh.build_from_trees(region_bvhs);
+}
+
 void NavMapBuilder3D::_build_step_find_edge_connection_pairs(NavMapIterationBuild3D &r_build) {
 	PerformanceData &performance_data = r_build.performance_data;
 	NavMapIteration3D *map_iteration = r_build.map_iteration;
@@ -110,9 +247,16 @@ void NavMapBuilder3D::_build_step_find_edge_connection_pairs(NavMapIterationBuil
 
 	HashMap<EdgeKey, EdgeConnectionPair, EdgeKey> &connection_pairs_map = r_build.iter_connection_pairs_map;
 
-	// Group all edges per key.
+	uint32_t boundary_edge_count = 0;
+	for (const NavRegionIteration3D &region : map_iteration->region_iterations) {
+		if (region.get_enabled()) {
+			boundary_edge_count += region.boundary_edges.size();
+		}
+	}
+
+	// Group the boundary edges of all regions per key.
 	connection_pairs_map.clear();
-	connection_pairs_map.reserve(polygon_count);
+	connection_pairs_map.reserve(MAX(boundary_edge_count, (uint32_t)polygon_count / 4));
 	int free_edges_count = 0; // How many ConnectionPairs have only one Connection.
 
 	for (NavRegionIteration3D &region : map_iteration->region_iterations) {
@@ -120,36 +264,35 @@ void NavMapBuilder3D::_build_step_find_edge_connection_pairs(NavMapIterationBuil
 			continue;
 		}
 
-		for (Polygon &poly : region.navmesh_polygons) {
-			for (uint32_t p = 0; p < poly.points.size(); p++) {
-				const int next_point = (p + 1) % poly.points.size();
-				const EdgeKey ek(poly.points[p].key, poly.points[next_point].key);
+		for (const NavRegionIteration3D::BoundaryEdge &boundary_edge : region.boundary_edges) {
+			Polygon &poly = region.navmesh_polygons[boundary_edge.polygon];
+			const uint32_t p = boundary_edge.edge;
+			const int next_point = (p + 1) % poly.points.size();
 
-				HashMap<EdgeKey, EdgeConnectionPair, EdgeKey>::Iterator pair_it = connection_pairs_map.find(ek);
-				if (!pair_it) {
-					pair_it = connection_pairs_map.insert(ek, EdgeConnectionPair());
-					performance_data.pm_edge_count += 1;
-					++free_edges_count;
+			HashMap<EdgeKey, EdgeConnectionPair, EdgeKey>::Iterator pair_it = connection_pairs_map.find(boundary_edge.key);
+			if (!pair_it) {
+				pair_it = connection_pairs_map.insert(boundary_edge.key, EdgeConnectionPair());
+				performance_data.pm_edge_count += 1;
+				++free_edges_count;
+			}
+			EdgeConnectionPair &pair = pair_it->value;
+			if (pair.size < 2) {
+				// Add the polygon/edge tuple to this key.
+				Edge::Connection new_connection;
+				new_connection.polygon = &poly;
+				new_connection.edge = p;
+				new_connection.pathway_start = poly.points[p].pos;
+				new_connection.pathway_end = poly.points[next_point].pos;
+
+				pair.connections[pair.size] = new_connection;
+				++pair.size;
+				if (pair.size == 2) {
+					--free_edges_count;
 				}
-				EdgeConnectionPair &pair = pair_it->value;
-				if (pair.size < 2) {
-					// Add the polygon/edge tuple to this key.
-					Edge::Connection new_connection;
-					new_connection.polygon = &poly;
-					new_connection.edge = p;
-					new_connection.pathway_start = poly.points[p].pos;
-					new_connection.pathway_end = poly.points[next_point].pos;
-
-					pair.connections[pair.size] = new_connection;
-					++pair.size;
-					if (pair.size == 2) {
-						--free_edges_count;
-					}
 
-				} else {
-					// The edge is already connected with another edge, skip.
-					ERR_PRINT_ONCE("Navigation map synchronization error. Attempted to merge a navigation mesh polygon edge with another already-merged edge. This is usually caused by crossing edges, overlapping polygons, or a mismatch of the NavigationMesh / NavigationPolygon baked 'cell_size' and navigation map 'cell_size'. If you're certain none of above is the case, change 'navigation/3d/merge_rasterizer_cell_scale' to 0.001.");
-				}
+			} else {
+				// The edge is already connected with another edge, skip.
+				ERR_PRINT_ONCE("Navigation map synchronization error. Attempted to merge a navigation mesh polygon edge with another already-merged edge. This is usually caused by crossing edges, overlapping polygons, or a mismatch of the NavigationMesh / NavigationPolygon baked 'cell_size' and navigation map 'cell_size'. If you're certain none of above is the case, change 'navigation/3d/merge_rasterizer_cell_scale' to 0.001.");
 			}
 		}
 	}
@@ -206,60 +349,94 @@ void NavMapBuilder3D::_build_step_edge_connection_margin_connections(NavMapItera
 
 	const real_t edge_connection_margin_squared = edge_connection_margin * edge_connection_margin;
 
-	for (uint32_t i = 0; i < free_edges.size(); i++) {
-		const Edge::Connection &free_edge = free_edges[i];
-		Vector3 edge_p1 = free_edge.polygon->points[free_edge.edge].pos;
-		Vector3 edge_p2 = free_edge.polygon->points[(free_edge.edge + 1) % free_edge.polygon->points.size()].pos;
+	// The free edges of a region follow each other. Edges can only connect when they are within the margin,
+	// so the edges of a region only need to be compared with the edges of regions whose bounds are close enough.
+	struct FreeEdgeGroup {
+		const NavBaseIteration3D *owner = nullptr;
+		AABB bounds;
+		uint32_t from = 0;
+		uint32_t to = 0;
+	};
 
-		for (uint32_t j = 0; j < free_edges.size(); j++) {
-			const Edge::Connection &other_edge = free_edges[j];
-			if (i == j || free_edge.polygon->owner == other_edge.polygon->owner) {
-				continue;
-			}
+	LocalVector<FreeEdgeGroup> free_edge_groups;
+	for (uint32_t i = 0; i < free_edges.size(); i++) {
+		const NavBaseIteration3D *owner = free_edges[i].polygon->owner;
+		if (free_edge_groups.is_empty() || free_edge_groups[free_edge_groups.size() - 1].owner != owner) {
+			FreeEdgeGroup free_edge_group;
+			free_edge_group.owner = owner;
+			free_edge_group.bounds = map_iteration->region_iterations[owner->id].get_bounds().grow(edge_connection_margin);
+			free_edge_group.from = i;
+			free_edge_groups.push_back(free_edge_group);
+		}
+		free_edge_groups[free_edge_groups.size() - 1].to = i + 1;
+	}
 
-			Vector3 other_edge_p1 = other_edge.polygon->points[other_edge.edge].pos;
-			Vector3 other_edge_p2 = other_edge.polygon->points[(other_edge.edge + 1) % other_edge.polygon->points.size()].pos;
+	LocalVector<uint32_t> nearby_groups;
 
-			// Compute the projection of the opposite edge on the current one
-			Vector3 edge_vector = edge_p2 - edge_p1;
-			real_t projected_p1_ratio = edge_vector.dot(other_edge_p1 - edge_p1) / (edge_vector.length_squared());
-			real_t projected_p2_ratio = edge_vector.dot(other_edge_p2 - edge_p1) / (edge_vector.length_squared());
-			if ((projected_p1_ratio < 0.0 && projected_p2_ratio < 0.0) || (projected_p1_ratio > 1.0 && projected_p2_ratio > 1.0)) {
-				continue;
+	for (const FreeEdgeGroup &free_edge_group : free_edge_groups) {
+		nearby_groups.clear();
+		for (uint32_t group_index = 0; group_index < free_edge_groups.size(); group_index++) {
+			const FreeEdgeGroup &other_group = free_edge_groups[group_index];
+			if (other_group.owner != free_edge_group.owner && other_group.bounds.intersects_inclusive(free_edge_group.bounds)) {
+				nearby_groups.push_back(group_index);
 			}
+		}
 
-			// Check if the two edges are close to each other enough and compute a pathway between the two regions.
-			Vector3 self1 = edge_vector * CLAMP(projected_p1_ratio, 0.0, 1.0) + edge_p1;
-			Vector3 other1;
-			if (projected_p1_ratio >= 0.0 && projected_p1_ratio <= 1.0) {
-				other1 = other_edge_p1;
-			} else {
-				other1 = other_edge_p1.lerp(other_edge_p2, (1.0 - projected_p1_ratio) / (projected_p2_ratio - projected_p1_ratio));
-			}
-			if (other1.distance_squared_to(self1) > edge_connection_margin_squared) {
-				continue;
-			}
+		for (uint32_t i = free_edge_group.from; i < free_edge_group.to; i++) {
+			const Edge::Connection &free_edge = free_edges[i];
+			Vector3 edge_p1 = free_edge.polygon->points[free_edge.edge].pos;
+			Vector3 edge_p2 = free_edge.polygon->points[(free_edge.edge + 1) % free_edge.polygon->points.size()].pos;
+
+			for (uint32_t group_index : nearby_groups) {
+				const FreeEdgeGroup &other_group = free_edge_groups[group_index];
+				for (uint32_t j = other_group.from; j < other_group.to; j++) {
+					const Edge::Connection &other_edge = free_edges[j];
+
+					Vector3 other_edge_p1 = other_edge.polygon->points[other_edge.edge].pos;
+					Vector3 other_edge_p2 = other_edge.polygon->points[(other_edge.edge + 1) % other_edge.polygon->points.size()].pos;
+
+					// Compute the projection of the opposite edge on the current one
+					Vector3 edge_vector = edge_p2 - edge_p1;
+					real_t projected_p1_ratio = edge_vector.dot(other_edge_p1 - edge_p1) / (edge_vector.length_squared());
+					real_t projected_p2_ratio = edge_vector.dot(other_edge_p2 - edge_p1) / (edge_vector.length_squared());
+					if ((projected_p1_ratio < 0.0 && projected_p2_ratio < 0.0) || (projected_p1_ratio > 1.0 && projected_p2_ratio > 1.0)) {
+						continue;
+					}
 
-			Vector3 self2 = edge_vector * CLAMP(projected_p2_ratio, 0.0, 1.0) + edge_p1;
-			Vector3 other2;
-			if (projected_p2_ratio >= 0.0 && projected_p2_ratio <= 1.0) {
-				other2 = other_edge_p2;
-			} else {
-				other2 = other_edge_p1.lerp(other_edge_p2, (0.0 - projected_p1_ratio) / (projected_p2_ratio - projected_p1_ratio));
-			}
-			if (other2.distance_squared_to(self2) > edge_connection_margin_squared) {
-				continue;
-			}
+					// Check if the two edges are close to each other enough and compute a pathway between the two regions.
+					Vector3 self1 = edge_vector * CLAMP(projected_p1_ratio, 0.0, 1.0) + edge_p1;
+					Vector3 other1;
+					if (projected_p1_ratio >= 0.0 && projected_p1_ratio <= 1.0) {
+						other1 = other_edge_p1;
+					} else {
+						other1 = other_edge_p1.lerp(other_edge_p2, (1.0 - projected_p1_ratio) / (projected_p2_ratio - projected_p1_ratio));
+					}
+					if (other1.distance_squared_to(self1) > edge_connection_margin_squared) {
+						continue;
+					}
+
+					Vector3 self2 = edge_vector * CLAMP(projected_p2_ratio, 0.0, 1.0) + edge_p1;
+					Vector3 other2;
+					if (projected_p2_ratio >= 0.0 && projected_p2_ratio <= 1.0) {
+						other2 = other_edge_p2;
+					} else {
+						other2 = other_edge_p1.lerp(other_edge_p2, (0.0 - projected_p1_ratio) / (projected_p2_ratio - projected_p1_ratio));
+					}
+					if (other2.distance_squared_to(self2) > edge_connection_margin_squared) {
+						continue;
+					}
 
-			// The edges can now be connected.
-			Edge::Connection new_connection = other_edge;
-			new_connection.pathway_start = (self1 + other1) / 2.0;
-			new_connection.pathway_end = (self2 + other2) / 2.0;
-			free_edge.polygon->edges[free_edge.edge].connections.push_back(new_connection);
+					// The edges can now be connected.
+					Edge::Connection new_connection = other_edge;
+					new_connection.pathway_start = (self1 + other1) / 2.0;
+					new_connection.pathway_end = (self2 + other2) / 2.0;
+					free_edge.polygon->edges[free_edge.edge].connections.push_back(new_connection);
 
-			// Add the connection to the region_connection map.
-			region_external_connections[(uint32_t)free_edge.polygon->owner->id].push_back(new_connection);
-			performance_data.pm_edge_connection_count += 1;
+					// Add the connection to the region_connection map.
+					region_external_connections[(uint32_t)free_edge.polygon->owner->id].push_back(new_connection);
+					performance_data.pm_edge_connection_count += 1;
+				}
+			}
 		}
 	}
 }
@@ -385,6 +562,109 @@ void NavMapBuilder3D::_build_step_navlink_connections(NavMapIterationBuild3D &r_
 			}
 		}
 	}
+
+	// Drop the polygons of links that found nothing to connect to, they may hold stale data from a previous iteration.
+	link_polygons.resize(link_poly_idx);
+}
+
+void NavMapBuilder3D::_build_step_hierarchical_clusters(NavMapIterationBuild3D &r_build) {
+	NavMapIteration3D *map_iteration = r_build.map_iteration;
+
+	LocalVector<Cluster> &clusters = map_iteration->clusters;
+	LocalVector<uint32_t> &polygon_clusters = map_iteration->polygon_clusters;
+
+	clusters.clear();
+	polygon_clusters.clear();
+
+	if (!r_build.use_hierarchical_pathfinding) {
+		return;
+	}
+
+	LocalVector<const Polygon *> polygons;
+	polygons.reserve(r_build.polygon_count + map_iteration->link_polygons.size());
+	for (const NavRegionIteration3D &region : map_iteration->region_iterations) {
+		if (!region.get_enabled()) {
+			continue;
+		}
+		for (const Polygon &polygon : region.navmesh_polygons) {
+			if (!polygon.points.is_empty()) {
+				polygons.push_back(&polygon);
+			}
+		}
+	}
+	for (const Polygon &polygon : map_iteration->link_polygons) {
+		polygons.push_back(&polygon);
+	}
+
+	// Group the polygons into clusters by the map tile their center falls in.
+	const real_t cluster_size = r_build.hierarchical_pathfinding_cluster_size;
+	HashMap<Vector3i, uint32_t> cluster_ids;
+	LocalVector<uint32_t> cluster_polygon_counts;
+
+	polygon_clusters.resize(r_build.polygon_count + map_iteration->link_polygons.size());
+	for (const Polygon *polygon : polygons) {
+		Vector3 center;
+		for (const Point &point : polygon->points) {
+			center += point.pos;
+		}
+		center /= polygon->points.size();
+
+		const Vector3i key = Vector3i((center / cluster_size).floor());
+		HashMap<Vector3i, uint32_t>::Iterator cluster_it = cluster_ids.find(key);
+		if (!cluster_it) {
+			cluster_it = cluster_ids.insert(key, clusters.size());
+			clusters.push_back(Cluster());
+			cluster_polygon_counts.push_back(0);
+		}
+
+		const uint32_t cluster_id = cluster_it->value;
+		polygon_clusters[polygon->id] = cluster_id;
+		clusters[cluster_id].position += center;
+		cluster_polygon_counts[cluster_id] += 1;
+	}
+
+	for (uint32_t i = 0; i < clusters.size(); i++) {
+		clusters[i].position /= cluster_polygon_counts[i];
+	}
+
+	// Connect the clusters through the polygon connections that cross their borders.
+	for (const Polygon *polygon : polygons) {
+		const uint32_t cluster_id = polygon_clusters[polygon->id];
+		Cluster &cluster = clusters[cluster_id];
+
+		for (const Edge &edge : polygon->edges) {
+			for (const Edge::Connection &connection : edge.connections) {
+				const uint32_t other_cluster_id = polygon_clusters[connection.polygon->id];
+				if (other_cluster_id == cluster_id) {
+					continue;
+				}
+
+				const Vector3 portal = (connection.pathway_start + connection.pathway_end) * 0.5;
+				const real_t cost = cluster.position.distance_to(portal) * polygon->owner->get_travel_cost() +
+						portal.distance_to(clusters[other_cluster_id].position) * connection.polygon->owner->get_travel_cost();
+				const uint32_t navigation_layers = polygon->owner->get_navigation_layers() & connection.polygon->owner->get_navigation_layers();
+
+				Cluster::Connection *cluster_connection = nullptr;
+				for (Cluster::Connection &existing_connection : cluster.connections) {
+					if (existing_connection.cluster == other_cluster_id) {
+						cluster_connection = &existing_connection;
+						break;
+					}
+				}
+
+				if (cluster_connection) {
+					cluster_connection->cost = MIN(cluster_connection->cost, cost);
+					cluster_connection->navigation_layers |= navigation_layers;
+				} else {
+					Cluster::Connection new_connection;
+					new_connection.cluster = other_cluster_id;
+					new_connection.cost = cost;
+					new_connection.navigation_layers = navigation_layers;
+					cluster.connections.push_back(new_connection);
+				}
+			}
+		}
+	}
 }
 
 void NavMapBuilder3D::_build_update_map_iteration(NavMapIterationBuild3D &r_build) {
@@ -401,6 +681,15 @@ void NavMapBuilder3D::_build_update_map_iteration(NavMapIterationBuild3D &r_buil
 		p_path_query_slot.traversable_polys.reserve(map_iteration->navmesh_polygon_count * 0.25);
 		p_path_query_slot.path_corridor.clear();
 		p_path_query_slot.path_corridor.resize(map_iteration->navmesh_polygon_count + map_iteration->link_polygon_count);
+		p_path_query_slot.traversable_clusters.clear();
+		p_path_query_slot.navigation_clusters.clear();
+		p_path_query_slot.navigation_clusters.resize(map_iteration->clusters.size());
+		for (uint32_t i = 0; i < map_iteration->clusters.size(); i++) {
+			p_path_query_slot.navigation_clusters[i].id = i;
+		}
+		p_path_query_slot.cluster_corridor.clear();
+		p_path_query_slot.cluster_corridor.resize(map_iteration->clusters.size());
+		p_path_query_slot.flow_field.reset();
 	}
 	map_iteration->path_query_slots_mutex.unlock();
 }
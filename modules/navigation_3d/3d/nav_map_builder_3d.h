@@ -33,13 +33,19 @@
 #include "../nav_utils_3d.h"
 
 struct NavMapIterationBuild3D;
+struct NavRegionIteration3D;
 
 class NavMapBuilder3D {
+	static void _build_region_edges(NavRegionIteration3D &r_region);
+
 	static void _build_step_gather_region_polygons(NavMapIterationBuild3D &r_build);
+	static void _build_step_region_edge_connections(NavMapIterationBuild3D &r_build);
+	static void _build_step_polygon_bvh(NavMapIterationBuild3D &r_build);
 	static void _build_step_find_edge_connection_pairs(NavMapIterationBuild3D &r_build);
 	static void _build_step_merge_edge_connection_pairs(NavMapIterationBuild3D &r_build);
 	static void _build_step_edge_connection_margin_connections(NavMapIterationBuild3D &r_build);
 	static void _build_step_navlink_connections(NavMapIterationBuild3D &r_build);
+	static void _build_step_hierarchical_clusters(NavMapIterationBuild3D &r_build);
 	static void _build_update_map_iteration(NavMapIterationBuild3D &r_build);
 
 public:
@@ -33,6 +33,7 @@
 #include "../nav_rid_3d.h"
 #include "../nav_utils_3d.h"
 #include "nav_mesh_queries_3d.h"
+#include "nav_polygon_bvh_3d.h"
 
 #include "core/math/math_defs.h"
 #include "core/os/semaphore.h"
@@ -47,6 +48,8 @@ struct NavMapIterationBuild3D {
 	bool use_edge_connections = true;
 	real_t edge_connection_margin;
 	real_t link_connection_radius;
+	bool use_hierarchical_pathfinding = false;
+	real_t hierarchical_pathfinding_cluster_size = 0.0;
 	Nav3D::PerformanceData performance_data;
 	int polygon_count = 0;
 	int free_edge_count = 0;
@@ -85,6 +88,14 @@ struct NavMapIteration3D {
 	int navmesh_polygon_count = 0;
 	int link_polygon_count = 0;
 
+	// Spatial index over all region polygons, used by the closest point and path start/end lookups.
+	NavPolygonBVH3D polygon_bvh;
+
+	// Coarse cluster graph for hierarchical pathfinding, empty when the map doesn't use it.
+	LocalVector<Nav3D::Cluster> clusters;
+	// The cluster of each polygon, indexed by polygon id.
+	LocalVector<uint32_t> polygon_clusters;
+
 	// The edge connections that the map builds on top with the edge connection margin.
 	HashMap<uint32_t, LocalVector<Nav3D::Edge::Connection>> external_region_connections;
 
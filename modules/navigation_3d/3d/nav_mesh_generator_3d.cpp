@@ -48,6 +48,8 @@ bool NavMeshGenerator3D::baking_use_high_priority_threads = true;
 HashSet<Ref<NavigationMesh>> NavMeshGenerator3D::baking_navmeshes;
 HashMap<WorkerThreadPool::TaskID, NavMeshGenerator3D::NavMeshGeneratorTask3D *> NavMeshGenerator3D::generator_tasks;
 LocalVector<NavMeshGeometryParser3D *> NavMeshGenerator3D::generator_parsers;
+Mutex NavMeshGenerator3D::tile_cache_mutex;
+HashMap<ObjectID, NavMeshGenerator3D::NavMeshGeneratorTileCache3D *> NavMeshGenerator3D::tile_caches;
 
 NavMeshGenerator3D *NavMeshGenerator3D::get_singleton() {
 	return singleton;
@@ -121,6 +123,12 @@ void NavMeshGenerator3D::cleanup() {
 		generator_parsers.clear();
 		generator_parsers_rwlock.write_unlock();
 	}
+
+	MutexLock tile_cache_lock(tile_cache_mutex);
+	for (KeyValue<ObjectID, NavMeshGeneratorTileCache3D *> &E : tile_caches) {
+		memdelete(E.value);
+	}
+	tile_caches.clear();
 }
 
 void NavMeshGenerator3D::finish() {
@@ -262,11 +270,16 @@ void NavMeshGenerator3D::generator_parse_source_geometry_data(const Ref<Navigati
 	p_source_geometry_data->clear();
 	p_source_geometry_data->root_node_transform = root_node_transform;
 
+	// Parsers only gather the geometry on the main thread, transforming it is deferred until all nodes are parsed.
+	p_source_geometry_data->begin_deferred_geometry();
+
 	bool recurse_children = p_navigation_mesh->get_source_geometry_mode() != NavigationMesh::SOURCE_GEOMETRY_GROUPS_EXPLICIT;
 
 	for (Node *parse_node : parse_nodes) {
 		generator_parse_geometry_node(p_navigation_mesh, p_source_geometry_data, parse_node, recurse_children);
 	}
+
+	p_source_geometry_data->commit_deferred_geometry(use_threads);
 }
 
 void NavMeshGenerator3D::generator_bake_from_source_geometry_data(Ref<NavigationMesh> p_navigation_mesh, const Ref<NavigationMeshSourceGeometryData3D> &p_source_geometry_data) {
@@ -274,6 +287,14 @@ void NavMeshGenerator3D::generator_bake_from_source_geometry_data(Ref<Navigation
 		return;
 	}
 
+	if (p_navigation_mesh->get_tile_size() > 0.0) {
+		generator_bake_tiles_from_source_geometry_data(p_navigation_mesh, p_source_geometry_data);
+		return;
+	}
+
+	// Tiles from an earlier tiled bake are outdated once the navigation mesh is baked whole.
+	generator_clear_tile_cache(p_navigation_mesh);
+
 	Vector<float> source_geometry_vertices;
 	Vector<int> source_geometry_indices;
 	Vector<NavigationMeshSourceGeometryData3D::ProjectedObstruction> projected_obstructions;
@@ -287,17 +308,15 @@ void NavMeshGenerator3D::generator_bake_from_source_geometry_data(Ref<Navigation
 		return;
 	}
 
-	rcHeightfield *hf = nullptr;
-	rcCompactHeightfield *chf = nullptr;
-	rcContourSet *cset = nullptr;
-	rcPolyMesh *poly_mesh = nullptr;
-	rcPolyMeshDetail *detail_mesh = nullptr;
-	rcContext ctx;
-
-	// added to keep track of steps, no functionality right now
-	String bake_state = "";
+	rcConfig cfg;
+	generator_init_recast_config(p_navigation_mesh, cfg);
 
-	bake_state = "Setting up Configuration..."; // step #1
+	if (p_navigation_mesh->get_border_size() > 0.0) {
+		cfg.borderSize = (int)Math::ceil(p_navigation_mesh->get_border_size() / cfg.cs);
+	}
+	if (p_navigation_mesh->get_border_size() > 0.0 && Math::fmod(p_navigation_mesh->get_border_size(), p_navigation_mesh->get_cell_size()) != 0.0) {
+		WARN_PRINT("Property border_size is ceiled to cell_size voxel units and loses precision.");
+	}
 
 	const float *verts = source_geometry_vertices.ptr();
 	const int nverts = source_geometry_vertices.size() / 3;
@@ -307,54 +326,6 @@ void NavMeshGenerator3D::generator_bake_from_source_geometry_data(Ref<Navigation
 	float bmin[3], bmax[3];
 	rcCalcBounds(verts, nverts, bmin, bmax);
 
-	rcConfig cfg;
-	memset(&cfg, 0, sizeof(cfg));
-
-	cfg.cs = p_navigation_mesh->get_cell_size();
-	cfg.ch = p_navigation_mesh->get_cell_height();
-	if (p_navigation_mesh->get_border_size() > 0.0) {
-		cfg.borderSize = (int)Math::ceil(p_navigation_mesh->get_border_size() / cfg.cs);
-	}
-	cfg.walkableSlopeAngle = p_navigation_mesh->get_agent_max_slope();
-	cfg.walkableHeight = (int)Math::ceil(p_navigation_mesh->get_agent_height() / cfg.ch);
-	cfg.walkableClimb = (int)Math::floor(p_navigation_mesh->get_agent_max_climb() / cfg.ch);
-	cfg.walkableRadius = (int)Math::ceil(p_navigation_mesh->get_agent_radius() / cfg.cs);
-	cfg.maxEdgeLen = (int)(p_navigation_mesh->get_edge_max_length() / p_navigation_mesh->get_cell_size());
-	cfg.maxSimplificationError = p_navigation_mesh->get_edge_max_error();
-	cfg.minRegionArea = (int)(p_navigation_mesh->get_region_min_size() * p_navigation_mesh->get_region_min_size());
-	cfg.mergeRegionArea = (int)(p_navigation_mesh->get_region_merge_size() * p_navigation_mesh->get_region_merge_size());
-	cfg.maxVertsPerPoly = (int)p_navigation_mesh->get_vertices_per_polygon();
-	cfg.detailSampleDist = MAX(p_navigation_mesh->get_cell_size() * p_navigation_mesh->get_detail_sample_distance(), 0.1f);
-	cfg.detailSampleMaxError = p_navigation_mesh->get_cell_height() * p_navigation_mesh->get_detail_sample_max_error();
-
-	if (p_navigation_mesh->get_border_size() > 0.0 && Math::fmod(p_navigation_mesh->get_border_size(), p_navigation_mesh->get_cell_size()) != 0.0) {
-		WARN_PRINT("Property border_size is ceiled to cell_size voxel units and loses precision.");
-	}
-	if (!Math::is_equal_approx((float)cfg.walkableHeight * cfg.ch, p_navigation_mesh->get_agent_height())) {
-		WARN_PRINT("Property agent_height is ceiled to cell_height voxel units and loses precision.");
-	}
-	if (!Math::is_equal_approx((float)cfg.walkableClimb * cfg.ch, p_navigation_mesh->get_agent_max_climb())) {
-		WARN_PRINT("Property agent_max_climb is floored to cell_height voxel units and loses precision.");
-	}
-	if (!Math::is_equal_approx((float)cfg.walkableRadius * cfg.cs, p_navigation_mesh->get_agent_radius())) {
-		WARN_PRINT("Property agent_radius is ceiled to cell_size voxel units and loses precision.");
-	}
-	if (!Math::is_equal_approx((float)cfg.maxEdgeLen * cfg.cs, p_navigation_mesh->get_edge_max_length())) {
-		WARN_PRINT("Property edge_max_length is rounded to cell_size voxel units and loses precision.");
-	}
-	if (!Math::is_equal_approx((float)cfg.minRegionArea, p_navigation_mesh->get_region_min_size() * p_navigation_mesh->get_region_min_size())) {
-		WARN_PRINT("Property region_min_size is converted to int and loses precision.");
-	}
-	if (!Math::is_equal_approx((float)cfg.mergeRegionArea, p_navigation_mesh->get_region_merge_size() * p_navigation_mesh->get_region_merge_size())) {
-		WARN_PRINT("Property region_merge_size is converted to int and loses precision.");
-	}
-	if (!Math::is_equal_approx((float)cfg.maxVertsPerPoly, p_navigation_mesh->get_vertices_per_polygon())) {
-		WARN_PRINT("Property vertices_per_polygon is converted to int and loses precision.");
-	}
-	if (p_navigation_mesh->get_cell_size() * p_navigation_mesh->get_detail_sample_distance() < 0.1f) {
-		WARN_PRINT("Property detail_sample_distance is clamped to 0.1 world units as the resulting value from multiplying with cell_size is too low.");
-	}
-
 	cfg.bmin[0] = bmin[0];
 	cfg.bmin[1] = bmin[1];
 	cfg.bmin[2] = bmin[2];
@@ -373,7 +344,6 @@ void NavMeshGenerator3D::generator_bake_from_source_geometry_data(Ref<Navigation
 		cfg.bmax[2] = cfg.bmin[2] + baking_aabb.size[2];
 	}
 
-	bake_state = "Calculating grid size..."; // step #2
 	rcCalcGridSize(cfg.bmin, cfg.bmax, cfg.cs, &cfg.width, &cfg.height);
 
 	// ~30000000 seems to be around sweetspot where Editor baking breaks
@@ -387,110 +357,179 @@ void NavMeshGenerator3D::generator_bake_from_source_geometry_data(Ref<Navigation
 		return;
 	}
 
+	LocalVector<const NavigationMeshSourceGeometryData3D::ProjectedObstruction *> obstructions;
+	obstructions.reserve(projected_obstructions.size());
+	for (const NavigationMeshSourceGeometryData3D::ProjectedObstruction &projected_obstruction : projected_obstructions) {
+		obstructions.push_back(&projected_obstruction);
+	}
+
+	Vector<Vector3> nav_vertices;
+	Vector<Vector<int>> nav_polygons;
+	if (!generator_bake_recast_mesh(p_navigation_mesh, cfg, verts, nverts, tris, ntris, obstructions, nav_vertices, nav_polygons)) {
+		return;
+	}
+
+	p_navigation_mesh->set_data(nav_vertices, nav_polygons);
+}
+
+void NavMeshGenerator3D::generator_init_recast_config(const Ref<NavigationMesh> &p_navigation_mesh, rcConfig &r_config) {
+	memset(&r_config, 0, sizeof(r_config));
+
+	r_config.cs = p_navigation_mesh->get_cell_size();
+	r_config.ch = p_navigation_mesh->get_cell_height();
+	r_config.walkableSlopeAngle = p_navigation_mesh->get_agent_max_slope();
+	r_config.walkableHeight = (int)Math::ceil(p_navigation_mesh->get_agent_height() / r_config.ch);
+	r_config.walkableClimb = (int)Math::floor(p_navigation_mesh->get_agent_max_climb() / r_config.ch);
+	r_config.walkableRadius = (int)Math::ceil(p_navigation_mesh->get_agent_radius() / r_config.cs);
+	r_config.maxEdgeLen = (int)(p_navigation_mesh->get_edge_max_length() / p_navigation_mesh->get_cell_size());
+	r_config.maxSimplificationError = p_navigation_mesh->get_edge_max_error();
+	r_config.minRegionArea = (int)(p_navigation_mesh->get_region_min_size() * p_navigation_mesh->get_region_min_size());
+	r_config.mergeRegionArea = (int)(p_navigation_mesh->get_region_merge_size() * p_navigation_mesh->get_region_merge_size());
+	r_config.maxVertsPerPoly = (int)p_navigation_mesh->get_vertices_per_polygon();
+	r_config.detailSampleDist = MAX(p_navigation_mesh->get_cell_size() * p_navigation_mesh->get_detail_sample_distance(), 0.1f);
+	r_config.detailSampleMaxError = p_navigation_mesh->get_cell_height() * p_navigation_mesh->get_detail_sample_max_error();
+
+	if (!Math::is_equal_approx((float)r_config.walkableHeight * r_config.ch, p_navigation_mesh->get_agent_height())) {
+		WARN_PRINT("Property agent_height is ceiled to cell_height voxel units and loses precision.");
+	}
+	if (!Math::is_equal_approx((float)r_config.walkableClimb * r_config.ch, p_navigation_mesh->get_agent_max_climb())) {
+		WARN_PRINT("Property agent_max_climb is floored to cell_height voxel units and loses precision.");
+	}
+	if (!Math::is_equal_approx((float)r_config.walkableRadius * r_config.cs, p_navigation_mesh->get_agent_radius())) {
+		WARN_PRINT("Property agent_radius is ceiled to cell_size voxel units and loses precision.");
+	}
+	if (!Math::is_equal_approx((float)r_config.maxEdgeLen * r_config.cs, p_navigation_mesh->get_edge_max_length())) {
+		WARN_PRINT("Property edge_max_length is rounded to cell_size voxel units and loses precision.");
+	}
+	if (!Math::is_equal_approx((float)r_config.minRegionArea, p_navigation_mesh->get_region_min_size() * p_navigation_mesh->get_region_min_size())) {
+		WARN_PRINT("Property region_min_size is converted to int and loses precision.");
+	}
+	if (!Math::is_equal_approx((float)r_config.mergeRegionArea, p_navigation_mesh->get_region_merge_size() * p_navigation_mesh->get_region_merge_size())) {
+		WARN_PRINT("Property region_merge_size is converted to int and loses precision.");
+	}
+	if (!Math::is_equal_approx((float)r_config.maxVertsPerPoly, p_navigation_mesh->get_vertices_per_polygon())) {
+		WARN_PRINT("Property vertices_per_polygon is converted to int and loses precision.");
+	}
+	if (p_navigation_mesh->get_cell_size() * p_navigation_mesh->get_detail_sample_distance() < 0.1f) {
+		WARN_PRINT("Property detail_sample_distance is clamped to 0.1 world units as the resulting value from multiplying with cell_size is too low.");
+	}
+}
+
+bool NavMeshGenerator3D::generator_bake_recast_mesh(const Ref<NavigationMesh> &p_navigation_mesh, const rcConfig &p_config, const float *p_vertices, int p_vertex_count, const int *p_triangles, int p_triangle_count, const LocalVector<const NavigationMeshSourceGeometryData3D::ProjectedObstruction *> &p_projected_obstructions, Vector<Vector3> &r_vertices, Vector<Vector<int>> &r_polygons) {
+	rcHeightfield *hf = nullptr;
+	rcCompactHeightfield *chf = nullptr;
+	rcContourSet *cset = nullptr;
+	rcPolyMesh *poly_mesh = nullptr;
+	rcPolyMeshDetail *detail_mesh = nullptr;
+	rcContext ctx;
+
+	// added to keep track of steps, no functionality right now
+	String bake_state = "";
+
 	bake_state = "Creating heightfield..."; // step #3
 	hf = rcAllocHeightfield();
 
-	ERR_FAIL_NULL(hf);
-	ERR_FAIL_COND(!rcCreateHeightfield(&ctx, *hf, cfg.width, cfg.height, cfg.bmin, cfg.bmax, cfg.cs, cfg.ch));
+	ERR_FAIL_NULL_V(hf, false);
+	ERR_FAIL_COND_V(!rcCreateHeightfield(&ctx, *hf, p_config.width, p_config.height, p_config.bmin, p_config.bmax, p_config.cs, p_config.ch), false);
 
 	bake_state = "Marking walkable triangles..."; // step #4
 	{
 		Vector<unsigned char> tri_areas;
-		tri_areas.resize(ntris);
+		tri_areas.resize(p_triangle_count);
 
-		ERR_FAIL_COND(tri_areas.is_empty());
+		ERR_FAIL_COND_V(tri_areas.is_empty(), false);
 
-		memset(tri_areas.ptrw(), 0, ntris * sizeof(unsigned char));
-		rcMarkWalkableTriangles(&ctx, cfg.walkableSlopeAngle, verts, nverts, tris, ntris, tri_areas.ptrw());
+		memset(tri_areas.ptrw(), 0, p_triangle_count * sizeof(unsigned char));
+		rcMarkWalkableTriangles(&ctx, p_config.walkableSlopeAngle, p_vertices, p_vertex_count, p_triangles, p_triangle_count, tri_areas.ptrw());
 
-		ERR_FAIL_COND(!rcRasterizeTriangles(&ctx, verts, nverts, tris, tri_areas.ptr(), ntris, *hf, cfg.walkableClimb));
+		ERR_FAIL_COND_V(!rcRasterizeTriangles(&ctx, p_vertices, p_vertex_count, p_triangles, tri_areas.ptr(), p_triangle_count, *hf, p_config.walkableClimb), false);
 	}
 
 	if (p_navigation_mesh->get_filter_low_hanging_obstacles()) {
-		rcFilterLowHangingWalkableObstacles(&ctx, cfg.walkableClimb, *hf);
+		rcFilterLowHangingWalkableObstacles(&ctx, p_config.walkableClimb, *hf);
 	}
 	if (p_navigation_mesh->get_filter_ledge_spans()) {
-		rcFilterLedgeSpans(&ctx, cfg.walkableHeight, cfg.walkableClimb, *hf);
+		rcFilterLedgeSpans(&ctx, p_config.walkableHeight, p_config.walkableClimb, *hf);
 	}
 	if (p_navigation_mesh->get_filter_walkable_low_height_spans()) {
-		rcFilterWalkableLowHeightSpans(&ctx, cfg.walkableHeight, *hf);
+		rcFilterWalkableLowHeightSpans(&ctx, p_config.walkableHeight, *hf);
 	}
 
 	bake_state = "Constructing compact heightfield..."; // step #5
 
 	chf = rcAllocCompactHeightfield();
 
-	ERR_FAIL_NULL(chf);
-	ERR_FAIL_COND(!rcBuildCompactHeightfield(&ctx, cfg.walkableHeight, cfg.walkableClimb, *hf, *chf));
+	ERR_FAIL_NULL_V(chf, false);
+	ERR_FAIL_COND_V(!rcBuildCompactHeightfield(&ctx, p_config.walkableHeight, p_config.walkableClimb, *hf, *chf), false);
 
 	rcFreeHeightField(hf);
 	hf = nullptr;
 
 	// Add obstacles to the source geometry. Those will be affected by e.g. agent_radius.
-	if (!projected_obstructions.is_empty()) {
-		for (const NavigationMeshSourceGeometryData3D::ProjectedObstruction &projected_obstruction : projected_obstructions) {
-			if (projected_obstruction.carve) {
+	if (!p_projected_obstructions.is_empty()) {
+		for (const NavigationMeshSourceGeometryData3D::ProjectedObstruction *projected_obstruction : p_projected_obstructions) {
+			if (projected_obstruction->carve) {
 				continue;
 			}
-			if (projected_obstruction.vertices.is_empty() || projected_obstruction.vertices.size() % 3 != 0) {
+			if (projected_obstruction->vertices.is_empty() || projected_obstruction->vertices.size() % 3 != 0) {
 				continue;
 			}
 
-			const float *projected_obstruction_verts = projected_obstruction.vertices.ptr();
-			const int projected_obstruction_nverts = projected_obstruction.vertices.size() / 3;
+			const float *projected_obstruction_verts = projected_obstruction->vertices.ptr();
+			const int projected_obstruction_nverts = projected_obstruction->vertices.size() / 3;
 
-			rcMarkConvexPolyArea(&ctx, projected_obstruction_verts, projected_obstruction_nverts, projected_obstruction.elevation, projected_obstruction.elevation + projected_obstruction.height, RC_NULL_AREA, *chf);
+			rcMarkConvexPolyArea(&ctx, projected_obstruction_verts, projected_obstruction_nverts, projected_obstruction->elevation, projected_obstruction->elevation + projected_obstruction->height, RC_NULL_AREA, *chf);
 		}
 	}
 
 	bake_state = "Eroding walkable area..."; // step #6
 
-	ERR_FAIL_COND(!rcErodeWalkableArea(&ctx, cfg.walkableRadius, *chf));
+	ERR_FAIL_COND_V(!rcErodeWalkableArea(&ctx, p_config.walkableRadius, *chf), false);
 
 	// Carve obstacles to the eroded geometry. Those will NOT be affected by e.g. agent_radius because that step is already done.
-	if (!projected_obstructions.is_empty()) {
-		for (const NavigationMeshSourceGeometryData3D::ProjectedObstruction &projected_obstruction : projected_obstructions) {
-			if (!projected_obstruction.carve) {
+	if (!p_projected_obstructions.is_empty()) {
+		for (const NavigationMeshSourceGeometryData3D::ProjectedObstruction *projected_obstruction : p_projected_obstructions) {
+			if (!projected_obstruction->carve) {
 				continue;
 			}
-			if (projected_obstruction.vertices.is_empty() || projected_obstruction.vertices.size() % 3 != 0) {
+			if (projected_obstruction->vertices.is_empty() || projected_obstruction->vertices.size() % 3 != 0) {
 				continue;
 			}
 
-			const float *projected_obstruction_verts = projected_obstruction.vertices.ptr();
-			const int projected_obstruction_nverts = projected_obstruction.vertices.size() / 3;
+			const float *projected_obstruction_verts = projected_obstruction->vertices.ptr();
+			const int projected_obstruction_nverts = projected_obstruction->vertices.size() / 3;
 
-			rcMarkConvexPolyArea(&ctx, projected_obstruction_verts, projected_obstruction_nverts, projected_obstruction.elevation, projected_obstruction.elevation + projected_obstruction.height, RC_NULL_AREA, *chf);
+			rcMarkConvexPolyArea(&ctx, projected_obstruction_verts, projected_obstruction_nverts, projected_obstruction->elevation, projected_obstruction->elevation + projected_obstruction->height, RC_NULL_AREA, *chf);
 		}
 	}
 
 	bake_state = "Partitioning..."; // step #7
 
 	if (p_navigation_mesh->get_sample_partition_type() == NavigationMesh::SAMPLE_PARTITION_WATERSHED) {
-		ERR_FAIL_COND(!rcBuildDistanceField(&ctx, *chf));
-		ERR_FAIL_COND(!rcBuildRegions(&ctx, *chf, cfg.borderSize, cfg.minRegionArea, cfg.mergeRegionArea));
+		ERR_FAIL_COND_V(!rcBuildDistanceField(&ctx, *chf), false);
+		ERR_FAIL_COND_V(!rcBuildRegions(&ctx, *chf, p_config.borderSize, p_config.minRegionArea, p_config.mergeRegionArea), false);
 	} else if (p_navigation_mesh->get_sample_partition_type() == NavigationMesh::SAMPLE_PARTITION_MONOTONE) {
-		ERR_FAIL_COND(!rcBuildRegionsMonotone(&ctx, *chf, cfg.borderSize, cfg.minRegionArea, cfg.mergeRegionArea));
+		ERR_FAIL_COND_V(!rcBuildRegionsMonotone(&ctx, *chf, p_config.borderSize, p_config.minRegionArea, p_config.mergeRegionArea), false);
 	} else {
-		ERR_FAIL_COND(!rcBuildLayerRegions(&ctx, *chf, cfg.borderSize, cfg.minRegionArea));
+		ERR_FAIL_COND_V(!rcBuildLayerRegions(&ctx, *chf, p_config.borderSize, p_config.minRegionArea), false);
 	}
 
 	bake_state = "Creating contours..."; // step #8
 
 	cset = rcAllocContourSet();
 
-	ERR_FAIL_NULL(cset);
-	ERR_FAIL_COND(!rcBuildContours(&ctx, *chf, cfg.maxSimplificationError, cfg.maxEdgeLen, *cset));
+	ERR_FAIL_NULL_V(cset, false);
+	ERR_FAIL_COND_V(!rcBuildContours(&ctx, *chf, p_config.maxSimplificationError, p_config.maxEdgeLen, *cset), false);
 
 	bake_state = "Creating polymesh..."; // step #9
 
 	poly_mesh = rcAllocPolyMesh();
-	ERR_FAIL_NULL(poly_mesh);
-	ERR_FAIL_COND(!rcBuildPolyMesh(&ctx, *cset, cfg.maxVertsPerPoly, *poly_mesh));
+	ERR_FAIL_NULL_V(poly_mesh, false);
+	ERR_FAIL_COND_V(!rcBuildPolyMesh(&ctx, *cset, p_config.maxVertsPerPoly, *poly_mesh), false);
 
 	detail_mesh = rcAllocPolyMeshDetail();
-	ERR_FAIL_NULL(detail_mesh);
-	ERR_FAIL_COND(!rcBuildPolyMeshDetail(&ctx, *poly_mesh, *chf, cfg.detailSampleDist, cfg.detailSampleMaxError, *detail_mesh));
+	ERR_FAIL_NULL_V(detail_mesh, false);
+	ERR_FAIL_COND_V(!rcBuildPolyMeshDetail(&ctx, *poly_mesh, *chf, p_config.detailSampleDist, p_config.detailSampleMaxError, *detail_mesh), false);
 
 	rcFreeCompactHeightfield(chf);
 	chf = nullptr;
@@ -499,9 +538,6 @@ void NavMeshGenerator3D::generator_bake_from_source_geometry_data(Ref<Navigation
 
 	bake_state = "Converting to native navigation mesh..."; // step #10
 
-	Vector<Vector3> nav_vertices;
-	Vector<Vector<int>> nav_polygons;
-
 	HashMap<Vector3, int> recast_vertex_to_native_index;
 	LocalVector<int> recast_index_to_native_index;
 	recast_index_to_native_index.resize(detail_mesh->nverts);
@@ -514,7 +550,7 @@ void NavMeshGenerator3D::generator_bake_from_source_geometry_data(Ref<Navigation
 			int new_index = recast_vertex_to_native_index.size();
 			recast_index_to_native_index[i] = new_index;
 			recast_vertex_to_native_index[vertex] = new_index;
-			nav_vertices.push_back(vertex);
+			r_vertices.push_back(vertex);
 		} else {
 			recast_index_to_native_index[i] = *existing_index_ptr;
 		}
@@ -538,12 +574,10 @@ void NavMeshGenerator3D::generator_bake_from_source_geometry_data(Ref<Navigation
 			nav_indices.write[1] = recast_index_to_native_index[index2];
 			nav_indices.write[2] = recast_index_to_native_index[index3];
 
-			nav_polygons.push_back(nav_indices);
+			r_polygons.push_back(nav_indices);
 		}
 	}
 
-	p_navigation_mesh->set_data(nav_vertices, nav_polygons);
-
 	bake_state = "Cleanup..."; // step #11
 
 	rcFreePolyMesh(poly_mesh);
@@ -552,6 +586,395 @@ void NavMeshGenerator3D::generator_bake_from_source_geometry_data(Ref<Navigation
 	detail_mesh = nullptr;
 
 	bake_state = "Baking finished."; // step #12
+
+	return true;
+}
+
+void NavMeshGenerator3D::generator_bake_tiles_from_source_geometry_data(Ref<NavigationMesh> p_navigation_mesh, const Ref<NavigationMeshSourceGeometryData3D> &p_source_geometry_data) {
+	Vector<float> source_geometry_vertices;
+	Vector<int> source_geometry_indices;
+	Vector<NavigationMeshSourceGeometryData3D::ProjectedObstruction> projected_obstructions;
+
+	p_source_geometry_data->get_data(
+			source_geometry_vertices,
+			source_geometry_indices,
+			projected_obstructions);
+
+	if (source_geometry_vertices.size() < 3 || source_geometry_indices.size() < 3) {
+		return;
+	}
+
+	rcConfig cfg;
+	generator_init_recast_config(p_navigation_mesh, cfg);
+
+	const float *verts = source_geometry_vertices.ptr();
+	const int nverts = source_geometry_vertices.size() / 3;
+	const int *tris = source_geometry_indices.ptr();
+	const int ntris = source_geometry_indices.size() / 3;
+
+	float bmin[3], bmax[3];
+	rcCalcBounds(verts, nverts, bmin, bmax);
+
+	AABB baking_aabb = p_navigation_mesh->get_filter_baking_aabb();
+	if (baking_aabb.has_volume()) {
+		const Vector3 baking_aabb_position = baking_aabb.position + p_navigation_mesh->get_filter_baking_aabb_offset();
+		for (int i = 0; i < 3; i++) {
+			bmin[i] = baking_aabb_position[i];
+			bmax[i] = baking_aabb_position[i] + baking_aabb.size[i];
+		}
+	}
+
+	// Tiles are laid out on a world grid of whole cells so the same tile covers the same cells in every bake.
+	// The border lets each tile see the geometry around it so erosion by agent_radius matches across tile edges.
+	const int tile_cells = MAX(1, (int)Math::ceil(p_navigation_mesh->get_tile_size() / cfg.cs));
+	const int border_cells = cfg.walkableRadius + 3;
+
+	cfg.tileSize = tile_cells;
+	cfg.borderSize = border_cells;
+	cfg.width = tile_cells + border_cells * 2;
+	cfg.height = tile_cells + border_cells * 2;
+	// All tiles share the vertical bounds so vertices on shared tile edges are sampled at the same heights.
+	cfg.bmin[1] = Math::floor(bmin[1] / cfg.ch) * cfg.ch;
+	cfg.bmax[1] = Math::ceil(bmax[1] / cfg.ch) * cfg.ch;
+
+	NavMeshGeneratorTileBake3D tile_bake;
+	tile_bake.navigation_mesh = p_navigation_mesh;
+	tile_bake.config = &cfg;
+	tile_bake.vertices = verts;
+	tile_bake.vertex_count = nverts;
+	tile_bake.tile_size = tile_cells * cfg.cs;
+	tile_bake.border_size = border_cells * cfg.cs;
+
+	uint32_t settings_hash = hash_murmur3_buffer(&cfg, sizeof(rcConfig));
+	settings_hash = hash_murmur3_one_32(p_navigation_mesh->get_sample_partition_type(), settings_hash);
+	settings_hash = hash_murmur3_one_32(p_navigation_mesh->get_filter_low_hanging_obstacles(), settings_hash);
+	settings_hash = hash_murmur3_one_32(p_navigation_mesh->get_filter_ledge_spans(), settings_hash);
+	settings_hash = hash_murmur3_one_32(p_navigation_mesh->get_filter_walkable_low_height_spans(), settings_hash);
+
+	const Vector2i tile_min = Vector2i(Math::floor(bmin[0] / tile_bake.tile_size), Math::floor(bmin[2] / tile_bake.tile_size));
+	const Vector2i tile_max = Vector2i(Math::floor(bmax[0] / tile_bake.tile_size), Math::floor(bmax[2] / tile_bake.tile_size));
+
+	// Bucket the source triangles and obstructions by the tiles whose bake area, including the border, they touch.
+	const Vector2 border = Vector2(tile_bake.border_size, tile_bake.border_size);
+	LocalVector<NavMeshGeneratorTileGeometry3D> &tiles = tile_bake.tiles;
+	HashMap<Vector2i, uint32_t> tile_ids;
+
+	for (int i = 0; i < ntris; i++) {
+		const float *v0 = &verts[tris[i * 3 + 0] * 3];
+		const float *v1 = &verts[tris[i * 3 + 1] * 3];
+		const float *v2 = &verts[tris[i * 3 + 2] * 3];
+
+		const Vector2 triangle_min = Vector2(MIN(MIN(v0[0], v1[0]), v2[0]), MIN(MIN(v0[2], v1[2]), v2[2]));
+		const Vector2 triangle_max = Vector2(MAX(MAX(v0[0], v1[0]), v2[0]), MAX(MAX(v0[2], v1[2]), v2[2]));
+		const Vector2i from = Vector2i(((triangle_min - border) / tile_bake.tile_size).floor()).max(tile_min);
+		const Vector2i to = Vector2i(((triangle_max + border) / tile_bake.tile_size).floor()).min(tile_max);
+
+		for (int z = from.y; z <= to.y; z++) {
+			for (int x = from.x; x <= to.x; x++) {
+				const Vector2i coords = Vector2i(x, z);
+				HashMap<Vector2i, uint32_t>::Iterator tile_id = tile_ids.find(coords);
+				if (!tile_id) {
+					tile_id = tile_ids.insert(coords, tiles.size());
+					tiles.push_back(NavMeshGeneratorTileGeometry3D());
+					tiles[tile_id->value].coords = coords;
+				}
+				LocalVector<int> &tile_triangles = tiles[tile_id->value].triangles;
+				tile_triangles.push_back(tris[i * 3 + 0]);
+				tile_triangles.push_back(tris[i * 3 + 1]);
+				tile_triangles.push_back(tris[i * 3 + 2]);
+			}
+		}
+	}
+
+	for (const NavigationMeshSourceGeometryData3D::ProjectedObstruction &projected_obstruction : projected_obstructions) {
+		if (projected_obstruction.vertices.is_empty() || projected_obstruction.vertices.size() % 3 != 0) {
+			continue;
+		}
+
+		const float *obstruction_verts = projected_obstruction.vertices.ptr();
+		Vector2 obstruction_min = Vector2(obstruction_verts[0], obstruction_verts[2]);
+		Vector2 obstruction_max = obstruction_min;
+		for (int i = 1; i < projected_obstruction.vertices.size() / 3; i++) {
+			obstruction_min = obstruction_min.min(Vector2(obstruction_verts[i * 3], obstruction_verts[i * 3 + 2]));
+			obstruction_max = obstruction_max.max(Vector2(obstruction_verts[i * 3], obstruction_verts[i * 3 + 2]));
+		}
+
+		const Vector2i from = Vector2i(((obstruction_min - border) / tile_bake.tile_size).floor()).max(tile_min);
+		const Vector2i to = Vector2i(((obstruction_max + border) / tile_bake.tile_size).floor()).min(tile_max);
+
+		for (int z = from.y; z <= to.y; z++) {
+			for (int x = from.x; x <= to.x; x++) {
+				// Tiles without source geometry have nothing to obstruct.
+				const uint32_t *tile_id = tile_ids.getptr(Vector2i(x, z));
+				if (tile_id) {
+					tiles[*tile_id].projected_obstructions.push_back(&projected_obstruction);
+				}
+			}
+		}
+	}
+
+	NavMeshGeneratorTileCache3D *tile_cache = generator_get_tile_cache(p_navigation_mesh);
+	if (tile_cache->settings_hash != settings_hash) {
+		tile_cache->settings_hash = settings_hash;
+		tile_cache->tiles.clear();
+	}
+
+	// Tiles that lost all their source geometry are removed, all others are only rebaked when their geometry changed.
+	LocalVector<Vector2i> removed_tiles;
+	for (const KeyValue<Vector2i, NavMeshGeneratorTile3D> &E : tile_cache->tiles) {
+		if (!tile_ids.has(E.key)) {
+			removed_tiles.push_back(E.key);
+		}
+	}
+	for (const Vector2i &coords : removed_tiles) {
+		tile_cache->tiles.erase(coords);
+	}
+
+	for (uint32_t tile_index = 0; tile_index < tiles.size(); tile_index++) {
+		NavMeshGeneratorTileGeometry3D &tile = tiles[tile_index];
+
+		uint32_t geometry_hash = HASH_MURMUR3_SEED;
+		for (int index : tile.triangles) {
+			geometry_hash = hash_murmur3_buffer(&verts[index * 3], sizeof(float) * 3, geometry_hash);
+		}
+		for (const NavigationMeshSourceGeometryData3D::ProjectedObstruction *projected_obstruction : tile.projected_obstructions) {
+			geometry_hash = hash_murmur3_buffer(projected_obstruction->vertices.ptr(), projected_obstruction->vertices.size() * sizeof(float), geometry_hash);
+			geometry_hash = hash_murmur3_one_float(projected_obstruction->elevation, geometry_hash);
+			geometry_hash = hash_murmur3_one_float(projected_obstruction->height, geometry_hash);
+			geometry_hash = hash_murmur3_one_32(projected_obstruction->carve, geometry_hash);
+		}
+
+		NavMeshGeneratorTile3D *cached_tile = tile_cache->tiles.getptr(tile.coords);
+		if (cached_tile && cached_tile->geometry_hash == geometry_hash) {
+			continue;
+		}
+		if (!cached_tile) {
+			cached_tile = &tile_cache->tiles.insert(tile.coords, NavMeshGeneratorTile3D())->value;
+		}
+
+		tile.geometry_hash = geometry_hash;
+		tile.tile = cached_tile;
+		tile_bake.dirty_tiles.push_back(tile_index);
+	}
+
+	tile_cache->last_baked_tile_count = tile_bake.dirty_tiles.size();
+
+	if (use_threads && tile_bake.dirty_tiles.size() > 1) {
+		WorkerThreadPool::GroupID group_task = WorkerThreadPool::get_singleton()->add_native_group_task(&NavMeshGenerator3D::generator_thread_bake_tile, &tile_bake, tile_bake.dirty_tiles.size(), -1, baking_use_high_priority_threads, SNAME("NavMeshGeneratorBakeTiles3D"));
+		WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_task);
+	} else {
+		for (uint32_t i = 0; i < tile_bake.dirty_tiles.size(); i++) {
+			generator_thread_bake_tile(&tile_bake, i);
+		}
+	}
+
+	Vector<Vector3> nav_vertices;
+	Vector<Vector<int>> nav_polygons;
+	generator_merge_tiles(*tile_cache, tile_bake.tile_size, cfg.cs, cfg.walkableClimb * cfg.ch, nav_vertices, nav_polygons);
+
+	p_navigation_mesh->set_data(nav_vertices, nav_polygons);
+}
+
+void NavMeshGenerator3D::generator_thread_bake_tile(void *p_arg, uint32_t p_index) {
+	NavMeshGeneratorTileBake3D *tile_bake = static_cast<NavMeshGeneratorTileBake3D *>(p_arg);
+	const NavMeshGeneratorTileGeometry3D &dirty_tile = tile_bake->tiles[tile_bake->dirty_tiles[p_index]];
+
+	rcConfig cfg = *tile_bake->config;
+	cfg.bmin[0] = dirty_tile.coords.x * tile_bake->tile_size - tile_bake->border_size;
+	cfg.bmin[2] = dirty_tile.coords.y * tile_bake->tile_size - tile_bake->border_size;
+	cfg.bmax[0] = (dirty_tile.coords.x + 1) * tile_bake->tile_size + tile_bake->border_size;
+	cfg.bmax[2] = (dirty_tile.coords.y + 1) * tile_bake->tile_size + tile_bake->border_size;
+
+	NavMeshGeneratorTile3D *tile = dirty_tile.tile;
+	tile->vertices.clear();
+	tile->polygons.clear();
+
+	const bool baked = generator_bake_recast_mesh(tile_bake->navigation_mesh, cfg, tile_bake->vertices, tile_bake->vertex_count, dirty_tile.triangles.ptr(), dirty_tile.triangles.size() / 3, dirty_tile.projected_obstructions, tile->vertices, tile->polygons);
+
+	// A failed tile is retried on the next bake.
+	tile->geometry_hash = baked ? dirty_tile.geometry_hash : 0;
+}
+
+void NavMeshGenerator3D::generator_merge_tiles(const NavMeshGeneratorTileCache3D &p_tile_cache, float p_tile_size, float p_cell_size, float p_max_climb, Vector<Vector3> &r_vertices, Vector<Vector<int>> &r_polygons) {
+	// Tile sides in the order -X, +X, -Z, +Z. A side and its opposite only differ in the lowest bit.
+	static const Vector2i side_offsets[4] = { Vector2i(-1, 0), Vector2i(1, 0), Vector2i(0, -1), Vector2i(0, 1) };
+
+	struct TileSides {
+		real_t coordinates[4];
+		// The merged vertices that lie on each side of the tile.
+		LocalVector<int> vertices[4];
+	};
+
+	struct EdgeVertex {
+		real_t weight = 0.0;
+		int index = -1;
+
+		bool operator<(const EdgeVertex &p_other) const { return weight < p_other.weight; }
+	};
+
+	LocalVector<Vector2i> tile_coords;
+	tile_coords.reserve(p_tile_cache.tiles.size());
+	for (const KeyValue<Vector2i, NavMeshGeneratorTile3D> &E : p_tile_cache.tiles) {
+		tile_coords.push_back(E.key);
+	}
+	tile_coords.sort();
+
+	// Vertices are snapped onto the tile sides they lie on so that vertices shared by neighboring tiles weld together.
+	const real_t snap_distance = p_cell_size * 0.5;
+
+	HashMap<Vector3, int> vertex_ids;
+	HashMap<Vector2i, TileSides> tile_sides;
+	LocalVector<Vector<int>> polygons;
+	LocalVector<uint32_t> polygon_tiles;
+
+	for (uint32_t tile_index = 0; tile_index < tile_coords.size(); tile_index++) {
+		const Vector2i &coords = tile_coords[tile_index];
+		const NavMeshGeneratorTile3D &tile = p_tile_cache.tiles[coords];
+
+		TileSides &sides = tile_sides.insert(coords, TileSides())->value;
+		sides.coordinates[0] = coords.x * p_tile_size;
+		sides.coordinates[1] = (coords.x + 1) * p_tile_size;
+		sides.coordinates[2] = coords.y * p_tile_size;
+		sides.coordinates[3] = (coords.y + 1) * p_tile_size;
+
+		LocalVector<int> tile_vertex_ids;
+		tile_vertex_ids.resize(tile.vertices.size());
+
+		for (int i = 0; i < tile.vertices.size(); i++) {
+			Vector3 vertex = tile.vertices[i];
+			uint32_t vertex_sides = 0;
+			for (int side = 0; side < 4; side++) {
+				real_t &coordinate = side < 2 ? vertex.x : vertex.z;
+				if (Math::abs(coordinate - sides.coordinates[side]) <= snap_distance) {
+					coordinate = sides.coordinates[side];
+					vertex_sides |= 1 << side;
+				}
+			}
+
+			HashMap<Vector3, int>::Iterator vertex_id = vertex_ids.find(vertex);
+			if (!vertex_id) {
+				vertex_id = vertex_ids.insert(vertex, r_vertices.size());
+				r_vertices.push_back(vertex);
+			}
+			tile_vertex_ids[i] = vertex_id->value;
+
+			for (int side = 0; side < 4; side++) {
+				if (vertex_sides & (1 << side)) {
+					sides.vertices[side].push_back(vertex_id->value);
+				}
+			}
+		}
+
+		for (const Vector<int> &tile_polygon : tile.polygons) {
+			Vector<int> polygon;
+			polygon.resize(tile_polygon.size());
+			for (int i = 0; i < tile_polygon.size(); i++) {
+				polygon.write[i] = tile_vertex_ids[tile_polygon[i]];
+			}
+			polygons.push_back(polygon);
+			polygon_tiles.push_back(tile_index);
+		}
+	}
+
+	// Tiles are triangulated independently, so an edge on a tile side can be split differently by the neighboring tile.
+	// The vertices of the neighbor on that edge are inserted so that both tiles end up with the same edges and connect.
+	// Splits shorter than a cell would collapse into a single point on the navigation map.
+	const real_t min_edge_length = p_cell_size;
+	const Vector3 *vertices = r_vertices.ptr();
+	LocalVector<EdgeVertex> edge_vertices;
+
+	r_polygons.resize(polygons.size());
+	for (uint32_t polygon_index = 0; polygon_index < polygons.size(); polygon_index++) {
+		const Vector<int> &polygon = polygons[polygon_index];
+		const Vector2i &coords = tile_coords[polygon_tiles[polygon_index]];
+		const TileSides &sides = tile_sides[coords];
+
+		Vector<int> &merged_polygon = r_polygons.write[polygon_index];
+
+		for (int i = 0; i < polygon.size(); i++) {
+			const int edge_start = polygon[i];
+			const int edge_end = polygon[(i + 1) % polygon.size()];
+			merged_polygon.push_back(edge_start);
+
+			for (int side = 0; side < 4; side++) {
+				const int axis = side < 2 ? Vector3::AXIS_X : Vector3::AXIS_Z;
+				if (vertices[edge_start][axis] != sides.coordinates[side] || vertices[edge_end][axis] != sides.coordinates[side]) {
+					continue;
+				}
+
+				const TileSides *neighbor_sides = tile_sides.getptr(coords + side_offsets[side]);
+				if (!neighbor_sides) {
+					break;
+				}
+
+				const int edge_axis = side < 2 ? Vector3::AXIS_Z : Vector3::AXIS_X;
+				const real_t edge_from = vertices[edge_start][edge_axis];
+				const real_t edge_length = vertices[edge_end][edge_axis] - edge_from;
+				if (Math::abs(edge_length) <= min_edge_length) {
+					break;
+				}
+
+				edge_vertices.clear();
+				for (int neighbor_vertex : neighbor_sides->vertices[side ^ 1]) {
+					const Vector3 &vertex = vertices[neighbor_vertex];
+					const real_t weight = (vertex[edge_axis] - edge_from) / edge_length;
+					if (weight * Math::abs(edge_length) < min_edge_length || (1.0 - weight) * Math::abs(edge_length) < min_edge_length) {
+						continue;
+					}
+					const real_t edge_height = Math::lerp(vertices[edge_start].y, vertices[edge_end].y, weight);
+					if (Math::abs(vertex.y - edge_height) > p_max_climb) {
+						continue;
+					}
+					edge_vertices.push_back({ weight, neighbor_vertex });
+				}
+
+				edge_vertices.sort();
+				for (const EdgeVertex &edge_vertex : edge_vertices) {
+					merged_polygon.push_back(edge_vertex.index);
+				}
+				break;
+			}
+		}
+	}
+}
+
+uint32_t NavMeshGenerator3D::get_last_baked_tile_count(const Ref<NavigationMesh> &p_navigation_mesh) {
+	ERR_FAIL_COND_V(p_navigation_mesh.is_null(), 0);
+	MutexLock tile_cache_lock(tile_cache_mutex);
+	NavMeshGeneratorTileCache3D *const *tile_cache = tile_caches.getptr(p_navigation_mesh->get_instance_id());
+	return tile_cache ? (*tile_cache)->last_baked_tile_count : 0;
+}
+
+NavMeshGenerator3D::NavMeshGeneratorTileCache3D *NavMeshGenerator3D::generator_get_tile_cache(const Ref<NavigationMesh> &p_navigation_mesh) {
+	MutexLock tile_cache_lock(tile_cache_mutex);
+
+	// Drop the tiles of navigation meshes that no longer exist.
+	LocalVector<ObjectID> freed_navmesh_ids;
+	for (const KeyValue<ObjectID, NavMeshGeneratorTileCache3D *> &E : tile_caches) {
+		if (!ObjectDB::get_instance(E.key)) {
+			freed_navmesh_ids.push_back(E.key);
+		}
+	}
+	for (const ObjectID &navmesh_id : freed_navmesh_ids) {
+		memdelete(tile_caches[navmesh_id]);
+		tile_caches.erase(navmesh_id);
+	}
+
+	NavMeshGeneratorTileCache3D **tile_cache = tile_caches.getptr(p_navigation_mesh->get_instance_id());
+	if (tile_cache) {
+		return *tile_cache;
+	}
+	return tile_caches.insert(p_navigation_mesh->get_instance_id(), memnew(NavMeshGeneratorTileCache3D))->value;
+}
+
+void NavMeshGenerator3D::generator_clear_tile_cache(const Ref<NavigationMesh> &p_navigation_mesh) {
+	MutexLock tile_cache_lock(tile_cache_mutex);
+
+	NavMeshGeneratorTileCache3D **tile_cache = tile_caches.getptr(p_navigation_mesh->get_instance_id());
+	if (tile_cache) {
+		memdelete(*tile_cache);
+		tile_caches.erase(p_navigation_mesh->get_instance_id());
+	}
 }
 
 bool NavMeshGenerator3D::generator_emit_callback(const Callable &p_callback) {
@@ -38,6 +38,7 @@
 class Node;
 class NavigationMesh;
 class NavigationMeshSourceGeometryData3D;
+struct rcConfig;
 
 class NavMeshGenerator3D : public Object {
 	static NavMeshGenerator3D *singleton;
@@ -70,6 +71,41 @@ class NavMeshGenerator3D : public Object {
 
 	static HashMap<WorkerThreadPool::TaskID, NavMeshGeneratorTask3D *> generator_tasks;
 
+	struct NavMeshGeneratorTile3D {
+		uint32_t geometry_hash = 0;
+		Vector<Vector3> vertices;
+		Vector<Vector<int>> polygons;
+	};
+
+	// The baked tiles of a navigation mesh, kept to only rebake the tiles with changed source geometry.
+	struct NavMeshGeneratorTileCache3D {
+		uint32_t settings_hash = 0;
+		HashMap<Vector2i, NavMeshGeneratorTile3D> tiles;
+		uint32_t last_baked_tile_count = 0;
+	};
+
+	struct NavMeshGeneratorTileGeometry3D {
+		Vector2i coords;
+		uint32_t geometry_hash = 0;
+		LocalVector<int> triangles;
+		LocalVector<const NavigationMeshSourceGeometryData3D::ProjectedObstruction *> projected_obstructions;
+		NavMeshGeneratorTile3D *tile = nullptr;
+	};
+
+	struct NavMeshGeneratorTileBake3D {
+		Ref<NavigationMesh> navigation_mesh;
+		const rcConfig *config = nullptr;
+		const float *vertices = nullptr;
+		int vertex_count = 0;
+		float tile_size = 0.0;
+		float border_size = 0.0;
+		LocalVector<NavMeshGeneratorTileGeometry3D> tiles;
+		LocalVector<uint32_t> dirty_tiles;
+	};
+
+	static Mutex tile_cache_mutex;
+	static HashMap<ObjectID, NavMeshGeneratorTileCache3D *> tile_caches;
+
 	static void generator_thread_bake(void *p_arg);
 
 	static HashSet<Ref<NavigationMesh>> baking_navmeshes;
@@ -77,6 +113,15 @@ class NavMeshGenerator3D : public Object {
 	static void generator_parse_geometry_node(const Ref<NavigationMesh> &p_navigation_mesh, Ref<NavigationMeshSourceGeometryData3D> p_source_geometry_data, Node *p_node, bool p_recurse_children);
 	static void generator_parse_source_geometry_data(const Ref<NavigationMesh> &p_navigation_mesh, Ref<NavigationMeshSourceGeometryData3D> p_source_geometry_data, Node *p_root_node);
 	static void generator_bake_from_source_geometry_data(Ref<NavigationMesh> p_navigation_mesh, const Ref<NavigationMeshSourceGeometryData3D> &p_source_geometry_data);
+	static void generator_bake_tiles_from_source_geometry_data(Ref<NavigationMesh> p_navigation_mesh, const Ref<NavigationMeshSourceGeometryData3D> &p_source_geometry_data);
+	static void generator_thread_bake_tile(void *p_arg, uint32_t p_index);
+
+	static void generator_init_recast_config(const Ref<NavigationMesh> &p_navigation_mesh, rcConfig &r_config);
+	static bool generator_bake_recast_mesh(const Ref<NavigationMesh> &p_navigation_mesh, const rcConfig &p_config, const float *p_vertices, int p_vertex_count, const int *p_triangles, int p_triangle_count, const LocalVector<const NavigationMeshSourceGeometryData3D::ProjectedObstruction *> &p_projected_obstructions, Vector<Vector3> &r_vertices, Vector<Vector<int>> &r_polygons);
+
+	static NavMeshGeneratorTileCache3D *generator_get_tile_cache(const Ref<NavigationMesh> &p_navigation_mesh);
+	static void generator_clear_tile_cache(const Ref<NavigationMesh> &p_navigation_mesh);
+	static void generator_merge_tiles(const NavMeshGeneratorTileCache3D &p_tile_cache, float p_tile_size, float p_cell_size, float p_max_climb, Vector<Vector3> &r_vertices, Vector<Vector<int>> &r_polygons);
 
 	static bool generator_emit_callback(const Callable &p_callback);
 
@@ -93,6 +138,8 @@ public:
 	static void bake_from_source_geometry_data(Ref<NavigationMesh> p_navigation_mesh, Ref<NavigationMeshSourceGeometryData3D> p_source_geometry_data, const Callable &p_callback = Callable());
 	static void bake_from_source_geometry_data_async(Ref<NavigationMesh> p_navigation_mesh, Ref<NavigationMeshSourceGeometryData3D> p_source_geometry_data, const Callable &p_callback = Callable());
 	static bool is_baking(Ref<NavigationMesh> p_navigation_mesh);
+	// How many tiles the last tiled bake of the navigation mesh had to bake, the others were reused.
+	static uint32_t get_last_baked_tile_count(const Ref<NavigationMesh> &p_navigation_mesh);
 
 	NavMeshGenerator3D();
 	~NavMeshGenerator3D();
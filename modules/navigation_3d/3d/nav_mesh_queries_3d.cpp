@@ -145,18 +145,12 @@ void NavMeshQueries3D::_query_task_push_back_point_with_metadata(NavMeshPathQuer
 	p_query_task.path_points.push_back(p_point);
 }
 
-void NavMeshQueries3D::map_query_path(NavMap3D *map, const Ref<NavigationPathQueryParameters3D> &p_query_parameters, Ref<NavigationPathQueryResult3D> p_query_result, const Callable &p_callback) {
-	ERR_FAIL_NULL(map);
-	ERR_FAIL_COND(p_query_parameters.is_null());
-	ERR_FAIL_COND(p_query_result.is_null());
-
+void NavMeshQueries3D::_query_task_set_parameters(NavMeshPathQueryTask3D &r_query_task, const Ref<NavigationPathQueryParameters3D> &p_query_parameters) {
 	using namespace NavigationUtilities;
 
-	NavMeshQueries3D::NavMeshPathQueryTask3D query_task;
-	query_task.start_position = p_query_parameters->get_start_position();
-	query_task.target_position = p_query_parameters->get_target_position();
-	query_task.navigation_layers = p_query_parameters->get_navigation_layers();
-	query_task.callback = p_callback;
+	r_query_task.start_position = p_query_parameters->get_start_position();
+	r_query_task.target_position = p_query_parameters->get_target_position();
+	r_query_task.navigation_layers = p_query_parameters->get_navigation_layers();
 
 	const TypedArray<RID> &_excluded_regions = p_query_parameters->get_excluded_regions();
 	const TypedArray<RID> &_included_regions = p_query_parameters->get_included_regions();
@@ -164,53 +158,63 @@ void NavMeshQueries3D::map_query_path(NavMap3D *map, const Ref<NavigationPathQue
 	uint32_t _excluded_region_count = _excluded_regions.size();
 	uint32_t _included_region_count = _included_regions.size();
 
-	query_task.exclude_regions = _excluded_region_count > 0;
-	query_task.include_regions = _included_region_count > 0;
+	r_query_task.exclude_regions = _excluded_region_count > 0;
+	r_query_task.include_regions = _included_region_count > 0;
 
-	if (query_task.exclude_regions) {
-		query_task.excluded_regions.resize(_excluded_region_count);
+	if (r_query_task.exclude_regions) {
+		r_query_task.excluded_regions.resize(_excluded_region_count);
 		for (uint32_t i = 0; i < _excluded_region_count; i++) {
-			query_task.excluded_regions[i] = _excluded_regions[i];
+			r_query_task.excluded_regions[i] = _excluded_regions[i];
 		}
 	}
 
-	if (query_task.include_regions) {
-		query_task.included_regions.resize(_included_region_count);
+	if (r_query_task.include_regions) {
+		r_query_task.included_regions.resize(_included_region_count);
 		for (uint32_t i = 0; i < _included_region_count; i++) {
-			query_task.included_regions[i] = _included_regions[i];
+			r_query_task.included_regions[i] = _included_regions[i];
 		}
 	}
 
 	switch (p_query_parameters->get_pathfinding_algorithm()) {
 		case NavigationPathQueryParameters3D::PathfindingAlgorithm::PATHFINDING_ALGORITHM_ASTAR: {
-			query_task.pathfinding_algorithm = PathfindingAlgorithm::PATHFINDING_ALGORITHM_ASTAR;
+			r_query_task.pathfinding_algorithm = PathfindingAlgorithm::PATHFINDING_ALGORITHM_ASTAR;
 		} break;
 		default: {
 			WARN_PRINT("No match for used PathfindingAlgorithm - fallback to default");
-			query_task.pathfinding_algorithm = PathfindingAlgorithm::PATHFINDING_ALGORITHM_ASTAR;
+			r_query_task.pathfinding_algorithm = PathfindingAlgorithm::PATHFINDING_ALGORITHM_ASTAR;
 		} break;
 	}
 
 	switch (p_query_parameters->get_path_postprocessing()) {
 		case NavigationPathQueryParameters3D::PathPostProcessing::PATH_POSTPROCESSING_CORRIDORFUNNEL: {
-			query_task.path_postprocessing = PathPostProcessing::PATH_POSTPROCESSING_CORRIDORFUNNEL;
+			r_query_task.path_postprocessing = PathPostProcessing::PATH_POSTPROCESSING_CORRIDORFUNNEL;
 		} break;
 		case NavigationPathQueryParameters3D::PathPostProcessing::PATH_POSTPROCESSING_EDGECENTERED: {
-			query_task.path_postprocessing = PathPostProcessing::PATH_POSTPROCESSING_EDGECENTERED;
+			r_query_task.path_postprocessing = PathPostProcessing::PATH_POSTPROCESSING_EDGECENTERED;
 		} break;
 		case NavigationPathQueryParameters3D::PathPostProcessing::PATH_POSTPROCESSING_NONE: {
-			query_task.path_postprocessing = PathPostProcessing::PATH_POSTPROCESSING_NONE;
+			r_query_task.path_postprocessing = PathPostProcessing::PATH_POSTPROCESSING_NONE;
 		} break;
 		default: {
 			WARN_PRINT("No match for used PathPostProcessing - fallback to default");
-			query_task.path_postprocessing = PathPostProcessing::PATH_POSTPROCESSING_CORRIDORFUNNEL;
+			r_query_task.path_postprocessing = PathPostProcessing::PATH_POSTPROCESSING_CORRIDORFUNNEL;
 		} break;
 	}
 
-	query_task.metadata_flags = (int64_t)p_query_parameters->get_metadata_flags();
-	query_task.simplify_path = p_query_parameters->get_simplify_path();
-	query_task.simplify_epsilon = p_query_parameters->get_simplify_epsilon();
-	query_task.status = NavMeshPathQueryTask3D::TaskStatus::QUERY_STARTED;
+	r_query_task.metadata_flags = (int64_t)p_query_parameters->get_metadata_flags();
+	r_query_task.simplify_path = p_query_parameters->get_simplify_path();
+	r_query_task.simplify_epsilon = p_query_parameters->get_simplify_epsilon();
+	r_query_task.status = NavMeshPathQueryTask3D::TaskStatus::QUERY_STARTED;
+}
+
+void NavMeshQueries3D::map_query_path(NavMap3D *map, const Ref<NavigationPathQueryParameters3D> &p_query_parameters, Ref<NavigationPathQueryResult3D> p_query_result, const Callable &p_callback) {
+	ERR_FAIL_NULL(map);
+	ERR_FAIL_COND(p_query_parameters.is_null());
+	ERR_FAIL_COND(p_query_result.is_null());
+
+	NavMeshQueries3D::NavMeshPathQueryTask3D query_task;
+	_query_task_set_parameters(query_task, p_query_parameters);
+	query_task.callback = p_callback;
 
 	map->query_path(query_task);
 
@@ -229,53 +233,151 @@ void NavMeshQueries3D::map_query_path(NavMap3D *map, const Ref<NavigationPathQue
 	}
 }
 
-void NavMeshQueries3D::_query_task_find_start_end_positions(NavMeshPathQueryTask3D &p_query_task, const NavMapIteration3D &p_map_iteration) {
-	real_t begin_d = FLT_MAX;
-	real_t end_d = FLT_MAX;
+void NavMeshQueries3D::map_query_paths_batch(NavMap3D *map, const TypedArray<NavigationPathQueryParameters3D> &p_query_parameters, const TypedArray<NavigationPathQueryResult3D> &p_query_results, const LocalVector<uint32_t> &p_query_indices) {
+	ERR_FAIL_NULL(map);
+	ERR_FAIL_COND(p_query_parameters.size() != p_query_results.size());
 
-	const LocalVector<NavRegionIteration3D> &regions = p_map_iteration.region_iterations;
+	LocalVector<NavMeshPathQueryTask3D> query_tasks;
+	query_tasks.resize(p_query_indices.size());
+	for (uint32_t i = 0; i < p_query_indices.size(); i++) {
+		const Ref<NavigationPathQueryParameters3D> query_parameters = p_query_parameters[p_query_indices[i]];
+		_query_task_set_parameters(query_tasks[i], query_parameters);
+	}
 
-	for (const NavRegionIteration3D &region : regions) {
-		if (!region.get_enabled()) {
-			continue;
+	map->query_paths_batch(query_tasks);
+
+	for (uint32_t i = 0; i < p_query_indices.size(); i++) {
+		const NavMeshPathQueryTask3D &query_task = query_tasks[i];
+		Ref<NavigationPathQueryResult3D> query_result = p_query_results[p_query_indices[i]];
+		query_result->set_data(
+				query_task.path_points,
+				query_task.path_meta_point_types,
+				query_task.path_meta_point_rids,
+				query_task.path_meta_point_owners);
+	}
+}
+
+void NavMeshQueries3D::query_task_map_iteration_find_closest_polygon(const NavMeshPathQueryTask3D &p_query_task, const NavMapIteration3D &p_map_iteration, const Vector3 &p_position, const Polygon *&r_polygon, Vector3 &r_closest_point) {
+	real_t closest_distance_squared = FLT_MAX;
+	p_map_iteration.polygon_bvh.cull_nearest(p_position, closest_distance_squared, [&](const Polygon &p_polygon, real_t &r_distance_squared) {
+		const NavBaseIteration3D *owner = p_polygon.owner;
+		if (!owner->get_enabled()) {
+			return true;
+		}
+		if (p_query_task.exclude_regions && p_query_task.excluded_regions.has(owner->get_self())) {
+			return true;
+		}
+		if (p_query_task.include_regions && !p_query_task.included_regions.has(owner->get_self())) {
+			return true;
+		}
+		// Only consider the polygon if it in a region with compatible layers.
+		if ((p_query_task.navigation_layers & owner->get_navigation_layers()) == 0) {
+			return true;
 		}
 
-		if (p_query_task.exclude_regions && p_query_task.excluded_regions.has(region.get_self())) {
-			continue;
+		// For each face check the distance to the position.
+		for (uint32_t point_id = 2; point_id < p_polygon.points.size(); point_id++) {
+			const Face3 face(p_polygon.points[0].pos, p_polygon.points[point_id - 1].pos, p_polygon.points[point_id].pos);
+
+			const Vector3 point = face.get_closest_point_to(p_position);
+			const real_t distance_squared = point.distance_squared_to(p_position);
+			if (distance_squared < r_distance_squared) {
+				r_distance_squared = distance_squared;
+				r_polygon = &p_polygon;
+				r_closest_point = point;
+			}
 		}
-		if (p_query_task.include_regions && !p_query_task.included_regions.has(region.get_self())) {
-			continue;
+
+		// Nothing can be closer than a polygon the position is on.
+		return r_distance_squared > 0.0;
+	});
+}
+
+void NavMeshQueries3D::_query_task_find_start_end_positions(NavMeshPathQueryTask3D &p_query_task, const NavMapIteration3D &p_map_iteration) {
+	// Find the initial poly and the end poly on this map.
+	query_task_map_iteration_find_closest_polygon(p_query_task, p_map_iteration, p_query_task.start_position, p_query_task.begin_polygon, p_query_task.begin_position);
+	query_task_map_iteration_find_closest_polygon(p_query_task, p_map_iteration, p_query_task.target_position, p_query_task.end_polygon, p_query_task.end_position);
+}
+
+bool NavMeshQueries3D::_query_task_build_cluster_corridor(NavMeshPathQueryTask3D &p_query_task, const NavMapIteration3D &p_map_iteration) {
+	const LocalVector<Cluster> &clusters = p_map_iteration.clusters;
+	if (clusters.is_empty()) {
+		return false;
+	}
+
+	const uint32_t begin_cluster_id = p_map_iteration.polygon_clusters[p_query_task.begin_polygon->id];
+	const uint32_t end_cluster_id = p_map_iteration.polygon_clusters[p_query_task.end_polygon->id];
+	if (begin_cluster_id == end_cluster_id) {
+		// Nothing to gain, the polygon search stays within a single cluster anyway.
+		return false;
+	}
+
+	Heap<NavigationCluster *, NavClusterTravelCostGreaterThan, NavClusterHeapIndexer> &traversable_clusters = p_query_task.path_query_slot->traversable_clusters;
+	traversable_clusters.clear();
+
+	LocalVector<NavigationCluster> &navigation_clusters = p_query_task.path_query_slot->navigation_clusters;
+	for (NavigationCluster &navigation_cluster : navigation_clusters) {
+		navigation_cluster.reset();
+	}
+
+	const Vector3 end_position = clusters[end_cluster_id].position;
+	navigation_clusters[begin_cluster_id].traveled_cost = 0.0;
+
+	// A* over the cluster graph.
+	bool found_route = false;
+	uint32_t least_cost_id = begin_cluster_id;
+	while (true) {
+		if (least_cost_id == end_cluster_id) {
+			found_route = true;
+			break;
 		}
 
-		// Find the initial poly and the end poly on this map.
-		for (const Polygon &p : region.get_navmesh_polygons()) {
-			// Only consider the polygon if it in a region with compatible layers.
-			if ((p_query_task.navigation_layers & p.owner->get_navigation_layers()) == 0) {
+		const NavigationCluster &least_cost_cluster = navigation_clusters[least_cost_id];
+		for (const Cluster::Connection &connection : clusters[least_cost_id].connections) {
+			if ((p_query_task.navigation_layers & connection.navigation_layers) == 0) {
 				continue;
 			}
 
-			// For each face check the distance between the origin/destination.
-			for (uint32_t point_id = 2; point_id < p.points.size(); point_id++) {
-				const Face3 face(p.points[0].pos, p.points[point_id - 1].pos, p.points[point_id].pos);
+			const real_t new_traveled_cost = least_cost_cluster.traveled_cost + connection.cost;
+			NavigationCluster &neighbor_cluster = navigation_clusters[connection.cluster];
+			if (new_traveled_cost < neighbor_cluster.traveled_cost) {
+				neighbor_cluster.back_navigation_cluster_id = least_cost_id;
+				neighbor_cluster.traveled_cost = new_traveled_cost;
+				neighbor_cluster.cost_to_destination = clusters[connection.cluster].position.distance_to(end_position);
 
-				Vector3 point = face.get_closest_point_to(p_query_task.start_position);
-				real_t distance_to_point = point.distance_to(p_query_task.start_position);
-				if (distance_to_point < begin_d) {
-					begin_d = distance_to_point;
-					p_query_task.begin_polygon = &p;
-					p_query_task.begin_position = point;
-				}
-
-				point = face.get_closest_point_to(p_query_task.target_position);
-				distance_to_point = point.distance_to(p_query_task.target_position);
-				if (distance_to_point < end_d) {
-					end_d = distance_to_point;
-					p_query_task.end_polygon = &p;
-					p_query_task.end_position = point;
+				if (neighbor_cluster.traversable_cluster_index != traversable_clusters.INVALID_INDEX) {
+					traversable_clusters.shift(neighbor_cluster.traversable_cluster_index);
+				} else {
+					traversable_clusters.push(&neighbor_cluster);
 				}
 			}
 		}
+
+		if (traversable_clusters.is_empty()) {
+			break;
+		}
+		least_cost_id = traversable_clusters.pop()->id;
+	}
+
+	if (!found_route) {
+		return false;
 	}
+
+	// Allow the clusters along the route and their neighbors, which leaves the polygon search some room around it.
+	LocalVector<uint8_t> &cluster_corridor = p_query_task.path_query_slot->cluster_corridor;
+	memset(cluster_corridor.ptr(), 0, cluster_corridor.size());
+
+	uint32_t cluster_id = end_cluster_id;
+	while (cluster_id != UINT32_MAX) {
+		cluster_corridor[cluster_id] = 1;
+		for (const Cluster::Connection &connection : clusters[cluster_id].connections) {
+			cluster_corridor[connection.cluster] = 1;
+		}
+		cluster_id = navigation_clusters[cluster_id].back_navigation_cluster_id;
+	}
+
+	p_query_task.polygon_clusters = &p_map_iteration.polygon_clusters;
+	return true;
 }
 
 void NavMeshQueries3D::_query_task_build_path_corridor(NavMeshPathQueryTask3D &p_query_task) {
@@ -328,6 +430,11 @@ void NavMeshQueries3D::_query_task_build_path_corridor(NavMeshPathQueryTask3D &p
 					continue;
 				}
 
+				// Stay inside the clusters picked by the hierarchical search.
+				if (p_query_task.use_cluster_corridor && !p_query_task.path_query_slot->cluster_corridor[(*p_query_task.polygon_clusters)[connection.polygon->id]]) {
+					continue;
+				}
+
 				const Vector3 new_entry = Geometry3D::get_closest_point_to_segment(least_cost_poly.entry, connection.pathway_start, connection.pathway_end);
 				const real_t new_traveled_distance = least_cost_poly.entry.distance_to(new_entry) * poly_travel_cost + poly_enter_cost + least_cost_poly.traveled_distance;
 
@@ -469,7 +576,10 @@ void NavMeshQueries3D::query_task_map_iteration_get_path(NavMeshPathQueryTask3D
 	p_query_task.path_clear();
 
 	_query_task_find_start_end_positions(p_query_task, p_map_iteration);
+	_query_task_build_path(p_query_task, p_map_iteration);
+}
 
+void NavMeshQueries3D::_query_task_build_path(NavMeshPathQueryTask3D &p_query_task, const NavMapIteration3D &p_map_iteration) {
 	// Check for trivial cases.
 	if (!p_query_task.begin_polygon || !p_query_task.end_polygon) {
 		p_query_task.status = NavMeshPathQueryTask3D::TaskStatus::QUERY_FINISHED;
@@ -483,12 +593,34 @@ void NavMeshQueries3D::query_task_map_iteration_get_path(NavMeshPathQueryTask3D
 		return;
 	}
 
-	_query_task_build_path_corridor(p_query_task);
+	if (_query_task_build_cluster_corridor(p_query_task, p_map_iteration)) {
+		const Polygon *end_polygon = p_query_task.end_polygon;
+		const Vector3 end_position = p_query_task.end_position;
+
+		p_query_task.use_cluster_corridor = true;
+		_query_task_build_path_corridor(p_query_task);
+		p_query_task.use_cluster_corridor = false;
+
+		if (p_query_task.status == NavMeshPathQueryTask3D::TaskStatus::QUERY_FINISHED || p_query_task.end_polygon != end_polygon) {
+			// The destination can't be reached inside the cluster corridor, e.g. because of region filters. Search the whole map.
+			p_query_task.path_clear();
+			p_query_task.status = NavMeshPathQueryTask3D::TaskStatus::QUERY_STARTED;
+			p_query_task.end_polygon = end_polygon;
+			p_query_task.end_position = end_position;
+			_query_task_build_path_corridor(p_query_task);
+		}
+	} else {
+		_query_task_build_path_corridor(p_query_task);
+	}
 
 	if (p_query_task.status == NavMeshPathQueryTask3D::TaskStatus::QUERY_FINISHED || p_query_task.status == NavMeshPathQueryTask3D::TaskStatus::QUERY_FAILED) {
 		return;
 	}
 
+	_query_task_post_process_path(p_query_task);
+}
+
+void NavMeshQueries3D::_query_task_post_process_path(NavMeshPathQueryTask3D &p_query_task) {
 	// Post-Process path.
 	switch (p_query_task.path_postprocessing) {
 		case PathPostProcessing::PATH_POSTPROCESSING_CORRIDORFUNNEL: {
@@ -530,6 +662,295 @@ void NavMeshQueries3D::query_task_map_iteration_get_path(NavMeshPathQueryTask3D
 	p_query_task.status = NavMeshPathQueryTask3D::TaskStatus::QUERY_FINISHED;
 }
 
+void NavMeshQueries3D::map_iteration_build_reverse_connections(const NavMapIteration3D &p_map_iteration, ReverseConnections &r_reverse_connections) {
+	LocalVector<uint32_t> &offsets = r_reverse_connections.offsets;
+	LocalVector<ReverseConnections::Connection> &connections = r_reverse_connections.connections;
+
+	LocalVector<const Polygon *> polygons;
+	polygons.reserve(p_map_iteration.navmesh_polygon_count + p_map_iteration.link_polygon_count);
+	for (const NavRegionIteration3D &region : p_map_iteration.region_iterations) {
+		if (!region.get_enabled()) {
+			continue;
+		}
+		for (const Polygon &polygon : region.get_navmesh_polygons()) {
+			polygons.push_back(&polygon);
+		}
+	}
+	for (const Polygon &polygon : p_map_iteration.link_polygons) {
+		polygons.push_back(&polygon);
+	}
+
+	// Count the incoming connections of each polygon and turn the counts into offsets.
+	const uint32_t polygon_count = p_map_iteration.navmesh_polygon_count + p_map_iteration.link_polygon_count;
+	offsets.resize(polygon_count + 1);
+	for (uint32_t &offset : offsets) {
+		offset = 0;
+	}
+
+	for (const Polygon *polygon : polygons) {
+		for (const Edge &edge : polygon->edges) {
+			for (const Edge::Connection &connection : edge.connections) {
+				offsets[connection.polygon->id + 1] += 1;
+			}
+		}
+	}
+	for (uint32_t i = 1; i < offsets.size(); i++) {
+		offsets[i] += offsets[i - 1];
+	}
+
+	connections.resize(offsets[polygon_count]);
+	LocalVector<uint32_t> connection_indices = offsets;
+	for (const Polygon *polygon : polygons) {
+		for (const Edge &edge : polygon->edges) {
+			for (const Edge::Connection &connection : edge.connections) {
+				ReverseConnections::Connection &reverse_connection = connections[connection_indices[connection.polygon->id]++];
+				reverse_connection.polygon = polygon;
+				reverse_connection.connection = &connection;
+			}
+		}
+	}
+}
+
+void NavMeshQueries3D::query_batch_map_iteration_group_tasks(PathQueryBatch3D &r_query_batch) {
+	LocalVector<NavMeshPathQueryTask3D> &query_tasks = *r_query_batch.query_tasks;
+	const NavMapIteration3D &map_iteration = *r_query_batch.map_iteration;
+
+	LocalVector<PathQueryBatch3D::Group> &groups = r_query_batch.groups;
+	groups.clear();
+
+	LocalVector<uint32_t> single_query_task_indices;
+	LocalVector<PathQueryBatch3D::Group> shared_groups;
+	// The shared groups of each end polygon.
+	HashMap<uint32_t, LocalVector<uint32_t>> end_polygon_groups;
+
+	for (uint32_t i = 0; i < query_tasks.size(); i++) {
+		NavMeshPathQueryTask3D &query_task = query_tasks[i];
+		query_task.path_clear();
+		_query_task_find_start_end_positions(query_task, map_iteration);
+
+		if (!query_task.begin_polygon || !query_task.end_polygon || query_task.begin_polygon == query_task.end_polygon) {
+			// Trivial case, nothing to share.
+			single_query_task_indices.push_back(i);
+			continue;
+		}
+
+		LocalVector<uint32_t> &group_indices = end_polygon_groups[query_task.end_polygon->id];
+		bool is_grouped = false;
+		for (uint32_t group_index : group_indices) {
+			PathQueryBatch3D::Group &group = shared_groups[group_index];
+			if (_query_tasks_share_flow_field(query_tasks[group.query_task_indices[0]], query_task)) {
+				group.query_task_indices.push_back(i);
+				is_grouped = true;
+				break;
+			}
+		}
+		if (!is_grouped) {
+			group_indices.push_back(shared_groups.size());
+			shared_groups.push_back(PathQueryBatch3D::Group());
+			shared_groups[shared_groups.size() - 1].query_task_indices.push_back(i);
+		}
+	}
+
+	// The flow field groups take the longest, so they are processed first.
+	for (PathQueryBatch3D::Group &group : shared_groups) {
+		if (group.query_task_indices.size() < PathQueryBatch3D::FLOW_FIELD_MIN_QUERIES) {
+			for (uint32_t query_task_index : group.query_task_indices) {
+				single_query_task_indices.push_back(query_task_index);
+			}
+			continue;
+		}
+		group.use_flow_field = true;
+		groups.push_back(group);
+	}
+
+	if (!groups.is_empty()) {
+		map_iteration_build_reverse_connections(map_iteration, r_query_batch.reverse_connections);
+	}
+
+	for (uint32_t query_task_index : single_query_task_indices) {
+		groups.push_back(PathQueryBatch3D::Group());
+		groups[groups.size() - 1].query_task_indices.push_back(query_task_index);
+	}
+}
+
+void NavMeshQueries3D::query_batch_process_group(PathQueryBatch3D &r_query_batch, uint32_t p_group_index, PathQuerySlot *p_path_query_slot) {
+	LocalVector<NavMeshPathQueryTask3D> &query_tasks = *r_query_batch.query_tasks;
+	const NavMapIteration3D &map_iteration = *r_query_batch.map_iteration;
+	const PathQueryBatch3D::Group &group = r_query_batch.groups[p_group_index];
+
+	if (group.use_flow_field) {
+		HashSet<uint32_t> begin_polygon_ids;
+		for (uint32_t query_task_index : group.query_task_indices) {
+			begin_polygon_ids.insert(query_tasks[query_task_index].begin_polygon->id);
+		}
+
+		NavMeshPathQueryTask3D &query_task = query_tasks[group.query_task_indices[0]];
+		query_task.path_query_slot = p_path_query_slot;
+		query_task_build_flow_field(query_task, r_query_batch.reverse_connections, &begin_polygon_ids);
+	}
+
+	for (uint32_t query_task_index : group.query_task_indices) {
+		NavMeshPathQueryTask3D &query_task = query_tasks[query_task_index];
+		query_task.path_query_slot = p_path_query_slot;
+
+		if (group.use_flow_field && _query_task_build_path_corridor_from_flow_field(query_task)) {
+			_query_task_post_process_path(query_task);
+		} else {
+			// The regular search also handles the destinations that can't be reached.
+			_query_task_build_path(query_task, map_iteration);
+		}
+
+		query_task.path_query_slot = nullptr;
+	}
+}
+
+bool NavMeshQueries3D::_query_tasks_share_flow_field(const NavMeshPathQueryTask3D &p_query_task_a, const NavMeshPathQueryTask3D &p_query_task_b) {
+	if (p_query_task_a.end_polygon != p_query_task_b.end_polygon ||
+			p_query_task_a.end_position != p_query_task_b.end_position ||
+			p_query_task_a.navigation_layers != p_query_task_b.navigation_layers ||
+			p_query_task_a.excluded_regions.size() != p_query_task_b.excluded_regions.size() ||
+			p_query_task_a.included_regions.size() != p_query_task_b.included_regions.size()) {
+		return false;
+	}
+
+	for (uint32_t i = 0; i < p_query_task_a.excluded_regions.size(); i++) {
+		if (p_query_task_a.excluded_regions[i] != p_query_task_b.excluded_regions[i]) {
+			return false;
+		}
+	}
+	for (uint32_t i = 0; i < p_query_task_a.included_regions.size(); i++) {
+		if (p_query_task_a.included_regions[i] != p_query_task_b.included_regions[i]) {
+			return false;
+		}
+	}
+
+	return true;
+}
+
+void NavMeshQueries3D::query_task_build_flow_field(const NavMeshPathQueryTask3D &p_query_task, const ReverseConnections &p_reverse_connections, HashSet<uint32_t> *r_begin_polygon_ids) {
+	const LocalVector<uint32_t> &offsets = p_reverse_connections.offsets;
+	const LocalVector<ReverseConnections::Connection> &connections = p_reverse_connections.connections;
+	const Polygon *end_poly = p_query_task.end_polygon;
+	const Vector3 end_point = p_query_task.end_position;
+
+	// Heap of polygons to travel next.
+	Heap<NavigationPoly *, NavPolyTravelCostGreaterThan, NavPolyHeapIndexer>
+			&traversable_polys = p_query_task.path_query_slot->traversable_polys;
+	traversable_polys.clear();
+
+	LocalVector<NavigationPoly> &flow_field = p_query_task.path_query_slot->flow_field;
+	flow_field.resize(offsets.size() - 1);
+	for (NavigationPoly &polygon : flow_field) {
+		polygon.reset();
+	}
+
+	NavigationPoly &end_navigation_poly = flow_field[end_poly->id];
+	end_navigation_poly.poly = end_poly;
+	end_navigation_poly.entry = end_point;
+	end_navigation_poly.back_navigation_edge_pathway_start = end_point;
+	end_navigation_poly.back_navigation_edge_pathway_end = end_point;
+	end_navigation_poly.traveled_distance = 0.0;
+
+	// This is Dijkstra's algorithm over the incoming connections, starting at the destination.
+	// Each reached polygon stores the next polygon towards the destination in `back_navigation_poly_id`,
+	// the connection to it and its exit position in `entry`.
+	uint32_t least_cost_id = end_poly->id;
+
+	while (true) {
+		const NavigationPoly &least_cost_poly = flow_field[least_cost_id];
+		const NavBaseIteration3D *least_cost_owner = least_cost_poly.poly->owner;
+		const real_t poly_travel_cost = least_cost_owner->get_travel_cost();
+
+		for (uint32_t i = offsets[least_cost_id]; i < offsets[least_cost_id + 1]; i++) {
+			const ReverseConnections::Connection &reverse_connection = connections[i];
+
+			const NavBaseIteration3D *connection_owner = reverse_connection.polygon->owner;
+			if (!_query_task_is_connection_owner_usable(p_query_task, connection_owner)) {
+				continue;
+			}
+
+			const Edge::Connection &connection = *reverse_connection.connection;
+			const Vector3 new_exit = Geometry3D::get_closest_point_to_segment(least_cost_poly.entry, connection.pathway_start, connection.pathway_end);
+			real_t new_traveled_distance = least_cost_poly.entry.distance_to(new_exit) * poly_travel_cost + least_cost_poly.traveled_distance;
+			if (connection_owner->get_self() != least_cost_owner->get_self()) {
+				new_traveled_distance += least_cost_owner->get_enter_cost();
+			}
+
+			NavigationPoly &neighbor_poly = flow_field[reverse_connection.polygon->id];
+			if (new_traveled_distance < neighbor_poly.traveled_distance) {
+				neighbor_poly.back_navigation_poly_id = least_cost_id;
+				neighbor_poly.back_navigation_edge = connection.edge;
+				neighbor_poly.back_navigation_edge_pathway_start = connection.pathway_start;
+				neighbor_poly.back_navigation_edge_pathway_end = connection.pathway_end;
+				neighbor_poly.traveled_distance = new_traveled_distance;
+				neighbor_poly.entry = new_exit;
+
+				if (neighbor_poly.traversable_poly_index != traversable_polys.INVALID_INDEX) {
+					traversable_polys.shift(neighbor_poly.traversable_poly_index);
+				} else {
+					neighbor_poly.poly = reverse_connection.polygon;
+					traversable_polys.push(&neighbor_poly);
+				}
+			}
+		}
+
+		if (traversable_polys.is_empty()) {
+			break;
+		}
+		least_cost_id = traversable_polys.pop()->poly->id;
+
+		// Stop once the start polygons of all queries are reached, without them the whole map is covered.
+		if (r_begin_polygon_ids) {
+			r_begin_polygon_ids->erase(least_cost_id);
+			if (r_begin_polygon_ids->is_empty()) {
+				break;
+			}
+		}
+	}
+}
+
+bool NavMeshQueries3D::_query_task_build_path_corridor_from_flow_field(NavMeshPathQueryTask3D &p_query_task) {
+	const LocalVector<NavigationPoly> &flow_field = p_query_task.path_query_slot->flow_field;
+	const Polygon *begin_poly = p_query_task.begin_polygon;
+	const Polygon *end_poly = p_query_task.end_polygon;
+	const Vector3 begin_point = p_query_task.begin_position;
+
+	if (flow_field[begin_poly->id].poly == nullptr) {
+		// The destination can't be reached from here.
+		return false;
+	}
+
+	LocalVector<NavigationPoly> &navigation_polys = p_query_task.path_query_slot->path_corridor;
+
+	NavigationPoly &begin_navigation_poly = navigation_polys[begin_poly->id];
+	begin_navigation_poly.poly = begin_poly;
+	begin_navigation_poly.entry = begin_point;
+	begin_navigation_poly.back_navigation_poly_id = -1;
+	begin_navigation_poly.back_navigation_edge = -1;
+	begin_navigation_poly.back_navigation_edge_pathway_start = begin_point;
+	begin_navigation_poly.back_navigation_edge_pathway_end = begin_point;
+
+	// Follow the flow field to the destination and link the corridor backwards like the A* search does.
+	uint32_t poly_id = begin_poly->id;
+	while (poly_id != end_poly->id) {
+		const NavigationPoly &flow_field_poly = flow_field[poly_id];
+		const uint32_t next_poly_id = flow_field_poly.back_navigation_poly_id;
+
+		NavigationPoly &next_navigation_poly = navigation_polys[next_poly_id];
+		next_navigation_poly.poly = flow_field[next_poly_id].poly;
+		next_navigation_poly.back_navigation_poly_id = poly_id;
+		next_navigation_poly.back_navigation_edge = flow_field_poly.back_navigation_edge;
+		next_navigation_poly.back_navigation_edge_pathway_start = flow_field_poly.back_navigation_edge_pathway_start;
+		next_navigation_poly.back_navigation_edge_pathway_end = flow_field_poly.back_navigation_edge_pathway_end;
+		next_navigation_poly.entry = Geometry3D::get_closest_point_to_segment(navigation_polys[poly_id].entry, flow_field_poly.back_navigation_edge_pathway_start, flow_field_poly.back_navigation_edge_pathway_end);
+
+		poly_id = next_poly_id;
+	}
+
+	p_query_task.least_cost_id = end_poly->id;
+	return true;
+}
+
 void NavMeshQueries3D::_query_task_simplified_path_points(NavMeshPathQueryTask3D &p_query_task) {
 	if (!p_query_task.simplify_path || p_query_task.path_points.size() <= 2) {
 		return;
@@ -799,77 +1220,7 @@ RID NavMeshQueries3D::map_iteration_get_closest_point_owner(const NavMapIteratio
 }
 
 ClosestPointQueryResult NavMeshQueries3D::map_iteration_get_closest_point_info(const NavMapIteration3D &p_map_iteration, const Vector3 &p_point) {
-	ClosestPointQueryResult result;
-	real_t closest_point_distance_squared = FLT_MAX;
-
-	const LocalVector<NavRegionIteration3D> &regions = p_map_iteration.region_iterations;
-	for (const NavRegionIteration3D &region : regions) {
-		for (const Polygon &polygon : region.get_navmesh_polygons()) {
-			Vector3 plane_normal = (polygon.points[1].pos - polygon.points[0].pos).cross(polygon.points[2].pos - polygon.points[0].pos);
-			Vector3 closest_on_polygon;
-			real_t closest = FLT_MAX;
-			bool inside = true;
-			Vector3 previous = polygon.points[polygon.points.size() - 1].pos;
-			for (uint32_t point_id = 0; point_id < polygon.points.size(); ++point_id) {
-				Vector3 edge = polygon.points[point_id].pos - previous;
-				Vector3 to_point = p_point - previous;
-				Vector3 edge_to_point_pormal = edge.cross(to_point);
-				bool clockwise = edge_to_point_pormal.dot(plane_normal) > 0;
-				// If we are not clockwise, the point will never be inside the polygon and so the closest point will be on an edge.
-				if (!clockwise) {
-					inside = false;
-					real_t point_projected_on_edge = edge.dot(to_point);
-					real_t edge_square = edge.length_squared();
-
-					if (point_projected_on_edge > edge_square) {
-						real_t distance = polygon.points[point_id].pos.distance_squared_to(p_point);
-						if (distance < closest) {
-							closest_on_polygon = polygon.points[point_id].pos;
-							closest = distance;
-						}
-					} else if (point_projected_on_edge < 0.f) {
-						real_t distance = previous.distance_squared_to(p_point);
-						if (distance < closest) {
-							closest_on_polygon = previous;
-							closest = distance;
-						}
-					} else {
-						// If we project on this edge, this will be the closest point.
-						real_t percent = point_projected_on_edge / edge_square;
-						closest_on_polygon = previous + percent * edge;
-						break;
-					}
-				}
-				previous = polygon.points[point_id].pos;
-			}
-
-			if (inside) {
-				Vector3 plane_normalized = plane_normal.normalized();
-				real_t distance = plane_normalized.dot(p_point - polygon.points[0].pos);
-				real_t distance_squared = distance * distance;
-				if (distance_squared < closest_point_distance_squared) {
-					closest_point_distance_squared = distance_squared;
-					result.point = p_point - plane_normalized * distance;
-					result.normal = plane_normal;
-					result.owner = polygon.owner->get_self();
-
-					if (Math::is_zero_approx(distance)) {
-						break;
-					}
-				}
-			} else {
-				real_t distance = closest_on_polygon.distance_squared_to(p_point);
-				if (distance < closest_point_distance_squared) {
-					closest_point_distance_squared = distance;
-					result.point = closest_on_polygon;
-					result.normal = plane_normal;
-					result.owner = polygon.owner->get_self();
-				}
-			}
-		}
-	}
-
-	return result;
+	return polygon_bvh_get_closest_point_info(p_map_iteration.polygon_bvh, p_point);
 }
 
 Vector3 NavMeshQueries3D::map_iteration_get_random_point(const NavMapIteration3D &p_map_iteration, uint32_t p_navigation_layers, bool p_uniformly) {
@@ -1012,72 +1363,25 @@ ClosestPointQueryResult NavMeshQueries3D::polygons_get_closest_point_info(const
 	real_t closest_point_distance_squared = FLT_MAX;
 
 	for (const Polygon &polygon : p_polygons) {
-		Vector3 plane_normal = (polygon.points[1].pos - polygon.points[0].pos).cross(polygon.points[2].pos - polygon.points[0].pos);
-		Vector3 closest_on_polygon;
-		real_t closest = FLT_MAX;
-		bool inside = true;
-		Vector3 previous = polygon.points[polygon.points.size() - 1].pos;
-		for (uint32_t point_id = 0; point_id < polygon.points.size(); ++point_id) {
-			Vector3 edge = polygon.points[point_id].pos - previous;
-			Vector3 to_point = p_point - previous;
-			Vector3 edge_to_point_pormal = edge.cross(to_point);
-			bool clockwise = edge_to_point_pormal.dot(plane_normal) > 0;
-			// If we are not clockwise, the point will never be inside the polygon and so the closest point will be on an edge.
-			if (!clockwise) {
-				inside = false;
-				real_t point_projected_on_edge = edge.dot(to_point);
-				real_t edge_square = edge.length_squared();
-
-				if (point_projected_on_edge > edge_square) {
-					real_t distance = polygon.points[point_id].pos.distance_squared_to(p_point);
-					if (distance < closest) {
-						closest_on_polygon = polygon.points[point_id].pos;
-						closest = distance;
-					}
-				} else if (point_projected_on_edge < 0.f) {
-					real_t distance = previous.distance_squared_to(p_point);
-					if (distance < closest) {
-						closest_on_polygon = previous;
-						closest = distance;
-					}
-				} else {
-					// If we project on this edge, this will be the closest point.
-					real_t percent = point_projected_on_edge / edge_square;
-					closest_on_polygon = previous + percent * edge;
-					break;
-				}
-			}
-			previous = polygon.points[point_id].pos;
-		}
-
-		if (inside) {
-			Vector3 plane_normalized = plane_normal.normalized();
-			real_t distance = plane_normalized.dot(p_point - polygon.points[0].pos);
-			real_t distance_squared = distance * distance;
-			if (distance_squared < closest_point_distance_squared) {
-				closest_point_distance_squared = distance_squared;
-				result.point = p_point - plane_normalized * distance;
-				result.normal = plane_normal;
-				result.owner = polygon.owner->get_self();
-
-				if (Math::is_zero_approx(distance)) {
-					break;
-				}
-			}
-		} else {
-			real_t distance = closest_on_polygon.distance_squared_to(p_point);
-			if (distance < closest_point_distance_squared) {
-				closest_point_distance_squared = distance;
-				result.point = closest_on_polygon;
-				result.normal = plane_normal;
-				result.owner = polygon.owner->get_self();
-			}
+		if (_polygon_get_closest_point_info(polygon, p_point, closest_point_distance_squared, result)) {
+			break;
 		}
 	}
 
 	return result;
 }
 
+ClosestPointQueryResult NavMeshQueries3D::polygon_bvh_get_closest_point_info(const NavPolygonBVH3D &p_polygon_bvh, const Vector3 &p_point) {
+	ClosestPointQueryResult result;
+	real_t closest_point_distance_squared = FLT_MAX;
+
+	p_polygon_bvh.cull_nearest(p_point, closest_point_distance_squared, [&](const Polygon &p_polygon, real_t &r_distance_squared) {
+		return !_polygon_get_closest_point_info(p_polygon, p_point, r_distance_squared, result);
+	});
+
+	return result;
+}
+
 RID NavMeshQueries3D::polygons_get_closest_point_owner(const LocalVector<Polygon> &p_polygons, const Vector3 &p_point) {
 	ClosestPointQueryResult cp = polygons_get_closest_point_info(p_polygons, p_point);
 	return cp.owner;
@@ -1200,3 +1504,68 @@ void NavMeshQueries3D::simplify_path_segment(int p_start_inx, int p_end_inx, con
 		simplify_path_segment(point_max_index, p_end_inx, p_points, p_epsilon, r_simplified_path_indices);
 	}
 }
+
+bool NavMeshQueries3D::_polygon_get_closest_point_info(const Polygon &p_polygon, const Vector3 &p_point, real_t &r_closest_point_distance_squared, ClosestPointQueryResult &r_result) {
+	Vector3 plane_normal = (p_polygon.points[1].pos - p_polygon.points[0].pos).cross(p_polygon.points[2].pos - p_polygon.points[0].pos);
+	Vector3 closest_on_polygon;
+	real_t closest = FLT_MAX;
+	bool inside = true;
+	Vector3 previous = p_polygon.points[p_polygon.points.size() - 1].pos;
+	for (uint32_t point_id = 0; point_id < p_polygon.points.size(); ++point_id) {
+		Vector3 edge = p_polygon.points[point_id].pos - previous;
+		Vector3 to_point = p_point - previous;
+		Vector3 edge_to_point_pormal = edge.cross(to_point);
+		bool clockwise = edge_to_point_pormal.dot(plane_normal) > 0;
+		// If we are not clockwise, the point will never be inside the polygon and so the closest point will be on an edge.
+		if (!clockwise) {
+			inside = false;
+			real_t point_projected_on_edge = edge.dot(to_point);
+			real_t edge_square = edge.length_squared();
+
+			if (point_projected_on_edge > edge_square) {
+				real_t distance = p_polygon.points[point_id].pos.distance_squared_to(p_point);
+				if (distance < closest) {
+					closest_on_polygon = p_polygon.points[point_id].pos;
+					closest = distance;
+				}
+			} else if (point_projected_on_edge < 0.f) {
+				real_t distance = previous.distance_squared_to(p_point);
+				if (distance < closest) {
+					closest_on_polygon = previous;
+					closest = distance;
+				}
+			} else {
+				// If we project on this edge, this will be the closest point.
+				real_t percent = point_projected_on_edge / edge_square;
+				closest_on_polygon = previous + percent * edge;
+				break;
+			}
+		}
+		previous = p_polygon.points[point_id].pos;
+	}
+
+	if (inside) {
+		Vector3 plane_normalized = plane_normal.normalized();
+		real_t distance = plane_normalized.dot(p_point - p_polygon.points[0].pos);
+		real_t distance_squared = distance * distance;
+		if (distance_squared < r_closest_point_distance_squared) {
+			r_closest_point_distance_squared = distance_squared;
+			r_result.point = p_point - plane_normalized * distance;
+			r_result.normal = plane_normal;
+			r_result.owner = p_polygon.owner->get_self();
+
+			// The point is on the polygon, nothing can be closer.
+			return Math::is_zero_approx(distance);
+		}
+	} else {
+		real_t distance = closest_on_polygon.distance_squared_to(p_point);
+		if (distance < r_closest_point_distance_squared) {
+			r_closest_point_distance_squared = distance;
+			r_result.point = closest_on_polygon;
+			r_result.normal = plane_normal;
+			r_result.owner = p_polygon.owner->get_self();
+		}
+	}
+
+	return false;
+}
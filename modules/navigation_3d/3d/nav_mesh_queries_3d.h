@@ -32,6 +32,9 @@
 
 #include "../nav_utils_3d.h"
 
+#include "core/templates/hash_set.h"
+#include "core/templates/safe_refcount.h"
+#include "core/variant/typed_array.h"
 #include "servers/navigation/navigation_path_query_parameters_3d.h"
 #include "servers/navigation/navigation_path_query_result_3d.h"
 #include "servers/navigation/navigation_utilities.h"
@@ -40,6 +43,7 @@ using namespace NavigationUtilities;
 
 class NavMap3D;
 struct NavMapIteration3D;
+class NavPolygonBVH3D;
 
 class NavMeshQueries3D {
 public:
@@ -48,6 +52,14 @@ public:
 		Heap<Nav3D::NavigationPoly *, Nav3D::NavPolyTravelCostGreaterThan, Nav3D::NavPolyHeapIndexer> traversable_polys;
 		bool in_use = false;
 		uint32_t slot_index = 0;
+
+		// Hierarchical pathfinding.
+		LocalVector<Nav3D::NavigationCluster> navigation_clusters;
+		Heap<Nav3D::NavigationCluster *, Nav3D::NavClusterTravelCostGreaterThan, Nav3D::NavClusterHeapIndexer> traversable_clusters;
+		LocalVector<uint8_t> cluster_corridor;
+
+		// Path query batches, the reverse search shared by the queries with the same destination.
+		LocalVector<Nav3D::NavigationPoly> flow_field;
 	};
 
 	struct NavMeshPathQueryTask3D {
@@ -85,6 +97,10 @@ public:
 		NavMap3D *map = nullptr;
 		PathQuerySlot *path_query_slot = nullptr;
 
+		// Hierarchical pathfinding, limits the polygon search to the clusters in `PathQuerySlot::cluster_corridor`.
+		bool use_cluster_corridor = false;
+		const LocalVector<uint32_t> *polygon_clusters = nullptr;
+
 		// Path points.
 		LocalVector<Vector3> path_points;
 		LocalVector<int32_t> path_meta_point_types;
@@ -111,6 +127,36 @@ public:
 		}
 	};
 
+	// The connections leading into each polygon, used to search the map backwards from a destination.
+	struct ReverseConnections {
+		struct Connection {
+			/// Polygon that this connection starts from.
+			const Nav3D::Polygon *polygon = nullptr;
+			const Nav3D::Edge::Connection *connection = nullptr;
+		};
+
+		/// The incoming connections of polygon `id` are in `[offsets[id], offsets[id + 1])`.
+		LocalVector<uint32_t> offsets;
+		LocalVector<Connection> connections;
+	};
+
+	struct PathQueryBatch3D {
+		// Destinations shared by fewer queries are searched per query.
+		static constexpr uint32_t FLOW_FIELD_MIN_QUERIES = 4;
+
+		struct Group {
+			LocalVector<uint32_t> query_task_indices;
+			// All queries of the group share a destination and filters and are answered from a single flow field.
+			bool use_flow_field = false;
+		};
+
+		LocalVector<NavMeshPathQueryTask3D> *query_tasks = nullptr;
+		NavMapIteration3D *map_iteration = nullptr;
+		LocalVector<Group> groups;
+		ReverseConnections reverse_connections;
+		SafeNumeric<uint32_t> next_group_index;
+	};
+
 	static bool emit_callback(const Callable &p_callback);
 
 	static Vector3 polygons_get_random_point(const LocalVector<Nav3D::Polygon> &p_polygons, uint32_t p_navigation_layers, bool p_uniformly);
@@ -121,6 +167,8 @@ public:
 	static Nav3D::ClosestPointQueryResult polygons_get_closest_point_info(const LocalVector<Nav3D::Polygon> &p_polygons, const Vector3 &p_point);
 	static RID polygons_get_closest_point_owner(const LocalVector<Nav3D::Polygon> &p_polygons, const Vector3 &p_point);
 
+	static Nav3D::ClosestPointQueryResult polygon_bvh_get_closest_point_info(const NavPolygonBVH3D &p_polygon_bvh, const Vector3 &p_point);
+
 	static Vector3 map_iteration_get_closest_point_to_segment(const NavMapIteration3D &p_map_iteration, const Vector3 &p_from, const Vector3 &p_to, const bool p_use_collision);
 	static Vector3 map_iteration_get_closest_point(const NavMapIteration3D &p_map_iteration, const Vector3 &p_point);
 	static Vector3 map_iteration_get_closest_point_normal(const NavMapIteration3D &p_map_iteration, const Vector3 &p_point);
@@ -129,10 +177,23 @@ public:
 	static Vector3 map_iteration_get_random_point(const NavMapIteration3D &p_map_iteration, uint32_t p_navigation_layers, bool p_uniformly);
 
 	static void map_query_path(NavMap3D *map, const Ref<NavigationPathQueryParameters3D> &p_query_parameters, Ref<NavigationPathQueryResult3D> p_query_result, const Callable &p_callback);
+	static void map_query_paths_batch(NavMap3D *map, const TypedArray<NavigationPathQueryParameters3D> &p_query_parameters, const TypedArray<NavigationPathQueryResult3D> &p_query_results, const LocalVector<uint32_t> &p_query_indices);
+
+	static void map_iteration_build_reverse_connections(const NavMapIteration3D &p_map_iteration, ReverseConnections &r_reverse_connections);
 
 	static void query_task_map_iteration_get_path(NavMeshPathQueryTask3D &p_query_task, const NavMapIteration3D &p_map_iteration);
+	static void query_task_map_iteration_find_closest_polygon(const NavMeshPathQueryTask3D &p_query_task, const NavMapIteration3D &p_map_iteration, const Vector3 &p_position, const Nav3D::Polygon *&r_polygon, Vector3 &r_closest_point);
+	static void query_task_build_flow_field(const NavMeshPathQueryTask3D &p_query_task, const ReverseConnections &p_reverse_connections, HashSet<uint32_t> *r_begin_polygon_ids);
+	static void query_batch_map_iteration_group_tasks(PathQueryBatch3D &r_query_batch);
+	static void query_batch_process_group(PathQueryBatch3D &r_query_batch, uint32_t p_group_index, PathQuerySlot *p_path_query_slot);
+	static void _query_task_set_parameters(NavMeshPathQueryTask3D &r_query_task, const Ref<NavigationPathQueryParameters3D> &p_query_parameters);
+	static void _query_task_build_path(NavMeshPathQueryTask3D &p_query_task, const NavMapIteration3D &p_map_iteration);
+	static void _query_task_post_process_path(NavMeshPathQueryTask3D &p_query_task);
+	static bool _query_tasks_share_flow_field(const NavMeshPathQueryTask3D &p_query_task_a, const NavMeshPathQueryTask3D &p_query_task_b);
+	static bool _query_task_build_path_corridor_from_flow_field(NavMeshPathQueryTask3D &p_query_task);
 	static void _query_task_push_back_point_with_metadata(NavMeshPathQueryTask3D &p_query_task, const Vector3 &p_point, const Nav3D::Polygon *p_point_polygon);
 	static void _query_task_find_start_end_positions(NavMeshPathQueryTask3D &p_query_task, const NavMapIteration3D &p_map_iteration);
+	static bool _query_task_build_cluster_corridor(NavMeshPathQueryTask3D &p_query_task, const NavMapIteration3D &p_map_iteration);
 	static void _query_task_build_path_corridor(NavMeshPathQueryTask3D &p_query_task);
 	static void _query_task_post_process_corridorfunnel(NavMeshPathQueryTask3D &p_query_task);
 	static void _query_task_post_process_edgecentered(NavMeshPathQueryTask3D &p_query_task);
@@ -140,6 +201,7 @@ public:
 	static void _query_task_clip_path(NavMeshPathQueryTask3D &p_query_task, const Nav3D::NavigationPoly *from_poly, const Vector3 &p_to_point, const Nav3D::NavigationPoly *p_to_poly);
 	static void _query_task_simplified_path_points(NavMeshPathQueryTask3D &p_query_task);
 	static bool _query_task_is_connection_owner_usable(const NavMeshPathQueryTask3D &p_query_task, const NavBaseIteration3D *p_owner);
+	static bool _polygon_get_closest_point_info(const Nav3D::Polygon &p_polygon, const Vector3 &p_point, real_t &r_closest_point_distance_squared, Nav3D::ClosestPointQueryResult &r_result);
 
 	static void simplify_path_segment(int p_start_inx, int p_end_inx, const LocalVector<Vector3> &p_points, real_t p_epsilon, LocalVector<uint32_t> &r_simplified_path_indices);
 	static LocalVector<uint32_t> get_simplified_path_indices(const LocalVector<Vector3> &p_path, real_t p_epsilon);
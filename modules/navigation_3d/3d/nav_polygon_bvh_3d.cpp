@@ -0,0 +1,181 @@
+/**************************************************************************/
+/*  nav_polygon_bvh_3d.cpp                                                */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#include "nav_polygon_bvh_3d.h"
+
+#include "core/templates/sort_array.h"
+
+using namespace Nav3D;
+
+void NavPolygonBVH3D::clear() {
+	nodes.clear();
+	polygons.clear();
+}
+
+void NavPolygonBVH3D::build(const LocalVector<const Polygon *> &p_polygons) {
+	clear();
+
+	LocalVector<BuildItem> items;
+	items.reserve(p_polygons.size());
+	for (const Polygon *polygon : p_polygons) {
+		if (polygon->points.size() < 3) {
+			continue;
+		}
+
+		BuildItem item;
+		item.polygon = polygon;
+		item.bounds.position = polygon->points[0].pos;
+		for (uint32_t i = 1; i < polygon->points.size(); i++) {
+			item.bounds.expand_to(polygon->points[i].pos);
+		}
+		item.center = item.bounds.get_center();
+		items.push_back(item);
+	}
+
+	if (items.is_empty()) {
+		return;
+	}
+
+	nodes.reserve(2 * (items.size() / MAX_LEAF_POLYGONS + 1));
+	polygons.reserve(items.size());
+	nodes.resize(1);
+	_build_node(items, 0, items.size(), 0);
+}
+
+void NavPolygonBVH3D::_build_node(LocalVector<BuildItem> &r_items, uint32_t p_from, uint32_t p_to, uint32_t p_node) {
+	AABB bounds = r_items[p_from].bounds;
+	AABB center_bounds(r_items[p_from].center, Vector3());
+	for (uint32_t i = p_from + 1; i < p_to; i++) {
+		bounds.merge_with(r_items[i].bounds);
+		center_bounds.expand_to(r_items[i].center);
+	}
+	nodes[p_node].bounds = bounds;
+
+	if (p_to - p_from <= MAX_LEAF_POLYGONS) {
+		nodes[p_node].first = polygons.size();
+		nodes[p_node].count = p_to - p_from;
+		for (uint32_t i = p_from; i < p_to; i++) {
+			polygons.push_back(r_items[i].polygon);
+		}
+		return;
+	}
+
+	// Split at the median along the longest axis of the polygon centers.
+	uint32_t middle = (p_from + p_to) / 2;
+	SortArray<BuildItem, BuildItemAxisCompare> sorter;
+	sorter.compare.axis = center_bounds.get_longest_axis_index();
+	sorter.nth_element(p_from, p_to, middle, r_items.ptr());
+
+	uint32_t first_child = nodes.size();
+	nodes.resize(first_child + 2);
+	nodes[p_node].first = first_child;
+	nodes[p_node].count = 0;
+
+	_build_node(r_items, p_from, middle, first_child);
+	_build_node(r_items, middle, p_to, first_child + 1);
+}
+
+void NavPolygonBVH3D::build_from_trees(const LocalVector<const NavPolygonBVH3D *> &p_trees) {
+	clear();
+
+	LocalVector<TreeBuildItem> items;
+	items.reserve(p_trees.size());
+	uint32_t node_count = 0;
+	uint32_t polygon_count = 0;
+	for (const NavPolygonBVH3D *tree : p_trees) {
+		if (tree->is_empty()) {
+			continue;
+		}
+
+		TreeBuildItem item;
+		item.tree = tree;
+		item.bounds = tree->nodes[0].bounds;
+		item.center = item.bounds.get_center();
+		items.push_back(item);
+
+		node_count += tree->nodes.size();
+		polygon_count += tree->polygons.size();
+	}
+
+	if (items.is_empty()) {
+		return;
+	}
+
+	nodes.reserve(node_count + 2 * items.size());
+	polygons.reserve(polygon_count);
+	nodes.resize(1);
+	_build_tree_node(items, 0, items.size(), 0);
+}
+
+void NavPolygonBVH3D::_build_tree_node(LocalVector<TreeBuildItem> &r_items, uint32_t p_from, uint32_t p_to, uint32_t p_node) {
+	if (p_to - p_from == 1) {
+		_append_tree(*r_items[p_from].tree, p_node);
+		return;
+	}
+
+	AABB bounds = r_items[p_from].bounds;
+	AABB center_bounds(r_items[p_from].center, Vector3());
+	for (uint32_t i = p_from + 1; i < p_to; i++) {
+		bounds.merge_with(r_items[i].bounds);
+		center_bounds.expand_to(r_items[i].center);
+	}
+	nodes[p_node].bounds = bounds;
+
+	// Split at the median along the longest axis of the tree centers.
+	uint32_t middle = (p_from + p_to) / 2;
+	SortArray<TreeBuildItem, BuildItemAxisCompare> sorter;
+	sorter.compare.axis = center_bounds.get_longest_axis_index();
+	sorter.nth_element(p_from, p_to, middle, r_items.ptr());
+
+	uint32_t first_child = nodes.size();
+	nodes.resize(first_child + 2);
+	nodes[p_node].first = first_child;
+	nodes[p_node].count = 0;
+
+	_build_tree_node(r_items, p_from, middle, first_child);
+	_build_tree_node(r_items, middle, p_to, first_child + 1);
+}
+
+void NavPolygonBVH3D::_append_tree(const NavPolygonBVH3D &p_tree, uint32_t p_node) {
+	// The root of the tree takes the place of p_node, its other nodes are appended.
+	const uint32_t node_offset = nodes.size() - 1;
+	const uint32_t polygon_offset = polygons.size();
+
+	nodes.resize(node_offset + p_tree.nodes.size());
+	for (uint32_t i = 0; i < p_tree.nodes.size(); i++) {
+		Node node = p_tree.nodes[i];
+		node.first += node.count > 0 ? polygon_offset : node_offset;
+		nodes[i == 0 ? p_node : node_offset + i] = node;
+	}
+
+	for (const Polygon *polygon : p_tree.polygons) {
+		polygons.push_back(polygon);
+	}
+}
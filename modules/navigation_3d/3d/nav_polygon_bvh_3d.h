@@ -0,0 +1,132 @@
+/**************************************************************************/
+/*  nav_polygon_bvh_3d.h                                                  */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#pragma once
+
+#include "../nav_utils_3d.h"
+
+#include "core/math/aabb.h"
+#include "core/templates/local_vector.h"
+
+// Static bounding volume hierarchy over navigation mesh polygons.
+// Built once per map iteration (or region update) and then only read, so queries can run from any thread.
+class NavPolygonBVH3D {
+	struct Node {
+		AABB bounds;
+		// Branches store the index of their first child (the second follows it), leaves the index of their first polygon.
+		uint32_t first = 0;
+		// Number of polygons in a leaf, 0 for branches.
+		uint32_t count = 0;
+	};
+
+	struct BuildItem {
+		AABB bounds;
+		Vector3 center;
+		const Nav3D::Polygon *polygon = nullptr;
+	};
+
+	struct TreeBuildItem {
+		AABB bounds;
+		Vector3 center;
+		const NavPolygonBVH3D *tree = nullptr;
+	};
+
+	struct BuildItemAxisCompare {
+		int axis = 0;
+		template <typename T>
+		bool operator()(const T &p_a, const T &p_b) const {
+			return p_a.center[axis] < p_b.center[axis];
+		}
+	};
+
+	static constexpr uint32_t MAX_LEAF_POLYGONS = 4;
+	// Median splits keep the tree balanced, so this is far deeper than any tree will get.
+	static constexpr uint32_t MAX_DEPTH = 64;
+
+	LocalVector<Node> nodes;
+	LocalVector<const Nav3D::Polygon *> polygons;
+
+	void _build_node(LocalVector<BuildItem> &r_items, uint32_t p_from, uint32_t p_to, uint32_t p_node);
+	void _build_tree_node(LocalVector<TreeBuildItem> &r_items, uint32_t p_from, uint32_t p_to, uint32_t p_node);
+	void _append_tree(const NavPolygonBVH3D &p_tree, uint32_t p_node);
+
+	_FORCE_INLINE_ static real_t _get_distance_squared(const AABB &p_bounds, const Vector3 &p_point) {
+		return p_point.clamp(p_bounds.position, p_bounds.position + p_bounds.size).distance_squared_to(p_point);
+	}
+
+public:
+	void clear();
+	void build(const LocalVector<const Nav3D::Polygon *> &p_polygons);
+	// Builds a tree on top of already built trees and copies their nodes in, so their polygons don't need to be split again.
+	void build_from_trees(const LocalVector<const NavPolygonBVH3D *> &p_trees);
+
+	bool is_empty() const { return nodes.is_empty(); }
+
+	// Calls `p_callback(polygon, r_distance_squared)` for the polygons whose bounds are closer to `p_point` than
+	// `r_distance_squared`, nearest first. The callback lowers `r_distance_squared` when it finds a closer point,
+	// which prunes the rest of the search, and returns `false` to stop it.
+	template <typename F>
+	void cull_nearest(const Vector3 &p_point, real_t &r_distance_squared, F &&p_callback) const {
+		if (nodes.is_empty()) {
+			return;
+		}
+
+		uint32_t stack[MAX_DEPTH];
+		uint32_t stack_size = 0;
+		stack[stack_size++] = 0;
+
+		while (stack_size > 0) {
+			const Node &node = nodes[stack[--stack_size]];
+			if (_get_distance_squared(node.bounds, p_point) >= r_distance_squared) {
+				continue;
+			}
+
+			if (node.count > 0) {
+				for (uint32_t i = node.first; i < node.first + node.count; i++) {
+					if (!p_callback(*polygons[i], r_distance_squared)) {
+						return;
+					}
+				}
+				continue;
+			}
+
+			// Push the farther child first so the nearer one is visited first.
+			real_t distance_a = _get_distance_squared(nodes[node.first].bounds, p_point);
+			real_t distance_b = _get_distance_squared(nodes[node.first + 1].bounds, p_point);
+			if (distance_a <= distance_b) {
+				stack[stack_size++] = node.first + 1;
+				stack[stack_size++] = node.first;
+			} else {
+				stack[stack_size++] = node.first;
+				stack[stack_size++] = node.first + 1;
+			}
+		}
+	}
+};
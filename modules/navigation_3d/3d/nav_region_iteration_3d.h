@@ -32,14 +32,39 @@
 
 #include "../nav_utils_3d.h"
 #include "nav_base_iteration_3d.h"
+#include "nav_polygon_bvh_3d.h"
 
 #include "core/math/aabb.h"
 
 struct NavRegionIteration3D : NavBaseIteration3D {
+	// Two edges of this region's polygons that share their points.
+	struct InternalEdgeConnection {
+		uint32_t polygon = 0;
+		uint32_t edge = 0;
+		uint32_t other_polygon = 0;
+		uint32_t other_edge = 0;
+	};
+
+	// An edge that no other polygon of this region shares, only these can connect to other regions.
+	struct BoundaryEdge {
+		uint32_t polygon = 0;
+		uint32_t edge = 0;
+		Nav3D::EdgeKey key;
+	};
+
 	Transform3D transform;
 	real_t surface_area = 0.0;
 	AABB bounds;
 
+	// The NavRegion3D polygon update the polygons were copied from. A map iteration keeps the polygons and
+	// the region-local data below from its previous build as long as the region's polygons didn't change.
+	uint64_t polygons_version = 0;
+	bool polygons_reused = false;
+
+	LocalVector<InternalEdgeConnection> internal_edge_connections;
+	LocalVector<BoundaryEdge> boundary_edges;
+	NavPolygonBVH3D polygon_bvh;
+
 	const Transform3D &get_transform() const { return transform; }
 	real_t get_surface_area() const { return surface_area; }
 	AABB get_bounds() const { return bounds; }
@@ -30,6 +30,7 @@
 
 #include "nav_agent_3d.h"
 
+#include "nav_flow_field_3d.h"
 #include "nav_map_3d.h"
 
 void NavAgent3D::set_avoidance_enabled(bool p_enabled) {
@@ -404,6 +405,32 @@ bool NavAgent3D::get_paused() const {
 	return paused;
 }
 
+void NavAgent3D::set_flow_field(NavFlowField3D *p_flow_field) {
+	flow_field = p_flow_field;
+	flow_field_polygon_id = UINT32_MAX;
+}
+
+void NavAgent3D::update_flow_field_velocity(const NavMapIteration3D &p_map_iteration, uint32_t p_map_iteration_id, real_t p_time_step) {
+	if (flow_field == nullptr || flow_field->get_map() != map) {
+		return;
+	}
+
+	const Vector3 direction = flow_field->get_direction(p_map_iteration, p_map_iteration_id, position, &flow_field_polygon_id, height);
+
+	// Slow down on the last stretch instead of overshooting the target.
+	real_t speed = max_speed;
+	if (p_time_step > 0.0) {
+		speed = MIN(speed, position.distance_to(flow_field->get_target_position()) / p_time_step);
+	}
+	const Vector3 preferred_velocity = direction * speed;
+
+	if (use_3d_avoidance) {
+		rvo_agent_3d.prefVelocity_ = RVO3D::Vector3(preferred_velocity.x, preferred_velocity.y, preferred_velocity.z);
+	} else {
+		rvo_agent_2d.prefVelocity_ = RVO2D::Vector2(preferred_velocity.x, preferred_velocity.z);
+	}
+}
+
 void NavAgent3D::request_sync() {
 	if (map && !sync_dirty_request_list_element.in_list()) {
 		map->add_agent_sync_dirty_request(&sync_dirty_request_list_element);
@@ -38,7 +38,9 @@
 #include <Agent2d.h>
 #include <Agent3d.h>
 
+class NavFlowField3D;
 class NavMap3D;
+struct NavMapIteration3D;
 
 class NavAgent3D : public NavRid3D {
 	Vector3 position;
@@ -68,6 +70,10 @@ class NavAgent3D : public NavRid3D {
 
 	Callable avoidance_callback;
 
+	// Replaces the velocity as the avoidance preferred velocity.
+	NavFlowField3D *flow_field = nullptr;
+	uint32_t flow_field_polygon_id = UINT32_MAX;
+
 	bool agent_dirty = true;
 
 	uint32_t last_map_iteration_id = 0;
@@ -143,6 +149,12 @@ public:
 	void set_paused(bool p_paused);
 	bool get_paused() const;
 
+	void set_flow_field(NavFlowField3D *p_flow_field);
+	NavFlowField3D *get_flow_field() const { return flow_field; }
+
+	// Steers the agent along its flow field, called by the map before the avoidance step.
+	void update_flow_field_velocity(const NavMapIteration3D &p_map_iteration, uint32_t p_map_iteration_id, real_t p_time_step);
+
 	bool is_dirty() const;
 	void sync();
 	void request_sync();
@@ -0,0 +1,170 @@
+/**************************************************************************/
+/*  nav_flow_field_3d.cpp                                                 */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#include "nav_flow_field_3d.h"
+
+#include "3d/nav_map_iteration_3d.h"
+#include "nav_map_3d.h"
+
+using namespace Nav3D;
+
+void NavFlowField3D::set_map(NavMap3D *p_map) {
+	if (map == p_map) {
+		return;
+	}
+
+	if (map) {
+		map->remove_flow_field(this);
+	}
+
+	map = p_map;
+	flow_field_dirty = true;
+
+	if (map) {
+		map->add_flow_field(this);
+	}
+}
+
+void NavFlowField3D::set_target_position(const Vector3 &p_target_position) {
+	if (target_position == p_target_position) {
+		return;
+	}
+
+	target_position = p_target_position;
+	target_dirty = true;
+}
+
+void NavFlowField3D::set_navigation_layers(uint32_t p_navigation_layers) {
+	if (navigation_layers == p_navigation_layers) {
+		return;
+	}
+
+	navigation_layers = p_navigation_layers;
+	flow_field_dirty = true;
+}
+
+void NavFlowField3D::update(const NavMapIteration3D &p_map_iteration, uint32_t p_map_iteration_id) {
+	const bool map_changed = map_iteration_id != p_map_iteration_id;
+	if (!map_changed && !target_dirty && !flow_field_dirty) {
+		return;
+	}
+
+	RWLockWrite write_lock(rwlock);
+
+	NavMeshQueries3D::NavMeshPathQueryTask3D query_task;
+	query_task.navigation_layers = navigation_layers;
+	query_task.path_query_slot = &path_query_slot;
+
+	const Polygon *target_polygon = nullptr;
+	NavMeshQueries3D::query_task_map_iteration_find_closest_polygon(query_task, p_map_iteration, target_position, target_polygon, target_point);
+
+	if (map_changed) {
+		NavMeshQueries3D::map_iteration_build_reverse_connections(p_map_iteration, reverse_connections);
+	}
+
+	if (target_polygon == nullptr) {
+		path_query_slot.flow_field.clear();
+		target_polygon_id = UINT32_MAX;
+	} else if (map_changed || flow_field_dirty || target_polygon->id != target_polygon_id) {
+		query_task.end_polygon = target_polygon;
+		query_task.end_position = target_point;
+		NavMeshQueries3D::query_task_build_flow_field(query_task, reverse_connections, nullptr);
+		target_polygon_id = target_polygon->id;
+	}
+	// A target that moves inside its polygon keeps the field, only the direction on the target polygon changes.
+
+	map_iteration_id = p_map_iteration_id;
+	target_dirty = false;
+	flow_field_dirty = false;
+}
+
+Vector3 NavFlowField3D::get_direction(const NavMapIteration3D &p_map_iteration, uint32_t p_map_iteration_id, const Vector3 &p_position, uint32_t *r_polygon_id, real_t p_polygon_max_distance) const {
+	RWLockRead read_lock(rwlock);
+
+	if (map_iteration_id != p_map_iteration_id || target_polygon_id == UINT32_MAX) {
+		return Vector3();
+	}
+
+	const LocalVector<NavigationPoly> &flow_field = path_query_slot.flow_field;
+
+	const Polygon *polygon = nullptr;
+	if (r_polygon_id && *r_polygon_id < flow_field.size()) {
+		const Polygon *last_polygon = flow_field[*r_polygon_id].poly;
+		if (last_polygon && _is_position_on_polygon(*last_polygon, p_position, p_polygon_max_distance)) {
+			polygon = last_polygon;
+		}
+	}
+
+	if (polygon == nullptr) {
+		NavMeshQueries3D::NavMeshPathQueryTask3D query_task;
+		query_task.navigation_layers = navigation_layers;
+
+		Vector3 closest_point;
+		NavMeshQueries3D::query_task_map_iteration_find_closest_polygon(query_task, p_map_iteration, p_position, polygon, closest_point);
+		if (polygon == nullptr || flow_field[polygon->id].poly == nullptr) {
+			// Off the map or cut off from the target.
+			return Vector3();
+		}
+		if (r_polygon_id) {
+			*r_polygon_id = polygon->id;
+		}
+	}
+
+	// Head for the exit towards the target, or for the target itself once on its polygon.
+	const Vector3 next_position = polygon->id == target_polygon_id ? target_point : flow_field[polygon->id].entry;
+	const Vector3 direction = next_position - p_position;
+	if (direction.is_zero_approx()) {
+		return Vector3();
+	}
+	return direction.normalized();
+}
+
+bool NavFlowField3D::_is_position_on_polygon(const Polygon &p_polygon, const Vector3 &p_position, real_t p_max_distance) {
+	if (p_polygon.points.size() < 3) {
+		return false;
+	}
+
+	const Vector3 normal = (p_polygon.points[1].pos - p_polygon.points[0].pos).cross(p_polygon.points[2].pos - p_polygon.points[0].pos);
+	Vector3 previous = p_polygon.points[p_polygon.points.size() - 1].pos;
+	for (const Point &point : p_polygon.points) {
+		if ((point.pos - previous).cross(p_position - previous).dot(normal) <= 0) {
+			return false;
+		}
+		previous = point.pos;
+	}
+
+	return Math::abs(normal.normalized().dot(p_position - p_polygon.points[0].pos)) <= p_max_distance;
+}
+
+NavFlowField3D::~NavFlowField3D() {
+	if (map) {
+		map->remove_flow_field(this);
+	}
+}
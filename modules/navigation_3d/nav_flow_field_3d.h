@@ -0,0 +1,84 @@
+/**************************************************************************/
+/*  nav_flow_field_3d.h                                                   */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#pragma once
+
+#include "3d/nav_mesh_queries_3d.h"
+#include "nav_rid_3d.h"
+
+#include "core/os/rw_lock.h"
+
+class NavMap3D;
+struct NavMapIteration3D;
+
+// Distances to a target over all polygons of a map, shared by any number of agents heading there.
+class NavFlowField3D : public NavRid3D {
+	NavMap3D *map = nullptr;
+	Vector3 target_position;
+	uint32_t navigation_layers = 1;
+
+	// The target moved, the field is updated on the next map sync.
+	bool target_dirty = true;
+	// The field is rebuilt on the next map sync.
+	bool flow_field_dirty = true;
+
+	uint32_t map_iteration_id = 0;
+	uint32_t target_polygon_id = UINT32_MAX;
+	Vector3 target_point;
+
+	// Search buffers, `path_query_slot.flow_field` holds the field itself.
+	NavMeshQueries3D::PathQuerySlot path_query_slot;
+	NavMeshQueries3D::ReverseConnections reverse_connections;
+
+	mutable RWLock rwlock;
+
+public:
+	~NavFlowField3D();
+
+	void set_map(NavMap3D *p_map);
+	NavMap3D *get_map() const { return map; }
+
+	void set_target_position(const Vector3 &p_target_position);
+	const Vector3 &get_target_position() const { return target_position; }
+
+	void set_navigation_layers(uint32_t p_navigation_layers);
+	uint32_t get_navigation_layers() const { return navigation_layers; }
+
+	// Brings the field up to date with the map, called by the map on sync.
+	void update(const NavMapIteration3D &p_map_iteration, uint32_t p_map_iteration_id);
+
+	// Returns the normalized direction to move in from `p_position` to reach the target, or a zero vector if the target can't be reached.
+	// `r_polygon_id` remembers the polygon of `p_position` so the next call skips the polygon lookup while the position stays on it,
+	// up to `p_polygon_max_distance` away from the polygon surface.
+	Vector3 get_direction(const NavMapIteration3D &p_map_iteration, uint32_t p_map_iteration_id, const Vector3 &p_position, uint32_t *r_polygon_id = nullptr, real_t p_polygon_max_distance = 0.0) const;
+
+private:
+	static bool _is_position_on_polygon(const Nav3D::Polygon &p_polygon, const Vector3 &p_position, real_t p_max_distance);
+};
@@ -34,6 +34,7 @@
 #include "3d/nav_mesh_queries_3d.h"
 #include "3d/nav_region_iteration_3d.h"
 #include "nav_agent_3d.h"
+#include "nav_flow_field_3d.h"
 #include "nav_link_3d.h"
 #include "nav_obstacle_3d.h"
 #include "nav_region_3d.h"
@@ -109,6 +110,23 @@ void NavMap3D::set_use_edge_connections(bool p_enabled) {
 	iteration_dirty = true;
 }
 
+void NavMap3D::set_use_hierarchical_pathfinding(bool p_enabled) {
+	if (use_hierarchical_pathfinding == p_enabled) {
+		return;
+	}
+	use_hierarchical_pathfinding = p_enabled;
+	iteration_dirty = true;
+}
+
+void NavMap3D::set_hierarchical_pathfinding_cluster_size(real_t p_cluster_size) {
+	ERR_FAIL_COND_MSG(p_cluster_size <= 0.0, "Hierarchical pathfinding cluster size must be greater than 0.");
+	if (hierarchical_pathfinding_cluster_size == p_cluster_size) {
+		return;
+	}
+	hierarchical_pathfinding_cluster_size = p_cluster_size;
+	iteration_dirty = true;
+}
+
 void NavMap3D::set_edge_connection_margin(real_t p_edge_connection_margin) {
 	if (edge_connection_margin == p_edge_connection_margin) {
 		return;
@@ -142,41 +160,97 @@ PointKey NavMap3D::get_point_key(const Vector3 &p_pos) const {
 	return p;
 }
 
-void NavMap3D::query_path(NavMeshQueries3D::NavMeshPathQueryTask3D &p_query_task) {
-	if (iteration_id == 0) {
-		return;
-	}
+NavMeshQueries3D::PathQuerySlot *NavMap3D::_path_query_slot_acquire(NavMapIteration3D &p_map_iteration) {
+	p_map_iteration.path_query_slots_semaphore.wait();
 
-	GET_MAP_ITERATION();
+	NavMeshQueries3D::PathQuerySlot *path_query_slot = nullptr;
 
-	map_iteration.path_query_slots_semaphore.wait();
-
-	map_iteration.path_query_slots_mutex.lock();
-	for (NavMeshQueries3D::PathQuerySlot &p_path_query_slot : map_iteration.path_query_slots) {
+	p_map_iteration.path_query_slots_mutex.lock();
+	for (NavMeshQueries3D::PathQuerySlot &p_path_query_slot : p_map_iteration.path_query_slots) {
 		if (!p_path_query_slot.in_use) {
 			p_path_query_slot.in_use = true;
-			p_query_task.path_query_slot = &p_path_query_slot;
+			path_query_slot = &p_path_query_slot;
 			break;
 		}
 	}
-	map_iteration.path_query_slots_mutex.unlock();
+	p_map_iteration.path_query_slots_mutex.unlock();
+
+	if (path_query_slot == nullptr) {
+		p_map_iteration.path_query_slots_semaphore.post();
+		ERR_FAIL_NULL_V_MSG(path_query_slot, nullptr, "No unused NavMap3D path query slot found! This should never happen :(.");
+	}
+
+	return path_query_slot;
+}
+
+void NavMap3D::_path_query_slot_release(NavMapIteration3D &p_map_iteration, NavMeshQueries3D::PathQuerySlot *p_path_query_slot) {
+	p_map_iteration.path_query_slots_mutex.lock();
+	uint32_t used_slot_index = p_path_query_slot->slot_index;
+	p_map_iteration.path_query_slots[used_slot_index].in_use = false;
+	p_map_iteration.path_query_slots_mutex.unlock();
+
+	p_map_iteration.path_query_slots_semaphore.post();
+}
+
+void NavMap3D::query_path(NavMeshQueries3D::NavMeshPathQueryTask3D &p_query_task) {
+	if (iteration_id == 0) {
+		return;
+	}
+
+	GET_MAP_ITERATION();
 
+	p_query_task.path_query_slot = _path_query_slot_acquire(map_iteration);
 	if (p_query_task.path_query_slot == nullptr) {
-		map_iteration.path_query_slots_semaphore.post();
-		ERR_FAIL_NULL_MSG(p_query_task.path_query_slot, "No unused NavMap3D path query slot found! This should never happen :(.");
+		return;
 	}
 
 	p_query_task.map_up = map_iteration.map_up;
 
 	NavMeshQueries3D::query_task_map_iteration_get_path(p_query_task, map_iteration);
 
-	map_iteration.path_query_slots_mutex.lock();
-	uint32_t used_slot_index = p_query_task.path_query_slot->slot_index;
-	map_iteration.path_query_slots[used_slot_index].in_use = false;
+	_path_query_slot_release(map_iteration, p_query_task.path_query_slot);
 	p_query_task.path_query_slot = nullptr;
-	map_iteration.path_query_slots_mutex.unlock();
+}
+
+void NavMap3D::query_paths_batch(LocalVector<NavMeshQueries3D::NavMeshPathQueryTask3D> &p_query_tasks) {
+	if (iteration_id == 0 || p_query_tasks.is_empty()) {
+		return;
+	}
+
+	GET_MAP_ITERATION();
 
-	map_iteration.path_query_slots_semaphore.post();
+	for (NavMeshQueries3D::NavMeshPathQueryTask3D &query_task : p_query_tasks) {
+		query_task.map_up = map_iteration.map_up;
+	}
+
+	NavMeshQueries3D::PathQueryBatch3D query_batch;
+	query_batch.query_tasks = &p_query_tasks;
+	query_batch.map_iteration = &map_iteration;
+	NavMeshQueries3D::query_batch_map_iteration_group_tasks(query_batch);
+
+	// Each worker holds on to one path query slot and reuses its search buffers for all the groups it takes.
+	const uint32_t worker_count = MIN(query_batch.groups.size(), map_iteration.path_query_slots.size());
+	if (use_threads && worker_count > 1) {
+		WorkerThreadPool::GroupID group_task = WorkerThreadPool::get_singleton()->add_template_group_task(this, &NavMap3D::_query_paths_batch_worker, &query_batch, worker_count, worker_count, true, SNAME("NavigationPathQueryBatch3D"));
+		WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_task);
+	} else {
+		_query_paths_batch_worker(0, &query_batch);
+	}
+}
+
+void NavMap3D::_query_paths_batch_worker(uint32_t p_index, NavMeshQueries3D::PathQueryBatch3D *p_query_batch) {
+	NavMeshQueries3D::PathQuerySlot *path_query_slot = _path_query_slot_acquire(*p_query_batch->map_iteration);
+	ERR_FAIL_NULL(path_query_slot);
+
+	while (true) {
+		const uint32_t group_index = p_query_batch->next_group_index.postincrement();
+		if (group_index >= p_query_batch->groups.size()) {
+			break;
+		}
+		NavMeshQueries3D::query_batch_process_group(*p_query_batch, group_index, path_query_slot);
+	}
+
+	_path_query_slot_release(*p_query_batch->map_iteration, path_query_slot);
 }
 
 Vector3 NavMap3D::get_closest_point_to_segment(const Vector3 &p_from, const Vector3 &p_to, const bool p_use_collision) const {
@@ -291,6 +365,26 @@ void NavMap3D::remove_obstacle(NavObstacle3D *obstacle) {
 	}
 }
 
+void NavMap3D::add_flow_field(NavFlowField3D *p_flow_field) {
+	if (!flow_fields.has(p_flow_field)) {
+		flow_fields.push_back(p_flow_field);
+	}
+}
+
+void NavMap3D::remove_flow_field(NavFlowField3D *p_flow_field) {
+	flow_fields.erase_unordered(p_flow_field);
+}
+
+Vector3 NavMap3D::get_flow_field_direction(const NavFlowField3D *p_flow_field, const Vector3 &p_position) const {
+	if (iteration_id == 0) {
+		return Vector3();
+	}
+
+	GET_MAP_ITERATION_CONST();
+
+	return p_flow_field->get_direction(map_iteration, iteration_id, p_position);
+}
+
 void NavMap3D::set_agent_as_controlled(NavAgent3D *agent) {
 	remove_agent_as_controlled(agent);
 
@@ -363,15 +457,26 @@ void NavMap3D::_build_iteration() {
 	iteration_build.use_edge_connections = get_use_edge_connections();
 	iteration_build.edge_connection_margin = get_edge_connection_margin();
 	iteration_build.link_connection_radius = get_link_connection_radius();
+	iteration_build.use_hierarchical_pathfinding = get_use_hierarchical_pathfinding();
+	iteration_build.hierarchical_pathfinding_cluster_size = get_hierarchical_pathfinding_cluster_size();
 
 	uint32_t enabled_region_count = 0;
 	uint32_t enabled_link_count = 0;
 
+	// Regions whose polygons didn't change since this slot was last built keep their polygons and region-local
+	// build data, only the regions that changed in between are copied again. Their previous ids are looked up
+	// before the region map is cleared, so it doesn't need to be copied on every build.
+	LocalVector<uint32_t> previous_region_ids;
+	previous_region_ids.reserve(regions.size());
+
 	for (NavRegion3D *region : regions) {
 		if (!region->get_enabled()) {
 			continue;
 		}
 		enabled_region_count++;
+
+		HashMap<NavRegion3D *, uint32_t>::ConstIterator previous_region_id = next_map_iteration.region_ptr_to_region_id.find(region);
+		previous_region_ids.push_back(previous_region_id ? previous_region_id->value : UINT32_MAX);
 	}
 	for (NavLink3D *link : links) {
 		if (!link->get_enabled()) {
@@ -380,6 +485,8 @@ void NavMap3D::_build_iteration() {
 		enabled_link_count++;
 	}
 
+	LocalVector<NavRegionIteration3D> previous_region_iterations = std::move(next_map_iteration.region_iterations);
+
 	next_map_iteration.region_ptr_to_region_id.clear();
 
 	next_map_iteration.region_iterations.clear();
@@ -396,7 +503,21 @@ void NavMap3D::_build_iteration() {
 			continue;
 		}
 		NavRegionIteration3D &region_iteration = next_map_iteration.region_iterations[region_id_count];
+		const uint32_t previous_region_id = previous_region_ids[region_id_count];
 		region_iteration.id = region_id_count++;
+
+		if (previous_region_id != UINT32_MAX) {
+			NavRegionIteration3D &previous_region_iteration = previous_region_iterations[previous_region_id];
+			if (previous_region_iteration.polygons_version == region->get_polygons_version()) {
+				region_iteration.polygons_version = previous_region_iteration.polygons_version;
+				region_iteration.polygons_reused = true;
+				region_iteration.navmesh_polygons = std::move(previous_region_iteration.navmesh_polygons);
+				region_iteration.internal_edge_connections = std::move(previous_region_iteration.internal_edge_connections);
+				region_iteration.boundary_edges = std::move(previous_region_iteration.boundary_edges);
+				region_iteration.polygon_bvh = std::move(previous_region_iteration.polygon_bvh);
+			}
+		}
+
 		region->get_iteration_update(region_iteration);
 		next_map_iteration.region_ptr_to_region_id[region] = (uint32_t)region_iteration.id;
 	}
@@ -478,9 +599,22 @@ void NavMap3D::sync() {
 
 	map_settings_dirty = false;
 
+	_sync_flow_fields();
 	_sync_avoidance();
 }
 
+void NavMap3D::_sync_flow_fields() {
+	if (flow_fields.is_empty() || iteration_id == 0) {
+		return;
+	}
+
+	GET_MAP_ITERATION_CONST();
+
+	for (NavFlowField3D *flow_field : flow_fields) {
+		flow_field->update(map_iteration, iteration_id);
+	}
+}
+
 void NavMap3D::_sync_avoidance() {
 	_sync_dirty_avoidance_update_requests();
 
@@ -577,7 +711,23 @@ void NavMap3D::_update_rvo_agents_tree_2d() {
 	for (NavAgent3D *agent : active_2d_avoidance_agents) {
 		raw_agents.push_back(agent->get_rvo_agent_2d());
 	}
-	rvo_simulation_2d.kdTree_->buildAgentTree(raw_agents);
+
+	const uint32_t subtree_size = _get_rvo_agent_subtree_size(raw_agents.size());
+	if (subtree_size == 0) {
+		rvo_simulation_2d.kdTree_->buildAgentTree(std::move(raw_agents));
+		return;
+	}
+
+	rvo_agent_subtrees_2d.clear();
+	rvo_simulation_2d.kdTree_->buildAgentTreeTop(std::move(raw_agents), subtree_size, rvo_agent_subtrees_2d);
+
+	WorkerThreadPool::GroupID group_task = WorkerThreadPool::get_singleton()->add_template_group_task(this, &NavMap3D::_build_rvo_agent_subtree_2d, rvo_agent_subtrees_2d.data(), rvo_agent_subtrees_2d.size(), -1, true, SNAME("RVOAgentTree2D"));
+	WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_task);
+}
+
+void NavMap3D::_build_rvo_agent_subtree_2d(uint32_t p_index, RVO2D::KdTree2D::AgentSubtree2D *p_subtrees) {
+	const RVO2D::KdTree2D::AgentSubtree2D &subtree = p_subtrees[p_index];
+	rvo_simulation_2d.kdTree_->buildAgentTreeRecursive(subtree.begin, subtree.end, subtree.node);
 }
 
 void NavMap3D::_update_rvo_agents_tree_3d() {
@@ -587,7 +737,36 @@ void NavMap3D::_update_rvo_agents_tree_3d() {
 	for (NavAgent3D *agent : active_3d_avoidance_agents) {
 		raw_agents.push_back(agent->get_rvo_agent_3d());
 	}
-	rvo_simulation_3d.kdTree_->buildAgentTree(raw_agents);
+
+	const uint32_t subtree_size = _get_rvo_agent_subtree_size(raw_agents.size());
+	if (subtree_size == 0) {
+		rvo_simulation_3d.kdTree_->buildAgentTree(std::move(raw_agents));
+		return;
+	}
+
+	rvo_agent_subtrees_3d.clear();
+	rvo_simulation_3d.kdTree_->buildAgentTreeTop(std::move(raw_agents), subtree_size, rvo_agent_subtrees_3d);
+
+	WorkerThreadPool::GroupID group_task = WorkerThreadPool::get_singleton()->add_template_group_task(this, &NavMap3D::_build_rvo_agent_subtree_3d, rvo_agent_subtrees_3d.data(), rvo_agent_subtrees_3d.size(), -1, true, SNAME("RVOAgentTree3D"));
+	WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_task);
+}
+
+void NavMap3D::_build_rvo_agent_subtree_3d(uint32_t p_index, RVO3D::KdTree3D::AgentSubtree3D *p_subtrees) {
+	const RVO3D::KdTree3D::AgentSubtree3D &subtree = p_subtrees[p_index];
+	rvo_simulation_3d.kdTree_->buildAgentTreeRecursive(subtree.begin, subtree.end, subtree.node);
+}
+
+uint32_t NavMap3D::_get_rvo_agent_subtree_size(uint32_t p_agent_count) const {
+	// Below this many agents per subtree dispatching the build costs more than it saves.
+	const uint32_t min_subtree_size = 1024;
+
+	if (!use_threads || !avoidance_use_multiple_threads || p_agent_count < 2 * min_subtree_size) {
+		return 0;
+	}
+
+	// A few subtrees per thread so that uneven kd splits still balance out.
+	const uint32_t subtree_count = WorkerThreadPool::get_singleton()->get_thread_count() * 4;
+	return MAX(min_subtree_size, p_agent_count / subtree_count);
 }
 
 void NavMap3D::_update_rvo_simulation() {
@@ -600,16 +779,30 @@ void NavMap3D::_update_rvo_simulation() {
 	}
 }
 
+void NavMap3D::_update_agent_flow_field_velocity(NavAgent3D *p_agent, real_t p_time_step) const {
+	if (avoidance_step_map_iteration) {
+		p_agent->update_flow_field_velocity(*avoidance_step_map_iteration, iteration_id, p_time_step);
+	}
+}
+
 void NavMap3D::compute_single_avoidance_step_2d(uint32_t index, NavAgent3D **agent) {
+	_update_agent_flow_field_velocity(*(agent + index), rvo_simulation_2d.getTimeStep());
 	(*(agent + index))->get_rvo_agent_2d()->computeNeighbors(&rvo_simulation_2d);
 	(*(agent + index))->get_rvo_agent_2d()->computeNewVelocity(&rvo_simulation_2d);
+}
+
+void NavMap3D::update_single_avoidance_step_2d(uint32_t index, NavAgent3D **agent) {
 	(*(agent + index))->get_rvo_agent_2d()->update(&rvo_simulation_2d);
 	(*(agent + index))->update();
 }
 
 void NavMap3D::compute_single_avoidance_step_3d(uint32_t index, NavAgent3D **agent) {
+	_update_agent_flow_field_velocity(*(agent + index), rvo_simulation_3d.getTimeStep());
 	(*(agent + index))->get_rvo_agent_3d()->computeNeighbors(&rvo_simulation_3d);
 	(*(agent + index))->get_rvo_agent_3d()->computeNewVelocity(&rvo_simulation_3d);
+}
+
+void NavMap3D::update_single_avoidance_step_3d(uint32_t index, NavAgent3D **agent) {
 	(*(agent + index))->get_rvo_agent_3d()->update(&rvo_simulation_3d);
 	(*(agent + index))->update();
 }
@@ -618,14 +811,34 @@ void NavMap3D::step(double p_delta_time) {
 	rvo_simulation_2d.setTimeStep(float(p_delta_time));
 	rvo_simulation_3d.setTimeStep(float(p_delta_time));
 
+	if (flow_fields.is_empty()) {
+		// Only flow field agents read the map iteration, so it isn't acquired without them.
+		_step_avoidance(p_delta_time);
+		return;
+	}
+
+	GET_MAP_ITERATION_CONST();
+	avoidance_step_map_iteration = &map_iteration;
+	_step_avoidance(p_delta_time);
+	avoidance_step_map_iteration = nullptr;
+}
+
+void NavMap3D::_step_avoidance(double p_delta_time) {
 	if (active_2d_avoidance_agents.size() > 0) {
 		if (use_threads && avoidance_use_multiple_threads) {
+			// Agents read the velocity and position of their neighbors, so all new velocities
+			// are computed before any agent is updated.
 			WorkerThreadPool::GroupID group_task = WorkerThreadPool::get_singleton()->add_template_group_task(this, &NavMap3D::compute_single_avoidance_step_2d, active_2d_avoidance_agents.ptr(), active_2d_avoidance_agents.size(), -1, true, SNAME("RVOAvoidanceAgents2D"));
 			WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_task);
+			group_task = WorkerThreadPool::get_singleton()->add_template_group_task(this, &NavMap3D::update_single_avoidance_step_2d, active_2d_avoidance_agents.ptr(), active_2d_avoidance_agents.size(), -1, true, SNAME("RVOAvoidanceAgents2DUpdate"));
+			WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_task);
 		} else {
 			for (NavAgent3D *agent : active_2d_avoidance_agents) {
+				_update_agent_flow_field_velocity(agent, p_delta_time);
 				agent->get_rvo_agent_2d()->computeNeighbors(&rvo_simulation_2d);
 				agent->get_rvo_agent_2d()->computeNewVelocity(&rvo_simulation_2d);
+			}
+			for (NavAgent3D *agent : active_2d_avoidance_agents) {
 				agent->get_rvo_agent_2d()->update(&rvo_simulation_2d);
 				agent->update();
 			}
@@ -634,12 +847,19 @@ void NavMap3D::step(double p_delta_time) {
 
 	if (active_3d_avoidance_agents.size() > 0) {
 		if (use_threads && avoidance_use_multiple_threads) {
+			// Agents read the velocity and position of their neighbors, so all new velocities
+			// are computed before any agent is updated.
 			WorkerThreadPool::GroupID group_task = WorkerThreadPool::get_singleton()->add_template_group_task(this, &NavMap3D::compute_single_avoidance_step_3d, active_3d_avoidance_agents.ptr(), active_3d_avoidance_agents.size(), -1, true, SNAME("RVOAvoidanceAgents3D"));
 			WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_task);
+			group_task = WorkerThreadPool::get_singleton()->add_template_group_task(this, &NavMap3D::update_single_avoidance_step_3d, active_3d_avoidance_agents.ptr(), active_3d_avoidance_agents.size(), -1, true, SNAME("RVOAvoidanceAgents3DUpdate"));
+			WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_task);
 		} else {
 			for (NavAgent3D *agent : active_3d_avoidance_agents) {
+				_update_agent_flow_field_velocity(agent, p_delta_time);
 				agent->get_rvo_agent_3d()->computeNeighbors(&rvo_simulation_3d);
 				agent->get_rvo_agent_3d()->computeNewVelocity(&rvo_simulation_3d);
+			}
+			for (NavAgent3D *agent : active_3d_avoidance_agents) {
 				agent->get_rvo_agent_3d()->update(&rvo_simulation_3d);
 				agent->update();
 			}
@@ -47,6 +47,7 @@
 class NavLink3D;
 class NavRegion3D;
 class NavAgent3D;
+class NavFlowField3D;
 class NavObstacle3D;
 
 class NavMap3D : public NavRid3D {
@@ -71,6 +72,10 @@ class NavMap3D : public NavRid3D {
 	/// This value is used to limit how far links search to find polygons to connect to.
 	real_t link_connection_radius = NavigationDefaults3D::link_connection_radius;
 
+	/// Path queries first search a coarse graph of polygon clusters of this size, then only the polygons along the way.
+	bool use_hierarchical_pathfinding = false;
+	real_t hierarchical_pathfinding_cluster_size = NavigationDefaults3D::hierarchical_pathfinding_cluster_size;
+
 	bool map_settings_dirty = true;
 
 	/// Map regions
@@ -90,12 +95,19 @@ class NavMap3D : public NavRid3D {
 	/// dirty flag when one of the agent's arrays are modified
 	bool agents_dirty = true;
 
+	/// Agent kd-subtrees left to build in parallel after the tree top is built.
+	std::vector<RVO2D::KdTree2D::AgentSubtree2D> rvo_agent_subtrees_2d;
+	std::vector<RVO3D::KdTree3D::AgentSubtree3D> rvo_agent_subtrees_3d;
+
 	/// All the Agents (even the controlled one)
 	LocalVector<NavAgent3D *> agents;
 
 	/// All the avoidance obstacles (both static and dynamic)
 	LocalVector<NavObstacle3D *> obstacles;
 
+	/// All the flow fields computed on this map.
+	LocalVector<NavFlowField3D *> flow_fields;
+
 	/// Are rvo obstacles modified?
 	bool obstacles_dirty = true;
 
@@ -106,6 +118,9 @@ class NavMap3D : public NavRid3D {
 	bool avoidance_use_multiple_threads = true;
 	bool avoidance_use_high_priority_threads = true;
 
+	// The map iteration the flow field agents read during the avoidance step.
+	const NavMapIteration3D *avoidance_step_map_iteration = nullptr;
+
 	// Performance Monitor
 	Nav3D::PerformanceData performance_data;
 
@@ -175,10 +190,21 @@ public:
 		return link_connection_radius;
 	}
 
+	void set_use_hierarchical_pathfinding(bool p_enabled);
+	bool get_use_hierarchical_pathfinding() const {
+		return use_hierarchical_pathfinding;
+	}
+
+	void set_hierarchical_pathfinding_cluster_size(real_t p_cluster_size);
+	real_t get_hierarchical_pathfinding_cluster_size() const {
+		return hierarchical_pathfinding_cluster_size;
+	}
+
 	Nav3D::PointKey get_point_key(const Vector3 &p_pos) const;
 	const Vector3 &get_merge_rasterizer_cell_size() const;
 
 	void query_path(NavMeshQueries3D::NavMeshPathQueryTask3D &p_query_task);
+	void query_paths_batch(LocalVector<NavMeshQueries3D::NavMeshPathQueryTask3D> &p_query_tasks);
 
 	Vector3 get_closest_point_to_segment(const Vector3 &p_from, const Vector3 &p_to, const bool p_use_collision) const;
 	Vector3 get_closest_point(const Vector3 &p_point) const;
@@ -215,6 +241,13 @@ public:
 		return obstacles;
 	}
 
+	void add_flow_field(NavFlowField3D *p_flow_field);
+	void remove_flow_field(NavFlowField3D *p_flow_field);
+	const LocalVector<NavFlowField3D *> &get_flow_fields() const {
+		return flow_fields;
+	}
+	Vector3 get_flow_field_direction(const NavFlowField3D *p_flow_field, const Vector3 &p_position) const;
+
 	Vector3 get_random_point(uint32_t p_navigation_layers, bool p_uniformly) const;
 
 	void sync();
@@ -257,12 +290,24 @@ private:
 
 	void compute_single_avoidance_step_2d(uint32_t index, NavAgent3D **agent);
 	void compute_single_avoidance_step_3d(uint32_t index, NavAgent3D **agent);
+	void update_single_avoidance_step_2d(uint32_t index, NavAgent3D **agent);
+	void update_single_avoidance_step_3d(uint32_t index, NavAgent3D **agent);
+	void _step_avoidance(double p_delta_time);
+	void _update_agent_flow_field_velocity(NavAgent3D *p_agent, real_t p_time_step) const;
 
 	void _sync_avoidance();
+	void _sync_flow_fields();
 	void _update_rvo_simulation();
 	void _update_rvo_obstacles_tree_2d();
 	void _update_rvo_agents_tree_2d();
 	void _update_rvo_agents_tree_3d();
+	uint32_t _get_rvo_agent_subtree_size(uint32_t p_agent_count) const;
+	void _build_rvo_agent_subtree_2d(uint32_t p_index, RVO2D::KdTree2D::AgentSubtree2D *p_subtrees);
+	void _build_rvo_agent_subtree_3d(uint32_t p_index, RVO3D::KdTree3D::AgentSubtree3D *p_subtrees);
 
 	void _update_merge_rasterizer_cell_dimensions();
+
+	NavMeshQueries3D::PathQuerySlot *_path_query_slot_acquire(NavMapIteration3D &p_map_iteration);
+	void _path_query_slot_release(NavMapIteration3D &p_map_iteration, NavMeshQueries3D::PathQuerySlot *p_path_query_slot);
+	void _query_paths_batch_worker(uint32_t p_index, NavMeshQueries3D::PathQueryBatch3D *p_query_batch);
 };
@@ -38,6 +38,8 @@
 
 using namespace Nav3D;
 
+SafeNumeric<uint64_t> NavRegion3D::last_polygons_version;
+
 void NavRegion3D::set_map(NavMap3D *p_map) {
 	if (map == p_map) {
 		return;
@@ -130,7 +132,7 @@ Vector3 NavRegion3D::get_closest_point_to_segment(const Vector3 &p_from, const V
 ClosestPointQueryResult NavRegion3D::get_closest_point_info(const Vector3 &p_point) const {
 	RWLockRead read_lock(region_rwlock);
 
-	return NavMeshQueries3D::polygons_get_closest_point_info(get_polygons(), p_point);
+	return NavMeshQueries3D::polygon_bvh_get_closest_point_info(polygon_bvh, p_point);
 }
 
 Vector3 NavRegion3D::get_random_point(uint32_t p_navigation_layers, bool p_uniformly) const {
@@ -202,9 +204,11 @@ void NavRegion3D::update_polygons() {
 		return;
 	}
 	navmesh_polygons.clear();
+	polygon_bvh.clear();
 	surface_area = 0.0;
 	bounds = AABB();
 	polygons_dirty = false;
+	polygons_version = last_polygons_version.increment();
 
 	if (map == nullptr) {
 		return;
@@ -288,6 +292,13 @@ void NavRegion3D::update_polygons() {
 
 	surface_area = _new_region_surface_area;
 	bounds = _new_bounds;
+
+	LocalVector<const Polygon *> polygons;
+	polygons.reserve(navmesh_polygons.size());
+	for (const Polygon &polygon : navmesh_polygons) {
+		polygons.push_back(&polygon);
+	}
+	polygon_bvh.build(polygons);
 }
 
 void NavRegion3D::get_iteration_update(NavRegionIteration3D &r_iteration) {
@@ -304,6 +315,12 @@ void NavRegion3D::get_iteration_update(NavRegionIteration3D &r_iteration) {
 	r_iteration.bounds = get_bounds();
 	r_iteration.surface_area = get_surface_area();
 
+	if (r_iteration.polygons_version == polygons_version) {
+		// The map kept the polygons of an earlier iteration, see NavMap3D::_build_iteration().
+		return;
+	}
+	r_iteration.polygons_version = polygons_version;
+
 	r_iteration.navmesh_polygons.clear();
 	r_iteration.navmesh_polygons.resize(navmesh_polygons.size());
 	for (uint32_t i = 0; i < navmesh_polygons.size(); i++) {
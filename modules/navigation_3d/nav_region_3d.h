@@ -30,10 +30,12 @@
 
 #pragma once
 
+#include "3d/nav_polygon_bvh_3d.h"
 #include "nav_base_3d.h"
 #include "nav_utils_3d.h"
 
 #include "core/os/rw_lock.h"
+#include "core/templates/safe_refcount.h"
 #include "scene/resources/navigation_mesh.h"
 
 struct NavRegionIteration3D;
@@ -50,7 +52,12 @@ class NavRegion3D : public NavBase3D {
 	bool region_dirty = true;
 	bool polygons_dirty = true;
 
+	// Unique across all regions, so map iterations can tell whether their copy of the polygons is still current.
+	static SafeNumeric<uint64_t> last_polygons_version;
+	uint64_t polygons_version = 0;
+
 	LocalVector<Nav3D::Polygon> navmesh_polygons;
+	NavPolygonBVH3D polygon_bvh;
 
 	real_t surface_area = 0.0;
 	AABB bounds;
@@ -90,6 +97,7 @@ public:
 	LocalVector<Nav3D::Polygon> const &get_polygons() const {
 		return navmesh_polygons;
 	}
+	uint64_t get_polygons_version() const { return polygons_version; }
 
 	Vector3 get_closest_point_to_segment(const Vector3 &p_from, const Vector3 &p_to, bool p_use_collision) const;
 	Nav3D::ClosestPointQueryResult get_closest_point_info(const Vector3 &p_point) const;
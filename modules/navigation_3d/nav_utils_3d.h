@@ -178,6 +178,68 @@ struct NavPolyHeapIndexer {
 	}
 };
 
+/// A group of nearby polygons in the coarse graph used for hierarchical pathfinding.
+struct Cluster {
+	/// A link to a neighbor cluster through the polygon connections (portals) between them.
+	struct Connection {
+		/// Cluster that this connection leads to.
+		uint32_t cluster = UINT32_MAX;
+
+		/// Cheapest travel cost between the two cluster positions through one of the portals.
+		real_t cost = 0.0;
+
+		/// Navigation layers shared by the polygons on both sides of the portals.
+		uint32_t navigation_layers = 0;
+	};
+
+	/// The average center of the polygons in this cluster.
+	Vector3 position;
+
+	/// Connections to the neighbor clusters.
+	LocalVector<Connection> connections;
+};
+
+struct NavigationCluster {
+	/// Id of this cluster in the map.
+	uint32_t id = UINT32_MAX;
+
+	/// Index in the heap of traversable clusters.
+	uint32_t traversable_cluster_index = UINT32_MAX;
+
+	/// The cluster this one was reached from.
+	uint32_t back_navigation_cluster_id = UINT32_MAX;
+
+	/// The cost traveled until now (g cost).
+	real_t traveled_cost = FLT_MAX;
+	/// The estimated cost to the destination (h cost).
+	real_t cost_to_destination = 0.0;
+
+	/// The total travel cost (f cost).
+	real_t total_travel_cost() const {
+		return traveled_cost + cost_to_destination;
+	}
+
+	void reset() {
+		traversable_cluster_index = UINT32_MAX;
+		back_navigation_cluster_id = UINT32_MAX;
+		traveled_cost = FLT_MAX;
+		cost_to_destination = 0.0;
+	}
+};
+
+struct NavClusterTravelCostGreaterThan {
+	// Returns `true` if the travel cost of `a` is higher than that of `b`.
+	bool operator()(const NavigationCluster *p_cluster_a, const NavigationCluster *p_cluster_b) const {
+		return p_cluster_a->total_travel_cost() > p_cluster_b->total_travel_cost();
+	}
+};
+
+struct NavClusterHeapIndexer {
+	void operator()(NavigationCluster *p_cluster, uint32_t p_heap_index) const {
+		p_cluster->traversable_cluster_index = p_heap_index;
+	}
+};
+
 struct ClosestPointQueryResult {
 	Vector3 point;
 	Vector3 normal;
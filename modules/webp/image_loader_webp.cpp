@@ -44,6 +44,12 @@ static Ref<Image> _webp_mem_loader_func(const uint8_t *p_webp_data, int p_size)
 }
 
 Error ImageLoaderWebP::load_image(Ref<Image> p_image, Ref<FileAccess> f, BitField<ImageFormatLoader::LoaderFlags> p_flags, float p_scale) {
+	const Span<uint8_t> mapped = f->get_mapped_span();
+	if (!mapped.is_empty()) {
+		// Decode in place, no need to copy the file.
+		return WebPCommon::webp_load_image_from_buffer(p_image.ptr(), mapped.ptr(), mapped.size());
+	}
+
 	Vector<uint8_t> src_image;
 	uint64_t src_image_len = f->get_length();
 	ERR_FAIL_COND_V(src_image_len == 0, ERR_FILE_CORRUPT);
@@ -38,6 +38,7 @@
 #include "core/object/worker_thread_pool.h"
 #include "core/os/os.h"
 #include "node.h"
+#include "scene/2d/node_2d.h"
 #include "scene/animation/tween.h"
 #include "scene/debugger/scene_debugger.h"
 #include "scene/gui/control.h"
@@ -173,6 +174,9 @@ SceneTree::Group *SceneTree::add_to_group(const StringName &p_group, Node *p_nod
 	ERR_FAIL_COND_V_MSG(E->value.nodes.has(p_node), &E->value, "Already in group: " + p_group + ".");
 	E->value.nodes.push_back(p_node);
 	E->value.changed = true;
+	if (E->value.spatial_index) {
+		_group_spatial_index_insert(E->value.spatial_index, p_node);
+	}
 	return &E->value;
 }
 
@@ -183,7 +187,13 @@ void SceneTree::remove_from_group(const StringName &p_group, Node *p_node) {
 	ERR_FAIL_COND(!E);
 
 	E->value.nodes.erase(p_node);
+	if (E->value.spatial_index) {
+		_group_spatial_index_remove(E->value.spatial_index, p_node);
+	}
 	if (E->value.nodes.is_empty()) {
+		if (E->value.spatial_index) {
+			memdelete(E->value.spatial_index);
+		}
 		group_map.remove(E);
 	}
 }
@@ -344,6 +354,159 @@ void SceneTree::_update_group_order(Group &g) {
 	g.changed = false;
 }
 
+bool SceneTree::_get_group_spatial_position(Node *p_node, Vector3 &r_position) {
+	const Node2D *node_2d = Object::cast_to<Node2D>(p_node);
+	if (node_2d) {
+		const Vector2 position = node_2d->get_global_position();
+		r_position = Vector3(position.x, position.y, 0);
+		return true;
+	}
+#ifndef _3D_DISABLED
+	const Node3D *node_3d = Object::cast_to<Node3D>(p_node);
+	if (node_3d) {
+		r_position = node_3d->get_global_position();
+		return true;
+	}
+#endif // _3D_DISABLED
+	return false;
+}
+
+void SceneTree::_group_spatial_index_insert(GroupSpatialIndex *p_index, Node *p_node) {
+	bool is_3d = Object::cast_to<Node2D>(p_node) == nullptr;
+#ifdef _3D_DISABLED
+	if (is_3d) {
+		return;
+	}
+#else
+	if (is_3d && !Object::cast_to<Node3D>(p_node)) {
+		return;
+	}
+#endif // _3D_DISABLED
+
+	// Nodes are added to their groups before receiving NOTIFICATION_ENTER_TREE,
+	// so the global position is not reliable yet. The leaf is inserted into the
+	// tree on the next refresh instead.
+	GroupSpatialIndex::Leaf leaf;
+	leaf.node = p_node;
+	leaf.is_3d = is_3d;
+	p_index->leaves.insert(p_node, leaf);
+	p_index->last_pass = 0;
+}
+
+void SceneTree::_group_spatial_index_remove(GroupSpatialIndex *p_index, Node *p_node) {
+	HashMap<Node *, GroupSpatialIndex::Leaf>::Iterator E = p_index->leaves.find(p_node);
+	if (!E) {
+		return;
+	}
+
+	if (E->value.id.is_valid()) {
+#ifndef _3D_DISABLED
+		if (E->value.is_3d) {
+			p_index->tree_3d.remove(E->value.id);
+		} else
+#endif // _3D_DISABLED
+		{
+			p_index->tree_2d.remove(E->value.id);
+		}
+	}
+	p_index->leaves.remove(E);
+}
+
+void SceneTree::_update_group_spatial_index(Group &g) {
+	if (!g.spatial_index) {
+		g.spatial_index = memnew(GroupSpatialIndex);
+		for (Node *node : g.nodes) {
+			_group_spatial_index_insert(g.spatial_index, node);
+		}
+	}
+
+	GroupSpatialIndex *index = g.spatial_index;
+	if (index->last_pass == group_spatial_index_pass) {
+		return;
+	}
+
+	for (KeyValue<Node *, GroupSpatialIndex::Leaf> &E : index->leaves) {
+		// A node can't switch between 2D and 3D, so the leaf keeps the tree it was assigned to on insertion.
+		GroupSpatialIndex::Leaf &leaf = E.value;
+		_get_group_spatial_position(leaf.node, leaf.position);
+
+#ifndef _3D_DISABLED
+		DynamicBVH &tree = leaf.is_3d ? index->tree_3d : index->tree_2d;
+#else
+		DynamicBVH &tree = index->tree_2d;
+#endif // _3D_DISABLED
+		const AABB aabb(leaf.position, Vector3());
+		if (leaf.id.is_valid()) {
+			tree.update(leaf.id, aabb);
+		} else {
+			// The leaf stores a pointer to itself, HashMap elements are never relocated.
+			leaf.id = tree.insert(aabb, &leaf);
+		}
+	}
+
+	index->last_pass = group_spatial_index_pass;
+}
+
+TypedArray<Node> SceneTree::_group_spatial_query(const StringName &p_group, bool p_is_3d, const AABB &p_aabb, const Vector3 &p_center, real_t p_radius) {
+	_THREAD_SAFE_METHOD_
+	TypedArray<Node> ret;
+	HashMap<StringName, Group>::Iterator E = group_map.find(p_group);
+	if (!E) {
+		return ret;
+	}
+
+	_update_group_spatial_index(E->value);
+
+	struct QueryResult {
+		LocalVector<const GroupSpatialIndex::Leaf *> leaves;
+		_FORCE_INLINE_ bool operator()(void *p_data) {
+			leaves.push_back((const GroupSpatialIndex::Leaf *)p_data);
+			return false;
+		}
+	} result;
+
+#ifndef _3D_DISABLED
+	DynamicBVH &tree = p_is_3d ? E->value.spatial_index->tree_3d : E->value.spatial_index->tree_2d;
+#else
+	DynamicBVH &tree = E->value.spatial_index->tree_2d;
+#endif // _3D_DISABLED
+	tree.aabb_query(p_aabb, result);
+
+	const real_t radius_squared = p_radius * p_radius;
+	for (const GroupSpatialIndex::Leaf *leaf : result.leaves) {
+		if (p_radius >= 0 && leaf->position.distance_squared_to(p_center) > radius_squared) {
+			continue;
+		}
+		ret.push_back(leaf->node);
+	}
+
+	return ret;
+}
+
+TypedArray<Node> SceneTree::get_nodes_in_group_in_rect(const StringName &p_group, const Rect2 &p_rect) {
+	const AABB aabb(Vector3(p_rect.position.x, p_rect.position.y, 0), Vector3(p_rect.size.x, p_rect.size.y, 0));
+	return _group_spatial_query(p_group, false, aabb.abs(), Vector3(), -1);
+}
+
+TypedArray<Node> SceneTree::get_nodes_in_group_in_circle(const StringName &p_group, const Vector2 &p_center, real_t p_radius) {
+	ERR_FAIL_COND_V_MSG(p_radius < 0, TypedArray<Node>(), "Radius must be non-negative.");
+	const Vector3 center(p_center.x, p_center.y, 0);
+	const AABB aabb(center - Vector3(p_radius, p_radius, 0), Vector3(p_radius, p_radius, 0) * 2);
+	return _group_spatial_query(p_group, false, aabb, center, p_radius);
+}
+
+#ifndef _3D_DISABLED
+TypedArray<Node> SceneTree::get_nodes_in_group_in_aabb(const StringName &p_group, const AABB &p_aabb) {
+	return _group_spatial_query(p_group, true, p_aabb.abs(), Vector3(), -1);
+}
+
+TypedArray<Node> SceneTree::get_nodes_in_group_in_sphere(const StringName &p_group, const Vector3 &p_center, real_t p_radius) {
+	ERR_FAIL_COND_V_MSG(p_radius < 0, TypedArray<Node>(), "Radius must be non-negative.");
+	const AABB aabb(p_center - Vector3(p_radius, p_radius, p_radius), Vector3(p_radius, p_radius, p_radius) * 2);
+	return _group_spatial_query(p_group, true, aabb, p_center, p_radius);
+}
+#endif // _3D_DISABLED
+
 void SceneTree::call_group_flagsp(uint32_t p_call_flags, const StringName &p_group, const StringName &p_function, const Variant **p_args, int p_argcount) {
 	Vector<Node *> nodes_copy;
 
@@ -621,6 +784,7 @@ void SceneTree::iteration_prepare() {
 
 bool SceneTree::physics_process(double p_time) {
 	current_frame++;
+	group_spatial_index_pass++;
 
 	flush_transform_notifications();
 
@@ -669,6 +833,8 @@ void SceneTree::iteration_end() {
 }
 
 bool SceneTree::process(double p_time) {
+	group_spatial_index_pass++;
+
 	if (MainLoop::process(p_time)) {
 		_quit = true;
 	}
@@ -1891,6 +2057,12 @@ void SceneTree::_bind_methods() {
 	ClassDB::bind_method(D_METHOD("get_nodes_in_group", "group"), &SceneTree::_get_nodes_in_group);
 	ClassDB::bind_method(D_METHOD("get_first_node_in_group", "group"), &SceneTree::get_first_node_in_group);
 	ClassDB::bind_method(D_METHOD("get_node_count_in_group", "group"), &SceneTree::get_node_count_in_group);
+	ClassDB::bind_method(D_METHOD("get_nodes_in_group_in_rect", "group", "rect"), &SceneTree::get_nodes_in_group_in_rect);
+	ClassDB::bind_method(D_METHOD("get_nodes_in_group_in_circle", "group", "center", "radius"), &SceneTree::get_nodes_in_group_in_circle);
+#ifndef _3D_DISABLED
+	ClassDB::bind_method(D_METHOD("get_nodes_in_group_in_aabb", "group", "aabb"), &SceneTree::get_nodes_in_group_in_aabb);
+	ClassDB::bind_method(D_METHOD("get_nodes_in_group_in_sphere", "group", "center", "radius"), &SceneTree::get_nodes_in_group_in_sphere);
+#endif // _3D_DISABLED
 
 	ClassDB::bind_method(D_METHOD("set_current_scene", "child_node"), &SceneTree::set_current_scene);
 	ClassDB::bind_method(D_METHOD("get_current_scene"), &SceneTree::get_current_scene);
@@ -1956,7 +2128,7 @@ void SceneTree::get_argument_options(const StringName &p_function, int p_idx, Li
 	const String pf = p_function;
 	bool add_options = false;
 	if (p_idx == 0) {
-		add_options = pf == "get_nodes_in_group" || pf == "has_group" || pf == "get_first_node_in_group" || pf == "set_group" || pf == "notify_group" || pf == "call_group" || pf == "add_to_group";
+		add_options = pf == "get_nodes_in_group" || pf == "get_nodes_in_group_in_rect" || pf == "get_nodes_in_group_in_circle" || pf == "get_nodes_in_group_in_aabb" || pf == "get_nodes_in_group_in_sphere" || pf == "has_group" || pf == "get_first_node_in_group" || pf == "set_group" || pf == "notify_group" || pf == "call_group" || pf == "add_to_group";
 	} else if (p_idx == 1) {
 		add_options = pf == "set_group_flags" || pf == "call_group_flags" || pf == "notify_group_flags";
 	}
@@ -2172,6 +2344,14 @@ SceneTree::~SceneTree() {
 		}
 	}
 
+	// Groups should be empty by now, but make sure no spatial index is leaked.
+	for (KeyValue<StringName, Group> &E : group_map) {
+		if (E.value.spatial_index) {
+			memdelete(E.value.spatial_index);
+			E.value.spatial_index = nullptr;
+		}
+	}
+
 	memdelete(process_group_call_queue_allocator);
 
 	if (singleton == this) {
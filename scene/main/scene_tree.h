@@ -30,6 +30,7 @@
 
 #pragma once
 
+#include "core/math/dynamic_bvh.h"
 #include "core/os/main_loop.h"
 #include "core/os/thread_safe.h"
 #include "core/templates/paged_allocator.h"
@@ -117,8 +118,29 @@ private:
 
 	bool node_threading_disabled = false;
 
+	// Spatial index over the Node2D/Node3D members of a group, used by the
+	// `get_nodes_in_group_in_*()` queries. It is built on the first spatial query
+	// and kept in sync with membership changes; member positions are resampled at
+	// most once per process/physics frame.
+	struct GroupSpatialIndex {
+		struct Leaf {
+			Node *node = nullptr;
+			DynamicBVH::ID id;
+			Vector3 position;
+			bool is_3d = false;
+		};
+
+		DynamicBVH tree_2d;
+#ifndef _3D_DISABLED
+		DynamicBVH tree_3d;
+#endif
+		HashMap<Node *, Leaf> leaves;
+		uint64_t last_pass = 0;
+	};
+
 	struct Group {
 		Vector<Node *> nodes;
+		GroupSpatialIndex *spatial_index = nullptr;
 		bool changed = false;
 	};
 
@@ -145,6 +167,7 @@ private:
 	bool suspended = false;
 
 	HashMap<StringName, Group> group_map;
+	uint64_t group_spatial_index_pass = 1;
 	bool _quit = false;
 
 	bool _physics_interpolation_enabled = false;
@@ -189,6 +212,12 @@ private:
 
 	_FORCE_INLINE_ void _update_group_order(Group &g);
 
+	static bool _get_group_spatial_position(Node *p_node, Vector3 &r_position);
+	void _group_spatial_index_insert(GroupSpatialIndex *p_index, Node *p_node);
+	void _group_spatial_index_remove(GroupSpatialIndex *p_index, Node *p_node);
+	void _update_group_spatial_index(Group &g);
+	TypedArray<Node> _group_spatial_query(const StringName &p_group, bool p_is_3d, const AABB &p_aabb, const Vector3 &p_center, real_t p_radius);
+
 	TypedArray<Node> _get_nodes_in_group(const StringName &p_group);
 
 	Node *current_scene = nullptr;
@@ -407,6 +436,13 @@ public:
 	bool has_group(const StringName &p_identifier) const;
 	int get_node_count_in_group(const StringName &p_group) const;
 
+	TypedArray<Node> get_nodes_in_group_in_rect(const StringName &p_group, const Rect2 &p_rect);
+	TypedArray<Node> get_nodes_in_group_in_circle(const StringName &p_group, const Vector2 &p_center, real_t p_radius);
+#ifndef _3D_DISABLED
+	TypedArray<Node> get_nodes_in_group_in_aabb(const StringName &p_group, const AABB &p_aabb);
+	TypedArray<Node> get_nodes_in_group_in_sphere(const StringName &p_group, const Vector3 &p_center, real_t p_radius);
+#endif // _3D_DISABLED
+
 	//void change_scene(const String& p_path);
 	//Node *get_loaded_scene();
 
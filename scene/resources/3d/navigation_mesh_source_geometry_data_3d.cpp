@@ -30,6 +30,8 @@
 
 #include "navigation_mesh_source_geometry_data_3d.h"
 
+#include "core/object/worker_thread_pool.h"
+
 void NavigationMeshSourceGeometryData3D::set_vertices(const Vector<float> &p_vertices) {
 	RWLockWrite write_lock(geometry_rwlock);
 	vertices = p_vertices;
@@ -77,6 +79,8 @@ void NavigationMeshSourceGeometryData3D::clear() {
 	RWLockWrite write_lock(geometry_rwlock);
 	vertices.clear();
 	indices.clear();
+	pending_geometry.clear();
+	deferred_mesh_surfaces.clear();
 	_projected_obstructions.clear();
 	bounds_dirty = true;
 }
@@ -87,17 +91,8 @@ void NavigationMeshSourceGeometryData3D::clear_projected_obstructions() {
 	bounds_dirty = true;
 }
 
-void NavigationMeshSourceGeometryData3D::_add_vertex(const Vector3 &p_vec3) {
-	vertices.push_back(p_vec3.x);
-	vertices.push_back(p_vec3.y);
-	vertices.push_back(p_vec3.z);
-}
-
-void NavigationMeshSourceGeometryData3D::_add_mesh(const Ref<Mesh> &p_mesh, const Transform3D &p_xform) {
-	int current_vertex_count;
+void NavigationMeshSourceGeometryData3D::_get_mesh_surfaces(const Ref<Mesh> &p_mesh, LocalVector<MeshSurface> &r_surfaces) {
 	for (int i = 0; i < p_mesh->get_surface_count(); i++) {
-		current_vertex_count = vertices.size() / 3;
-
 		if (p_mesh->surface_get_primitive_type(i) != Mesh::PRIMITIVE_TRIANGLES) {
 			continue;
 		}
@@ -111,43 +106,55 @@ void NavigationMeshSourceGeometryData3D::_add_mesh(const Ref<Mesh> &p_mesh, cons
 
 		ERR_CONTINUE((index_count == 0 || (index_count % 3) != 0));
 
-		int face_count = index_count / 3;
-
 		Array a = p_mesh->surface_get_arrays(i);
 		ERR_CONTINUE(a.is_empty() || (a.size() != Mesh::ARRAY_MAX));
 
-		Vector<Vector3> mesh_vertices = a[Mesh::ARRAY_VERTEX];
-		ERR_CONTINUE(mesh_vertices.is_empty());
-		const Vector3 *vr = mesh_vertices.ptr();
+		MeshSurface surface;
+		surface.vertices = a[Mesh::ARRAY_VERTEX];
+		ERR_CONTINUE(surface.vertices.is_empty());
 
 		if (p_mesh->surface_get_format(i) & Mesh::ARRAY_FORMAT_INDEX) {
-			Vector<int> mesh_indices = a[Mesh::ARRAY_INDEX];
-			ERR_CONTINUE(mesh_indices.is_empty() || (mesh_indices.size() != index_count));
-			const int *ir = mesh_indices.ptr();
+			surface.indices = a[Mesh::ARRAY_INDEX];
+			ERR_CONTINUE(surface.indices.is_empty() || (surface.indices.size() != index_count));
+		} else {
+			ERR_CONTINUE(surface.vertices.size() != index_count);
+		}
 
-			for (int j = 0; j < mesh_vertices.size(); j++) {
-				_add_vertex(p_xform.xform(vr[j]));
-			}
+		r_surfaces.push_back(surface);
+	}
+}
 
-			for (int j = 0; j < face_count; j++) {
-				// CCW
-				indices.push_back(current_vertex_count + (ir[j * 3 + 0]));
-				indices.push_back(current_vertex_count + (ir[j * 3 + 2]));
-				indices.push_back(current_vertex_count + (ir[j * 3 + 1]));
-			}
-		} else {
-			ERR_CONTINUE(mesh_vertices.size() != index_count);
-			face_count = mesh_vertices.size() / 3;
-			for (int j = 0; j < face_count; j++) {
-				_add_vertex(p_xform.xform(vr[j * 3 + 0]));
-				_add_vertex(p_xform.xform(vr[j * 3 + 2]));
-				_add_vertex(p_xform.xform(vr[j * 3 + 1]));
+void NavigationMeshSourceGeometryData3D::_add_geometry(const Vector<Vector3> &p_vertices, const Vector<int> &p_indices, const Transform3D &p_xform, PendingGeometry::Type p_type) {
+	PendingGeometry geometry;
+	geometry.vertices = p_vertices;
+	geometry.indices = p_indices;
+	geometry.xform = p_xform;
+	geometry.type = p_type;
+	pending_geometry.push_back(geometry);
 
-				indices.push_back(current_vertex_count + (j * 3 + 0));
-				indices.push_back(current_vertex_count + (j * 3 + 1));
-				indices.push_back(current_vertex_count + (j * 3 + 2));
-			}
+	if (!deferring_geometry) {
+		_commit_pending_geometry(false);
+	}
+}
+
+void NavigationMeshSourceGeometryData3D::_add_mesh(const Ref<Mesh> &p_mesh, const Transform3D &p_xform) {
+	LocalVector<MeshSurface> mesh_surfaces;
+	const LocalVector<MeshSurface> *surfaces = &mesh_surfaces;
+
+	if (deferring_geometry) {
+		// Meshes are often instanced many times, e.g. by a MultiMesh or a GridMap, fetching their arrays once is enough.
+		HashMap<ObjectID, LocalVector<MeshSurface>>::Iterator deferred_surfaces = deferred_mesh_surfaces.find(p_mesh->get_instance_id());
+		if (!deferred_surfaces) {
+			deferred_surfaces = deferred_mesh_surfaces.insert(p_mesh->get_instance_id(), LocalVector<MeshSurface>());
+			_get_mesh_surfaces(p_mesh, deferred_surfaces->value);
 		}
+		surfaces = &deferred_surfaces->value;
+	} else {
+		_get_mesh_surfaces(p_mesh, mesh_surfaces);
+	}
+
+	for (const MeshSurface &surface : *surfaces) {
+		_add_geometry(surface.vertices, surface.indices, p_xform, surface.indices.is_empty() ? PendingGeometry::TYPE_UNINDEXED_MESH : PendingGeometry::TYPE_INDEXED);
 	}
 }
 
@@ -156,44 +163,125 @@ void NavigationMeshSourceGeometryData3D::_add_mesh_array(const Array &p_mesh_arr
 
 	Vector<Vector3> mesh_vertices = p_mesh_array[Mesh::ARRAY_VERTEX];
 	ERR_FAIL_COND(mesh_vertices.is_empty());
-	const Vector3 *vr = mesh_vertices.ptr();
 
 	Vector<int> mesh_indices = p_mesh_array[Mesh::ARRAY_INDEX];
 	ERR_FAIL_COND(mesh_indices.is_empty());
-	const int *ir = mesh_indices.ptr();
 
-	const int face_count = mesh_indices.size() / 3;
-	const int current_vertex_count = vertices.size() / 3;
+	_add_geometry(mesh_vertices, mesh_indices, p_xform, PendingGeometry::TYPE_INDEXED);
+}
+
+void NavigationMeshSourceGeometryData3D::_add_faces(const PackedVector3Array &p_faces, const Transform3D &p_xform) {
+	ERR_FAIL_COND(p_faces.is_empty());
+	ERR_FAIL_COND(p_faces.size() % 3 != 0);
+
+	_add_geometry(p_faces, Vector<int>(), p_xform, PendingGeometry::TYPE_FACES);
+}
+
+void NavigationMeshSourceGeometryData3D::_commit_pending_geometry(bool p_use_threads) {
+	if (pending_geometry.is_empty()) {
+		return;
+	}
+
+	// Reserve the space of all pending geometry at once, the geometry is then transformed into its own slice.
+	int64_t vertex_count = vertices.size();
+	int64_t index_count = indices.size();
+	for (PendingGeometry &geometry : pending_geometry) {
+		geometry.vertex_offset = vertex_count;
+		geometry.index_offset = index_count;
+		if (geometry.type == PendingGeometry::TYPE_INDEXED) {
+			vertex_count += geometry.vertices.size() * 3;
+			index_count += geometry.indices.size() / 3 * 3;
+		} else {
+			vertex_count += geometry.vertices.size() / 3 * 9;
+			index_count += geometry.vertices.size() / 3 * 3;
+		}
+	}
+
+	vertices.resize(vertex_count);
+	indices.resize(index_count);
 
-	for (int j = 0; j < mesh_vertices.size(); j++) {
-		_add_vertex(p_xform.xform(vr[j]));
+	float *vertices_ptrw = vertices.ptrw();
+	int *indices_ptrw = indices.ptrw();
+	for (PendingGeometry &geometry : pending_geometry) {
+		geometry.vertices_write = vertices_ptrw + geometry.vertex_offset;
+		geometry.indices_write = indices_ptrw + geometry.index_offset;
 	}
 
-	for (int j = 0; j < face_count; j++) {
-		// CCW
-		indices.push_back(current_vertex_count + (ir[j * 3 + 0]));
-		indices.push_back(current_vertex_count + (ir[j * 3 + 2]));
-		indices.push_back(current_vertex_count + (ir[j * 3 + 1]));
+	if (p_use_threads && pending_geometry.size() > 1) {
+		WorkerThreadPool::GroupID group_task = WorkerThreadPool::get_singleton()->add_template_group_task(this, &NavigationMeshSourceGeometryData3D::_commit_pending_geometry_item, pending_geometry.ptr(), pending_geometry.size(), -1, true, SNAME("NavMeshSourceGeometryCommit3D"));
+		WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_task);
+	} else {
+		for (uint32_t i = 0; i < pending_geometry.size(); i++) {
+			_commit_pending_geometry_item(i, pending_geometry.ptr());
+		}
 	}
+
+	pending_geometry.clear();
 }
 
-void NavigationMeshSourceGeometryData3D::_add_faces(const PackedVector3Array &p_faces, const Transform3D &p_xform) {
-	ERR_FAIL_COND(p_faces.is_empty());
-	ERR_FAIL_COND(p_faces.size() % 3 != 0);
-	int face_count = p_faces.size() / 3;
-	int current_vertex_count = vertices.size() / 3;
+void NavigationMeshSourceGeometryData3D::_commit_pending_geometry_item(uint32_t p_index, PendingGeometry *p_pending_geometry) {
+	const PendingGeometry &geometry = p_pending_geometry[p_index];
+
+	const Vector3 *vr = geometry.vertices.ptr();
+	const int base_index = geometry.vertex_offset / 3;
+	float *vw = geometry.vertices_write;
+	int *iw = geometry.indices_write;
+
+	switch (geometry.type) {
+		case PendingGeometry::TYPE_INDEXED: {
+			const int *ir = geometry.indices.ptr();
+			const int face_count = geometry.indices.size() / 3;
+
+			for (int j = 0; j < geometry.vertices.size(); j++) {
+				const Vector3 vertex = geometry.xform.xform(vr[j]);
+				vw[j * 3 + 0] = vertex.x;
+				vw[j * 3 + 1] = vertex.y;
+				vw[j * 3 + 2] = vertex.z;
+			}
 
-	for (int j = 0; j < face_count; j++) {
-		_add_vertex(p_xform.xform(p_faces[j * 3 + 0]));
-		_add_vertex(p_xform.xform(p_faces[j * 3 + 1]));
-		_add_vertex(p_xform.xform(p_faces[j * 3 + 2]));
+			for (int j = 0; j < face_count; j++) {
+				// CCW
+				iw[j * 3 + 0] = base_index + ir[j * 3 + 0];
+				iw[j * 3 + 1] = base_index + ir[j * 3 + 2];
+				iw[j * 3 + 2] = base_index + ir[j * 3 + 1];
+			}
+		} break;
+		case PendingGeometry::TYPE_UNINDEXED_MESH:
+		case PendingGeometry::TYPE_FACES: {
+			// Unindexed mesh surfaces swap the vertices of each face, faces swap the indices instead.
+			static const int mesh_face_order[3] = { 0, 2, 1 };
+			static const int faces_face_order[3] = { 0, 1, 2 };
+			const int *vertex_order = geometry.type == PendingGeometry::TYPE_UNINDEXED_MESH ? mesh_face_order : faces_face_order;
+			const int *index_order = geometry.type == PendingGeometry::TYPE_UNINDEXED_MESH ? faces_face_order : mesh_face_order;
+			const int face_count = geometry.vertices.size() / 3;
+
+			for (int j = 0; j < face_count; j++) {
+				for (int k = 0; k < 3; k++) {
+					const Vector3 vertex = geometry.xform.xform(vr[j * 3 + vertex_order[k]]);
+					vw[j * 9 + k * 3 + 0] = vertex.x;
+					vw[j * 9 + k * 3 + 1] = vertex.y;
+					vw[j * 9 + k * 3 + 2] = vertex.z;
 
-		indices.push_back(current_vertex_count + (j * 3 + 0));
-		indices.push_back(current_vertex_count + (j * 3 + 2));
-		indices.push_back(current_vertex_count + (j * 3 + 1));
+					iw[j * 3 + k] = base_index + j * 3 + index_order[k];
+				}
+			}
+		} break;
 	}
 }
 
+void NavigationMeshSourceGeometryData3D::begin_deferred_geometry() {
+	RWLockWrite write_lock(geometry_rwlock);
+	deferring_geometry = true;
+}
+
+void NavigationMeshSourceGeometryData3D::commit_deferred_geometry(bool p_use_threads) {
+	RWLockWrite write_lock(geometry_rwlock);
+	deferring_geometry = false;
+	deferred_mesh_surfaces.clear();
+	_commit_pending_geometry(p_use_threads);
+	bounds_dirty = true;
+}
+
 void NavigationMeshSourceGeometryData3D::add_mesh(const Ref<Mesh> &p_mesh, const Transform3D &p_xform) {
 	ERR_FAIL_COND(p_mesh.is_null());
 
@@ -205,7 +293,9 @@ void NavigationMeshSourceGeometryData3D::add_mesh(const Ref<Mesh> &p_mesh, const
 	}
 #endif
 
+	RWLockWrite write_lock(geometry_rwlock);
 	_add_mesh(p_mesh, root_node_transform * p_xform);
+	bounds_dirty = true;
 }
 
 void NavigationMeshSourceGeometryData3D::add_mesh_array(const Array &p_mesh_array, const Transform3D &p_xform) {
@@ -31,6 +31,7 @@
 #pragma once
 
 #include "core/os/rw_lock.h"
+#include "core/templates/local_vector.h"
 #include "scene/resources/mesh.h"
 
 class NavigationMeshSourceGeometryData3D : public Resource {
@@ -43,6 +44,33 @@ class NavigationMeshSourceGeometryData3D : public Resource {
 	AABB bounds;
 	bool bounds_dirty = true;
 
+	// Geometry that was added but not yet transformed into the vertices and indices.
+	struct PendingGeometry {
+		enum Type {
+			TYPE_INDEXED,
+			TYPE_UNINDEXED_MESH,
+			TYPE_FACES,
+		};
+
+		Vector<Vector3> vertices;
+		Vector<int> indices;
+		Transform3D xform;
+		Type type = TYPE_INDEXED;
+		int64_t vertex_offset = 0;
+		int64_t index_offset = 0;
+		float *vertices_write = nullptr;
+		int *indices_write = nullptr;
+	};
+
+	struct MeshSurface {
+		Vector<Vector3> vertices;
+		Vector<int> indices;
+	};
+
+	bool deferring_geometry = false;
+	LocalVector<PendingGeometry> pending_geometry;
+	HashMap<ObjectID, LocalVector<MeshSurface>> deferred_mesh_surfaces;
+
 public:
 	struct ProjectedObstruction;
 
@@ -55,10 +83,13 @@ protected:
 	static void _bind_methods();
 
 private:
-	void _add_vertex(const Vector3 &p_vec3);
+	void _get_mesh_surfaces(const Ref<Mesh> &p_mesh, LocalVector<MeshSurface> &r_surfaces);
+	void _add_geometry(const Vector<Vector3> &p_vertices, const Vector<int> &p_indices, const Transform3D &p_xform, PendingGeometry::Type p_type);
 	void _add_mesh(const Ref<Mesh> &p_mesh, const Transform3D &p_xform);
 	void _add_mesh_array(const Array &p_array, const Transform3D &p_xform);
 	void _add_faces(const PackedVector3Array &p_faces, const Transform3D &p_xform);
+	void _commit_pending_geometry(bool p_use_threads);
+	void _commit_pending_geometry_item(uint32_t p_index, PendingGeometry *p_pending_geometry);
 
 public:
 	struct ProjectedObstruction {
@@ -94,6 +125,11 @@ public:
 
 	void merge(const Ref<NavigationMeshSourceGeometryData3D> &p_other_geometry);
 
+	// While deferred, added geometry is only recorded and mesh surfaces are fetched once per mesh.
+	// The geometry is transformed in bulk, optionally on multiple threads, when it is committed.
+	void begin_deferred_geometry();
+	void commit_deferred_geometry(bool p_use_threads);
+
 	void add_projected_obstruction(const Vector<Vector3> &p_vertices, float p_elevation, float p_height, bool p_carve);
 	Vector<ProjectedObstruction> _get_projected_obstructions() const;
 
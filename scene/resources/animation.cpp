@@ -892,6 +892,40 @@ void Animation::reset_state() {
 	clear();
 }
 
+bool Animation::can_evict_payload() const {
+	return !tracks.is_empty();
+}
+
+uint64_t Animation::get_payload_size() const {
+	uint64_t size = 0;
+	for (const Compression::Page &page : compression.pages) {
+		size += page.data.size();
+	}
+	for (int i = 0; i < tracks.size(); i++) {
+		size += uint64_t(track_get_key_count(i)) * sizeof(TKey<Variant>); // Estimate, key sizes vary by track type.
+	}
+	return size;
+}
+
+void Animation::evict_payload() {
+	// Only the tracks are dropped; length, loop mode and markers stay usable.
+	for (int i = 0; i < tracks.size(); i++) {
+		memdelete(tracks[i]);
+	}
+	tracks.clear();
+	compression.enabled = false;
+	compression.bounds.clear();
+	compression.pages.clear();
+	emit_changed();
+}
+
+void Animation::apply_payload(const Variant &p_payload) {
+	Dictionary properties = p_payload;
+	properties = properties.duplicate();
+	properties.erase("markers"); // Never evicted, inserting them again would duplicate them.
+	Resource::apply_payload(properties);
+}
+
 int Animation::add_track(TrackType p_type, int p_at_pos) {
 	if (p_at_pos < 0 || p_at_pos >= tracks.size()) {
 		p_at_pos = tracks.size();
@@ -572,6 +572,11 @@ public:
 
 	static TrackType get_cache_type(TrackType p_type);
 
+	virtual bool can_evict_payload() const override;
+	virtual uint64_t get_payload_size() const override;
+	virtual void evict_payload() override;
+	virtual void apply_payload(const Variant &p_payload) override;
+
 	Animation();
 	~Animation();
 };
@@ -32,9 +32,7 @@
 
 #include "scene/resources/bit_map.h"
 
-Error CompressedTexture2D::_load_data(const String &p_path, int &r_width, int &r_height, Ref<Image> &image, bool &r_request_3d, bool &r_request_normal, bool &r_request_roughness, int &mipmap_limit, int p_size_limit) {
-	alpha_cache.unref();
-
+Error CompressedTexture2D::_load_data(const String &p_path, int &r_width, int &r_height, Ref<Image> &image, bool &r_request_3d, bool &r_request_normal, bool &r_request_roughness, int &mipmap_limit, int p_size_limit, bool *r_streamable) {
 	ERR_FAIL_COND_V(image.is_null(), ERR_INVALID_PARAMETER);
 
 	Ref<FileAccess> f = FileAccess::open(p_path, FileAccess::READ);
@@ -78,6 +76,9 @@ Error CompressedTexture2D::_load_data(const String &p_path, int &r_width, int &r
 	if (!(df & FORMAT_BIT_STREAM)) {
 		p_size_limit = 0;
 	}
+	if (r_streamable) {
+		*r_streamable = df & FORMAT_BIT_STREAM;
+	}
 
 	image = load_image_from_file(f, p_size_limit);
 
@@ -135,7 +136,9 @@ Error CompressedTexture2D::load(const String &p_path) {
 	bool request_roughness;
 	int mipmap_limit;
 
-	Error err = _load_data(p_path, lw, lh, image, request_3d, request_normal, request_roughness, mipmap_limit);
+	alpha_cache.unref();
+
+	Error err = _load_data(p_path, lw, lh, image, request_3d, request_normal, request_roughness, mipmap_limit, 0, &streamable);
 	if (err) {
 		return err;
 	}
@@ -154,6 +157,7 @@ Error CompressedTexture2D::load(const String &p_path) {
 	h = lh;
 	path_to_file = p_path;
 	format = image->get_format();
+	image_data_size = image->get_data_size();
 
 	if (get_path().is_empty()) {
 		//temporarily set path if no path set for resource, helps find errors
@@ -296,6 +300,70 @@ void CompressedTexture2D::reload_from_file() {
 void CompressedTexture2D::_validate_property(PropertyInfo &p_property) const {
 }
 
+void CompressedTexture2D::_replace_image(const Ref<Image> &p_image) {
+	RID new_texture = RS::get_singleton()->texture_2d_create(p_image);
+	RS::get_singleton()->texture_replace(texture, new_texture);
+	if (w || h) {
+		RS::get_singleton()->texture_set_size_override(texture, w, h);
+	}
+
+	format = p_image->get_format();
+	alpha_cache.unref();
+}
+
+bool CompressedTexture2D::can_evict_payload() const {
+	return streamable && texture.is_valid() && !path_to_file.is_empty();
+}
+
+uint64_t CompressedTexture2D::get_payload_size() const {
+	return image_data_size;
+}
+
+void CompressedTexture2D::evict_payload() {
+	int lw, lh;
+	Ref<Image> image;
+	image.instantiate();
+
+	bool request_3d;
+	bool request_normal;
+	bool request_roughness;
+	int mipmap_limit;
+
+	// Only the mipmaps that fit the limit are read, the size reported to users doesn't change.
+	Error err = _load_data(path_to_file, lw, lh, image, request_3d, request_normal, request_roughness, mipmap_limit, RESIDENCY_STUB_SIZE_LIMIT);
+	ERR_FAIL_COND_MSG(err != OK, vformat("Failed to load the stub of texture: '%s'.", path_to_file));
+
+	_replace_image(image);
+	image_data_size = image->get_data_size();
+}
+
+Error CompressedTexture2D::load_payload(Variant &r_payload) const {
+	int lw, lh;
+	Ref<Image> image;
+	image.instantiate();
+
+	bool request_3d;
+	bool request_normal;
+	bool request_roughness;
+	int mipmap_limit;
+
+	Error err = _load_data(path_to_file, lw, lh, image, request_3d, request_normal, request_roughness, mipmap_limit);
+	if (err != OK) {
+		return err;
+	}
+
+	r_payload = image;
+	return OK;
+}
+
+void CompressedTexture2D::apply_payload(const Variant &p_payload) {
+	Ref<Image> image = p_payload;
+	ERR_FAIL_COND(image.is_null() || image->is_empty());
+
+	_replace_image(image);
+	image_data_size = image->get_data_size();
+}
+
 Ref<Image> CompressedTexture2D::load_image_from_file(Ref<FileAccess> f, int p_size_limit) {
 	uint32_t data_format = f->get_32();
 	uint32_t w = f->get_16();
@@ -67,7 +67,13 @@ private:
 	int h = 0;
 	mutable Ref<BitMap> alpha_cache;
 
-	Error _load_data(const String &p_path, int &r_width, int &r_height, Ref<Image> &image, bool &r_request_3d, bool &r_request_normal, bool &r_request_roughness, int &mipmap_limit, int p_size_limit = 0);
+	// Residency: streamed textures can drop to their smallest mipmaps.
+	static constexpr int RESIDENCY_STUB_SIZE_LIMIT = 64;
+	bool streamable = false;
+	uint64_t image_data_size = 0;
+
+	static Error _load_data(const String &p_path, int &r_width, int &r_height, Ref<Image> &image, bool &r_request_3d, bool &r_request_normal, bool &r_request_roughness, int &mipmap_limit, int p_size_limit = 0, bool *r_streamable = nullptr);
+	void _replace_image(const Ref<Image> &p_image);
 	virtual void reload_from_file() override;
 
 	static void _requested_3d(void *p_ud);
@@ -107,6 +113,12 @@ public:
 
 	virtual Ref<Image> get_image() const override;
 
+	virtual bool can_evict_payload() const override;
+	virtual uint64_t get_payload_size() const override;
+	virtual void evict_payload() override;
+	virtual Error load_payload(Variant &r_payload) const override;
+	virtual void apply_payload(const Variant &p_payload) override;
+
 	CompressedTexture2D();
 	~CompressedTexture2D();
 };
@@ -2340,6 +2340,77 @@ void ArrayMesh::reload_from_file() {
 	notify_property_list_changed();
 }
 
+bool ArrayMesh::can_evict_payload() const {
+	return !surfaces.is_empty();
+}
+
+uint64_t ArrayMesh::get_payload_size() const {
+	uint64_t size = 0;
+	for (const Surface &surface : surfaces) {
+		uint32_t offsets[RS::ARRAY_MAX];
+		uint32_t vertex_element_size;
+		uint32_t normal_element_size;
+		uint32_t attrib_element_size;
+		uint32_t skin_element_size;
+		RS::get_singleton()->mesh_surface_make_offsets_from_format(surface.format, surface.array_length, surface.index_array_length, offsets, vertex_element_size, normal_element_size, attrib_element_size, skin_element_size);
+
+		size += uint64_t(vertex_element_size + normal_element_size + attrib_element_size + skin_element_size) * surface.array_length;
+		size += uint64_t(surface.index_array_length) * (surface.array_length <= (1 << 16) ? 2 : 4);
+	}
+	return size;
+}
+
+void ArrayMesh::evict_payload() {
+	// Keep the bounds, so the stub can still be culled and laid out.
+	const AABB bounds = aabb;
+
+	// Keep the materials too. They may have been changed since loading, and the ones stored as
+	// sub-resources of the same file can't always be read back together with the surfaces.
+	evicted_surface_materials.clear();
+	for (const Surface &surface : surfaces) {
+		evicted_surface_materials.push_back(surface.material);
+	}
+
+	if (mesh.is_valid()) {
+		RenderingServer::get_singleton()->mesh_clear(mesh);
+		RenderingServer::get_singleton()->mesh_set_custom_aabb(mesh, custom_aabb != AABB() ? custom_aabb : bounds);
+	}
+	surfaces.clear();
+	clear_blend_shapes();
+	clear_cache();
+
+	aabb = bounds;
+}
+
+void ArrayMesh::apply_payload(const Variant &p_payload) {
+	// Only the surfaces and blend shapes were evicted, the other properties are left as they are.
+	const Dictionary properties = p_payload;
+	Dictionary surface_properties;
+	if (properties.has("_blend_shape_names")) {
+		surface_properties["_blend_shape_names"] = properties["_blend_shape_names"];
+	}
+	if (properties.has("_surfaces")) {
+		surface_properties["_surfaces"] = properties["_surfaces"];
+	}
+	Resource::apply_payload(surface_properties);
+
+	if (evicted_surface_materials.size() == uint32_t(surfaces.size())) {
+		for (uint32_t i = 0; i < evicted_surface_materials.size(); i++) {
+			const Ref<Material> &material = evicted_surface_materials[i];
+			surfaces.write[i].material = material;
+			RenderingServer::get_singleton()->mesh_surface_set_material(mesh, i, material.is_null() ? RID() : material->get_rid());
+		}
+	}
+	evicted_surface_materials.clear();
+
+	if (mesh.is_valid()) {
+		RenderingServer::get_singleton()->mesh_set_custom_aabb(mesh, custom_aabb);
+	}
+
+	// Users of the mesh reapply their per-surface state.
+	emit_changed();
+}
+
 ArrayMesh::ArrayMesh() {
 	//mesh is now created on demand
 	//mesh = RenderingServer::get_singleton()->mesh_create();
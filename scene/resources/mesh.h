@@ -322,6 +322,7 @@ private:
 	BlendShapeMode blend_shape_mode = BLEND_SHAPE_MODE_RELATIVE;
 	Vector<StringName> blend_shapes;
 	AABB custom_aabb;
+	LocalVector<Ref<Material>> evicted_surface_materials; // Reapplied when the evicted surfaces are restored.
 
 	_FORCE_INLINE_ void _create_if_empty() const;
 	void _recompute_aabb();
@@ -392,6 +393,11 @@ public:
 
 	virtual void reload_from_file() override;
 
+	virtual bool can_evict_payload() const override;
+	virtual uint64_t get_payload_size() const override;
+	virtual void evict_payload() override;
+	virtual void apply_payload(const Variant &p_payload) override;
+
 	void set_shadow_mesh(const Ref<ArrayMesh> &p_mesh);
 	Ref<ArrayMesh> get_shadow_mesh() const;
 
@@ -161,6 +161,8 @@ void PhysicsServer2DExtension::_bind_methods() {
 	GDVIRTUAL_BIND(_space_get_contacts, "space");
 	GDVIRTUAL_BIND(_space_get_contact_count, "space");
 
+	GDVIRTUAL_BIND(_space_get_state_hash, "space");
+
 	/* AREA API */
 
 	GDVIRTUAL_BIND(_area_create);
@@ -235,6 +235,8 @@ public:
 	EXBIND1RC(Vector<Vector2>, space_get_contacts, RID)
 	EXBIND1RC(int, space_get_contact_count, RID)
 
+	EXBIND1RC(uint64_t, space_get_state_hash, RID)
+
 	/* AREA API */
 
 	//EXBIND0RID(area);
@@ -167,6 +167,11 @@ void PhysicsServer3DExtension::_bind_methods() {
 	GDVIRTUAL_BIND(_space_get_contacts, "space");
 	GDVIRTUAL_BIND(_space_get_contact_count, "space");
 
+	GDVIRTUAL_BIND(_space_snapshot, "space");
+	GDVIRTUAL_BIND(_space_restore, "space", "snapshot");
+
+	GDVIRTUAL_BIND(_space_get_step_time, "space");
+
 	/* AREA API */
 
 	GDVIRTUAL_BIND(_area_create);
@@ -241,6 +241,11 @@ public:
 	EXBIND1RC(Vector<Vector3>, space_get_contacts, RID)
 	EXBIND1RC(int, space_get_contact_count, RID)
 
+	EXBIND1R(PackedByteArray, space_snapshot, RID)
+	EXBIND2R(bool, space_restore, RID, const PackedByteArray &)
+
+	EXBIND1RC(double, space_get_step_time, RID)
+
 	/* AREA API */
 
 	//EXBIND0RID(area);
@@ -45,6 +45,7 @@ constexpr auto navmesh_cell_size_hint{ "0.001,100,0.001,or_greater" };
 
 constexpr float edge_connection_margin{ 0.25f };
 constexpr float link_connection_radius{ 1.0f };
+constexpr float hierarchical_pathfinding_cluster_size{ 32.0f };
 
 } //namespace NavigationDefaults3D
 
@@ -106,6 +106,14 @@ public:
 	/// Returns the link connection radius of this map.
 	virtual real_t map_get_link_connection_radius(RID p_map) const = 0;
 
+	/// Set if path queries on this map first search a coarse graph of polygon clusters.
+	virtual void map_set_use_hierarchical_pathfinding(RID p_map, bool p_enabled) = 0;
+	virtual bool map_get_use_hierarchical_pathfinding(RID p_map) const = 0;
+
+	/// Set the size of the polygon clusters used for hierarchical pathfinding.
+	virtual void map_set_hierarchical_pathfinding_cluster_size(RID p_map, real_t p_cluster_size) = 0;
+	virtual real_t map_get_hierarchical_pathfinding_cluster_size(RID p_map) const = 0;
+
 	/// Returns the navigation path to reach the destination from the origin.
 	virtual Vector<Vector3> map_get_path(RID p_map, Vector3 p_origin, Vector3 p_destination, bool p_optimize, uint32_t p_navigation_layers = 1) = 0;
 
@@ -308,6 +316,10 @@ public:
 	virtual void agent_set_avoidance_priority(RID p_agent, real_t p_priority) = 0;
 	virtual real_t agent_get_avoidance_priority(RID p_agent) const = 0;
 
+	/// The avoidance preferred velocity of the agent follows the flow field instead of the agent velocity.
+	virtual void agent_set_flow_field(RID p_agent, RID p_flow_field) = 0;
+	virtual RID agent_get_flow_field(RID p_agent) const = 0;
+
 	/// Creates the obstacle.
 	virtual RID obstacle_create() = 0;
 
@@ -336,6 +348,21 @@ public:
 	virtual void obstacle_set_avoidance_layers(RID p_obstacle, uint32_t p_layers) = 0;
 	virtual uint32_t obstacle_get_avoidance_layers(RID p_obstacle) const = 0;
 
+	/// Creates the flow field, the travel directions to a target shared by many agents.
+	virtual RID flow_field_create() = 0;
+
+	virtual void flow_field_set_map(RID p_flow_field, RID p_map) = 0;
+	virtual RID flow_field_get_map(RID p_flow_field) const = 0;
+
+	virtual void flow_field_set_target_position(RID p_flow_field, Vector3 p_position) = 0;
+	virtual Vector3 flow_field_get_target_position(RID p_flow_field) const = 0;
+
+	virtual void flow_field_set_navigation_layers(RID p_flow_field, uint32_t p_navigation_layers) = 0;
+	virtual uint32_t flow_field_get_navigation_layers(RID p_flow_field) const = 0;
+
+	/// Returns the normalized direction to move in at the position to reach the target.
+	virtual Vector3 flow_field_get_direction(RID p_flow_field, const Vector3 &p_position) const = 0;
+
 	/// Destroy the `RID`
 	virtual void free(RID p_object) = 0;
 
@@ -355,6 +382,9 @@ public:
 	/// Returns a customized navigation path using a query parameters object
 	virtual void query_path(const Ref<NavigationPathQueryParameters3D> &p_query_parameters, Ref<NavigationPathQueryResult3D> p_query_result, const Callable &p_callback = Callable()) = 0;
 
+	/// Runs many path queries at once, queries to the same destination share their search.
+	virtual void query_paths_batch(const TypedArray<NavigationPathQueryParameters3D> &p_query_parameters, const TypedArray<NavigationPathQueryResult3D> &p_query_results) = 0;
+
 #ifndef _3D_DISABLED
 	virtual void parse_source_geometry_data(const Ref<NavigationMesh> &p_navigation_mesh, const Ref<NavigationMeshSourceGeometryData3D> &p_source_geometry_data, Node *p_root_node, const Callable &p_callback = Callable()) = 0;
 	virtual void bake_from_source_geometry_data(const Ref<NavigationMesh> &p_navigation_mesh, const Ref<NavigationMeshSourceGeometryData3D> &p_source_geometry_data, const Callable &p_callback = Callable()) = 0;
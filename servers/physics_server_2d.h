@@ -275,6 +275,8 @@ public:
 	virtual Vector<Vector2> space_get_contacts(RID p_space) const = 0;
 	virtual int space_get_contact_count(RID p_space) const = 0;
 
+	virtual uint64_t space_get_state_hash(RID p_space) const = 0;
+
 	//missing space parameters
 
 	/* AREA API */
@@ -158,6 +158,8 @@ public:
 	virtual Vector<Vector2> space_get_contacts(RID p_space) const override { return Vector<Vector2>(); }
 	virtual int space_get_contact_count(RID p_space) const override { return 0; }
 
+	virtual uint64_t space_get_state_hash(RID p_space) const override { return 0; }
+
 	/* AREA API */
 
 	virtual RID area_create() override { return RID(); }
@@ -166,6 +166,11 @@ public:
 	virtual Vector<Vector3> space_get_contacts(RID p_space) const override { return Vector<Vector3>(); }
 	virtual int space_get_contact_count(RID p_space) const override { return 0; }
 
+	virtual PackedByteArray space_snapshot(RID p_space) override { return PackedByteArray(); }
+	virtual bool space_restore(RID p_space, const PackedByteArray &p_snapshot) override { return false; }
+
+	virtual double space_get_step_time(RID p_space) const override { return 0.0; }
+
 	/* AREA API */
 
 	virtual RID area_create() override { return RID(); }
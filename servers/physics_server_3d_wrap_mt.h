@@ -127,6 +127,18 @@ public:
 		return physics_server_3d->space_get_contact_count(p_space);
 	}
 
+	virtual PackedByteArray space_snapshot(RID p_space) override {
+		ERR_FAIL_COND_V(!Thread::is_main_thread(), PackedByteArray());
+		return physics_server_3d->space_snapshot(p_space);
+	}
+
+	virtual bool space_restore(RID p_space, const PackedByteArray &p_snapshot) override {
+		ERR_FAIL_COND_V(!Thread::is_main_thread(), false);
+		return physics_server_3d->space_restore(p_space, p_snapshot);
+	}
+
+	FUNC1RC(double, space_get_step_time, RID);
+
 	/* AREA API */
 
 	//FUNC0RID(area);
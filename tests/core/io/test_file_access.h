@@ -31,6 +31,8 @@
 #pragma once
 
 #include "core/io/file_access.h"
+#include "core/io/file_access_pack.h"
+#include "core/os/os.h"
 #include "tests/test_macros.h"
 #include "tests/test_utils.h"
 
@@ -220,4 +222,44 @@ TEST_CASE("[FileAccess] Get/Store floating point half precision values") {
 	}
 }
 
+TEST_CASE("[FileAccess] Memory-mapped pack reads") {
+	const String file_path = TestUtils::get_data_path("testdata.csv");
+	const Vector<uint8_t> reference = FileAccess::get_file_as_bytes(file_path);
+	REQUIRE(reference.size() > 16);
+
+	uint64_t mapped_size = 0;
+	const uint8_t *mapped = OS::get_singleton()->map_file(file_path, mapped_size);
+	if (!mapped) {
+		MESSAGE("Memory-mapped files are not supported on this platform, skipping.");
+		return;
+	}
+	REQUIRE(mapped_size == (uint64_t)reference.size());
+
+	// Expose a slice of the file as if it were packed, and read it both from the mapping and through a regular file.
+	PackedData::PackedFile pf;
+	pf.pack = file_path;
+	pf.offset = 4;
+	pf.size = reference.size() - 8;
+	pf.encrypted = false;
+
+	Ref<FileAccess> fa_mapped = memnew(FileAccessPack(file_path, pf, mapped + pf.offset));
+	Ref<FileAccess> fa_regular = memnew(FileAccessPack(file_path, pf));
+	CHECK(fa_mapped->get_mapped_span().size() == pf.size);
+	CHECK(fa_regular->get_mapped_span().is_empty());
+
+	CHECK(fa_mapped->get_32() == fa_regular->get_32());
+	CHECK(fa_mapped->get_mapped_span().size() == pf.size - 4);
+	CHECK(fa_mapped->get_mapped_span().ptr()[0] == reference[pf.offset + 4]);
+
+	fa_mapped->seek(1);
+	fa_regular->seek(1);
+	CHECK(fa_mapped->get_buffer(pf.size * 2) == fa_regular->get_buffer(pf.size * 2));
+	CHECK(fa_mapped->eof_reached());
+	CHECK(fa_mapped->get_mapped_span().is_empty());
+
+	fa_mapped.unref();
+	fa_regular.unref();
+	OS::get_singleton()->unmap_file(mapped, mapped_size);
+}
+
 } // namespace TestFileAccess
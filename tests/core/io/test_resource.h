@@ -31,6 +31,7 @@
 #pragma once
 
 #include "core/io/resource.h"
+#include "core/io/resource_format_binary.h"
 #include "core/io/resource_loader.h"
 #include "core/io/resource_saver.h"
 #include "core/os/os.h"
@@ -165,4 +166,54 @@ TEST_CASE("[Resource] Breaking circular references on save") {
 	// Break circular reference to avoid memory leak
 	resource_c->remove_meta("next");
 }
+
+TEST_CASE("[Resource] Loading many sub-resources with sub-threads") {
+	// Large enough for the binary loader to decode sub-resources in parallel.
+	Ref<Resource> resource = memnew(Resource);
+	resource->set_name("Root");
+	PackedByteArray payload;
+	payload.resize(8192);
+	Array children;
+	Ref<Resource> previous;
+	for (int i = 0; i < 64; i++) {
+		payload.fill(i);
+		Ref<Resource> child = memnew(Resource);
+		child->set_name(vformat("Child %d", i));
+		child->set_meta("payload", payload);
+		if (previous.is_valid()) {
+			child->set_meta("previous", previous);
+		}
+		children.push_back(child);
+		previous = child;
+	}
+	resource->set_meta("children", children);
+
+	const String save_path = TestUtils::get_temp_path("resource_sub_threads.res");
+	ResourceSaver::save(resource, save_path);
+
+	Ref<ResourceFormatLoaderBinary> loader;
+	loader.instantiate();
+	Error err = FAILED;
+	const Ref<Resource> loaded = loader->load(save_path, "", &err, true, nullptr, ResourceFormatLoader::CACHE_MODE_IGNORE);
+	REQUIRE(err == OK);
+	REQUIRE(loaded.is_valid());
+	CHECK(loaded->get_name() == "Root");
+
+	const Array loaded_children = loaded->get_meta("children");
+	REQUIRE(loaded_children.size() == 64);
+	for (int i = 0; i < 64; i++) {
+		const Ref<Resource> child = loaded_children[i];
+		REQUIRE(child.is_valid());
+		CHECK(child->get_name() == vformat("Child %d", i));
+		const PackedByteArray loaded_payload = child->get_meta("payload");
+		REQUIRE(loaded_payload.size() == 8192);
+		CHECK(loaded_payload[0] == i);
+		CHECK(loaded_payload[8191] == i);
+		if (i > 0) {
+			CHECK_MESSAGE(
+					Ref<Resource>(child->get_meta("previous")) == Ref<Resource>(loaded_children[i - 1]),
+					"Internal references should resolve to the same loaded sub-resource.");
+		}
+	}
+}
 } // namespace TestResource
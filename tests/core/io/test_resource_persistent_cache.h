@@ -0,0 +1,148 @@
+/**************************************************************************/
+/*  test_resource_persistent_cache.h                                      */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#pragma once
+
+#include "core/config/project_settings.h"
+#include "core/io/dir_access.h"
+#include "core/io/resource_loader.h"
+#include "core/io/resource_persistent_cache.h"
+#include "core/io/resource_saver.h"
+#include "core/os/os.h"
+
+#include "tests/test_macros.h"
+#include "tests/test_utils.h"
+
+namespace TestResourcePersistentCache {
+
+static Ref<Resource> create_heavy_resource(int p_version) {
+	Ref<Resource> resource = memnew(Resource);
+	resource->set_name(vformat("Version %d", p_version));
+	for (int i = 0; i < 64; i++) {
+		PackedVector3Array points;
+		points.resize(256);
+		for (int j = 0; j < points.size(); j++) {
+			points.write[j] = Vector3(i, j, p_version);
+		}
+		Ref<Resource> child = memnew(Resource);
+		child->set_meta("points", points);
+		resource->set_meta(vformat("child_%d", i), child);
+	}
+	return resource;
+}
+
+static int count_cache_entries(const String &p_dir) {
+	int count = 0;
+	for (const String &file : DirAccess::get_files_at(p_dir)) {
+		count += file.ends_with(".res") ? 1 : 0;
+	}
+	return count;
+}
+
+// Enables the cache in a temporary directory and restores the project's settings when done.
+class ScopedPersistentCache {
+	const Variant previous_enabled = GLOBAL_GET("resource_loader/persistent_cache/enabled");
+	const Variant previous_path = GLOBAL_GET("resource_loader/persistent_cache/path");
+
+public:
+	const String cache_dir = TestUtils::get_temp_path("resource_persistent_cache");
+
+	ScopedPersistentCache() {
+		ProjectSettings::get_singleton()->set_setting("resource_loader/persistent_cache/enabled", true);
+		ProjectSettings::get_singleton()->set_setting("resource_loader/persistent_cache/path", cache_dir);
+		ResourcePersistentCache::initialize();
+		ResourcePersistentCache::clear();
+	}
+
+	~ScopedPersistentCache() {
+		ResourcePersistentCache::clear();
+		ProjectSettings::get_singleton()->set_setting("resource_loader/persistent_cache/enabled", previous_enabled);
+		ProjectSettings::get_singleton()->set_setting("resource_loader/persistent_cache/path", previous_path);
+		ResourcePersistentCache::initialize();
+	}
+};
+
+TEST_CASE("[ResourcePersistentCache] Text resources load from the cache on later runs") {
+	ScopedPersistentCache scoped_cache;
+	const String &cache_dir = scoped_cache.cache_dir;
+	REQUIRE(ResourcePersistentCache::is_enabled());
+
+	const String save_path = TestUtils::get_temp_path("persistent_cache.tres");
+	REQUIRE(ResourceSaver::save(create_heavy_resource(1), save_path) == OK);
+
+	// A new process would start with an empty resource cache, which CACHE_MODE_IGNORE mimics.
+	Ref<Resource> cold = ResourceLoader::load(save_path, "", ResourceFormatLoader::CACHE_MODE_IGNORE);
+	REQUIRE(cold.is_valid());
+	// Entries are written in the background.
+	ResourcePersistentCache::flush();
+	CHECK(count_cache_entries(cache_dir) == 1);
+
+	Ref<Resource> warm = ResourceLoader::load(save_path, "", ResourceFormatLoader::CACHE_MODE_IGNORE);
+	REQUIRE(warm.is_valid());
+
+	CHECK(warm->get_name() == "Version 1");
+	const Ref<Resource> warm_child = warm->get_meta("child_63");
+	REQUIRE(warm_child.is_valid());
+	const PackedVector3Array points = warm_child->get_meta("points");
+	REQUIRE(points.size() == 256);
+	CHECK(points[255] == Vector3(63, 255, 1));
+
+	SUBCASE("Modified sources replace their cache entry") {
+		REQUIRE(ResourceSaver::save(create_heavy_resource(2), save_path) == OK);
+		Ref<Resource> modified = ResourceLoader::load(save_path, "", ResourceFormatLoader::CACHE_MODE_IGNORE);
+		REQUIRE(modified.is_valid());
+		CHECK(modified->get_name() == "Version 2");
+		ResourcePersistentCache::flush();
+		CHECK(count_cache_entries(cache_dir) == 1);
+	}
+}
+
+TEST_CASE("[Stress][ResourcePersistentCache] Startup load with and without the cache") {
+	ScopedPersistentCache scoped_cache;
+	REQUIRE(ResourcePersistentCache::is_enabled());
+
+	const String save_path = TestUtils::get_temp_path("persistent_cache_stress.tres");
+	REQUIRE(ResourceSaver::save(create_heavy_resource(1), save_path) == OK);
+
+	uint64_t begin = OS::get_singleton()->get_ticks_usec();
+	Ref<Resource> cold = ResourceLoader::load(save_path, "", ResourceFormatLoader::CACHE_MODE_IGNORE);
+	const uint64_t cold_usec = OS::get_singleton()->get_ticks_usec() - begin;
+	REQUIRE(cold.is_valid());
+	ResourcePersistentCache::flush();
+
+	begin = OS::get_singleton()->get_ticks_usec();
+	Ref<Resource> warm = ResourceLoader::load(save_path, "", ResourceFormatLoader::CACHE_MODE_IGNORE);
+	const uint64_t warm_usec = OS::get_singleton()->get_ticks_usec() - begin;
+	REQUIRE(warm.is_valid());
+
+	MESSAGE(vformat("Startup load: %d usec parsing text, %d usec from the persistent cache.", cold_usec, warm_usec));
+}
+
+} // namespace TestResourcePersistentCache
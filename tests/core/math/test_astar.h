@@ -31,6 +31,8 @@
 #pragma once
 
 #include "core/math/a_star.h"
+#include "core/math/a_star_grid_2d.h"
+#include "core/os/os.h"
 
 #include "tests/test_macros.h"
 
@@ -57,7 +59,7 @@ public:
 	}
 
 	// Disable heuristic completely.
-	real_t _compute_cost(int64_t p_from, int64_t p_to) {
+	real_t _compute_cost(int64_t p_from, int64_t p_to) const override {
 		if (p_from == A && p_to == C) {
 			return 1000;
 		}
@@ -84,6 +86,67 @@ TEST_CASE("[AStar3D] ABCX path") {
 	CHECK(path[3] == ABCX::C);
 }
 
+TEST_CASE("[AStar3D] Changing points between searches") {
+	ABCX abcx;
+	Vector<int64_t> path = abcx.get_id_path(ABCX::A, ABCX::C);
+	REQUIRE(path.size() == 3);
+
+	abcx.set_point_weight_scale(ABCX::B, 20);
+	path = abcx.get_id_path(ABCX::A, ABCX::C);
+	REQUIRE(path.size() == 2);
+	CHECK(path[0] == ABCX::A);
+	CHECK(path[1] == ABCX::C);
+
+	abcx.set_point_disabled(ABCX::C);
+	CHECK(abcx.get_id_path(ABCX::A, ABCX::C).is_empty());
+
+	abcx.set_point_disabled(ABCX::C, false);
+	abcx.disconnect_points(ABCX::A, ABCX::C);
+	path = abcx.get_id_path(ABCX::A, ABCX::C);
+	REQUIRE(path.size() == 3);
+	CHECK(path[1] == ABCX::B);
+}
+
+TEST_CASE("[AStar3D] Batched paths should equal single paths") {
+	constexpr int S = 20;
+	Math::seed(0);
+
+	AStar3D a;
+	for (int y = 0; y < S; y++) {
+		for (int x = 0; x < S; x++) {
+			a.add_point(y * S + x, Vector3(x, y, 0), 1 + Math::rand() % 3);
+			if (x > 0) {
+				a.connect_points(y * S + x, y * S + x - 1);
+			}
+			if (y > 0) {
+				a.connect_points(y * S + x, (y - 1) * S + x);
+			}
+		}
+	}
+	for (int i = 0; i < S * S / 4; i++) {
+		a.set_point_disabled(Math::rand() % (S * S));
+	}
+
+	PackedInt64Array from_ids;
+	PackedInt64Array to_ids;
+	for (int i = 0; i < 64; i++) {
+		from_ids.push_back(Math::rand() % (S * S));
+		to_ids.push_back(Math::rand() % (S * S));
+	}
+
+	for (bool allow_partial_path : { false, true }) {
+		TypedArray<PackedInt64Array> paths = a.get_id_paths_batch(from_ids, to_ids, allow_partial_path);
+		REQUIRE(paths.size() == from_ids.size());
+		for (int i = 0; i < from_ids.size(); i++) {
+			CHECK(PackedInt64Array(paths[i]) == a.get_id_path(from_ids[i], to_ids[i], allow_partial_path));
+		}
+	}
+
+	ERR_PRINT_OFF;
+	CHECK(a.get_id_paths_batch(from_ids, PackedInt64Array()).is_empty());
+	ERR_PRINT_ON;
+}
+
 TEST_CASE("[AStar3D] Add/Remove") {
 	AStar3D a;
 
@@ -356,4 +419,98 @@ TEST_CASE("[Stress][AStar3D] Find paths") {
 		CHECK_MESSAGE(match, "Found all paths.");
 	}
 }
+
+static real_t get_id_path_length(const TypedArray<Vector2i> &p_path) {
+	real_t length = 0;
+	for (int i = 1; i < p_path.size(); i++) {
+		length += Vector2(Vector2i(p_path[i]) - Vector2i(p_path[i - 1])).length();
+	}
+	return length;
+}
+
+static void fill_random_walls(AStarGrid2D &r_grid, int p_count, int p_max_length) {
+	const Rect2i region = r_grid.get_region();
+	for (int i = 0; i < p_count; i++) {
+		const Vector2i position = Vector2i(Math::rand() % region.size.x, Math::rand() % region.size.y);
+		const int length = 1 + Math::rand() % p_max_length;
+		r_grid.fill_solid_region(Rect2i(position, Math::rand() % 2 ? Vector2i(length, 1) : Vector2i(1, length)));
+	}
+}
+
+TEST_CASE("[AStarGrid2D] Jumping should find paths as short as the regular search") {
+	Math::seed(0);
+
+	for (int mode = 0; mode < AStarGrid2D::DIAGONAL_MODE_MAX; mode++) {
+		AStarGrid2D grid;
+		AStarGrid2D jumping_grid;
+		for (AStarGrid2D *g : { &grid, &jumping_grid }) {
+			g->set_region(Rect2i(-8, -8, 48, 48));
+			g->set_diagonal_mode(AStarGrid2D::DiagonalMode(mode));
+			g->set_default_compute_heuristic(mode == AStarGrid2D::DIAGONAL_MODE_NEVER ? AStarGrid2D::HEURISTIC_MANHATTAN : AStarGrid2D::HEURISTIC_OCTILE);
+			g->set_default_estimate_heuristic(g->get_default_compute_heuristic());
+			g->update();
+		}
+		jumping_grid.set_jumping_enabled(true);
+
+		bool match = true;
+		for (int pass = 0; pass < 4 && match; pass++) {
+			// Changing cells between queries also checks that the precomputed jumps get updated.
+			const uint32_t seed = Math::rand();
+			Math::seed(seed);
+			fill_random_walls(grid, 40, 12);
+			Math::seed(seed);
+			fill_random_walls(jumping_grid, 40, 12);
+
+			for (int query = 0; query < 50; query++) {
+				const Vector2i from = Vector2i(-8 + Math::rand() % 48, -8 + Math::rand() % 48);
+				const Vector2i to = Vector2i(-8 + Math::rand() % 48, -8 + Math::rand() % 48);
+				const TypedArray<Vector2i> path = grid.get_id_path(from, to);
+				const TypedArray<Vector2i> jumping_path = jumping_grid.get_id_path(from, to);
+				if (path.is_empty() != jumping_path.is_empty() || !Math::is_equal_approx(get_id_path_length(path), get_id_path_length(jumping_path))) {
+					print_verbose(vformat("Diagonal mode %d, from %s to %s: regular path length %f, jumping path length %f\n", mode, from, to, get_id_path_length(path), get_id_path_length(jumping_path)));
+					match = false;
+					break;
+				}
+			}
+		}
+		CHECK_MESSAGE(match, "Jumping paths are as short as regular paths.");
+	}
+}
+
+TEST_CASE("[Stress][AStarGrid2D] Find paths on a large grid") {
+	constexpr int N = 1024;
+	Math::seed(0);
+
+	AStarGrid2D grid;
+	grid.set_region(Rect2i(0, 0, N, N));
+	grid.set_default_compute_heuristic(AStarGrid2D::HEURISTIC_OCTILE);
+	grid.set_default_estimate_heuristic(AStarGrid2D::HEURISTIC_OCTILE);
+	uint64_t begin = OS::get_singleton()->get_ticks_usec();
+	grid.update();
+	const uint64_t update_usec = OS::get_singleton()->get_ticks_usec() - begin;
+	fill_random_walls(grid, N * N / 2000, 200);
+
+	Vector<Vector2i> query_points;
+	for (int i = 0; i < 20; i++) {
+		const Vector2i point = Vector2i(Math::rand() % N, Math::rand() % N);
+		grid.set_point_solid(point, false);
+		query_points.push_back(point);
+	}
+
+	Vector<real_t> lengths;
+	begin = OS::get_singleton()->get_ticks_usec();
+	for (int i = 0; i < query_points.size(); i += 2) {
+		lengths.push_back(get_id_path_length(grid.get_id_path(query_points[i], query_points[i + 1])));
+	}
+	const uint64_t regular_usec = OS::get_singleton()->get_ticks_usec() - begin;
+
+	grid.set_jumping_enabled(true);
+	begin = OS::get_singleton()->get_ticks_usec();
+	for (int i = 0; i < query_points.size(); i += 2) {
+		CHECK(Math::is_equal_approx(get_id_path_length(grid.get_id_path(query_points[i], query_points[i + 1])), lengths[i / 2]));
+	}
+	const uint64_t jumping_usec = OS::get_singleton()->get_ticks_usec() - begin;
+
+	MESSAGE(vformat("%dx%d grid: update %d usec, 10 paths in %d usec regular, %d usec jumping.", N, N, update_usec, regular_usec, jumping_usec));
+}
 } // namespace TestAStar
@@ -30,9 +30,13 @@
 
 #pragma once
 
+#include "core/io/resource_loader.h"
+#include "core/io/resource_residency.h"
+#include "core/io/resource_saver.h"
 #include "scene/resources/animation.h"
 
 #include "tests/test_macros.h"
+#include "tests/test_utils.h"
 
 namespace TestAnimation {
 
@@ -308,4 +312,65 @@ TEST_CASE("[Animation] Create Bezier track") {
 	ERR_PRINT_ON;
 }
 
+TEST_CASE("[Animation] Evict and restore tracks with ResourceResidency") {
+	Ref<Animation> animation = memnew(Animation);
+	animation->set_length(2.0);
+	const int track = animation->add_track(Animation::TYPE_POSITION_3D);
+	animation->track_set_path(track, NodePath("Node:position"));
+	animation->position_track_insert_key(track, 0.0, Vector3(1, 2, 3));
+	animation->position_track_insert_key(track, 1.5, Vector3(4, 5, 6));
+
+	// Stored as a sub-resource, so it's read back on its own from the binary file.
+	Ref<Resource> container = memnew(Resource);
+	container->set_meta("animation", animation);
+	const String save_path = TestUtils::get_temp_path("animation_residency.res");
+	REQUIRE(ResourceSaver::save(container, save_path) == OK);
+
+	const Ref<Resource> loaded_container = ResourceLoader::load(save_path, "", ResourceFormatLoader::CACHE_MODE_REPLACE);
+	REQUIRE(loaded_container.is_valid());
+	const Ref<Animation> loaded = loaded_container->get_meta("animation");
+	REQUIRE(loaded.is_valid());
+	CHECK(loaded->get_path().contains("::"));
+
+	ResourceResidency *residency = ResourceResidency::get_singleton();
+	REQUIRE(residency->track(loaded));
+	CHECK(residency->get_resident_size() == loaded->get_payload_size());
+
+	CHECK(residency->evict(loaded));
+	CHECK_FALSE(residency->is_resident(loaded));
+	CHECK(loaded->get_track_count() == 0);
+	CHECK_MESSAGE(loaded->get_length() == doctest::Approx(2.0), "The length should be kept while evicted.");
+	CHECK(residency->get_resident_size() == 0);
+
+	CHECK(residency->make_resident(loaded) == OK);
+	CHECK(residency->is_resident(loaded));
+	REQUIRE(loaded->get_track_count() == 1);
+	CHECK(loaded->track_get_path(0) == NodePath("Node:position"));
+	CHECK(loaded->track_get_key_count(0) == 2);
+	CHECK(loaded->position_track_interpolate(0, 1.5) == Vector3(4, 5, 6));
+
+	residency->untrack(loaded);
+	CHECK_FALSE(residency->is_tracked(loaded));
+}
+
+TEST_CASE("[Animation] ResourceResidency should forget freed resources") {
+	Ref<Animation> animation = memnew(Animation);
+	const int track = animation->add_track(Animation::TYPE_POSITION_3D);
+	animation->position_track_insert_key(track, 0.0, Vector3(1, 2, 3));
+	const String save_path = TestUtils::get_temp_path("animation_residency_freed.res");
+	REQUIRE(ResourceSaver::save(animation, save_path) == OK);
+
+	ResourceResidency *residency = ResourceResidency::get_singleton();
+	const uint64_t resident_size = residency->get_resident_size();
+	{
+		const Ref<Animation> loaded = ResourceLoader::load(save_path, "", ResourceFormatLoader::CACHE_MODE_IGNORE);
+		REQUIRE(loaded.is_valid());
+		REQUIRE(residency->track(loaded));
+		CHECK(residency->get_resident_size() == resident_size + loaded->get_payload_size());
+	}
+
+	CHECK(residency->get_resident_size() == resident_size);
+	CHECK_FALSE(residency->get_type_stats().has("Animation"));
+}
+
 } // namespace TestAnimation
@@ -30,10 +30,14 @@
 
 #pragma once
 
+#include "core/io/resource_loader.h"
+#include "core/io/resource_residency.h"
+#include "core/io/resource_saver.h"
 #include "scene/resources/3d/primitive_meshes.h"
 #include "scene/resources/mesh.h"
 
 #include "tests/test_macros.h"
+#include "tests/test_utils.h"
 
 namespace TestArrayMesh {
 
@@ -443,4 +447,70 @@ TEST_CASE("[SceneTree][ArrayMesh] Get/Set mesh metadata and actions") {
 	}
 }
 
+TEST_CASE("[SceneTree][ArrayMesh] Evict and restore an embedded mesh with ResourceResidency") {
+	Ref<ArrayMesh> mesh;
+	mesh.instantiate();
+	Array cylinder_array;
+	cylinder_array.resize(Mesh::ARRAY_MAX);
+	CylinderMesh::create_mesh_array(cylinder_array, 3.f, 3.f, 5.f);
+	mesh->add_surface_from_arrays(Mesh::PRIMITIVE_TRIANGLES, cylinder_array);
+	Ref<StandardMaterial3D> material;
+	material.instantiate();
+	material->set_albedo(Color(1, 0, 0));
+	mesh->surface_set_material(0, material);
+
+	// Both the mesh and its material are built-in resources of the file, like the meshes of an imported scene.
+	Ref<Resource> container;
+	container.instantiate();
+	container->set_meta("mesh", mesh);
+
+	ResourceResidency *residency = ResourceResidency::get_singleton();
+
+	SUBCASE("Built-in meshes of binary files are read back on their own") {
+		const String save_path = TestUtils::get_temp_path("arraymesh_residency.res");
+		REQUIRE(ResourceSaver::save(container, save_path) == OK);
+
+		// Without the cache, the material can't be looked up when the surfaces are read back.
+		const Ref<Resource> loaded_container = ResourceLoader::load(save_path, "", ResourceFormatLoader::CACHE_MODE_IGNORE);
+		REQUIRE(loaded_container.is_valid());
+		const Ref<ArrayMesh> loaded = loaded_container->get_meta("mesh");
+		REQUIRE(loaded.is_valid());
+		CHECK(loaded->get_path().contains("::"));
+		REQUIRE(loaded->get_surface_count() == 1);
+		const Ref<Material> loaded_material = loaded->surface_get_material(0);
+		REQUIRE(loaded_material.is_valid());
+		const int array_length = loaded->surface_get_array_len(0);
+		const AABB aabb = loaded->get_aabb();
+
+		REQUIRE(residency->track(loaded));
+		CHECK(residency->evict(loaded));
+		CHECK(loaded->get_surface_count() == 0);
+		CHECK_MESSAGE(loaded->get_aabb().is_equal_approx(aabb), "The bounds should be kept while evicted.");
+
+		ERR_PRINT_OFF;
+		CHECK(residency->make_resident(loaded) == OK);
+		ERR_PRINT_ON;
+		REQUIRE(loaded->get_surface_count() == 1);
+		CHECK(loaded->surface_get_array_len(0) == array_length);
+		CHECK(loaded->get_aabb().is_equal_approx(aabb));
+		CHECK_MESSAGE(loaded->surface_get_material(0) == loaded_material, "The material should be kept through eviction.");
+
+		residency->untrack(loaded);
+	}
+
+	SUBCASE("Built-in meshes of text files can't be tracked") {
+		const String save_path = TestUtils::get_temp_path("arraymesh_residency.tres");
+		REQUIRE(ResourceSaver::save(container, save_path) == OK);
+
+		const Ref<Resource> loaded_container = ResourceLoader::load(save_path, "", ResourceFormatLoader::CACHE_MODE_IGNORE);
+		REQUIRE(loaded_container.is_valid());
+		const Ref<ArrayMesh> loaded = loaded_container->get_meta("mesh");
+		REQUIRE(loaded.is_valid());
+		CHECK(loaded->get_path().contains("::"));
+
+		CHECK_FALSE(residency->track(loaded));
+		CHECK(loaded->get_surface_count() == 1);
+	}
+}
+
 } // namespace TestArrayMesh
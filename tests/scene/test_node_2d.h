@@ -210,4 +210,51 @@ TEST_CASE("[SceneTree][Node2D] Utility methods") {
 	memdelete(test_node1);
 }
 
+TEST_CASE("[SceneTree][Node2D] Spatial group queries") {
+	Node2D *near_node = memnew(Node2D);
+	Node2D *far_node = memnew(Node2D);
+	near_node->set_position(Point2(10, 10));
+	far_node->set_position(Point2(200, 0));
+	near_node->add_to_group("spatial");
+	far_node->add_to_group("spatial");
+	SceneTree::get_singleton()->get_root()->add_child(near_node);
+	SceneTree::get_singleton()->get_root()->add_child(far_node);
+
+	SUBCASE("[Node2D] Circle and rect queries only return nodes inside the area") {
+		TypedArray<Node> nodes = SceneTree::get_singleton()->get_nodes_in_group_in_circle("spatial", Vector2(), 20);
+		REQUIRE_EQ(nodes.size(), 1);
+		CHECK_EQ(Object::cast_to<Node>(nodes[0]), near_node);
+
+		nodes = SceneTree::get_singleton()->get_nodes_in_group_in_circle("spatial", Vector2(), 10);
+		CHECK(nodes.is_empty());
+
+		nodes = SceneTree::get_singleton()->get_nodes_in_group_in_rect("spatial", Rect2(150, -50, 100, 100));
+		REQUIRE_EQ(nodes.size(), 1);
+		CHECK_EQ(Object::cast_to<Node>(nodes[0]), far_node);
+
+		nodes = SceneTree::get_singleton()->get_nodes_in_group_in_rect("spatial", Rect2(-500, -500, 1000, 1000));
+		CHECK_EQ(nodes.size(), 2);
+
+		CHECK(SceneTree::get_singleton()->get_nodes_in_group_in_rect("missing", Rect2(-500, -500, 1000, 1000)).is_empty());
+	}
+
+	SUBCASE("[Node2D] Group membership changes are reflected in spatial queries") {
+		// Build the index first.
+		CHECK_EQ(SceneTree::get_singleton()->get_nodes_in_group_in_circle("spatial", Vector2(), 1000).size(), 2);
+
+		Node2D *new_node = memnew(Node2D);
+		new_node->set_position(Point2(-5, 0));
+		SceneTree::get_singleton()->get_root()->add_child(new_node);
+		new_node->add_to_group("spatial");
+		CHECK_EQ(SceneTree::get_singleton()->get_nodes_in_group_in_circle("spatial", Vector2(), 20).size(), 2);
+
+		memdelete(new_node);
+		near_node->remove_from_group("spatial");
+		CHECK(SceneTree::get_singleton()->get_nodes_in_group_in_circle("spatial", Vector2(), 20).is_empty());
+	}
+
+	memdelete(far_node);
+	memdelete(near_node);
+}
+
 } // namespace TestNode2D
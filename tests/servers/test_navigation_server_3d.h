@@ -30,6 +30,8 @@
 
 #pragma once
 
+#include "core/os/os.h"
+#include "modules/navigation_3d/3d/nav_mesh_generator_3d.h"
 #include "scene/3d/mesh_instance_3d.h"
 #include "scene/resources/3d/primitive_meshes.h"
 #include "servers/navigation_server_3d.h"
@@ -60,6 +62,64 @@ static inline Array build_array(Variant item, Targs... Fargs) {
 	return a;
 }
 
+static Ref<NavigationMesh> create_square_navigation_mesh(real_t p_size) {
+	Ref<NavigationMesh> navigation_mesh = memnew(NavigationMesh);
+	Vector<Vector3> vertices;
+	vertices.push_back(Vector3(0.0, 0.0, 0.0));
+	vertices.push_back(Vector3(p_size, 0.0, 0.0));
+	vertices.push_back(Vector3(p_size, 0.0, p_size));
+	vertices.push_back(Vector3(0.0, 0.0, p_size));
+	navigation_mesh->set_vertices(vertices);
+	Vector<int> polygon;
+	polygon.push_back(0);
+	polygon.push_back(1);
+	polygon.push_back(2);
+	polygon.push_back(3);
+	navigation_mesh->add_polygon(polygon);
+	return navigation_mesh;
+}
+
+// Places square regions next to each other so that their edges merge, offsetting the moved ones by less than the edge connection margin.
+static void set_region_grid_transforms(const LocalVector<RID> &p_regions, int p_columns, real_t p_size, const LocalVector<uint32_t> &p_moved, real_t p_offset) {
+	NavigationServer3D *navigation_server = NavigationServer3D::get_singleton();
+	for (uint32_t i = 0; i < p_regions.size(); i++) {
+		navigation_server->region_set_transform(p_regions[i], Transform3D(Basis(), Vector3((i % p_columns) * p_size, 0.0, (i / p_columns) * p_size)));
+	}
+	for (uint32_t moved : p_moved) {
+		navigation_server->region_set_transform(p_regions[moved], Transform3D(Basis(), Vector3((moved % p_columns) * p_size + p_offset, 0.0, (moved / p_columns) * p_size)));
+	}
+}
+
+static RID create_region_grid_map(LocalVector<RID> &r_regions, int p_columns, int p_rows, const Ref<NavigationMesh> &p_navigation_mesh) {
+	NavigationServer3D *navigation_server = NavigationServer3D::get_singleton();
+	RID map = navigation_server->map_create();
+	navigation_server->map_set_active(map, true);
+	navigation_server->map_set_use_async_iterations(map, false);
+	for (int i = 0; i < p_columns * p_rows; i++) {
+		RID region = navigation_server->region_create();
+		navigation_server->region_set_map(region, map);
+		navigation_server->region_set_navigation_mesh(region, p_navigation_mesh);
+		r_regions.push_back(region);
+	}
+	return map;
+}
+
+static real_t get_path_length(const Vector<Vector3> &p_path) {
+	real_t length = 0.0;
+	for (int i = 1; i < p_path.size(); i++) {
+		length += p_path[i - 1].distance_to(p_path[i]);
+	}
+	return length;
+}
+
+static void free_region_grid_map(RID p_map, const LocalVector<RID> &p_regions) {
+	NavigationServer3D *navigation_server = NavigationServer3D::get_singleton();
+	for (const RID &region : p_regions) {
+		navigation_server->free(region);
+	}
+	navigation_server->free(p_map);
+}
+
 TEST_SUITE("[Navigation3D]") {
 	TEST_CASE("[NavigationServer3D] Server should be empty when initialized") {
 		NavigationServer3D *navigation_server = NavigationServer3D::get_singleton();
@@ -157,6 +217,8 @@ TEST_SUITE("[Navigation3D]") {
 			navigation_server->map_set_up(map, Vector3(1, 0, 0));
 			bool initial_use_edge_connections = navigation_server->map_get_use_edge_connections(map);
 			navigation_server->map_set_use_edge_connections(map, !initial_use_edge_connections);
+			navigation_server->map_set_use_hierarchical_pathfinding(map, true);
+			navigation_server->map_set_hierarchical_pathfinding_cluster_size(map, 12.5);
 			navigation_server->physics_process(0.0); // Give server some cycles to commit.
 
 			CHECK_EQ(navigation_server->map_get_cell_size(map), doctest::Approx(0.55));
@@ -164,6 +226,8 @@ TEST_SUITE("[Navigation3D]") {
 			CHECK_EQ(navigation_server->map_get_link_connection_radius(map), doctest::Approx(0.77));
 			CHECK_EQ(navigation_server->map_get_up(map), Vector3(1, 0, 0));
 			CHECK_EQ(navigation_server->map_get_use_edge_connections(map), !initial_use_edge_connections);
+			CHECK(navigation_server->map_get_use_hierarchical_pathfinding(map));
+			CHECK_EQ(navigation_server->map_get_hierarchical_pathfinding_cluster_size(map), doctest::Approx(12.5));
 		}
 
 		SUBCASE("'ProcessInfo' should report map iff active") {
@@ -619,6 +683,27 @@ TEST_SUITE("[Navigation3D]") {
 			CHECK_EQ(indices[0] + 4, indices[6]);
 		}
 
+		SUBCASE("Deferred geometry should equal geometry that was added directly") {
+			const Transform3D xform = Transform3D(Basis(Vector3(0, 1, 0), Math_PI * 0.25), Vector3(1, 2, 3));
+			const PackedVector3Array faces = { Vector3(0, 0, 0), Vector3(1, 0, 0), Vector3(0, 0, 1) };
+
+			Ref<NavigationMeshSourceGeometryData3D> direct_geometry = memnew(NavigationMeshSourceGeometryData3D);
+			direct_geometry->add_mesh(plane_mesh, xform);
+			direct_geometry->add_faces(faces, xform);
+			direct_geometry->add_mesh(plane_mesh, Transform3D());
+
+			Ref<NavigationMeshSourceGeometryData3D> deferred_geometry = memnew(NavigationMeshSourceGeometryData3D);
+			deferred_geometry->begin_deferred_geometry();
+			deferred_geometry->add_mesh(plane_mesh, xform);
+			deferred_geometry->add_faces(faces, xform);
+			deferred_geometry->add_mesh(plane_mesh, Transform3D());
+			CHECK_EQ(deferred_geometry->get_vertices().size(), 0);
+			deferred_geometry->commit_deferred_geometry(true);
+
+			CHECK_EQ(deferred_geometry->get_vertices(), direct_geometry->get_vertices());
+			CHECK_EQ(deferred_geometry->get_indices(), direct_geometry->get_indices());
+		}
+
 		memdelete(mesh_instance);
 		memdelete(node_3d);
 	}
@@ -805,11 +890,328 @@ TEST_SUITE("[Navigation3D]") {
 			CHECK_EQ(query_result->get_path().size(), 0);
 		}
 
+		SUBCASE("Batch query should yield the same path ends as single queries") {
+			TypedArray<NavigationPathQueryParameters3D> batch_parameters;
+			TypedArray<NavigationPathQueryResult3D> batch_results;
+			// Enough queries to the same target to share a flow field, and one to another target.
+			for (int i = 0; i < 5; i++) {
+				Ref<NavigationPathQueryParameters3D> query_parameters;
+				query_parameters.instantiate();
+				query_parameters->set_map(map);
+				query_parameters->set_start_position(Vector3(-4 + 2 * i, 0, 4));
+				query_parameters->set_target_position(i < 4 ? Vector3(0, 0, -4) : Vector3(4, 0, -4));
+				batch_parameters.push_back(query_parameters);
+				Ref<NavigationPathQueryResult3D> query_result;
+				query_result.instantiate();
+				batch_results.push_back(query_result);
+			}
+			navigation_server->query_paths_batch(batch_parameters, batch_results);
+
+			for (int i = 0; i < batch_parameters.size(); i++) {
+				Ref<NavigationPathQueryResult3D> query_result;
+				query_result.instantiate();
+				navigation_server->query_path(batch_parameters[i], query_result);
+
+				const Ref<NavigationPathQueryResult3D> batch_result = batch_results[i];
+				const Vector<Vector3> batch_path = batch_result->get_path();
+				const Vector<Vector3> path = query_result->get_path();
+				REQUIRE_GE(batch_path.size(), 2);
+				REQUIRE_GE(path.size(), 2);
+				CHECK(batch_path[0].is_equal_approx(path[0]));
+				CHECK(batch_path[batch_path.size() - 1].is_equal_approx(path[path.size() - 1]));
+				CHECK_EQ(batch_result->get_path_rids().size(), batch_path.size());
+			}
+		}
+
+		SUBCASE("Flow field should point towards its target") {
+			RID flow_field = navigation_server->flow_field_create();
+			navigation_server->flow_field_set_map(flow_field, map);
+			navigation_server->flow_field_set_target_position(flow_field, Vector3(4, 0, -4));
+			navigation_server->physics_process(0.0); // Give server some cycles to commit.
+
+			CHECK_EQ(navigation_server->flow_field_get_map(flow_field), map);
+			const Vector3 direction = navigation_server->flow_field_get_direction(flow_field, Vector3(-4, 0, 4));
+			CHECK(direction.is_normalized());
+			CHECK_GT(direction.dot(Vector3(1, 0, -1)), 0.0);
+
+			navigation_server->flow_field_set_navigation_layers(flow_field, 2);
+			navigation_server->physics_process(0.0); // Give server some cycles to commit.
+			CHECK_EQ(navigation_server->flow_field_get_direction(flow_field, Vector3(-4, 0, 4)), Vector3());
+
+			navigation_server->free(flow_field);
+		}
+
 		navigation_server->free(region);
 		navigation_server->free(map);
 		navigation_server->physics_process(0.0); // Give server some cycles to commit.
 	}
 
+	TEST_CASE("[NavigationServer3D] Server should bake navigation mesh in tiles") {
+		NavigationServer3D *navigation_server = NavigationServer3D::get_singleton();
+		Ref<NavigationMesh> navigation_mesh = memnew(NavigationMesh);
+		navigation_mesh->set_tile_size(4.0);
+		Ref<NavigationMeshSourceGeometryData3D> source_geometry = memnew(NavigationMeshSourceGeometryData3D);
+
+		Array arr;
+		arr.resize(RS::ARRAY_MAX);
+		BoxMesh::create_mesh_array(arr, Vector3(10.0, 0.001, 10.0));
+		source_geometry->add_mesh_array(arr, Transform3D());
+		navigation_server->bake_from_source_geometry_data(navigation_mesh, source_geometry, Callable());
+		CHECK_NE(navigation_mesh->get_polygon_count(), 0);
+
+		const Vector<Vector3> baked_vertices = navigation_mesh->get_vertices();
+		const int baked_polygon_count = navigation_mesh->get_polygon_count();
+
+		SUBCASE("Rebaking unchanged source geometry should yield the same navigation mesh") {
+			navigation_server->bake_from_source_geometry_data(navigation_mesh, source_geometry, Callable());
+			CHECK_EQ(navigation_mesh->get_vertices(), baked_vertices);
+			CHECK_EQ(navigation_mesh->get_polygon_count(), baked_polygon_count);
+			CHECK_EQ(NavMeshGenerator3D::get_last_baked_tile_count(navigation_mesh), 0);
+		}
+
+		SUBCASE("Changing the source geometry in one tile should only rebake that tile") {
+			RID map = navigation_server->map_create();
+			RID region = navigation_server->region_create();
+			navigation_server->map_set_active(map, true);
+			navigation_server->map_set_use_async_iterations(map, false);
+			navigation_server->region_set_map(region, map);
+
+			// The vertical bounds are shared by all tiles, the pillar keeps them the same with and without the obstacle.
+			Array pillar_arr;
+			pillar_arr.resize(RS::ARRAY_MAX);
+			BoxMesh::create_mesh_array(pillar_arr, Vector3(0.5, 2.0, 0.5));
+			const Transform3D pillar_transform = Transform3D(Basis(), Vector3(4.5, 1.0, -4.5));
+			// The obstacle and the border each tile bakes around itself stay inside the tile from (0, 0) to (4, 4).
+			const Transform3D obstacle_transform = Transform3D(Basis(), Vector3(2.0, 1.0, 2.0));
+			const Vector3 floor_point = Vector3(2.0, 0.0, 2.0);
+
+			source_geometry->add_mesh_array(pillar_arr, pillar_transform);
+			source_geometry->add_mesh_array(pillar_arr, obstacle_transform);
+			navigation_server->bake_from_source_geometry_data(navigation_mesh, source_geometry, Callable());
+			CHECK_GT(NavMeshGenerator3D::get_last_baked_tile_count(navigation_mesh), 1);
+			navigation_server->region_set_navigation_mesh(region, navigation_mesh);
+			navigation_server->physics_process(0.0); // Give server some cycles to commit.
+			CHECK_GT(navigation_server->map_get_closest_point(map, floor_point).distance_to(floor_point), 0.5);
+
+			source_geometry->clear();
+			source_geometry->add_mesh_array(arr, Transform3D());
+			source_geometry->add_mesh_array(pillar_arr, pillar_transform);
+			navigation_server->bake_from_source_geometry_data(navigation_mesh, source_geometry, Callable());
+			CHECK_EQ(NavMeshGenerator3D::get_last_baked_tile_count(navigation_mesh), 1);
+			navigation_server->region_set_navigation_mesh(region, navigation_mesh);
+			navigation_server->physics_process(0.0); // Give server some cycles to commit.
+			CHECK_LT(navigation_server->map_get_closest_point(map, floor_point).distance_to(floor_point), 0.25);
+
+			// The reused tiles still connect to the rebaked one.
+			const Vector<Vector3> path = navigation_server->map_get_path(map, Vector3(-4, 0, -4), Vector3(4, 0, 4), true);
+			REQUIRE_NE(path.size(), 0);
+			CHECK_LT(path[path.size() - 1].distance_to(Vector3(4, 0, 4)), 0.5);
+
+			navigation_server->free(region);
+			navigation_server->free(map);
+			navigation_server->physics_process(0.0); // Give server some cycles to commit.
+		}
+
+		SUBCASE("Tiles should connect into a single navigation mesh") {
+			RID map = navigation_server->map_create();
+			RID region = navigation_server->region_create();
+			navigation_server->map_set_active(map, true);
+			navigation_server->map_set_use_async_iterations(map, false);
+			navigation_server->region_set_map(region, map);
+			navigation_server->region_set_navigation_mesh(region, navigation_mesh);
+			navigation_server->physics_process(0.0); // Give server some cycles to commit.
+
+			const Vector<Vector3> path = navigation_server->map_get_path(map, Vector3(-4, 0, -4), Vector3(4, 0, 4), true);
+			REQUIRE_NE(path.size(), 0);
+			CHECK_LT(path[path.size() - 1].distance_to(Vector3(4, 0, 4)), 0.5);
+
+			navigation_server->free(region);
+			navigation_server->free(map);
+			navigation_server->physics_process(0.0); // Give server some cycles to commit.
+		}
+	}
+
+	TEST_CASE("[NavigationServer3D] Closest point queries should ignore disabled regions") {
+		NavigationServer3D *navigation_server = NavigationServer3D::get_singleton();
+		const Ref<NavigationMesh> navigation_mesh = create_square_navigation_mesh(2.0);
+
+		RID map = navigation_server->map_create();
+		navigation_server->map_set_active(map, true);
+		navigation_server->map_set_use_async_iterations(map, false);
+		RID near_region = navigation_server->region_create();
+		navigation_server->region_set_map(near_region, map);
+		navigation_server->region_set_navigation_mesh(near_region, navigation_mesh);
+		RID far_region = navigation_server->region_create();
+		navigation_server->region_set_map(far_region, map);
+		navigation_server->region_set_navigation_mesh(far_region, navigation_mesh);
+		navigation_server->region_set_transform(far_region, Transform3D(Basis(), Vector3(10.0, 0.0, 0.0)));
+		navigation_server->physics_process(0.0); // Give server some cycles to commit.
+
+		CHECK_EQ(navigation_server->map_get_closest_point_owner(map, Vector3(1.0, 1.0, 1.0)), near_region);
+
+		navigation_server->region_set_enabled(near_region, false);
+		navigation_server->physics_process(0.0); // Give server some cycles to commit.
+
+		CHECK_EQ(navigation_server->map_get_closest_point_owner(map, Vector3(1.0, 1.0, 1.0)), far_region);
+		CHECK(navigation_server->map_get_closest_point(map, Vector3(1.0, 1.0, 1.0)).is_equal_approx(Vector3(10.0, 0.0, 1.0)));
+
+		navigation_server->free(near_region);
+		navigation_server->free(far_region);
+		navigation_server->free(map);
+		navigation_server->physics_process(0.0); // Give server some cycles to commit.
+	}
+
+	TEST_CASE("[NavigationServer3D] Map should connect moved regions like a new map") {
+		NavigationServer3D *navigation_server = NavigationServer3D::get_singleton();
+		const Ref<NavigationMesh> navigation_mesh = create_square_navigation_mesh(2.0);
+		constexpr int columns = 10;
+		constexpr int rows = 10;
+
+		LocalVector<RID> regions;
+		RID map = create_region_grid_map(regions, columns, rows, navigation_mesh);
+		LocalVector<uint32_t> moved;
+		set_region_grid_transforms(regions, columns, 2.0, moved, 0.0);
+		navigation_server->physics_process(0.0); // Give server some cycles to commit.
+
+		moved.push_back(12);
+		moved.push_back(45);
+		moved.push_back(77);
+		for (int frame = 1; frame <= 3; frame++) {
+			set_region_grid_transforms(regions, columns, 2.0, moved, frame * 0.05);
+			navigation_server->physics_process(0.0); // Give server some cycles to commit.
+		}
+
+		LocalVector<RID> new_regions;
+		RID new_map = create_region_grid_map(new_regions, columns, rows, navigation_mesh);
+		set_region_grid_transforms(new_regions, columns, 2.0, moved, 3 * 0.05);
+		navigation_server->physics_process(0.0); // Give server some cycles to commit.
+
+		const Vector3 from = Vector3(0.5, 0.0, 0.5);
+		const Vector3 to = Vector3(columns * 2.0 - 0.5, 0.0, rows * 2.0 - 0.5);
+		const Vector<Vector3> path = navigation_server->map_get_path(map, from, to, false);
+		REQUIRE_NE(path.size(), 0);
+		CHECK_LT(path[path.size() - 1].distance_to(to), 0.5);
+		CHECK_EQ(path, navigation_server->map_get_path(new_map, from, to, false));
+
+		free_region_grid_map(map, regions);
+		free_region_grid_map(new_map, new_regions);
+		navigation_server->physics_process(0.0); // Give server some cycles to commit.
+	}
+
+	TEST_CASE("[NavigationServer3D] Hierarchical pathfinding should find paths close to the full search") {
+		NavigationServer3D *navigation_server = NavigationServer3D::get_singleton();
+		const Ref<NavigationMesh> navigation_mesh = create_square_navigation_mesh(2.0);
+		constexpr int columns = 10;
+		constexpr int rows = 10;
+
+		LocalVector<RID> regions;
+		RID map = create_region_grid_map(regions, columns, rows, navigation_mesh);
+		navigation_server->map_set_hierarchical_pathfinding_cluster_size(map, 4.0);
+		LocalVector<uint32_t> moved;
+		set_region_grid_transforms(regions, columns, 2.0, moved, 0.0);
+		// A wall through the middle of the map, with a gap at the far end that paths have to go around to.
+		for (int row = 0; row < rows - 2; row++) {
+			navigation_server->region_set_enabled(regions[row * columns + columns / 2], false);
+		}
+		navigation_server->physics_process(0.0); // Give server some cycles to commit.
+
+		const Vector3 from = Vector3(0.5, 0.0, 0.5);
+		const Vector3 to = Vector3(columns * 2.0 - 0.5, 0.0, 0.5);
+		const Vector<Vector3> full_path = navigation_server->map_get_path(map, from, to, true);
+		REQUIRE_NE(full_path.size(), 0);
+		CHECK_LT(full_path[full_path.size() - 1].distance_to(to), 0.5);
+
+		navigation_server->map_set_use_hierarchical_pathfinding(map, true);
+		navigation_server->physics_process(0.0); // Give server some cycles to commit.
+
+		const Vector<Vector3> hierarchical_path = navigation_server->map_get_path(map, from, to, true);
+		REQUIRE_NE(hierarchical_path.size(), 0);
+		CHECK_LT(hierarchical_path[hierarchical_path.size() - 1].distance_to(to), 0.5);
+
+		// The detour through the gap is much longer than the straight line, the cluster route must not add much to it.
+		const real_t full_length = get_path_length(full_path);
+		const real_t hierarchical_length = get_path_length(hierarchical_path);
+		CHECK_GT(full_length, 1.5 * from.distance_to(to));
+		CHECK_LE(hierarchical_length, full_length * 1.1);
+
+		free_region_grid_map(map, regions);
+		navigation_server->physics_process(0.0); // Give server some cycles to commit.
+	}
+
+	TEST_CASE("[NavigationServer3D] Hierarchical pathfinding should fall back to the full search without a cluster route") {
+		NavigationServer3D *navigation_server = NavigationServer3D::get_singleton();
+		const Ref<NavigationMesh> navigation_mesh = create_square_navigation_mesh(2.0);
+		constexpr int columns = 6;
+		constexpr int rows = 1;
+
+		LocalVector<RID> regions;
+		RID map = create_region_grid_map(regions, columns, rows, navigation_mesh);
+		navigation_server->map_set_hierarchical_pathfinding_cluster_size(map, 4.0);
+		LocalVector<uint32_t> moved;
+		set_region_grid_transforms(regions, columns, 2.0, moved, 0.0);
+		// An island the rest of the map doesn't connect to, so the cluster graph has no route to it.
+		RID island = navigation_server->region_create();
+		navigation_server->region_set_map(island, map);
+		navigation_server->region_set_navigation_mesh(island, navigation_mesh);
+		navigation_server->region_set_transform(island, Transform3D(Basis(), Vector3(30.0, 0.0, 0.0)));
+		navigation_server->physics_process(0.0); // Give server some cycles to commit.
+
+		const Vector3 from = Vector3(0.5, 0.0, 0.5);
+		const Vector3 to = Vector3(31.0, 0.0, 1.0);
+		const Vector<Vector3> full_path = navigation_server->map_get_path(map, from, to, true);
+		REQUIRE_NE(full_path.size(), 0);
+
+		navigation_server->map_set_use_hierarchical_pathfinding(map, true);
+		navigation_server->physics_process(0.0); // Give server some cycles to commit.
+
+		// The full search leads to the closest reachable point instead, the hierarchical one must do the same.
+		const Vector<Vector3> hierarchical_path = navigation_server->map_get_path(map, from, to, true);
+		REQUIRE_NE(hierarchical_path.size(), 0);
+		CHECK_EQ(hierarchical_path, full_path);
+		CHECK_LT(hierarchical_path[hierarchical_path.size() - 1].x, columns * 2.0 + 0.5);
+
+		navigation_server->free(island);
+		free_region_grid_map(map, regions);
+		navigation_server->physics_process(0.0); // Give server some cycles to commit.
+	}
+
+	TEST_CASE("[Stress][NavigationServer3D] Sync a map with many regions while a few move") {
+		NavigationServer3D *navigation_server = NavigationServer3D::get_singleton();
+		const Ref<NavigationMesh> navigation_mesh = create_square_navigation_mesh(2.0);
+		constexpr int columns = 25;
+		constexpr int rows = 20;
+		constexpr int frames = 20;
+
+		LocalVector<RID> regions;
+		RID map = create_region_grid_map(regions, columns, rows, navigation_mesh);
+		LocalVector<uint32_t> moved;
+		set_region_grid_transforms(regions, columns, 2.0, moved, 0.0);
+		uint64_t begin = OS::get_singleton()->get_ticks_usec();
+		navigation_server->physics_process(0.0); // Give server some cycles to commit.
+		const uint64_t full_sync_usec = OS::get_singleton()->get_ticks_usec() - begin;
+
+		for (int i = 0; i < 5; i++) {
+			moved.push_back(i * 97 + 13);
+		}
+
+		begin = OS::get_singleton()->get_ticks_usec();
+		for (int frame = 1; frame <= frames; frame++) {
+			set_region_grid_transforms(regions, columns, 2.0, moved, (frame % 2) * 0.1);
+			navigation_server->physics_process(0.0); // Give server some cycles to commit.
+		}
+		const uint64_t moving_sync_usec = (OS::get_singleton()->get_ticks_usec() - begin) / frames;
+
+		const Vector3 to = Vector3(columns * 2.0 - 0.5, 0.0, rows * 2.0 - 0.5);
+		const Vector<Vector3> path = navigation_server->map_get_path(map, Vector3(0.5, 0.0, 0.5), to, false);
+		REQUIRE_NE(path.size(), 0);
+		CHECK_LT(path[path.size() - 1].distance_to(to), 0.5);
+
+		MESSAGE(vformat("%d regions: full sync %d usec, %d usec per sync with %d moving regions.", regions.size(), full_sync_usec, moving_sync_usec, moved.size()));
+
+		free_region_grid_map(map, regions);
+		navigation_server->physics_process(0.0); // Give server some cycles to commit.
+	}
+
 	// FIXME: The race condition mentioned below is actually a problem and fails on CI (GH-90613).
 	/*
 	TEST_CASE("[NavigationServer3D] Server should be able to bake asynchronously") {
@@ -54,8 +54,28 @@ namespace RVO2D {
 		}
 	}
 
-	void KdTree2D::buildAgentTreeRecursive(size_t begin, size_t end, size_t node)
+	void KdTree2D::buildAgentTreeTop(std::vector<Agent2D *> agents, size_t maxSubtreeSize, std::vector<AgentSubtree2D> &subtrees)
 	{
+		agents_.swap(agents);
+
+		if (!agents_.empty()) {
+			agentTree_.resize(2 * agents_.size() - 1);
+			buildAgentTreeRecursive(0, agents_.size(), 0, maxSubtreeSize, &subtrees);
+		}
+	}
+
+	void KdTree2D::buildAgentTreeRecursive(size_t begin, size_t end, size_t node, size_t maxSubtreeSize, std::vector<AgentSubtree2D> *subtrees)
+	{
+		if (subtrees != NULL && end - begin <= maxSubtreeSize) {
+			/* Left to the caller, subtrees only touch their own agents and nodes. */
+			AgentSubtree2D subtree;
+			subtree.begin = begin;
+			subtree.end = end;
+			subtree.node = node;
+			subtrees->push_back(subtree);
+			return;
+		}
+
 		agentTree_[node].begin = begin;
 		agentTree_[node].end = end;
 		agentTree_[node].minX = agentTree_[node].maxX = agents_[begin]->position_.x();
@@ -100,8 +120,8 @@ namespace RVO2D {
 			agentTree_[node].left = node + 1;
 			agentTree_[node].right = node + 2 * (left - begin);
 
-			buildAgentTreeRecursive(begin, left, agentTree_[node].left);
-			buildAgentTreeRecursive(left, end, agentTree_[node].right);
+			buildAgentTreeRecursive(begin, left, agentTree_[node].left, maxSubtreeSize, subtrees);
+			buildAgentTreeRecursive(left, end, agentTree_[node].right, maxSubtreeSize, subtrees);
 		}
 	}
 
@@ -93,6 +93,16 @@ namespace RVO2D {
 			size_t right;
 		};
 
+		/**
+		 * \brief      Defines an agent <i>k</i>d-subtree that is left to build.
+		 */
+		class AgentSubtree2D {
+		public:
+			size_t begin;
+			size_t end;
+			size_t node;
+		};
+
 		/**
 		 * \brief      Defines an obstacle <i>k</i>d-tree node.
 		 */
@@ -130,7 +140,15 @@ namespace RVO2D {
 		 */
 		void buildAgentTree(std::vector<Agent2D *> agents);
 
-		void buildAgentTreeRecursive(size_t begin, size_t end, size_t node);
+		/**
+		 * \brief      Builds the top levels of an agent <i>k</i>d-tree and collects
+		 *             the subtrees of at most maxSubtreeSize agents that are left
+		 *             to build. The subtrees do not overlap and can be built in
+		 *             parallel with buildAgentTreeRecursive().
+		 */
+		void buildAgentTreeTop(std::vector<Agent2D *> agents, size_t maxSubtreeSize, std::vector<AgentSubtree2D> &subtrees);
+
+		void buildAgentTreeRecursive(size_t begin, size_t end, size_t node, size_t maxSubtreeSize = 0, std::vector<AgentSubtree2D> *subtrees = NULL);
 
 		/**
 		 * \brief      Builds an obstacle <i>k</i>d-tree.
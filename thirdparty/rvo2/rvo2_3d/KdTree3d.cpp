@@ -53,8 +53,28 @@ namespace RVO3D {
 		}
 	}
 
-	void KdTree3D::buildAgentTreeRecursive(size_t begin, size_t end, size_t node)
+	void KdTree3D::buildAgentTreeTop(std::vector<Agent3D *> agents, size_t maxSubtreeSize, std::vector<AgentSubtree3D> &subtrees)
 	{
+		agents_.swap(agents);
+
+		if (!agents_.empty()) {
+			agentTree_.resize(2 * agents_.size() - 1);
+			buildAgentTreeRecursive(0, agents_.size(), 0, maxSubtreeSize, &subtrees);
+		}
+	}
+
+	void KdTree3D::buildAgentTreeRecursive(size_t begin, size_t end, size_t node, size_t maxSubtreeSize, std::vector<AgentSubtree3D> *subtrees)
+	{
+		if (subtrees != NULL && end - begin <= maxSubtreeSize) {
+			/* Left to the caller, subtrees only touch their own agents and nodes. */
+			AgentSubtree3D subtree;
+			subtree.begin = begin;
+			subtree.end = end;
+			subtree.node = node;
+			subtrees->push_back(subtree);
+			return;
+		}
+
 		agentTree_[node].begin = begin;
 		agentTree_[node].end = end;
 		agentTree_[node].minCoord = agents_[begin]->position_;
@@ -116,8 +136,8 @@ namespace RVO3D {
 			agentTree_[node].left = node + 1;
 			agentTree_[node].right = node + 2 * leftSize;
 
-			buildAgentTreeRecursive(begin, left, agentTree_[node].left);
-			buildAgentTreeRecursive(left, end, agentTree_[node].right);
+			buildAgentTreeRecursive(begin, left, agentTree_[node].left, maxSubtreeSize, subtrees);
+			buildAgentTreeRecursive(left, end, agentTree_[node].right, maxSubtreeSize, subtrees);
 		}
 	}
 
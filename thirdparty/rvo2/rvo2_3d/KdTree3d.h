@@ -86,6 +86,16 @@ namespace RVO3D {
 			Vector3 minCoord;
 		};
 
+		/**
+		 * \brief   Defines an agent <i>k</i>d-subtree that is left to build.
+		 */
+		class AgentSubtree3D {
+		public:
+			size_t begin;
+			size_t end;
+			size_t node;
+		};
+
 		/**
 		 * \brief   Constructs a <i>k</i>d-tree instance.
 		 * \param   sim  The simulator instance.
@@ -97,7 +107,15 @@ namespace RVO3D {
 		 */
 		void buildAgentTree(std::vector<Agent3D *> agents);
 
-		void buildAgentTreeRecursive(size_t begin, size_t end, size_t node);
+		/**
+		 * \brief   Builds the top levels of an agent <i>k</i>d-tree and collects
+		 *          the subtrees of at most maxSubtreeSize agents that are left
+		 *          to build. The subtrees do not overlap and can be built in
+		 *          parallel with buildAgentTreeRecursive().
+		 */
+		void buildAgentTreeTop(std::vector<Agent3D *> agents, size_t maxSubtreeSize, std::vector<AgentSubtree3D> &subtrees);
+
+		void buildAgentTreeRecursive(size_t begin, size_t end, size_t node, size_t maxSubtreeSize = 0, std::vector<AgentSubtree3D> *subtrees = NULL);
 
 		/**
 		 * \brief   Computes the agent neighbors of the specified agent.